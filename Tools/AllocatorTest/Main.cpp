@@ -0,0 +1,518 @@
+///************************* アロケータのテスト *************************///
+// RangeAllocator・MeshBufferArena・FrameRingAllocator の動作を確かめ、1つでも違えば終了コード 1 を返す
+//   RangeAllocator  : 先頭から探す確保、解放時の前後の空きとの結合、ハンドルの使い回し、
+//                     Defragment の移動の順番（重なった memmove で中身が壊れないこと）
+//   MeshBufferArena : 断片化で入らないときに詰め直して確保し直すこと、詰め直し後も中身とオフセットが合っていること
+//   FrameRingAllocator : アライメント、フレームの領域を超える確保の失敗、BeginFrame で領域が空に戻ること
+// デバイスは WARP（Windows 以外では Stub の代替）で作るので GPU が無くても動く
+//
+// 使い方: AllocatorTest
+
+// C++
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Engine
+#include "DeviceManager.h"
+#include "FrameRingAllocator.h"
+#include "MeshBufferArena.h"
+#include "RangeAllocator.h"
+
+namespace {
+
+	///************************* 判定 *************************///
+
+	int failedCount = 0;
+	int checkedCount = 0;
+
+	void Check(bool condition, const char* expression, const char* file, int line) {
+		++checkedCount;
+		if (!condition) {
+			++failedCount;
+			std::printf("  FAILED  %s(%d): %s\n", file, line, expression);
+		}
+	}
+
+#define TEST_CHECK(expression) Check((expression), #expression, __FILE__, __LINE__)
+
+	///************************* RangeAllocator *************************///
+
+	/// <summary>
+	/// 先頭から探して最初に入る空き区間を使う（最も小さい空きを選ぶわけではない）
+	/// </summary>
+	void TestRangeFirstFit() {
+		RangeAllocator allocator;
+		allocator.Initialize(100);
+
+		const RangeAllocator::Handle a = allocator.Allocate(10);
+		const RangeAllocator::Handle b = allocator.Allocate(20);
+		const RangeAllocator::Handle c = allocator.Allocate(30);
+		const RangeAllocator::Handle d = allocator.Allocate(10);
+		TEST_CHECK(allocator.GetOffset(a) == 0);
+		TEST_CHECK(allocator.GetOffset(b) == 10);
+		TEST_CHECK(allocator.GetOffset(c) == 30);
+		TEST_CHECK(allocator.GetOffset(d) == 60);
+
+		// 空き: [0,10) [30,60) [70,100)
+		allocator.Free(a);
+		allocator.Free(c);
+		TEST_CHECK(allocator.GetFreeRangeCount() == 3);
+
+		// 5 は先頭の [0,10) に入る
+		const RangeAllocator::Handle e = allocator.Allocate(5);
+		TEST_CHECK(allocator.GetOffset(e) == 0);
+		// 25 は残りの [5,10) に入らないので次の [30,60)（後ろの [70,100) ではない）
+		const RangeAllocator::Handle f = allocator.Allocate(25);
+		TEST_CHECK(allocator.GetOffset(f) == 30);
+		// 8 は [5,10) にも [55,60) にも入らないので [70,100)
+		const RangeAllocator::Handle g = allocator.Allocate(8);
+		TEST_CHECK(allocator.GetOffset(g) == 70);
+
+		// どこにも入らない
+		TEST_CHECK(allocator.Allocate(23) == RangeAllocator::kInvalidHandle);
+		TEST_CHECK(allocator.Allocate(0) == RangeAllocator::kInvalidHandle);
+		TEST_CHECK(allocator.GetUsedSize() == 5 + 20 + 25 + 10 + 8);
+		TEST_CHECK(allocator.GetAllocationCount() == 5);
+	}
+
+	/// <summary>
+	/// 解放した区間は前後の空きとつながる（どちらの順で解放しても1つに戻る）
+	/// </summary>
+	void TestRangeCoalesce() {
+		// 前の空きとつながる（a → b → c の順に解放）
+		{
+			RangeAllocator allocator;
+			allocator.Initialize(30);
+			const RangeAllocator::Handle a = allocator.Allocate(10);
+			const RangeAllocator::Handle b = allocator.Allocate(10);
+			const RangeAllocator::Handle c = allocator.Allocate(10);
+			TEST_CHECK(allocator.GetFreeRangeCount() == 0);
+
+			allocator.Free(a);
+			allocator.Free(b);
+			TEST_CHECK(allocator.GetFreeRangeCount() == 1);
+			TEST_CHECK(allocator.GetLargestFreeRange() == 20);
+			allocator.Free(c);
+			TEST_CHECK(allocator.GetFreeRangeCount() == 1);
+			TEST_CHECK(allocator.GetLargestFreeRange() == 30);
+		}
+
+		// 後ろの空きとつながる（c → b → a の順に解放）
+		{
+			RangeAllocator allocator;
+			allocator.Initialize(30);
+			const RangeAllocator::Handle a = allocator.Allocate(10);
+			const RangeAllocator::Handle b = allocator.Allocate(10);
+			const RangeAllocator::Handle c = allocator.Allocate(10);
+
+			allocator.Free(c);
+			allocator.Free(b);
+			TEST_CHECK(allocator.GetFreeRangeCount() == 1);
+			TEST_CHECK(allocator.GetLargestFreeRange() == 20);
+			allocator.Free(a);
+			TEST_CHECK(allocator.GetFreeRangeCount() == 1);
+			TEST_CHECK(allocator.GetLargestFreeRange() == 30);
+		}
+
+		// 前後の両方とつながる（a と c の間の b を最後に解放）
+		{
+			RangeAllocator allocator;
+			allocator.Initialize(100);
+			const RangeAllocator::Handle a = allocator.Allocate(10);
+			const RangeAllocator::Handle b = allocator.Allocate(10);
+			const RangeAllocator::Handle c = allocator.Allocate(10);
+
+			allocator.Free(a);
+			allocator.Free(c);
+			// [0,10) と [20,100)（c は後ろの空きとつながっている）
+			TEST_CHECK(allocator.GetFreeRangeCount() == 2);
+			TEST_CHECK(allocator.GetLargestFreeRange() == 80);
+			allocator.Free(b);
+			TEST_CHECK(allocator.GetFreeRangeCount() == 1);
+			TEST_CHECK(allocator.GetLargestFreeRange() == 100);
+			TEST_CHECK(allocator.GetUsedSize() == 0);
+			TEST_CHECK(allocator.GetAllocationCount() == 0);
+		}
+	}
+
+	/// <summary>
+	/// 返却されたハンドルは無効になり、次の確保で使い回される
+	/// </summary>
+	void TestRangeHandleReuse() {
+		RangeAllocator allocator;
+		allocator.Initialize(100);
+
+		const RangeAllocator::Handle a = allocator.Allocate(10);
+		const RangeAllocator::Handle b = allocator.Allocate(10);
+		allocator.Free(a);
+		TEST_CHECK(!allocator.IsValid(a));
+		TEST_CHECK(allocator.GetOffset(a) == RangeAllocator::kInvalidOffset);
+		TEST_CHECK(allocator.GetSize(a) == 0);
+
+		// 二重解放は何もしない
+		allocator.Free(a);
+		TEST_CHECK(allocator.GetUsedSize() == 10);
+		TEST_CHECK(allocator.GetAllocationCount() == 1);
+
+		// 同じハンドルが新しい区間を指す
+		const RangeAllocator::Handle c = allocator.Allocate(4);
+		TEST_CHECK(c == a);
+		TEST_CHECK(allocator.IsValid(c));
+		TEST_CHECK(allocator.GetOffset(c) == 0);
+		TEST_CHECK(allocator.GetSize(c) == 4);
+		TEST_CHECK(allocator.GetOffset(b) == 10);
+
+		// 使い回せるハンドルが無ければ新しい番号
+		const RangeAllocator::Handle d = allocator.Allocate(4);
+		TEST_CHECK(d != a && d != b);
+
+		// 範囲外のハンドルは無効
+		TEST_CHECK(!allocator.IsValid(RangeAllocator::kInvalidHandle));
+		allocator.Free(RangeAllocator::kInvalidHandle);
+		TEST_CHECK(allocator.GetAllocationCount() == 3);
+	}
+
+	/// <summary>
+	/// Defragment の移動を返した順に memmove すれば、区間が重なっていても中身が壊れない
+	/// </summary>
+	void TestRangeDefragment() {
+		RangeAllocator allocator;
+		allocator.Initialize(100);
+
+		const RangeAllocator::Handle a = allocator.Allocate(10);
+		const RangeAllocator::Handle b = allocator.Allocate(20);
+		const RangeAllocator::Handle c = allocator.Allocate(15);
+		const RangeAllocator::Handle d = allocator.Allocate(5);
+
+		// 区間ごとに違う値で埋めたバッファ
+		std::vector<uint8_t> buffer(100, 0xff);
+		const auto fill = [&](RangeAllocator::Handle handle, uint8_t tag) {
+			for (uint64_t i = 0; i < allocator.GetSize(handle); ++i) {
+				buffer[allocator.GetOffset(handle) + i] = static_cast<uint8_t>(tag + i);
+			}
+			};
+		const auto matches = [&](RangeAllocator::Handle handle, uint8_t tag) {
+			for (uint64_t i = 0; i < allocator.GetSize(handle); ++i) {
+				if (buffer[allocator.GetOffset(handle) + i] != static_cast<uint8_t>(tag + i)) { return false; }
+			}
+			return true;
+			};
+		fill(b, 0x20);
+		fill(d, 0x80);
+
+		// 空き: [0,10) [30,45) [50,100)
+		allocator.Free(a);
+		allocator.Free(c);
+		TEST_CHECK(allocator.GetFreeRangeCount() == 3);
+
+		// b: 10 → 0（移動元と移動先が重なる）
+		// d: 45 → 20（移動先が b の移動元 [10,30) と重なるので、b より先に動かすと b が壊れる）
+		const std::vector<RangeAllocator::Move> moves = allocator.Defragment();
+		TEST_CHECK(moves.size() == 2);
+		if (moves.size() == 2) {
+			TEST_CHECK(moves[0].handle == b && moves[0].from == 10 && moves[0].to == 0 && moves[0].size == 20);
+			TEST_CHECK(moves[1].handle == d && moves[1].from == 45 && moves[1].to == 20 && moves[1].size == 5);
+		}
+		for (const RangeAllocator::Move& move : moves) {
+			TEST_CHECK(move.to < move.from);
+			std::memmove(buffer.data() + move.to, buffer.data() + move.from, static_cast<size_t>(move.size));
+		}
+
+		TEST_CHECK(allocator.GetOffset(b) == 0);
+		TEST_CHECK(allocator.GetOffset(d) == 20);
+		TEST_CHECK(matches(b, 0x20));
+		TEST_CHECK(matches(d, 0x80));
+
+		// 空きは末尾の1つだけ
+		TEST_CHECK(allocator.GetFreeRangeCount() == 1);
+		TEST_CHECK(allocator.GetLargestFreeRange() == 75);
+		TEST_CHECK(allocator.GetUsedSize() == 25);
+
+		// 詰まっていれば移動は無い
+		TEST_CHECK(allocator.Defragment().empty());
+
+		// 詰め直した後も普通に確保・解放できる
+		const RangeAllocator::Handle e = allocator.Allocate(75);
+		TEST_CHECK(allocator.GetOffset(e) == 25);
+		allocator.Free(b);
+		allocator.Free(d);
+		allocator.Free(e);
+		TEST_CHECK(allocator.GetFreeRangeCount() == 1);
+		TEST_CHECK(allocator.GetLargestFreeRange() == 100);
+	}
+
+	///************************* MeshBufferArena *************************///
+
+	constexpr uint32_t kVertexStride = 12;
+
+	// 区間の中身（頂点は tag で埋め、インデックスは tag からの連番）
+	struct MeshData {
+		std::vector<uint8_t> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	MeshData MakeMeshData(uint32_t vertexCount, uint32_t indexCount, uint8_t tag) {
+		MeshData data;
+		data.vertices.assign(static_cast<size_t>(vertexCount) * kVertexStride, tag);
+		data.indices.resize(indexCount);
+		for (uint32_t i = 0; i < indexCount; ++i) {
+			data.indices[i] = tag * 1000u + i;
+		}
+		return data;
+	}
+
+	MeshBufferArena::Allocation Allocate(MeshBufferArena& arena, const MeshData& data) {
+		return arena.Allocate(data.vertices.data(), static_cast<uint32_t>(data.vertices.size() / kVertexStride),
+			data.indices.data(), static_cast<uint32_t>(data.indices.size()));
+	}
+
+	// 区間の現在の位置に書き込んだ中身が残っているか
+	bool Matches(const MeshBufferArena& arena, const MeshBufferArena::Allocation& allocation, const MeshData& data) {
+		const uint8_t* vertices = arena.GetMappedVertices() + static_cast<size_t>(allocation.GetBaseVertex()) * kVertexStride;
+		const uint32_t* indices = arena.GetMappedIndices() + allocation.GetFirstIndex();
+		return std::memcmp(vertices, data.vertices.data(), data.vertices.size()) == 0 &&
+			std::memcmp(indices, data.indices.data(), data.indices.size() * sizeof(uint32_t)) == 0;
+	}
+
+	/// <summary>
+	/// 合計では足りているのに断片化で入らないときは、詰め直してから確保する
+	/// </summary>
+	void TestArenaCompactAndRetry(DeviceManager* deviceManager) {
+		auto arena = std::make_shared<MeshBufferArena>();
+		arena->Initialize(deviceManager, kVertexStride, 100, 300);
+
+		const MeshData dataA = MakeMeshData(30, 90, 1);
+		const MeshData dataB = MakeMeshData(30, 90, 2);
+		const MeshData dataC = MakeMeshData(30, 90, 3);
+		MeshBufferArena::Allocation a = Allocate(*arena, dataA);
+		MeshBufferArena::Allocation b = Allocate(*arena, dataB);
+		MeshBufferArena::Allocation c = Allocate(*arena, dataC);
+		TEST_CHECK(a.IsValid() && b.IsValid() && c.IsValid());
+		TEST_CHECK(b.GetBaseVertex() == 30 && b.GetFirstIndex() == 90);
+		TEST_CHECK(c.GetBaseVertex() == 60 && c.GetFirstIndex() == 180);
+
+		// 頂点の空き: [0,30) [90,100)。合計 40 あるが 35 はどちらにも入らない
+		a.Release();
+		TEST_CHECK(!a.IsValid());
+		TEST_CHECK(arena->GetVertexAllocator().GetFreeSize() == 40);
+		TEST_CHECK(arena->GetVertexAllocator().GetLargestFreeRange() == 30);
+		TEST_CHECK(arena->GetDefragmentCount() == 0);
+
+		const MeshData dataD = MakeMeshData(35, 100, 4);
+		MeshBufferArena::Allocation d = Allocate(*arena, dataD);
+		TEST_CHECK(d.IsValid());
+		TEST_CHECK(arena->GetDefragmentCount() == 1);
+
+		// b と c は先頭へ詰められ、d はその後ろ。中身も一緒に動いている
+		TEST_CHECK(b.GetBaseVertex() == 0 && b.GetFirstIndex() == 0);
+		TEST_CHECK(c.GetBaseVertex() == 30 && c.GetFirstIndex() == 90);
+		TEST_CHECK(d.GetBaseVertex() == 60 && d.GetFirstIndex() == 180);
+		TEST_CHECK(Matches(*arena, b, dataB));
+		TEST_CHECK(Matches(*arena, c, dataC));
+		TEST_CHECK(Matches(*arena, d, dataD));
+
+		// 合計でも足りなければ詰め直さずに失敗する
+		const MeshData dataE = MakeMeshData(10, 10, 5);
+		MeshBufferArena::Allocation e = Allocate(*arena, dataE);
+		TEST_CHECK(!e.IsValid());
+		TEST_CHECK(arena->GetDefragmentCount() == 1);
+		// 失敗しても片方だけ確保されたまま残らない
+		TEST_CHECK(arena->GetVertexAllocator().GetUsedSize() == 95);
+		TEST_CHECK(arena->GetIndexAllocator().GetUsedSize() == 280);
+
+		// インデックス側だけ断片化していても詰め直す
+		c.Release();
+		const MeshData dataF = MakeMeshData(5, 110, 6);
+		// インデックスの空き: [90,180) [280,300)。合計 110 だが 1 つには入らない
+		TEST_CHECK(arena->GetIndexAllocator().GetLargestFreeRange() == 90);
+		MeshBufferArena::Allocation f = Allocate(*arena, dataF);
+		TEST_CHECK(f.IsValid());
+		TEST_CHECK(arena->GetDefragmentCount() == 2);
+		TEST_CHECK(Matches(*arena, b, dataB));
+		TEST_CHECK(Matches(*arena, d, dataD));
+		TEST_CHECK(Matches(*arena, f, dataF));
+
+		// 破棄すると返却される
+		b = {};
+		d = {};
+		f = {};
+		TEST_CHECK(arena->GetVertexAllocator().GetUsedSize() == 0);
+		TEST_CHECK(arena->GetIndexAllocator().GetUsedSize() == 0);
+		TEST_CHECK(arena->GetVertexAllocator().GetFreeRangeCount() == 1);
+
+		// アリーナが先に破棄されても区間の返却で落ちない
+		MeshBufferArena::Allocation leftover = Allocate(*arena, dataE);
+		TEST_CHECK(leftover.IsValid());
+		arena->Finalize();
+		arena.reset();
+		TEST_CHECK(!leftover.IsValid());
+		leftover.Release();
+	}
+
+	/// <summary>
+	/// 確保と解放を繰り返しても、生きている区間の中身とオフセットがずれない
+	/// </summary>
+	void TestArenaChurn(DeviceManager* deviceManager) {
+		auto arena = std::make_shared<MeshBufferArena>();
+		arena->Initialize(deviceManager, kVertexStride, 1000, 3000);
+
+		struct Live {
+			MeshBufferArena::Allocation allocation;
+			MeshData data;
+		};
+		std::vector<Live> lives;
+
+		// 再現できるよう乱数は固定の線形合同法
+		uint32_t state = 12345;
+		const auto next = [&state]() { state = state * 1664525u + 1013904223u; return state >> 8; };
+
+		bool intact = true;
+		for (int step = 0; step < 5000 && intact; ++step) {
+			if ((next() & 1) && !lives.empty()) {
+				lives.erase(lives.begin() + next() % lives.size());
+			} else {
+				MeshData data = MakeMeshData(1 + next() % 60, 1 + next() % 200, static_cast<uint8_t>(next()));
+				MeshBufferArena::Allocation allocation = Allocate(*arena, data);
+				if (allocation.IsValid()) {
+					lives.push_back({ std::move(allocation), std::move(data) });
+				}
+			}
+			for (const Live& live : lives) {
+				intact = intact && Matches(*arena, live.allocation, live.data);
+			}
+		}
+		TEST_CHECK(intact);
+		TEST_CHECK(arena->GetDefragmentCount() > 0);
+
+		lives.clear();
+		TEST_CHECK(arena->GetVertexAllocator().GetUsedSize() == 0);
+		TEST_CHECK(arena->GetIndexAllocator().GetUsedSize() == 0);
+		arena->Finalize();
+	}
+
+	///************************* FrameRingAllocator *************************///
+
+	/// <summary>
+	/// 切り出す先頭とサイズはアライメントに揃う（1フレーム分のサイズも切り上げる）
+	/// </summary>
+	void TestFrameRingAlignment() {
+		FrameRingAllocator allocator;
+		allocator.Initialize(1000, 3);
+		TEST_CHECK(allocator.GetAlignment() == FrameRingAllocator::kDefaultAlignment);
+		TEST_CHECK(allocator.GetBytesPerFrame() == 1024);
+		TEST_CHECK(allocator.GetTotalBytes() == 3072);
+
+		allocator.BeginFrame(0);
+		TEST_CHECK(allocator.Allocate(1) == 0);
+		TEST_CHECK(allocator.Allocate(300) == 256);
+		TEST_CHECK(allocator.Allocate(0) == 768);
+		TEST_CHECK(allocator.GetUsedBytes() == 1024);
+		TEST_CHECK(allocator.GetAllocationCount() == 3);
+
+		// 256 以外のアライメント
+		FrameRingAllocator small;
+		small.Initialize(100, 2, 16);
+		TEST_CHECK(small.GetBytesPerFrame() == 112);
+		small.BeginFrame(1);
+		const uint64_t first = small.Allocate(17);
+		const uint64_t second = small.Allocate(3);
+		TEST_CHECK(first == 112);
+		TEST_CHECK(second == 144);
+		TEST_CHECK(first % 16 == 0 && second % 16 == 0);
+	}
+
+	/// <summary>
+	/// 現在のフレームの領域に入らない確保は失敗し、次のフレームの領域にはみ出さない
+	/// </summary>
+	void TestFrameRingOverflow() {
+		FrameRingAllocator allocator;
+		allocator.Initialize(1024, 3);
+
+		allocator.BeginFrame(0);
+		TEST_CHECK(allocator.Allocate(768) == 0);
+		// 残り 256 に 257 は入らない
+		TEST_CHECK(allocator.Allocate(257) == FrameRingAllocator::kInvalidOffset);
+		TEST_CHECK(allocator.GetFailedCount() == 1);
+		TEST_CHECK(allocator.GetUsedBytes() == 768);
+		// 失敗しても残りはそのまま使える
+		TEST_CHECK(allocator.Allocate(256) == 768);
+		TEST_CHECK(allocator.Allocate(1) == FrameRingAllocator::kInvalidOffset);
+
+		// 1フレーム分より大きいもの（切り上げで桁あふれするサイズも含む）
+		allocator.BeginFrame(1);
+		TEST_CHECK(allocator.Allocate(1025) == FrameRingAllocator::kInvalidOffset);
+		TEST_CHECK(allocator.Allocate(UINT64_MAX) == FrameRingAllocator::kInvalidOffset);
+		TEST_CHECK(allocator.Allocate(UINT64_MAX - 100) == FrameRingAllocator::kInvalidOffset);
+		TEST_CHECK(allocator.GetFailedCount() == 3);
+		TEST_CHECK(allocator.GetUsedBytes() == 0);
+
+		// 最後のフレームも自分の領域の末尾で止まる
+		allocator.BeginFrame(2);
+		TEST_CHECK(allocator.Allocate(1024) == 2048);
+		TEST_CHECK(allocator.Allocate(1) == FrameRingAllocator::kInvalidOffset);
+	}
+
+	/// <summary>
+	/// BeginFrame でそのフレームの領域が先頭に戻る（フレーム番号は frameCount で巡回する）
+	/// </summary>
+	void TestFrameRingRewind() {
+		FrameRingAllocator allocator;
+		allocator.Initialize(1024, 3);
+
+		for (uint32_t frame = 0; frame < 7; ++frame) {
+			allocator.BeginFrame(frame);
+			const uint32_t frameIndex = frame % 3;
+			TEST_CHECK(allocator.GetCurrentFrameIndex() == frameIndex);
+			TEST_CHECK(allocator.GetUsedBytes() == 0);
+			TEST_CHECK(allocator.GetAllocationCount() == 0);
+			TEST_CHECK(allocator.GetFailedCount() == 0);
+
+			// 毎回そのフレームの領域の先頭から切り出され、他のフレームの領域には入らない
+			const uint64_t first = allocator.Allocate(100);
+			TEST_CHECK(first == allocator.GetFrameOffset(frameIndex));
+			uint64_t last = first;
+			while (true) {
+				const uint64_t offset = allocator.Allocate(200);
+				if (offset == FrameRingAllocator::kInvalidOffset) { break; }
+				last = offset;
+			}
+			TEST_CHECK(last >= allocator.GetFrameOffset(frameIndex));
+			TEST_CHECK(last + 256 <= allocator.GetFrameOffset(frameIndex) + allocator.GetBytesPerFrame());
+			TEST_CHECK(allocator.GetFailedCount() == 1);
+		}
+
+		// 最大使用量はフレームをまたいで残る
+		TEST_CHECK(allocator.GetPeakUsedBytes() == 1024);
+	}
+
+} // namespace
+
+int main() {
+	std::printf("RangeAllocator\n");
+	TestRangeFirstFit();
+	TestRangeCoalesce();
+	TestRangeHandleReuse();
+	TestRangeDefragment();
+
+	std::printf("MeshBufferArena\n");
+	DeviceManager deviceManager;
+	deviceManager.Initialize();
+	if (!deviceManager.GetDevice()) {
+		std::printf("  FAILED  デバイスを作成できません\n");
+		return 1;
+	}
+	TestArenaCompactAndRetry(&deviceManager);
+	TestArenaChurn(&deviceManager);
+	deviceManager.Finalize();
+
+	std::printf("FrameRingAllocator\n");
+	TestFrameRingAlignment();
+	TestFrameRingOverflow();
+	TestFrameRingRewind();
+
+	std::printf("AllocatorTest  %d checks  %d failed\n", checkedCount, failedCount);
+	return failedCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,5 @@
+#pragma once
+///************************* Windows 以外でのビルド用の最小限の代替 *************************///
+// Logger.h が使う分だけ（Windows でもコンソールには出ないので捨てる）
+
+inline void OutputDebugStringA(const char*) {}
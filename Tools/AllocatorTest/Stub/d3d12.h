@@ -0,0 +1,108 @@
+#pragma once
+///************************* Windows 以外でのビルド用の最小限の代替 *************************///
+// MeshBufferArena が使う分だけ。アップロードバッファは CPU のメモリで代用し、GPU アドレスはその先頭を返す
+
+// C++
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+using UINT = uint32_t;
+using HRESULT = int32_t;
+using D3D12_GPU_VIRTUAL_ADDRESS = uint64_t;
+
+#define S_OK ((HRESULT)0)
+#define E_FAIL ((HRESULT)0x80004005)
+#define E_OUTOFMEMORY ((HRESULT)0x8007000E)
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+
+enum D3D_FEATURE_LEVEL { D3D_FEATURE_LEVEL_11_0 = 0xb000, D3D_FEATURE_LEVEL_12_0 = 0xc000 };
+enum D3D12_HEAP_TYPE { D3D12_HEAP_TYPE_DEFAULT = 1, D3D12_HEAP_TYPE_UPLOAD = 2 };
+enum D3D12_HEAP_FLAGS { D3D12_HEAP_FLAG_NONE = 0 };
+enum D3D12_RESOURCE_DIMENSION { D3D12_RESOURCE_DIMENSION_UNKNOWN = 0, D3D12_RESOURCE_DIMENSION_BUFFER = 1 };
+enum D3D12_TEXTURE_LAYOUT { D3D12_TEXTURE_LAYOUT_UNKNOWN = 0, D3D12_TEXTURE_LAYOUT_ROW_MAJOR = 1 };
+enum D3D12_RESOURCE_STATES { D3D12_RESOURCE_STATE_COMMON = 0, D3D12_RESOURCE_STATE_GENERIC_READ = 0xac3 };
+enum DXGI_FORMAT { DXGI_FORMAT_UNKNOWN = 0, DXGI_FORMAT_R32_UINT = 42 };
+
+struct DXGI_SAMPLE_DESC {
+	UINT Count = 0;
+	UINT Quality = 0;
+};
+
+struct D3D12_HEAP_PROPERTIES {
+	D3D12_HEAP_TYPE Type{};
+};
+
+struct D3D12_RESOURCE_DESC {
+	D3D12_RESOURCE_DIMENSION Dimension{};
+	uint64_t Alignment = 0;
+	uint64_t Width = 0;
+	UINT Height = 0;
+	uint16_t DepthOrArraySize = 0;
+	uint16_t MipLevels = 0;
+	DXGI_FORMAT Format{};
+	DXGI_SAMPLE_DESC SampleDesc{};
+	D3D12_TEXTURE_LAYOUT Layout{};
+};
+
+struct D3D12_RANGE {
+	size_t Begin;
+	size_t End;
+};
+
+struct D3D12_VERTEX_BUFFER_VIEW {
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	UINT StrideInBytes;
+};
+
+struct D3D12_INDEX_BUFFER_VIEW {
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	DXGI_FORMAT Format;
+};
+
+struct D3D12_CLEAR_VALUE;
+
+// 参照カウントだけを持つ基底
+struct IUnknown {
+	virtual ~IUnknown() = default;
+	uint32_t AddRef() { return ++refCount_; }
+	uint32_t Release() {
+		const uint32_t count = --refCount_;
+		if (count == 0) { delete this; }
+		return count;
+	}
+private:
+	std::atomic<uint32_t> refCount_ = 1;
+};
+
+struct ID3D12Resource : IUnknown {
+	explicit ID3D12Resource(uint64_t sizeInBytes) : memory_(std::calloc(1, static_cast<size_t>(sizeInBytes))) {}
+	~ID3D12Resource() override { std::free(memory_); }
+
+	HRESULT Map(UINT, const D3D12_RANGE*, void** data) {
+		*data = memory_;
+		return memory_ ? S_OK : E_FAIL;
+	}
+	void Unmap(UINT, const D3D12_RANGE*) {}
+	D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const { return reinterpret_cast<D3D12_GPU_VIRTUAL_ADDRESS>(memory_); }
+
+private:
+	void* memory_ = nullptr;
+};
+
+struct ID3D12Device : IUnknown {
+	HRESULT CreateCommittedResource(const D3D12_HEAP_PROPERTIES*, D3D12_HEAP_FLAGS, const D3D12_RESOURCE_DESC* desc,
+		D3D12_RESOURCE_STATES, const D3D12_CLEAR_VALUE*, ID3D12Resource** resource) {
+		if (desc->Dimension != D3D12_RESOURCE_DIMENSION_BUFFER) { return E_FAIL; }
+		*resource = new ID3D12Resource(desc->Width);
+		return S_OK;
+	}
+};
+
+inline HRESULT D3D12CreateDevice(IUnknown*, D3D_FEATURE_LEVEL, ID3D12Device** device) {
+	*device = new ID3D12Device();
+	return S_OK;
+}
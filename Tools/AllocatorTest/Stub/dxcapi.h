@@ -0,0 +1,3 @@
+#pragma once
+///************************* Windows 以外でのビルド用の最小限の代替 *************************///
+// DeviceManager.h が include するだけで中身は使わない
@@ -0,0 +1,20 @@
+#pragma once
+///************************* Windows 以外でのビルド用の最小限の代替 *************************///
+// WARP アダプタの取得だけ（アダプタは中身を持たない）
+
+// C++
+#include "d3d12.h"
+
+struct IDXGIAdapter : IUnknown {};
+
+struct IDXGIFactory7 : IUnknown {
+	HRESULT EnumWarpAdapter(IDXGIAdapter** adapter) {
+		*adapter = new IDXGIAdapter();
+		return S_OK;
+	}
+};
+
+inline HRESULT CreateDXGIFactory(IDXGIFactory7** factory) {
+	*factory = new IDXGIFactory7();
+	return S_OK;
+}
@@ -0,0 +1,52 @@
+#pragma once
+///************************* Windows 以外でのビルド用の最小限の代替 *************************///
+// Microsoft::WRL::ComPtr のうちテストで使う分だけ（参照カウントは対象の AddRef / Release に任せる）
+
+// C++
+#include <utility>
+
+namespace Microsoft::WRL {
+
+	template <class T>
+	class ComPtr {
+	public:
+		ComPtr() = default;
+		ComPtr(std::nullptr_t) {}
+		ComPtr(const ComPtr& other) : ptr_(other.ptr_) { if (ptr_) { ptr_->AddRef(); } }
+		ComPtr(ComPtr&& other) noexcept : ptr_(std::exchange(other.ptr_, nullptr)) {}
+		~ComPtr() { Reset(); }
+
+		ComPtr& operator=(const ComPtr& other) {
+			if (other.ptr_) { other.ptr_->AddRef(); }
+			Reset();
+			ptr_ = other.ptr_;
+			return *this;
+		}
+		ComPtr& operator=(ComPtr&& other) noexcept {
+			if (this != &other) {
+				Reset();
+				ptr_ = std::exchange(other.ptr_, nullptr);
+			}
+			return *this;
+		}
+
+		void Reset() {
+			if (ptr_) { ptr_->Release(); }
+			ptr_ = nullptr;
+		}
+
+		T* Get() const { return ptr_; }
+		T* operator->() const { return ptr_; }
+		T** GetAddressOf() { return &ptr_; }
+		T** ReleaseAndGetAddressOf() { Reset(); return &ptr_; }
+		explicit operator bool() const { return ptr_ != nullptr; }
+		bool operator==(std::nullptr_t) const { return ptr_ == nullptr; }
+
+	private:
+		T* ptr_ = nullptr;
+	};
+
+} // namespace Microsoft::WRL
+
+// ComPtr のアドレスから型付きの出力先を取る
+#define IID_PPV_ARGS(ppType) (ppType)->ReleaseAndGetAddressOf()
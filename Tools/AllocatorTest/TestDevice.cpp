@@ -0,0 +1,31 @@
+///************************* テスト用のデバイス *************************///
+// DeviceManager.cpp の代わりにリンクする（ハードウェア GPU を探さず WARP で作る）
+// Windows 以外では Stub の d3d12.h が CPU のメモリでバッファを代用する
+
+#include "DeviceManager.h"
+
+/// <summary>
+/// WARP アダプタでデバイスを作る
+/// </summary>
+void DeviceManager::Initialize()
+{
+	HRESULT hr = CreateDXGIFactory(IID_PPV_ARGS(&dxgiFactory_));
+	assert(SUCCEEDED(hr));
+
+	Microsoft::WRL::ComPtr<IDXGIAdapter> warpAdapter;
+	hr = dxgiFactory_->EnumWarpAdapter(IID_PPV_ARGS(&warpAdapter));
+	assert(SUCCEEDED(hr));
+
+	hr = D3D12CreateDevice(warpAdapter.Get(), D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&device_));
+	assert(SUCCEEDED(hr));
+	(void)hr;
+}
+
+/// <summary>
+/// 解放
+/// </summary>
+void DeviceManager::Finalize()
+{
+	device_.Reset();
+	dxgiFactory_.Reset();
+}
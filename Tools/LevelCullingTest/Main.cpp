@@ -0,0 +1,152 @@
+///************************* レベル配置物のカリングのテスト *************************///
+// LevelObjectCuller の動作を確かめ、1つでも違えば終了コード 1 を返す
+//   読み込み中のオブジェクトは見えない扱いだが、完了の確認は毎回全オブジェクトで行うこと
+//   原点が視錐台の外にあっても、モデルが届いた回から本来の AABB で判定されて描けるようになること
+//   読み込みに失敗したもの（ずっと準備できないもの）は描かないこと
+//
+// 使い方: LevelCullingTest
+
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+// Engine
+#include "Frustum.h"
+#include "LevelObjectCuller.h"
+#include "MathFunc.h"
+
+namespace {
+
+	///************************* 判定 *************************///
+
+	int failedCount = 0;
+	int checkedCount = 0;
+
+	void Check(bool condition, const char* expression, const char* file, int line) {
+		++checkedCount;
+		if (!condition) {
+			++failedCount;
+			std::printf("  FAILED  %s(%d): %s\n", file, line, expression);
+		}
+	}
+
+#define TEST_CHECK(expression) Check((expression), #expression, __FILE__, __LINE__)
+
+	///************************* テスト用の配置物 *************************///
+
+	// Object3d の非同期読み込みの代わり（loaded になるまでモデルが無い）
+	struct FakeObject {
+		bool loaded = false;     // モデルが届いたか
+		AABB worldAABB = {};     // モデルが届いた後のワールド AABB
+		int readyQueries = 0;    // 完了を確かめられた回数
+		int aabbQueries = 0;     // AABB を求められた回数
+
+		bool IsModelReady() { ++readyQueries; return loaded; }
+		AABB GetWorldAABB() { ++aabbQueries; return loaded ? worldAABB : AABB{}; }
+	};
+
+	// 原点 (0,0,100) から +Z を向くカメラ。ワールドの原点は背後にあるので視錐台の外
+	Frustum MakeTestFrustum() {
+		const Matrix4x4 view = InverseAffine(MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 100.0f }));
+		return MakeFrustum(view * MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f));
+	}
+
+	// カメラの前方 distance にある 1 辺 2 の箱
+	AABB MakeBoxInFront(float distance) {
+		return { { -1.0f, -1.0f, 100.0f + distance - 1.0f }, { 1.0f, 1.0f, 100.0f + distance + 1.0f } };
+	}
+
+	std::span<const uint8_t> CullObjects(LevelObjectCuller& culler, const Frustum& frustum, std::vector<FakeObject>& objects) {
+		return culler.Cull(frustum, objects.size(),
+			[&](size_t i) { return objects[i].IsModelReady(); },
+			[&](size_t i) { return objects[i].GetWorldAABB(); });
+	}
+
+	///************************* テスト *************************///
+
+	/// <summary>
+	/// 読み込み中は描かず、モデルが届いた回から見えるようになる（原点は視錐台の外）
+	/// </summary>
+	void TestPendingBecomesVisible() {
+		const Frustum frustum = MakeTestFrustum();
+		TEST_CHECK(!IsInFrustum(frustum, AABB{}));
+		TEST_CHECK(IsInFrustum(frustum, MakeBoxInFront(20.0f)));
+
+		LevelObjectCuller culler;
+		std::vector<FakeObject> objects(1);
+		objects[0].worldAABB = MakeBoxInFront(20.0f);
+
+		// 読み込み中: 見えない扱いで、仮の AABB は求めない
+		for (int frame = 0; frame < 3; ++frame) {
+			const std::span<const uint8_t> visible = CullObjects(culler, frustum, objects);
+			TEST_CHECK(visible.size() == 1 && visible[0] == 0);
+		}
+		TEST_CHECK(objects[0].readyQueries == 3);
+		TEST_CHECK(objects[0].aabbQueries == 0);
+
+		// モデルが届いた次の回で、本来の AABB で判定されて見える
+		objects[0].loaded = true;
+		const std::span<const uint8_t> visible = CullObjects(culler, frustum, objects);
+		TEST_CHECK(visible.size() == 1 && visible[0] == 1);
+		TEST_CHECK(objects[0].readyQueries == 4);
+		TEST_CHECK(objects[0].aabbQueries == 1);
+	}
+
+	/// <summary>
+	/// 見えないものも含め、完了の確認は毎回全オブジェクトで行う（SIMD の 8 個単位と端数の両方）
+	/// </summary>
+	void TestMixedObjects() {
+		const Frustum frustum = MakeTestFrustum();
+		LevelObjectCuller culler;
+
+		// 0: 読み込み済みで前方 / 1: 読み込み済みで背後 / 2: 読み込み中で前方 / 3: 読み込みに失敗 を繰り返す
+		std::vector<FakeObject> objects(19);
+		for (size_t i = 0; i < objects.size(); ++i) {
+			const float distance = 10.0f + static_cast<float>(i);
+			switch (i % 4) {
+			case 0: objects[i].loaded = true;  objects[i].worldAABB = MakeBoxInFront(distance); break;
+			case 1: objects[i].loaded = true;  objects[i].worldAABB = MakeBoxInFront(-distance); break;
+			case 2: objects[i].loaded = false; objects[i].worldAABB = MakeBoxInFront(distance); break;
+			case 3: objects[i].loaded = false; objects[i].worldAABB = {}; break;
+			}
+		}
+
+		std::span<const uint8_t> visible = CullObjects(culler, frustum, objects);
+		TEST_CHECK(visible.size() == objects.size());
+		for (size_t i = 0; i < objects.size(); ++i) {
+			TEST_CHECK(visible[i] == ((i % 4 == 0) ? 1 : 0));
+			TEST_CHECK(objects[i].readyQueries == 1);
+			TEST_CHECK(objects[i].aabbQueries == (objects[i].loaded ? 1 : 0));
+		}
+
+		// 読み込み中だったものが届くと見える（失敗したものは見えないまま）
+		for (size_t i = 2; i < objects.size(); i += 4) {
+			objects[i].loaded = true;
+		}
+		visible = CullObjects(culler, frustum, objects);
+		for (size_t i = 0; i < objects.size(); ++i) {
+			TEST_CHECK(visible[i] == ((i % 4 == 0 || i % 4 == 2) ? 1 : 0));
+			TEST_CHECK(objects[i].readyQueries == 2);
+		}
+
+		// 数が減っても前回の結果は残らない
+		objects.resize(3);
+		visible = CullObjects(culler, frustum, objects);
+		TEST_CHECK(visible.size() == 3);
+		TEST_CHECK(visible[0] == 1 && visible[1] == 0 && visible[2] == 1);
+	}
+
+} // namespace
+
+int main()
+{
+	std::printf("LevelObjectCuller\n");
+	TestPendingBecomesVisible();
+	TestMixedObjects();
+
+	std::printf("LevelCullingTest  %d checks  %d failed\n", checkedCount, failedCount);
+	return failedCount == 0 ? 0 : 1;
+}
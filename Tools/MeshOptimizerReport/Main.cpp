@@ -0,0 +1,342 @@
+///************************* メッシュ最適化レポート *************************///
+// OBJ をエンジンと同じ頂点形式（位置・UV・法線、面の角ごとに別頂点）で読み込み、
+// MeshOptimizer をかけて頂点数と ACMR / ATVR の変化を表示する
+// 最適化の前後で三角形の集合（頂点の値と巻き順）が変わっていないことも確かめ、違えば終了コード 1 を返す
+// 続けて MeshSimplifier で LOD を作り、段ごとの三角形数と誤差を表示する（インデックスが範囲内で、潰れた三角形が無いことも確かめる）
+// DirectX / assimp には依存しないので Windows 以外でもビルドできる
+//
+// 使い方: MeshOptimizerReport [--input ディレクトリかファイル]... [--no-weld] [--no-overdraw] [--no-lod] [--csv]
+//   --input 対象（複数指定可。省略時は Resources/Models）
+//   ファイルが無くても、合成した格子メッシュで必ず1回は確かめる
+
+// C++
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Engine
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+	///************************* 設定 *************************///
+
+	struct Options {
+		std::vector<fs::path> inputs;
+		MeshOptimizer::Options optimizer;
+		bool lod = true;
+		bool csv = false;
+	};
+
+	// Mesh::VertexData と同じ並び
+	struct Vertex {
+		float position[4];
+		float texcoord[2];
+		float normal[3];
+	};
+	static_assert(sizeof(Vertex) == 36);
+
+	struct MeshSource {
+		std::string name;
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	///************************* 読み込み *************************///
+
+	// OBJ のインデックス（1 始まり、負は末尾から）
+	int ResolveIndex(long index, size_t count) {
+		if (index > 0) { return static_cast<int>(index - 1); }
+		if (index < 0) { return static_cast<int>(static_cast<long>(count) + index); }
+		return -1;
+	}
+
+	/// <summary>
+	/// OBJ の読み込み（assimp を通したときと同じく、右手系 → 左手系、UV の上下反転、巻き順の反転を行う）
+	/// </summary>
+	bool LoadObj(const fs::path& path, MeshSource& mesh) {
+		std::ifstream file(path);
+		if (!file) { return false; }
+
+		std::vector<float> positions;
+		std::vector<float> texcoords;
+		std::vector<float> normals;
+		std::string line;
+		std::vector<uint32_t> face;
+		while (std::getline(file, line)) {
+			std::istringstream stream(line);
+			std::string tag;
+			stream >> tag;
+			if (tag == "v") {
+				float x = 0, y = 0, z = 0;
+				stream >> x >> y >> z;
+				positions.insert(positions.end(), { -x, y, z });
+			} else if (tag == "vt") {
+				float u = 0, v = 0;
+				stream >> u >> v;
+				texcoords.insert(texcoords.end(), { u, 1.0f - v });
+			} else if (tag == "vn") {
+				float x = 0, y = 0, z = 0;
+				stream >> x >> y >> z;
+				normals.insert(normals.end(), { -x, y, z });
+			} else if (tag == "f") {
+				face.clear();
+				std::string corner;
+				while (stream >> corner) {
+					long p = 0, t = 0, n = 0;
+					const char* cursor = corner.c_str();
+					char* end = nullptr;
+					p = std::strtol(cursor, &end, 10);
+					if (*end == '/') {
+						cursor = end + 1;
+						t = std::strtol(cursor, &end, 10);
+						if (*end == '/') {
+							n = std::strtol(end + 1, &end, 10);
+						}
+					}
+
+					Vertex vertex{};
+					const int pi = ResolveIndex(p, positions.size() / 3);
+					const int ti = ResolveIndex(t, texcoords.size() / 2);
+					const int ni = ResolveIndex(n, normals.size() / 3);
+					if (pi < 0 || static_cast<size_t>(pi) * 3 >= positions.size()) { return false; }
+					std::memcpy(vertex.position, &positions[static_cast<size_t>(pi) * 3], sizeof(float) * 3);
+					vertex.position[3] = 1.0f;
+					if (ti >= 0 && static_cast<size_t>(ti) * 2 < texcoords.size()) {
+						std::memcpy(vertex.texcoord, &texcoords[static_cast<size_t>(ti) * 2], sizeof(float) * 2);
+					}
+					if (ni >= 0 && static_cast<size_t>(ni) * 3 < normals.size()) {
+						std::memcpy(vertex.normal, &normals[static_cast<size_t>(ni) * 3], sizeof(float) * 3);
+					}
+					face.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+					mesh.vertices.push_back(vertex);
+				}
+
+				// 扇形に三角形へ分ける（巻き順は反転）
+				for (size_t k = 2; k < face.size(); ++k) {
+					mesh.indices.insert(mesh.indices.end(), { face[0], face[k], face[k - 1] });
+				}
+			}
+		}
+		mesh.name = path.generic_string();
+		return !mesh.indices.empty();
+	}
+
+	// 合成した格子（角ごとに別頂点なので、結合と並べ替えの両方が効く）
+	MeshSource MakeGrid(uint32_t size) {
+		MeshSource mesh;
+		mesh.name = "(synthetic grid " + std::to_string(size) + "x" + std::to_string(size) + ")";
+		const auto corner = [size](uint32_t x, uint32_t y) {
+			Vertex vertex{};
+			vertex.position[0] = static_cast<float>(x);
+			vertex.position[2] = static_cast<float>(y);
+			vertex.position[3] = 1.0f;
+			vertex.texcoord[0] = static_cast<float>(x) / static_cast<float>(size);
+			vertex.texcoord[1] = static_cast<float>(y) / static_cast<float>(size);
+			vertex.normal[1] = 1.0f;
+			return vertex;
+		};
+		// わざと行をまたいだ順に並べてキャッシュ効率を落としておく
+		for (uint32_t x = 0; x < size; ++x) {
+			for (uint32_t y = 0; y < size; ++y) {
+				const uint32_t base = static_cast<uint32_t>(mesh.vertices.size());
+				mesh.vertices.insert(mesh.vertices.end(), { corner(x, y), corner(x + 1, y), corner(x + 1, y + 1), corner(x, y + 1) });
+				mesh.indices.insert(mesh.indices.end(), { base, base + 2, base + 1, base, base + 3, base + 2 });
+			}
+		}
+		return mesh;
+	}
+
+	///************************* 確認 *************************///
+
+	// 三角形を頂点の値で表した並べ替え済みの一覧（巻き順は保ったまま、最小の頂点が先頭になるよう回す）
+	std::vector<std::string> CanonicalTriangles(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+		std::vector<std::string> triangles;
+		triangles.reserve(indices.size() / 3);
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+			std::string_view corners[3];
+			for (int k = 0; k < 3; ++k) {
+				corners[k] = std::string_view(reinterpret_cast<const char*>(&vertices[indices[i + k]]), sizeof(Vertex));
+			}
+			const int first = static_cast<int>(std::min_element(corners, corners + 3) - corners);
+			std::string key;
+			for (int k = 0; k < 3; ++k) {
+				key.append(corners[(first + k) % 3]);
+			}
+			triangles.push_back(std::move(key));
+		}
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	// LOD のインデックスが範囲内で、潰れた三角形が無く、前の段より三角形が少ないこと
+	bool ValidateLods(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<MeshSimplifier::Lod>& lods) {
+		size_t previousCount = indices.size();
+		float previousError = 0.0f;
+		for (const MeshSimplifier::Lod& lod : lods) {
+			if (lod.indices.empty() || lod.indices.size() % 3 != 0 || lod.indices.size() >= previousCount || lod.error < previousError) { return false; }
+			for (size_t i = 0; i < lod.indices.size(); i += 3) {
+				const uint32_t a = lod.indices[i], b = lod.indices[i + 1], c = lod.indices[i + 2];
+				if (a >= vertices.size() || b >= vertices.size() || c >= vertices.size()) { return false; }
+				if (a == b || b == c || c == a) { return false; }
+			}
+			previousCount = lod.indices.size();
+			previousError = lod.error;
+		}
+		return true;
+	}
+
+	// "4096 > 2048(0.01) > 1024(0.03)" のような段ごとの三角形数と誤差
+	std::string DescribeLods(const std::vector<uint32_t>& indices, const std::vector<MeshSimplifier::Lod>& lods, bool csv) {
+		std::string text = std::to_string(indices.size() / 3);
+		for (const MeshSimplifier::Lod& lod : lods) {
+			char error[32];
+			std::snprintf(error, sizeof(error), "(%.3g)", lod.error);
+			text += (csv ? " " : " > ") + std::to_string(lod.indices.size() / 3) + error;
+		}
+		return text;
+	}
+
+	///************************* オプション *************************///
+
+	Options ParseOptions(int argc, char** argv) {
+		Options options;
+		for (int i = 1; i < argc; ++i) {
+			const std::string arg = argv[i];
+			if (arg == "--input" && i + 1 < argc) {
+				options.inputs.emplace_back(argv[++i]);
+			} else if (arg == "--no-weld") {
+				options.optimizer.weld = false;
+			} else if (arg == "--no-overdraw") {
+				options.optimizer.overdraw = false;
+			} else if (arg == "--no-lod") {
+				options.lod = false;
+			} else if (arg == "--csv") {
+				options.csv = true;
+			} else {
+				std::printf("usage: %s [--input path]... [--no-weld] [--no-overdraw] [--no-lod] [--csv]\n", argv[0]);
+				std::exit(arg == "--help" ? 0 : 1);
+			}
+		}
+		if (options.inputs.empty()) {
+			options.inputs = { "Resources/Models" };
+		}
+		return options;
+	}
+
+	// 対象の OBJ を集める（パスの順に並べて、出力の順番を毎回同じにする）
+	std::vector<fs::path> CollectSources(const std::vector<fs::path>& inputs) {
+		std::vector<fs::path> sources;
+		for (const fs::path& input : inputs) {
+			std::error_code error;
+			if (fs::is_regular_file(input, error)) {
+				sources.push_back(input);
+				continue;
+			}
+			if (!fs::is_directory(input, error)) {
+				std::printf("warning: %s が見つかりません\n", input.string().c_str());
+				continue;
+			}
+			for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input, error)) {
+				std::string extension = entry.path().extension().string();
+				std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+				if (entry.is_regular_file() && extension == ".obj") {
+					sources.push_back(entry.path());
+				}
+			}
+		}
+		std::sort(sources.begin(), sources.end());
+		sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+		return sources;
+	}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	const Options options = ParseOptions(argc, argv);
+
+	std::vector<MeshSource> meshes;
+	meshes.push_back(MakeGrid(64));
+	for (const fs::path& source : CollectSources(options.inputs)) {
+		MeshSource mesh;
+		if (LoadObj(source, mesh)) {
+			meshes.push_back(std::move(mesh));
+		} else {
+			std::printf("warning: %s を読み込めません\n", source.generic_string().c_str());
+		}
+	}
+
+	if (options.csv) {
+		std::printf("name,vertices_before,vertices_after,triangles,acmr_before,acmr_after,atvr_before,atvr_after,index16,ms,lods\n");
+	} else {
+		std::printf("%-52s %9s %9s %9s %7s %7s %7s %7s %5s %8s\n", "mesh", "verts", "-> verts", "tris", "ACMR", "-> ACMR", "ATVR", "-> ATVR", "16bit", "ms");
+	}
+
+	uint32_t failures = 0;
+	uint64_t missesBefore = 0;
+	uint64_t missesAfter = 0;
+	uint64_t totalTriangles = 0;
+	for (MeshSource& mesh : meshes) {
+		const std::vector<std::string> expected = CanonicalTriangles(mesh.vertices, mesh.indices);
+
+		const auto start = std::chrono::steady_clock::now();
+		const MeshOptimizer::Report report = MeshOptimizer::Optimize(mesh.vertices, mesh.indices, options.optimizer);
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		// インデックスが範囲内で、三角形の集合が変わっていないこと
+		bool valid = std::all_of(mesh.indices.begin(), mesh.indices.end(), [&](uint32_t index) { return index < mesh.vertices.size(); });
+		valid = valid && CanonicalTriangles(mesh.vertices, mesh.indices) == expected;
+
+		// 最適化後のメッシュから LOD を作る（UV の継ぎ目も見る。法線の違いは形の誤差に任せる）
+		std::vector<MeshSimplifier::Lod> lods;
+		if (options.lod) {
+			MeshSimplifier::LodOptions lodOptions;
+			lodOptions.simplify.attributeOffset = static_cast<uint32_t>(offsetof(Vertex, texcoord));
+			lodOptions.simplify.attributeCount = 2;
+			lods = MeshSimplifier::GenerateLods(mesh.indices, mesh.vertices.data(), static_cast<uint32_t>(mesh.vertices.size()), sizeof(Vertex), lodOptions);
+			valid = valid && ValidateLods(mesh.vertices, mesh.indices, lods);
+		}
+		const double lodMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() - ms;
+		if (!valid) { ++failures; }
+
+		missesBefore += report.before.cacheMisses;
+		missesAfter += report.after.cacheMisses;
+		totalTriangles += report.after.triangleCount;
+
+		if (options.csv) {
+			std::printf("%s,%u,%u,%u,%.4f,%.4f,%.4f,%.4f,%d,%.3f,%s\n", mesh.name.c_str(),
+				report.before.vertexCount, report.after.vertexCount, report.after.triangleCount,
+				report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr,
+				report.canUse16BitIndices ? 1 : 0, ms, DescribeLods(mesh.indices, lods, true).c_str());
+		} else {
+			std::printf("%-52s %9u %9u %9u %7.3f %7.3f %7.3f %7.3f %5s %8.2f%s\n", mesh.name.c_str(),
+				report.before.vertexCount, report.after.vertexCount, report.after.triangleCount,
+				report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr,
+				report.canUse16BitIndices ? "yes" : "no", ms, valid ? "" : "  ** MISMATCH **");
+			if (options.lod) {
+				std::printf("    LOD %s  %.2f ms\n", DescribeLods(mesh.indices, lods, false).c_str(), lodMs);
+			}
+		}
+	}
+
+	if (!options.csv && totalTriangles > 0) {
+		std::printf("\n%zu meshes, ACMR %.3f -> %.3f, %u failed\n", meshes.size(),
+			static_cast<double>(missesBefore) / static_cast<double>(totalTriangles),
+			static_cast<double>(missesAfter) / static_cast<double>(totalTriangles), failures);
+	}
+	return failures == 0 ? 0 : 1;
+}
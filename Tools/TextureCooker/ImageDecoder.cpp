@@ -0,0 +1,189 @@
+#include "ImageDecoder.h"
+
+// C++
+#include <algorithm>
+#include <cctype>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+// libpng / libjpeg
+#include <png.h>
+#include <jpeglib.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+	// ファイルをすべて読む
+	bool ReadFile(const fs::path& path, std::vector<uint8_t>& bytes) {
+		std::ifstream file(path, std::ios::binary);
+		if (!file) { return false; }
+		bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		return !file.bad();
+	}
+
+	///************************* PNG *************************///
+
+	/// <summary>
+	/// libpng の簡易 API で RGBA8 に展開する（パレット・グレー・16 bit も変換される）
+	/// </summary>
+	bool DecodePng(const std::vector<uint8_t>& bytes, ImageDecoder::Image& image, std::string& error) {
+		png_image png{};
+		png.version = PNG_IMAGE_VERSION;
+		if (!png_image_begin_read_from_memory(&png, bytes.data(), bytes.size())) {
+			error = png.message;
+			return false;
+		}
+
+		png.format = PNG_FORMAT_RGBA;
+		image.width = png.width;
+		image.height = png.height;
+		image.pixels.resize(PNG_IMAGE_SIZE(png));
+		if (!png_image_finish_read(&png, nullptr, image.pixels.data(), 0, nullptr)) {
+			error = png.message;
+			return false;
+		}
+		return true;
+	}
+
+	///************************* JPG *************************///
+
+	// libjpeg は既定だとエラーで exit するので、longjmp で戻ってくる
+	struct JpegErrorManager {
+		jpeg_error_mgr base;
+		std::jmp_buf jump;
+		char message[JMSG_LENGTH_MAX];
+	};
+
+	void OnJpegError(j_common_ptr info) {
+		JpegErrorManager* manager = reinterpret_cast<JpegErrorManager*>(info->err);
+		(*info->err->format_message)(info, manager->message);
+		std::longjmp(manager->jump, 1);
+	}
+
+	/// <summary>
+	/// libjpeg で RGB に展開して RGBA8 に広げる（グレーは RGB に変換される）
+	/// longjmp で飛ばされても困らないよう、この関数の中ではデストラクタを持つ変数を作らない
+	/// </summary>
+	bool DecodeJpeg(const std::vector<uint8_t>& bytes, ImageDecoder::Image& image, std::string& error) {
+		jpeg_decompress_struct info{};
+		JpegErrorManager errorManager{};
+		info.err = jpeg_std_error(&errorManager.base);
+		errorManager.base.error_exit = OnJpegError;
+
+		if (setjmp(errorManager.jump)) {
+			jpeg_destroy_decompress(&info);
+			error = errorManager.message;
+			return false;
+		}
+
+		jpeg_create_decompress(&info);
+		jpeg_mem_src(&info, bytes.data(), static_cast<unsigned long>(bytes.size()));
+		jpeg_read_header(&info, TRUE);
+		info.out_color_space = JCS_RGB;
+		jpeg_start_decompress(&info);
+
+		image.width = info.output_width;
+		image.height = info.output_height;
+		image.pixels.resize(static_cast<size_t>(image.width) * image.height * 4);
+
+		// 各行は RGBA の行の先頭へ RGB のまま読み、後ろから広げる
+		while (info.output_scanline < info.output_height) {
+			uint8_t* row = image.pixels.data() + static_cast<size_t>(info.output_scanline) * image.width * 4;
+			JSAMPROW rows[1] = { row };
+			jpeg_read_scanlines(&info, rows, 1);
+			for (uint32_t x = image.width; x-- > 0;) {
+				row[x * 4 + 3] = 0xff;
+				row[x * 4 + 2] = row[x * 3 + 2];
+				row[x * 4 + 1] = row[x * 3 + 1];
+				row[x * 4 + 0] = row[x * 3 + 0];
+			}
+		}
+
+		jpeg_finish_decompress(&info);
+		jpeg_destroy_decompress(&info);
+		return true;
+	}
+
+	///************************* BMP *************************///
+
+	uint16_t ReadU16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+	uint32_t ReadU32(const uint8_t* p) { return static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24)); }
+
+	/// <summary>
+	/// 非圧縮の 24 / 32 bit BMP を RGBA8 に展開する（32 bit の 4 バイト目は WIC と同じく使わない）
+	/// </summary>
+	bool DecodeBmp(const std::vector<uint8_t>& bytes, ImageDecoder::Image& image, std::string& error) {
+		constexpr size_t kFileHeaderSize = 14;
+		constexpr size_t kInfoHeaderSize = 40;
+		if (bytes.size() < kFileHeaderSize + kInfoHeaderSize || bytes[0] != 'B' || bytes[1] != 'M') {
+			error = "BMP のヘッダが不正";
+			return false;
+		}
+
+		const uint8_t* info = bytes.data() + kFileHeaderSize;
+		const uint32_t pixelOffset = ReadU32(bytes.data() + 10);
+		const int32_t width = static_cast<int32_t>(ReadU32(info + 4));
+		const int32_t height = static_cast<int32_t>(ReadU32(info + 8));
+		const uint16_t bitCount = ReadU16(info + 14);
+		const uint32_t compression = ReadU32(info + 16);
+		if (compression != 0 || (bitCount != 24 && bitCount != 32)) {
+			error = "非圧縮の 24 / 32 bit 以外の BMP には対応していない";
+			return false;
+		}
+		if (width <= 0 || height == 0) {
+			error = "BMP の大きさが不正";
+			return false;
+		}
+
+		// 高さが負なら上の行から並んでいる
+		const bool topDown = height < 0;
+		image.width = static_cast<uint32_t>(width);
+		image.height = static_cast<uint32_t>(topDown ? -static_cast<int64_t>(height) : height);
+
+		const size_t bytesPerPixel = bitCount / 8;
+		const size_t stride = (static_cast<size_t>(image.width) * bitCount + 31) / 32 * 4;
+		if (pixelOffset > bytes.size() || (bytes.size() - pixelOffset) / stride < image.height) {
+			error = "BMP のデータが足りない";
+			return false;
+		}
+
+		image.pixels.resize(static_cast<size_t>(image.width) * image.height * 4);
+		for (uint32_t y = 0; y < image.height; ++y) {
+			const uint32_t sourceRow = topDown ? y : image.height - 1 - y;
+			const uint8_t* source = bytes.data() + pixelOffset + sourceRow * stride;
+			uint8_t* destination = image.pixels.data() + static_cast<size_t>(y) * image.width * 4;
+			for (uint32_t x = 0; x < image.width; ++x) {
+				destination[x * 4 + 0] = source[x * bytesPerPixel + 2];
+				destination[x * 4 + 1] = source[x * bytesPerPixel + 1];
+				destination[x * 4 + 2] = source[x * bytesPerPixel + 0];
+				destination[x * 4 + 3] = 0xff;
+			}
+		}
+		return true;
+	}
+
+} // namespace
+
+bool ImageDecoder::Decode(const fs::path& sourcePath, Image& image, std::string& error)
+{
+	std::string extension = sourcePath.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(),
+		[](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+	std::vector<uint8_t> bytes;
+	if (!ReadFile(sourcePath, bytes)) {
+		error = "ファイルを読めない";
+		return false;
+	}
+
+	if (extension == ".png") { return DecodePng(bytes, image, error); }
+	if (extension == ".jpg" || extension == ".jpeg") { return DecodeJpeg(bytes, image, error); }
+	if (extension == ".bmp") { return DecodeBmp(bytes, image, error); }
+
+	error = "対応していない形式";
+	return false;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+///************************* 画像の展開（WIC の代わり） *************************///
+///
+/// Windows 以外には WIC が無いので、PNG / JPG / BMP をここで RGBA8 に展開する
+/// PNG は libpng、JPG は libjpeg(-turbo) を使い、BMP は非圧縮の 24 / 32 bit のみ自前で読む
+/// 色空間の扱い（sRGB かどうか）は呼び出し側で決める
+///
+/// DirectX には依存しない（Windows では WIC を使うのでビルドしない）
+///
+namespace ImageDecoder {
+
+	// 展開した画像（1 ピクセル 4 バイトの RGBA、上の行から順に詰める）
+	struct Image {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		std::vector<uint8_t> pixels;
+	};
+
+	// 拡張子で形式を決めて展開する（失敗したら false を返し、error に理由を入れる）
+	bool Decode(const std::filesystem::path& sourcePath, Image& image, std::string& error);
+}
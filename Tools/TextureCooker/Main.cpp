@@ -0,0 +1,362 @@
+///************************* テクスチャ変換ツール *************************///
+// 画像をミップ付きの BC7 / BC5 / BC4 の DDS に変換し、内容のハッシュを名前にしてキャッシュへ書き出す
+// 名前の規則は TextureCache.h。実行時は TextureManager::LoadTexture がハッシュの一致する変換済みファイルを優先して読む
+// （起動のたびに PNG を展開してミップを作る処理が無くなり、VRAM も 1/4 になる）
+//
+// 使い方: TextureCooker [--input ディレクトリ]... [--output ディレクトリ] [--jobs 数] [--fast] [--force] [--prune]
+//   --input  変換元（複数指定可。省略時は Resources/Textures, Resources/images, Resources/Models）
+//   --output キャッシュの置き場所（省略時は Resources/Cooked/Textures）
+//   --jobs   同時に変換するファイル数（省略時は CPU のスレッド数）
+//   --fast   BC7 の探索を最小にする（画質は落ちるが数倍速い）
+//   --force  キャッシュがあっても変換し直す
+//   --prune  今回の変換元に対応しないキャッシュを削除する
+//
+// Windows では PNG / JPG / BMP を WIC で、それ以外では ImageDecoder（libpng / libjpeg）で読む
+// 1つでも変換に失敗すれば終了コード 1 を返す
+
+// C++
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#ifdef _WIN32
+#include <objbase.h>
+#endif
+
+// DirectXTex
+#include "DirectXTex.h"
+
+// Engine
+#include "TextureCache.h"
+
+#ifndef _WIN32
+#include "ImageDecoder.h"
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+	///************************* 設定 *************************///
+
+	struct Options {
+		std::vector<fs::path> inputs;
+		fs::path output = TextureCache::kDefaultCacheDirectory;
+		uint32_t jobs = 0;
+		bool fast = false;
+		bool force = false;
+		bool prune = false;
+	};
+
+	// 1ファイル分の結果
+	struct CookResult {
+		enum class Status { Cooked, UpToDate, Failed };
+
+		Status status = Status::Failed;
+		uint64_t hash = 0;
+		DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+		size_t rawBytes = 0;		// 実行時に非圧縮でミップを作った場合の VRAM
+		size_t cookedBytes = 0;		// 変換後の VRAM
+		std::string message;
+	};
+
+	// 種類ごとの圧縮形式
+	DXGI_FORMAT GetCompressedFormat(TextureCache::Kind kind) {
+		switch (kind) {
+		case TextureCache::Kind::Normal: return DXGI_FORMAT_BC5_UNORM;
+		case TextureCache::Kind::Mask:   return DXGI_FORMAT_BC4_UNORM;
+		default:                         return DXGI_FORMAT_BC7_UNORM_SRGB;
+		}
+	}
+
+	///************************* 読み込み *************************///
+
+	/// <summary>
+	/// 元画像を読む（カラーは sRGB、法線・マスクはリニアとして扱う）
+	/// </summary>
+	HRESULT LoadSource(const fs::path& sourcePath, TextureCache::Kind kind, DirectX::ScratchImage& image, [[maybe_unused]] std::string& error) {
+		std::string extension = sourcePath.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(),
+			[](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+		HRESULT hr = E_FAIL;
+		if (extension == ".tga") {
+			hr = DirectX::LoadFromTGAFile(sourcePath.wstring().c_str(), DirectX::TGA_FLAGS_NONE, nullptr, image);
+		} else {
+#ifdef _WIN32
+			const DirectX::WIC_FLAGS flags = (kind == TextureCache::Kind::Color)
+				? DirectX::WIC_FLAGS_FORCE_SRGB : DirectX::WIC_FLAGS_IGNORE_SRGB;
+			hr = DirectX::LoadFromWICFile(sourcePath.wstring().c_str(), flags, nullptr, image);
+#else
+			// RGBA8 に展開して ScratchImage へ移す（sRGB は下で WIC の場合と同じく付ける）
+			ImageDecoder::Image decoded;
+			if (!ImageDecoder::Decode(sourcePath, decoded, error)) {
+				return E_FAIL;
+			}
+			hr = image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, decoded.width, decoded.height, 1, 1);
+			if (FAILED(hr)) { return hr; }
+
+			const DirectX::Image* destination = image.GetImage(0, 0, 0);
+			const size_t rowBytes = static_cast<size_t>(decoded.width) * 4;
+			for (uint32_t y = 0; y < decoded.height; ++y) {
+				std::memcpy(destination->pixels + y * destination->rowPitch, decoded.pixels.data() + y * rowBytes, rowBytes);
+			}
+#endif
+		}
+		if (FAILED(hr)) { return hr; }
+
+		// 実行時の読み込み（WIC_FLAGS_FORCE_SRGB）と揃える
+		if (kind == TextureCache::Kind::Color) {
+			image.OverrideFormat(DirectX::MakeSRGB(image.GetMetadata().format));
+		}
+		return S_OK;
+	}
+
+	///************************* 変換 *************************///
+
+	/// <summary>
+	/// 1ファイルを変換してキャッシュへ書き出す
+	/// </summary>
+	CookResult CookTexture(const fs::path& sourcePath, const Options& options, bool parallelCompress) {
+		CookResult result;
+		const TextureCache::Kind kind = TextureCache::ClassifyTexture(sourcePath);
+
+		result.hash = TextureCache::HashSource(sourcePath);
+		if (result.hash == 0) {
+			result.message = "読み込めません";
+			return result;
+		}
+
+		std::error_code error;
+		const fs::path cookedPath = TextureCache::MakeCookedPath(result.hash, options.output);
+		if (!options.force && fs::exists(cookedPath, error)) {
+			result.status = CookResult::Status::UpToDate;
+			return result;
+		}
+
+		DirectX::ScratchImage image;
+		std::string decodeError;
+		HRESULT hr = LoadSource(sourcePath, kind, image, decodeError);
+		if (FAILED(hr)) {
+			result.message = decodeError.empty() ? "画像の展開に失敗" : "画像の展開に失敗（" + decodeError + "）";
+			return result;
+		}
+
+		// ミップ（実行時と同じフィルタ）
+		const DirectX::TexMetadata& metadata = image.GetMetadata();
+		const DirectX::TEX_FILTER_FLAGS filter = (kind == TextureCache::Kind::Color)
+			? DirectX::TEX_FILTER_SRGB : DirectX::TEX_FILTER_DEFAULT;
+		DirectX::ScratchImage mipImages;
+		hr = DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), metadata, filter, 0, mipImages);
+		if (FAILED(hr)) {
+			result.message = "ミップの生成に失敗";
+			return result;
+		}
+		result.rawBytes = mipImages.GetPixelsSize();
+
+		// BC は 4x4 ブロック単位なので、最上位が 4 の倍数でなければ圧縮せずミップだけ保存する
+		DirectX::ScratchImage compressed;
+		const DirectX::ScratchImage* output = &mipImages;
+		if (metadata.width % 4 == 0 && metadata.height % 4 == 0) {
+			DirectX::TEX_COMPRESS_FLAGS flags = DirectX::TEX_COMPRESS_DEFAULT;
+			if (options.fast) { flags |= DirectX::TEX_COMPRESS_BC7_QUICK; }
+			if (parallelCompress) { flags |= DirectX::TEX_COMPRESS_PARALLEL; }
+
+			hr = DirectX::Compress(mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(),
+				GetCompressedFormat(kind), flags, DirectX::TEX_THRESHOLD_DEFAULT, compressed);
+			if (FAILED(hr)) {
+				result.message = "圧縮に失敗";
+				return result;
+			}
+			output = &compressed;
+		}
+		result.format = output->GetMetadata().format;
+		result.cookedBytes = output->GetPixelsSize();
+
+		// 途中で止まっても壊れたキャッシュが残らないよう、別名で書いてから置き換える
+		fs::path temporaryPath = cookedPath;
+		temporaryPath += ".tmp";
+		hr = DirectX::SaveToDDSFile(output->GetImages(), output->GetImageCount(), output->GetMetadata(),
+			DirectX::DDS_FLAGS_NONE, temporaryPath.wstring().c_str());
+		if (FAILED(hr)) {
+			result.message = "DDS の書き出しに失敗";
+			return result;
+		}
+		fs::rename(temporaryPath, cookedPath, error);
+		if (error) {
+			fs::remove(temporaryPath, error);
+			result.message = "キャッシュの置き換えに失敗";
+			return result;
+		}
+
+		result.status = CookResult::Status::Cooked;
+		return result;
+	}
+
+	///************************* 引数 *************************///
+
+	Options ParseOptions(int argc, char** argv) {
+		Options options;
+		for (int i = 1; i < argc; ++i) {
+			const std::string arg = argv[i];
+			if (arg == "--input" && i + 1 < argc) {
+				options.inputs.emplace_back(argv[++i]);
+			} else if (arg == "--output" && i + 1 < argc) {
+				options.output = argv[++i];
+			} else if (arg == "--jobs" && i + 1 < argc) {
+				options.jobs = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+			} else if (arg == "--fast") {
+				options.fast = true;
+			} else if (arg == "--force") {
+				options.force = true;
+			} else if (arg == "--prune") {
+				options.prune = true;
+			} else {
+				std::printf("usage: %s [--input dir]... [--output dir] [--jobs count] [--fast] [--force] [--prune]\n", argv[0]);
+				std::exit(arg == "--help" ? 0 : 1);
+			}
+		}
+
+		if (options.inputs.empty()) {
+			options.inputs = { "Resources/Textures", "Resources/images", "Resources/Models" };
+		}
+		if (options.jobs == 0) {
+			options.jobs = std::max(1u, std::thread::hardware_concurrency());
+		}
+		return options;
+	}
+
+	// 変換元を集める（パスの順に並べて、出力の順番を毎回同じにする）
+	std::vector<fs::path> CollectSources(const std::vector<fs::path>& inputs) {
+		std::vector<fs::path> sources;
+		for (const fs::path& input : inputs) {
+			std::error_code error;
+			if (!fs::is_directory(input, error)) {
+				std::printf("warning: %s はディレクトリではありません\n", input.string().c_str());
+				continue;
+			}
+			for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input, error)) {
+				if (entry.is_regular_file() && TextureCache::IsCookableExtension(entry.path())) {
+					sources.push_back(entry.path());
+				}
+			}
+		}
+		std::sort(sources.begin(), sources.end());
+		sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+		return sources;
+	}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	const Options options = ParseOptions(argc, argv);
+	const std::vector<fs::path> sources = CollectSources(options.inputs);
+
+	std::error_code error;
+	fs::create_directories(options.output, error);
+	if (error) {
+		std::printf("error: %s を作成できません\n", options.output.string().c_str());
+		return 1;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	//------------------------------------------------------------
+	// ファイル単位で並列に変換する
+	// 1スレッドのときだけ DirectXTex の並列圧縮（OpenMP）に任せる
+	//------------------------------------------------------------
+	std::vector<CookResult> results(sources.size());
+	std::atomic<size_t> next = 0;
+	std::mutex printMutex;
+	const uint32_t threadCount = std::min<uint32_t>(options.jobs, static_cast<uint32_t>(std::max<size_t>(1, sources.size())));
+	const bool parallelCompress = (threadCount == 1);
+
+	const auto worker = [&]() {
+#ifdef _WIN32
+		// WIC は COM なのでスレッドごとに初期化する
+		const HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+		for (size_t index = next++; index < sources.size(); index = next++) {
+			results[index] = CookTexture(sources[index], options, parallelCompress);
+
+			const CookResult& result = results[index];
+			if (result.status == CookResult::Status::Cooked) {
+				std::lock_guard<std::mutex> lock(printMutex);
+				std::printf("  cooked  %-60s %s  %s\n", sources[index].generic_string().c_str(),
+					TextureCache::MakeCookedPath(result.hash, {}).string().c_str(),
+					DirectX::IsCompressed(result.format) ? "" : "(4 の倍数でないため非圧縮)");
+			} else if (result.status == CookResult::Status::Failed) {
+				std::lock_guard<std::mutex> lock(printMutex);
+				std::fprintf(stderr, "  error   %-60s %s\n", sources[index].generic_string().c_str(), result.message.c_str());
+			}
+		}
+#ifdef _WIN32
+		if (SUCCEEDED(comResult)) { CoUninitialize(); }
+#endif
+		};
+
+	std::vector<std::thread> threads;
+	for (uint32_t i = 1; i < threadCount; ++i) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	//------------------------------------------------------------
+	// 古いキャッシュの削除
+	//------------------------------------------------------------
+	size_t prunedCount = 0;
+	if (options.prune) {
+		std::unordered_set<std::string> alive;
+		for (const CookResult& result : results) {
+			if (result.hash != 0) {
+				alive.insert(TextureCache::MakeCookedPath(result.hash, {}).string());
+			}
+		}
+		for (const fs::directory_entry& entry : fs::directory_iterator(options.output, error)) {
+			if (entry.is_regular_file() && entry.path().extension() == ".dds" && !alive.contains(entry.path().filename().string())) {
+				fs::remove(entry.path(), error);
+				++prunedCount;
+			}
+		}
+	}
+
+	//------------------------------------------------------------
+	// 集計
+	//------------------------------------------------------------
+	size_t cooked = 0, upToDate = 0, failed = 0;
+	size_t rawBytes = 0, cookedBytes = 0;
+	for (const CookResult& result : results) {
+		switch (result.status) {
+		case CookResult::Status::Cooked:   ++cooked; break;
+		case CookResult::Status::UpToDate: ++upToDate; break;
+		case CookResult::Status::Failed:   ++failed; break;
+		}
+		rawBytes += result.rawBytes;
+		cookedBytes += result.cookedBytes;
+	}
+
+	std::printf("TextureCooker  %zu files  cooked %zu / up-to-date %zu / failed %zu / pruned %zu  (%.2f s, %u threads)\n",
+		sources.size(), cooked, upToDate, failed, prunedCount, seconds, threadCount);
+	if (cooked > 0) {
+		std::printf("  VRAM (今回変換した分): RGBA8 + mips %.2f MB -> %.2f MB\n",
+			static_cast<double>(rawBytes) / (1024.0 * 1024.0), static_cast<double>(cookedBytes) / (1024.0 * 1024.0));
+	}
+	return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,305 @@
+///************************* YMath マイクロベンチマーク *************************///
+// YMath の主要関数を1回あたりのナノ秒で計測する
+// YMath 以外（DirectX / エンジン）には依存しないので Windows 以外でもビルドできる
+//
+// 使い方: YMathBench [--filter 名前の一部] [--iterations 回数] [--csv]
+//   同じソースを YMATH_FORCE_SCALAR 付きでビルドしたもの（YMathBenchScalar）と出力を並べると、
+//   SIMD バックエンドとスカラー実装の差が比較できる
+
+// C++
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Math
+#include "MathFunc.h"
+#include "Matrix4x4.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+#include "Easing.h"
+#include "Frustum.h"
+#include "Spline.h"
+#include "TransformBatch.h"
+
+namespace {
+
+	///************************* 計測の補助 *************************///
+
+	// 結果を使ったことにして最適化で計算ごと消されないようにする
+	template <typename T>
+	inline void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+		static const void* volatile sink;
+		sink = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "g"(&value) : "memory");
+#endif
+	}
+
+	// 入力配列の要素数（2の累乗。インデックスはマスクで回す）
+	constexpr size_t kInputCount = 1024;
+	constexpr size_t kInputMask = kInputCount - 1;
+
+	// 計測を繰り返す回数（最速の回を採用する）
+	constexpr int kRepeatCount = 5;
+
+	struct Options {
+		std::string filter;
+		size_t iterations = size_t(1) << 18;
+		bool csv = false;
+	};
+
+	struct Result {
+		std::string name;
+		double nsPerOp = 0.0;
+	};
+
+	/// <summary>
+	/// body(i) を iterations 回呼び、1回あたりのナノ秒を返す
+	/// </summary>
+	template <typename Body>
+	double Measure(size_t iterations, const Body& body) {
+		// ウォームアップ（キャッシュと分岐予測を温める）
+		for (size_t i = 0; i < std::min<size_t>(iterations, kInputCount * 4); ++i) {
+			body(i & kInputMask);
+		}
+
+		double best = 0.0;
+		for (int r = 0; r < kRepeatCount; ++r) {
+			const auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < iterations; ++i) {
+				body(i & kInputMask);
+			}
+			const auto end = std::chrono::steady_clock::now();
+			const double ns = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+			best = (r == 0) ? ns : std::min(best, ns);
+		}
+		return best;
+	}
+
+	///************************* 入力データ *************************///
+
+	struct Inputs {
+		std::vector<Matrix4x4> matrices;
+		std::vector<Matrix4x4> affines;
+		std::vector<Vector3> vectors;
+		std::vector<Vector3> scales;
+		std::vector<Vector3> rotates;
+		std::vector<Quaternion> quaternions;
+		std::vector<float> params;
+		std::vector<AABB> aabbs;
+		std::vector<Sphere> spheres;
+		std::vector<Vector3> splinePoints;
+		Spline spline;
+	};
+
+	/// <summary>
+	/// 乱数で入力を作る（毎回同じ値になるようシードは固定）
+	/// </summary>
+	Inputs MakeInputs() {
+		std::mt19937 rng(12345);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> positive(0.5f, 2.0f);
+		std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+		std::uniform_real_distribution<float> param(0.0f, 1.0f);
+
+		const auto randomVector = [&](std::uniform_real_distribution<float>& dist) {
+			return Vector3{ dist(rng), dist(rng), dist(rng) };
+			};
+
+		Inputs in;
+		in.matrices.resize(kInputCount);
+		in.affines.resize(kInputCount);
+		in.vectors.resize(kInputCount);
+		in.scales.resize(kInputCount);
+		in.rotates.resize(kInputCount);
+		in.quaternions.resize(kInputCount);
+		in.params.resize(kInputCount);
+		in.aabbs.resize(kInputCount);
+		in.spheres.resize(kInputCount);
+
+		for (size_t i = 0; i < kInputCount; ++i) {
+			in.scales[i] = randomVector(positive);
+			in.rotates[i] = randomVector(angle);
+			in.vectors[i] = randomVector(unit) * 10.0f;
+			in.affines[i] = MakeAffineMatrix(in.scales[i], in.rotates[i], in.vectors[i]);
+
+			// 一般の行列（逆行列が存在するよう対角を大きくする）
+			Matrix4x4& m = in.matrices[i];
+			for (int r = 0; r < 4; ++r) {
+				for (int c = 0; c < 4; ++c) {
+					m.m[r][c] = unit(rng) + (r == c ? 4.0f : 0.0f);
+				}
+			}
+
+			in.quaternions[i] = MakeRotateQuaternionXYZ(in.rotates[i]);
+			in.params[i] = param(rng);
+
+			const Vector3 center = randomVector(unit) * 10.0f;
+			const Vector3 half = randomVector(positive);
+			in.aabbs[i] = { center - half, center + half };
+			in.spheres[i] = { randomVector(unit) * 10.0f, positive(rng) };
+		}
+
+		for (int i = 0; i < 16; ++i) {
+			in.splinePoints.push_back(randomVector(unit) * 20.0f);
+		}
+		in.spline.Build(in.splinePoints);
+		return in;
+	}
+
+	///************************* 引数 *************************///
+
+	Options ParseOptions(int argc, char** argv) {
+		Options options;
+		for (int i = 1; i < argc; ++i) {
+			const std::string arg = argv[i];
+			if (arg == "--csv") {
+				options.csv = true;
+			} else if (arg == "--filter" && i + 1 < argc) {
+				options.filter = argv[++i];
+			} else if (arg == "--iterations" && i + 1 < argc) {
+				options.iterations = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+			} else {
+				std::printf("usage: %s [--filter name] [--iterations count] [--csv]\n", argv[0]);
+				std::exit(arg == "--help" ? 0 : 1);
+			}
+		}
+		return options;
+	}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	const Options options = ParseOptions(argc, argv);
+	Inputs in = MakeInputs();
+
+	std::vector<Result> results;
+	const auto run = [&](const char* name, const std::function<void(size_t)>& body) {
+		if (!options.filter.empty() && std::string(name).find(options.filter) == std::string::npos) {
+			return;
+		}
+		results.push_back({ name, Measure(options.iterations, body) });
+	};
+
+	// std::function 呼び出し分のオーバーヘッド（各結果から差し引かずに併記する）
+	run("Baseline (empty)", [&](size_t i) { DoNotOptimize(i); });
+
+	//------------------------------------------------------------
+	// 行列
+	//------------------------------------------------------------
+	run("Multiply(Matrix4x4)", [&](size_t i) {
+		DoNotOptimize(Multiply(in.matrices[i], in.matrices[(i + 1) & kInputMask]));
+		});
+	run("Inverse(Matrix4x4)", [&](size_t i) { DoNotOptimize(Inverse(in.matrices[i])); });
+	run("InverseAffine", [&](size_t i) { DoNotOptimize(InverseAffine(in.affines[i])); });
+	run("InverseRigid", [&](size_t i) { DoNotOptimize(InverseRigid(in.affines[i])); });
+	run("InverseTransposeAffine", [&](size_t i) { DoNotOptimize(InverseTransposeAffine(in.affines[i])); });
+	run("MakeAffineMatrix(Euler)", [&](size_t i) {
+		DoNotOptimize(MakeAffineMatrix(in.scales[i], in.rotates[i], in.vectors[i]));
+		});
+	run("MakeAffineMatrix(Quaternion)", [&](size_t i) {
+		DoNotOptimize(MakeAffineMatrix(in.scales[i], in.quaternions[i], in.vectors[i]));
+		});
+	run("MakeRotateMatrixXYZ", [&](size_t i) { DoNotOptimize(MakeRotateMatrixXYZ(in.rotates[i])); });
+	run("Transform(Vector3)", [&](size_t i) { DoNotOptimize(Transform(in.vectors[i], in.affines[i])); });
+	run("Transform(Vector4)", [&](size_t i) {
+		const Vector3& v = in.vectors[i];
+		DoNotOptimize(Transform(Vector4(v.x, v.y, v.z, 1.0f), in.affines[i]));
+		});
+
+	//------------------------------------------------------------
+	// ベクトル・クォータニオン
+	//------------------------------------------------------------
+	run("Normalize(Vector3)", [&](size_t i) { DoNotOptimize(Normalize(in.vectors[i])); });
+	run("Slerp", [&](size_t i) {
+		DoNotOptimize(Slerp(in.quaternions[i], in.quaternions[(i + 1) & kInputMask], in.params[i]));
+		});
+	run("SlerpFast", [&](size_t i) {
+		DoNotOptimize(SlerpFast(in.quaternions[i], in.quaternions[(i + 1) & kInputMask], in.params[i]));
+		});
+
+	//------------------------------------------------------------
+	// 曲線
+	//------------------------------------------------------------
+	run("CatmullRomPosition", [&](size_t i) {
+		DoNotOptimize(CatmullRomPosition(in.splinePoints, in.params[i] * 0.999f));
+		});
+	run("Spline::EvaluateAtDistance", [&](size_t i) {
+		DoNotOptimize(in.spline.EvaluateAtDistance(in.params[i] * in.spline.GetLength()));
+		});
+	run("Easing::Ease(EaseInOutCubic)", [&](size_t i) {
+		DoNotOptimize(Easing::Ease(Easing::Function::EaseInOutCubic, in.params[i]));
+		});
+	run("Easing::Ease(EaseOutElastic)", [&](size_t i) {
+		DoNotOptimize(Easing::Ease(Easing::Function::EaseOutElastic, in.params[i]));
+		});
+	run("Easing::EaseApprox(EaseOutElastic)", [&](size_t i) {
+		DoNotOptimize(Easing::EaseApprox(Easing::Function::EaseOutElastic, in.params[i]));
+		});
+
+	//------------------------------------------------------------
+	// 衝突判定
+	//------------------------------------------------------------
+	run("IsCollision(AABB, point)", [&](size_t i) {
+		DoNotOptimize(IsCollision(in.aabbs[i], in.vectors[i]));
+		});
+	run("IsCollision(AABB, Sphere)", [&](size_t i) {
+		DoNotOptimize(IsCollision(in.aabbs[i], in.spheres[i]));
+		});
+
+	//------------------------------------------------------------
+	// 視錐台
+	//------------------------------------------------------------
+	const Matrix4x4 view = InverseAffine(MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.3f, 0.5f, 0.0f }, { 0.0f, 0.0f, -20.0f }));
+	const Frustum frustum = MakeFrustum(view * MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f));
+	run("IsInFrustum(AABB)", [&](size_t i) { DoNotOptimize(IsInFrustum(frustum, in.aabbs[i])); });
+	std::vector<uint8_t> visibleFlags(kInputCount);
+	run("CullAABBs (per box)", [&](size_t i) {
+		if (i == 0) {
+			CullAABBs(frustum, in.aabbs, visibleFlags);
+		}
+		DoNotOptimize(visibleFlags[i]);
+		});
+	run("TransformAABB", [&](size_t i) { DoNotOptimize(TransformAABB(in.aabbs[i], in.affines[i])); });
+
+	//------------------------------------------------------------
+	// 一括変換（1要素あたり）
+	//------------------------------------------------------------
+	std::vector<Vector3> transformed(kInputCount);
+	run("TransformAffinePoints (per point)", [&](size_t i) {
+		if (i == 0) {
+			TransformAffinePoints(in.vectors, in.affines[0], transformed);
+		}
+		DoNotOptimize(transformed[i]);
+		});
+
+	//------------------------------------------------------------
+	// 出力
+	//------------------------------------------------------------
+	const char* backend = YMathSimd::GetBackendName();
+	if (options.csv) {
+		std::printf("backend,name,ns_per_op\n");
+		for (const Result& result : results) {
+			std::printf("%s,%s,%.3f\n", backend, result.name.c_str(), result.nsPerOp);
+		}
+	} else {
+		std::printf("YMath benchmark  backend: %s  iterations: %zu (best of %d)\n", backend, options.iterations, kRepeatCount);
+		for (const Result& result : results) {
+			std::printf("  %-40s %10.2f ns/op\n", result.name.c_str(), result.nsPerOp);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include "DeferredReleaseQueue.h"
+
+// Engine
+#include "CommandManager.h"
+
+// C++
+#include <cassert>
+
+/// <summary>
+/// 初期化
+/// </summary>
+void DeferredReleaseQueue::Initialize(CommandManager* commandManager)
+{
+	assert(commandManager);
+	commandManager_ = commandManager;
+}
+
+/// <summary>
+/// 残りをすべて解放する
+/// </summary>
+void DeferredReleaseQueue::Finalize()
+{
+	while (!entries_.empty()) {
+		Entry entry = std::move(entries_.front());
+		entries_.pop_front();
+		if (entry.release) { entry.release(); }
+	}
+}
+
+/// <summary>
+/// GPU が使い終わったものを解放する
+/// </summary>
+void DeferredReleaseQueue::Collect()
+{
+	if (entries_.empty()) { return; }
+
+	const uint64_t completedValue = commandManager_->GetFence()->GetCompletedValue();
+	while (!entries_.empty() && entries_.front().fenceValue <= completedValue) {
+		// 実行中に Retire されても壊れないよう、取り出してから実行する
+		Entry entry = std::move(entries_.front());
+		entries_.pop_front();
+		if (entry.release) { entry.release(); }
+	}
+}
+
+/// <summary>
+/// リソースの解放予約
+/// </summary>
+void DeferredReleaseQueue::Retire(Microsoft::WRL::ComPtr<ID3D12Resource> resource)
+{
+	if (!resource) { return; }
+
+	// 今のフレームの終わりに Signal される値
+	entries_.push_back({ commandManager_->GetFenceValue() + 1, std::move(resource), nullptr });
+}
+
+/// <summary>
+/// 後処理の予約
+/// </summary>
+void DeferredReleaseQueue::Retire(std::function<void()> release)
+{
+	if (!release) { return; }
+
+	entries_.push_back({ commandManager_->GetFenceValue() + 1, nullptr, std::move(release) });
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+// C++
+#include <d3d12.h>
+#include <wrl.h>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+class CommandManager;
+/// <summary>
+/// GPU が使い終わるまで解放を遅らせるキュー
+/// 登録した時点で積まれているコマンドの完了（フェンス値）を記録し、
+/// フェンスがその値を越えたフレームでリソースの参照を外す・後処理を実行する
+/// </summary>
+class DeferredReleaseQueue
+{
+public:
+	///************************* 基本関数 *************************///
+
+	void Initialize(CommandManager* commandManager);
+
+	// 残りをすべて解放する（GPU の完了を待ってから呼ぶこと）
+	void Finalize();
+
+	// GPU が使い終わったものを解放する（フレームの終わりに呼ぶ）
+	void Collect();
+
+public:
+	///************************* 登録 *************************///
+
+	// 今のフレームのコマンドが完了したら resource の参照を外す
+	void Retire(Microsoft::WRL::ComPtr<ID3D12Resource> resource);
+
+	// 今のフレームのコマンドが完了したら release を実行する（SRV の返却など）
+	void Retire(std::function<void()> release);
+
+public:
+	///************************* アクセッサ *************************///
+
+	// 解放待ちの件数
+	uint32_t GetPendingCount() const { return static_cast<uint32_t>(entries_.size()); }
+
+private:
+	///************************* メンバ変数 *************************///
+
+	struct Entry {
+		uint64_t fenceValue = 0;
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		std::function<void()> release;
+	};
+
+	CommandManager* commandManager_ = nullptr;
+
+	// フェンス値の小さい順
+	std::deque<Entry> entries_;
+};
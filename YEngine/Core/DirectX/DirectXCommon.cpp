@@ -8,6 +8,7 @@
 #include "Debugger/Logger.h"
 #include "Debugger/ConvertString.h"
 #include <Debugger/DebugConsole.h>
+#include "Mesh/Mesh.h"
 
 // lib
 #pragma comment(lib,"d3d12.lib")
@@ -61,10 +62,24 @@ namespace YoRigine {
 		// コマンドマネージャーの終了処理（全フレームの完了を待機）
 		if (commandManager_) {
 			commandManager_->Finalize();
-			commandManager_.reset();
 		}
 
+		// 解放待ちを片付ける（SRV を返すので SrvManager より先に）
+		if (deferredReleaseQueue_) {
+			deferredReleaseQueue_->Finalize();
+			deferredReleaseQueue_.reset();
+		}
+		commandManager_.reset();
+
 		// 各マネージャーの終了処理
+		if (meshBufferArena_) {
+			meshBufferArena_->Finalize();
+			meshBufferArena_.reset();
+		}
+		if (uploadRingBuffer_) {
+			uploadRingBuffer_->Finalize();
+			uploadRingBuffer_.reset();
+		}
 		if (dsvManager_) {
 			dsvManager_->Finalize();
 			dsvManager_.reset();
@@ -102,6 +117,18 @@ namespace YoRigine {
 		commandManager_ = std::make_unique<CommandManager>();
 		commandManager_->Initialize(deviceManager_.get());
 
+		// フレームごとのアップロードバッファ（フレーム数分の領域を持つ）
+		uploadRingBuffer_ = std::make_unique<UploadRingBuffer>();
+		uploadRingBuffer_->Initialize(deviceManager_.get(), CommandManager::kFrameCount);
+
+		// モデル共有の頂点・インデックスバッファ（Allocation が弱参照で持つので shared_ptr）
+		meshBufferArena_ = std::make_shared<MeshBufferArena>();
+		meshBufferArena_->Initialize(deviceManager_.get(), sizeof(Mesh::VertexData));
+
+		// GPU が使い終わるまで解放を遅らせるキュー
+		deferredReleaseQueue_ = std::make_unique<DeferredReleaseQueue>();
+		deferredReleaseQueue_->Initialize(commandManager_.get());
+
 		// スワップチェーンマネージャー
 		swapChainManager_ = std::make_unique<SwapChainManager>();
 		swapChainManager_->Initialize(winApp_, deviceManager_.get(), commandManager_.get());
@@ -379,6 +406,12 @@ namespace YoRigine {
 		UpdateFixFPS();
 
 		commandManager_->Reset(backBufferIndex);
+
+		// GPU が使い終わったリソースを解放する
+		deferredReleaseQueue_->Collect();
+
+		// GPU の使用が終わった領域を次のフレームで使い回す
+		uploadRingBuffer_->BeginFrame(commandManager_->GetCurrentFrameIndex());
 	}
 	void DirectXCommon::InitializeViewPortRectangle()
 	{
@@ -480,6 +513,11 @@ namespace YoRigine {
 		commandManager_->WaitForCurrentFrame();
 	}
 
+	void DirectXCommon::WaitForAllFrames()
+	{
+		commandManager_->WaitForAllFrames();
+	}
+
 	void DirectXCommon::ResetCommandList()
 	{
 		uint32_t currentFrameIndex = commandManager_->GetCurrentFrameIndex();
@@ -606,6 +644,36 @@ namespace YoRigine {
 		return resource;
 	}
 
+	Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::CreateBufferResourceReadback(size_t sizeInBytes)
+	{
+		// GPU からの読み戻し用（CPU から Map して読む）
+		D3D12_HEAP_PROPERTIES readbackHeapProperties{};
+		readbackHeapProperties.Type = D3D12_HEAP_TYPE_READBACK;
+
+		D3D12_RESOURCE_DESC resourceDesc{};
+		resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+		resourceDesc.Width = sizeInBytes;
+		resourceDesc.Height = 1;
+		resourceDesc.DepthOrArraySize = 1;
+		resourceDesc.MipLevels = 1;
+		resourceDesc.SampleDesc.Count = 1;
+		resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource = nullptr;
+		HRESULT hr = deviceManager_->GetDevice()->CreateCommittedResource(
+			&readbackHeapProperties,
+			D3D12_HEAP_FLAG_NONE,
+			&resourceDesc,
+			D3D12_RESOURCE_STATE_COPY_DEST,
+			nullptr,
+			IID_PPV_ARGS(&resource)
+		);
+		assert(SUCCEEDED(hr));
+		(void)hr;
+
+		return resource;
+	}
+
 	void DirectXCommon::TransitionBarrier(ID3D12Resource* pResource, D3D12_RESOURCE_STATES Before, D3D12_RESOURCE_STATES After)
 	{
 		// バリアの設定
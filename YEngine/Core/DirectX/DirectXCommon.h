@@ -17,6 +17,9 @@
 #include "RTVManager.h"
 #include "DSVManager.h"
 #include "DescriptorHeap.h"
+#include "UploadRingBuffer.h"
+#include "MeshBufferArena.h"
+#include "DeferredReleaseQueue.h"
 
 // DirectX
 #include "DirectXTex.h"
@@ -55,6 +58,7 @@ namespace YoRigine {
 		///************************* 外部で使用する処理 *************************///
 		void ExecuteCommandList();
 		void WaitForGPU();
+		void WaitForAllFrames();
 		void ResetCommandList();
 
 
@@ -83,6 +87,7 @@ namespace YoRigine {
 		// バッファリソースの生成
 		Microsoft::WRL::ComPtr<ID3D12Resource> CreateBufferResource(size_t sizeInBytes);
 		Microsoft::WRL::ComPtr<ID3D12Resource> CreateBufferResourceUAV(size_t sizeInBytes);
+		Microsoft::WRL::ComPtr<ID3D12Resource> CreateBufferResourceReadback(size_t sizeInBytes);
 	public:
 		///************************* アクセッサ *************************///
 
@@ -106,6 +111,15 @@ namespace YoRigine {
 		// ディスクリプタヒープ
 		DescriptorHeap* GetDescriptorHeap() { return descriptorHeap_.get(); }
 
+		// フレームごとのアップロードバッファ
+		UploadRingBuffer* GetUploadRingBuffer() { return uploadRingBuffer_.get(); }
+
+		// モデル共有の頂点・インデックスバッファ
+		MeshBufferArena* GetMeshBufferArena() { return meshBufferArena_.get(); }
+
+		// GPU が使い終わるまで解放を遅らせるキュー
+		DeferredReleaseQueue* GetDeferredReleaseQueue() { return deferredReleaseQueue_.get(); }
+
 		// マネージャー取得
 		DeviceManager* GetDeviceManager() { return deviceManager_.get(); }
 		SrvManager* GetSrvManager() { return srvManager_; }
@@ -151,6 +165,9 @@ namespace YoRigine {
 		std::unique_ptr<CommandManager> commandManager_;
 		std::unique_ptr<SwapChainManager> swapChainManager_;
 		std::unique_ptr<DescriptorHeap> descriptorHeap_;
+		std::unique_ptr<UploadRingBuffer> uploadRingBuffer_;
+		std::shared_ptr<MeshBufferArena> meshBufferArena_;
+		std::unique_ptr<DeferredReleaseQueue> deferredReleaseQueue_;
 
 		SrvManager* srvManager_ = nullptr;
 		std::unique_ptr<RtvManager> rtvManager_;
@@ -0,0 +1,65 @@
+#include "FrameRingAllocator.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+
+///************************* 基本関数 *************************///
+
+/// <summary>
+/// 初期化
+/// </summary>
+void FrameRingAllocator::Initialize(uint64_t bytesPerFrame, uint32_t frameCount, uint64_t alignment)
+{
+	assert(frameCount > 0);
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	alignment_ = alignment;
+	frameCount_ = frameCount;
+	// 各フレームの領域の先頭もアライメントに揃える
+	bytesPerFrame_ = (bytesPerFrame + alignment - 1) & ~(alignment - 1);
+
+	frameIndex_ = 0;
+	usedBytes_ = 0;
+	allocationCount_ = 0;
+	failedCount_ = 0;
+	peakUsedBytes_ = 0;
+}
+
+/// <summary>
+/// フレーム開始
+/// </summary>
+void FrameRingAllocator::BeginFrame(uint32_t frameIndex)
+{
+	assert(frameCount_ > 0);
+
+	frameIndex_ = frameIndex % frameCount_;
+	usedBytes_ = 0;
+	allocationCount_ = 0;
+	failedCount_ = 0;
+}
+
+/// <summary>
+/// 切り出し
+/// </summary>
+uint64_t FrameRingAllocator::Allocate(uint64_t sizeInBytes)
+{
+	// 1フレーム分より大きければ切り上げる前に弾く（巨大なサイズで切り上げが桁あふれしないように）
+	if (sizeInBytes > bytesPerFrame_) {
+		++failedCount_;
+		return kInvalidOffset;
+	}
+	const uint64_t alignedSize = (std::max<uint64_t>(sizeInBytes, 1) + alignment_ - 1) & ~(alignment_ - 1);
+
+	// 領域を使い切ったら失敗（次のフレームの領域にはみ出さない）
+	if (alignedSize > bytesPerFrame_ - usedBytes_) {
+		++failedCount_;
+		return kInvalidOffset;
+	}
+
+	const uint64_t offset = GetFrameOffset(frameIndex_) + usedBytes_;
+	usedBytes_ += alignedSize;
+	++allocationCount_;
+	peakUsedBytes_ = std::max(peakUsedBytes_, usedBytes_);
+	return offset;
+}
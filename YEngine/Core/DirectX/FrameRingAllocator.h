@@ -0,0 +1,64 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/// <summary>
+/// フレームリング線形アロケータ
+/// 1本のバッファを frameCount 個の領域に分け、フレームごとに先頭から詰めて切り出す
+/// フレームの開始時にその領域を丸ごと空にする（個別の解放は無い）
+/// デバイスに依存せずオフセットだけを扱うので、リソースの無い環境でも動作を確認できる
+/// </summary>
+class FrameRingAllocator
+{
+public:
+	// 確保失敗
+	static constexpr uint64_t kInvalidOffset = UINT64_MAX;
+	// 定数バッファの配置アライメント（D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT）
+	static constexpr uint64_t kDefaultAlignment = 256;
+
+public:
+	///************************* 基本関数 *************************///
+
+	// 初期化（bytesPerFrame はアライメントに切り上げる。alignment は2の累乗）
+	void Initialize(uint64_t bytesPerFrame, uint32_t frameCount, uint64_t alignment = kDefaultAlignment);
+
+	// フレーム開始（そのフレームの領域を空にする。GPU の使用完了後に呼ぶこと）
+	void BeginFrame(uint32_t frameIndex);
+
+	// 現在のフレームの領域から切り出す（バッファ先頭からのオフセット。足りなければ kInvalidOffset）
+	uint64_t Allocate(uint64_t sizeInBytes);
+
+public:
+	///************************* アクセッサ *************************///
+
+	uint64_t GetBytesPerFrame() const { return bytesPerFrame_; }
+	uint32_t GetFrameCount() const { return frameCount_; }
+	uint64_t GetTotalBytes() const { return bytesPerFrame_ * frameCount_; }
+	uint64_t GetAlignment() const { return alignment_; }
+	uint32_t GetCurrentFrameIndex() const { return frameIndex_; }
+
+	// 指定フレームの領域の先頭オフセット
+	uint64_t GetFrameOffset(uint32_t frameIndex) const { return bytesPerFrame_ * frameIndex; }
+
+	// 現在のフレームの使用量・確保回数・失敗回数
+	uint64_t GetUsedBytes() const { return usedBytes_; }
+	uint32_t GetAllocationCount() const { return allocationCount_; }
+	uint32_t GetFailedCount() const { return failedCount_; }
+
+	// これまでの1フレームあたりの最大使用量
+	uint64_t GetPeakUsedBytes() const { return peakUsedBytes_; }
+
+private:
+	///************************* メンバ変数 *************************///
+
+	uint64_t bytesPerFrame_ = 0;
+	uint32_t frameCount_ = 0;
+	uint64_t alignment_ = kDefaultAlignment;
+
+	uint32_t frameIndex_ = 0;
+	uint64_t usedBytes_ = 0;
+	uint32_t allocationCount_ = 0;
+	uint32_t failedCount_ = 0;
+	uint64_t peakUsedBytes_ = 0;
+};
@@ -0,0 +1,198 @@
+#include "MeshBufferArena.h"
+
+// Engine
+#include "DeviceManager.h"
+#include "Debugger/Logger.h"
+
+// C++
+#include <cassert>
+#include <cstring>
+#include <format>
+
+///************************* 貸し出した区間 *************************///
+
+MeshBufferArena::Allocation& MeshBufferArena::Allocation::operator=(Allocation&& other) noexcept
+{
+	if (this != &other) {
+		Release();
+		arena_ = std::move(other.arena_);
+		vertexHandle_ = other.vertexHandle_;
+		indexHandle_ = other.indexHandle_;
+		other.arena_.reset();
+		other.vertexHandle_ = RangeAllocator::kInvalidHandle;
+		other.indexHandle_ = RangeAllocator::kInvalidHandle;
+	}
+	return *this;
+}
+
+/// <summary>
+/// 返却
+/// </summary>
+void MeshBufferArena::Allocation::Release()
+{
+	if (auto arena = arena_.lock()) {
+		arena->Free(vertexHandle_, indexHandle_);
+	}
+	arena_.reset();
+	vertexHandle_ = RangeAllocator::kInvalidHandle;
+	indexHandle_ = RangeAllocator::kInvalidHandle;
+}
+
+uint32_t MeshBufferArena::Allocation::GetBaseVertex() const
+{
+	auto arena = arena_.lock();
+	return arena ? static_cast<uint32_t>(arena->vertexAllocator_.GetOffset(vertexHandle_)) : 0;
+}
+
+uint32_t MeshBufferArena::Allocation::GetFirstIndex() const
+{
+	auto arena = arena_.lock();
+	return arena ? static_cast<uint32_t>(arena->indexAllocator_.GetOffset(indexHandle_)) : 0;
+}
+
+///************************* 基本関数 *************************///
+
+/// <summary>
+/// 初期化（頂点用・インデックス用を1本ずつ確保し、Map したままにする）
+/// </summary>
+void MeshBufferArena::Initialize(DeviceManager* deviceManager, uint32_t vertexStride, uint64_t vertexCapacity, uint64_t indexCapacity)
+{
+	assert(deviceManager);
+	assert(vertexStride > 0);
+
+	vertexStride_ = vertexStride;
+	vertexAllocator_.Initialize(vertexCapacity);
+	indexAllocator_.Initialize(indexCapacity);
+
+	vertexResource_ = CreateMappedBuffer(deviceManager, vertexCapacity * vertexStride, &mappedVertices_);
+	indexResource_ = CreateMappedBuffer(deviceManager, indexCapacity * sizeof(uint32_t), &mappedIndices_);
+
+	vertexBufferView_.BufferLocation = vertexResource_->GetGPUVirtualAddress();
+	vertexBufferView_.SizeInBytes = static_cast<UINT>(vertexCapacity * vertexStride);
+	vertexBufferView_.StrideInBytes = vertexStride;
+
+	indexBufferView_.BufferLocation = indexResource_->GetGPUVirtualAddress();
+	indexBufferView_.SizeInBytes = static_cast<UINT>(indexCapacity * sizeof(uint32_t));
+	indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
+}
+
+/// <summary>
+/// 終了
+/// </summary>
+void MeshBufferArena::Finalize()
+{
+	if (vertexResource_ && mappedVertices_) {
+		vertexResource_->Unmap(0, nullptr);
+	}
+	if (indexResource_ && mappedIndices_) {
+		indexResource_->Unmap(0, nullptr);
+	}
+	mappedVertices_ = nullptr;
+	mappedIndices_ = nullptr;
+	vertexResource_.Reset();
+	indexResource_.Reset();
+	vertexBufferView_ = {};
+	indexBufferView_ = {};
+
+	// 残っている貸し出しはすべて無効にする
+	vertexAllocator_.Initialize(0);
+	indexAllocator_.Initialize(0);
+}
+
+/// <summary>
+/// 区間の確保と書き込み
+/// </summary>
+MeshBufferArena::Allocation MeshBufferArena::Allocate(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+{
+	Allocation allocation;
+	if (!mappedVertices_ || !mappedIndices_ || vertexCount == 0 || indexCount == 0) { return allocation; }
+
+	// 合計では足りているのに断片化で入らない場合は詰め直す
+	if ((vertexAllocator_.GetLargestFreeRange() < vertexCount && vertexAllocator_.GetFreeSize() >= vertexCount) ||
+		(indexAllocator_.GetLargestFreeRange() < indexCount && indexAllocator_.GetFreeSize() >= indexCount)) {
+		Defragment();
+	}
+
+	const RangeAllocator::Handle vertexHandle = vertexAllocator_.Allocate(vertexCount);
+	const RangeAllocator::Handle indexHandle = indexAllocator_.Allocate(indexCount);
+	if (vertexHandle == RangeAllocator::kInvalidHandle || indexHandle == RangeAllocator::kInvalidHandle) {
+		vertexAllocator_.Free(vertexHandle);
+		indexAllocator_.Free(indexHandle);
+		if (!reportedOverflow_) {
+			Logger(std::format("MeshBufferArena: out of space (vertices {}/{}, indices {}/{})\n",
+				vertexAllocator_.GetUsedSize(), vertexAllocator_.GetCapacity(),
+				indexAllocator_.GetUsedSize(), indexAllocator_.GetCapacity()));
+			reportedOverflow_ = true;
+		}
+		return allocation;
+	}
+
+	std::memcpy(mappedVertices_ + vertexAllocator_.GetOffset(vertexHandle) * vertexStride_, vertices, static_cast<size_t>(vertexCount) * vertexStride_);
+	std::memcpy(mappedIndices_ + indexAllocator_.GetOffset(indexHandle) * sizeof(uint32_t), indices, static_cast<size_t>(indexCount) * sizeof(uint32_t));
+
+	allocation.arena_ = weak_from_this();
+	allocation.vertexHandle_ = vertexHandle;
+	allocation.indexHandle_ = indexHandle;
+	return allocation;
+}
+
+/// <summary>
+/// 詰め直し（アップロードバッファなので CPU 側で移すだけでよい）
+/// </summary>
+void MeshBufferArena::Defragment()
+{
+	if (!mappedVertices_ || !mappedIndices_) { return; }
+
+	for (const RangeAllocator::Move& move : vertexAllocator_.Defragment()) {
+		std::memmove(mappedVertices_ + move.to * vertexStride_, mappedVertices_ + move.from * vertexStride_, static_cast<size_t>(move.size) * vertexStride_);
+	}
+	for (const RangeAllocator::Move& move : indexAllocator_.Defragment()) {
+		std::memmove(mappedIndices_ + move.to * sizeof(uint32_t), mappedIndices_ + move.from * sizeof(uint32_t), static_cast<size_t>(move.size) * sizeof(uint32_t));
+	}
+	++defragmentCount_;
+}
+
+///************************* 内部処理 *************************///
+
+/// <summary>
+/// 返却
+/// </summary>
+void MeshBufferArena::Free(RangeAllocator::Handle vertexHandle, RangeAllocator::Handle indexHandle)
+{
+	vertexAllocator_.Free(vertexHandle);
+	indexAllocator_.Free(indexHandle);
+	reportedOverflow_ = false;
+}
+
+/// <summary>
+/// 永続 Map したアップロードバッファ
+/// </summary>
+Microsoft::WRL::ComPtr<ID3D12Resource> MeshBufferArena::CreateMappedBuffer(DeviceManager* deviceManager, uint64_t sizeInBytes, uint8_t** mappedData)
+{
+	D3D12_HEAP_PROPERTIES uploadHeapProperties{};
+	uploadHeapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+	D3D12_RESOURCE_DESC resourceDesc{};
+	resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+	resourceDesc.Width = sizeInBytes;
+	resourceDesc.Height = 1;
+	resourceDesc.DepthOrArraySize = 1;
+	resourceDesc.MipLevels = 1;
+	resourceDesc.SampleDesc.Count = 1;
+	resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+	HRESULT hr = deviceManager->GetDevice()->CreateCommittedResource(
+		&uploadHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&resource)
+	);
+	assert(SUCCEEDED(hr));
+	(void)hr;
+
+	resource->Map(0, nullptr, reinterpret_cast<void**>(mappedData));
+	return resource;
+}
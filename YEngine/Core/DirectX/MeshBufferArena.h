@@ -0,0 +1,115 @@
+#pragma once
+
+// C++
+#include <d3d12.h>
+#include <wrl.h>
+#include <cstdint>
+#include <memory>
+
+// Engine
+#include "RangeAllocator.h"
+
+class DeviceManager;
+/// <summary>
+/// モデル共有の頂点・インデックスバッファ
+/// 永続的に Map した頂点用・インデックス用のアップロードバッファを1本ずつ持ち、
+/// RangeAllocator で切り分けてモデルごとの (baseVertex, firstIndex) の区間として貸し出す
+/// どのモデルも同じビューを使うので、描画のたびに頂点・インデックスバッファを張り替えずに済む
+/// </summary>
+class MeshBufferArena : public std::enable_shared_from_this<MeshBufferArena>
+{
+public:
+	// 既定の容量（頂点 36 バイトで約 36MB、インデックス 4 バイトで 16MB）
+	static constexpr uint64_t kDefaultVertexCapacity = 1ull << 20;
+	static constexpr uint64_t kDefaultIndexCapacity = 4ull << 20;
+
+	/// <summary>
+	/// 貸し出した区間（破棄すると返却する）
+	/// 詰め直しで位置が変わるので、オフセットは描画のたびに取得する
+	/// </summary>
+	class Allocation
+	{
+	public:
+		Allocation() = default;
+		~Allocation() { Release(); }
+		Allocation(Allocation&& other) noexcept { *this = std::move(other); }
+		Allocation& operator=(Allocation&& other) noexcept;
+		Allocation(const Allocation&) = delete;
+		Allocation& operator=(const Allocation&) = delete;
+
+		// 返却（アリーナが先に破棄されていれば何もしない）
+		void Release();
+
+		bool IsValid() const { return !arena_.expired(); }
+
+		// 共有バッファ内での先頭（DrawIndexedInstanced の BaseVertexLocation / StartIndexLocation）
+		uint32_t GetBaseVertex() const;
+		uint32_t GetFirstIndex() const;
+
+	private:
+		friend class MeshBufferArena;
+
+		std::weak_ptr<MeshBufferArena> arena_;
+		RangeAllocator::Handle vertexHandle_ = RangeAllocator::kInvalidHandle;
+		RangeAllocator::Handle indexHandle_ = RangeAllocator::kInvalidHandle;
+	};
+
+public:
+	///************************* 基本関数 *************************///
+
+	void Initialize(DeviceManager* deviceManager, uint32_t vertexStride,
+		uint64_t vertexCapacity = kDefaultVertexCapacity, uint64_t indexCapacity = kDefaultIndexCapacity);
+	void Finalize();
+
+	// 頂点とインデックスを書き込んで区間を確保（入らなければ詰め直して再試行し、それでも駄目なら無効な区間）
+	// 詰め直しは描画コマンドを積む前（Update 中）にしか行えないので、描画中には呼ばないこと
+	Allocation Allocate(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+
+	// 貸し出し中の区間を先頭へ詰める（描画コマンドを積む前、GPU が使っていない間に呼ぶ）
+	void Defragment();
+
+public:
+	///************************* アクセッサ *************************///
+
+	const D3D12_VERTEX_BUFFER_VIEW& GetVertexBufferView() const { return vertexBufferView_; }
+	const D3D12_INDEX_BUFFER_VIEW& GetIndexBufferView() const { return indexBufferView_; }
+
+	const RangeAllocator& GetVertexAllocator() const { return vertexAllocator_; }
+	const RangeAllocator& GetIndexAllocator() const { return indexAllocator_; }
+
+	// Map 中の先頭（中身の確認用。書き込みは Allocate を通すこと）
+	const uint8_t* GetMappedVertices() const { return mappedVertices_; }
+	const uint32_t* GetMappedIndices() const { return reinterpret_cast<const uint32_t*>(mappedIndices_); }
+
+	// 詰め直しの回数
+	uint32_t GetDefragmentCount() const { return defragmentCount_; }
+
+private:
+	///************************* 内部処理 *************************///
+
+	void Free(RangeAllocator::Handle vertexHandle, RangeAllocator::Handle indexHandle);
+
+	// 永続 Map したアップロードバッファを作る
+	Microsoft::WRL::ComPtr<ID3D12Resource> CreateMappedBuffer(DeviceManager* deviceManager, uint64_t sizeInBytes, uint8_t** mappedData);
+
+private:
+	///************************* メンバ変数 *************************///
+
+	uint32_t vertexStride_ = 0;
+
+	RangeAllocator vertexAllocator_;
+	RangeAllocator indexAllocator_;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource_;
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexResource_;
+	uint8_t* mappedVertices_ = nullptr;
+	uint8_t* mappedIndices_ = nullptr;
+
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
+	D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
+
+	uint32_t defragmentCount_ = 0;
+
+	// 容量不足の警告を出したか（毎回出さないため）
+	bool reportedOverflow_ = false;
+};
@@ -0,0 +1,151 @@
+#include "RangeAllocator.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+///************************* 基本関数 *************************///
+
+/// <summary>
+/// 初期化
+/// </summary>
+void RangeAllocator::Initialize(uint64_t capacity)
+{
+	capacity_ = capacity;
+	usedSize_ = 0;
+	allocationCount_ = 0;
+	slots_.clear();
+	freeSlots_.clear();
+	freeRanges_.clear();
+	if (capacity_ > 0) {
+		freeRanges_.emplace(0, capacity_);
+	}
+}
+
+/// <summary>
+/// 確保
+/// </summary>
+RangeAllocator::Handle RangeAllocator::Allocate(uint64_t size)
+{
+	if (size == 0) { return kInvalidHandle; }
+
+	// 先頭から探して最初に入る空き区間
+	auto it = std::find_if(freeRanges_.begin(), freeRanges_.end(),
+		[size](const auto& range) { return range.second >= size; });
+	if (it == freeRanges_.end()) { return kInvalidHandle; }
+
+	const uint64_t offset = it->first;
+	const uint64_t remaining = it->second - size;
+	freeRanges_.erase(it);
+	if (remaining > 0) {
+		freeRanges_.emplace(offset + size, remaining);
+	}
+
+	Handle handle;
+	if (!freeSlots_.empty()) {
+		handle = freeSlots_.back();
+		freeSlots_.pop_back();
+	} else {
+		handle = static_cast<Handle>(slots_.size());
+		slots_.emplace_back();
+	}
+	slots_[handle] = { offset, size, true };
+
+	usedSize_ += size;
+	++allocationCount_;
+	return handle;
+}
+
+/// <summary>
+/// 返却
+/// </summary>
+void RangeAllocator::Free(Handle handle)
+{
+	if (!IsValid(handle)) { return; }
+
+	Slot& slot = slots_[handle];
+	InsertFreeRange(slot.offset, slot.size);
+	usedSize_ -= slot.size;
+	--allocationCount_;
+
+	slot = {};
+	freeSlots_.push_back(handle);
+}
+
+/// <summary>
+/// 詰め直し
+/// </summary>
+std::vector<RangeAllocator::Move> RangeAllocator::Defragment()
+{
+	// 貸し出し中のものをオフセット順に並べる
+	std::vector<Handle> liveHandles;
+	liveHandles.reserve(allocationCount_);
+	for (Handle handle = 0; handle < slots_.size(); ++handle) {
+		if (slots_[handle].inUse) {
+			liveHandles.push_back(handle);
+		}
+	}
+	std::sort(liveHandles.begin(), liveHandles.end(),
+		[this](Handle a, Handle b) { return slots_[a].offset < slots_[b].offset; });
+
+	// 前から隙間なく並べ直す
+	std::vector<Move> moves;
+	uint64_t cursor = 0;
+	for (Handle handle : liveHandles) {
+		Slot& slot = slots_[handle];
+		if (slot.offset != cursor) {
+			moves.push_back({ handle, slot.offset, cursor, slot.size });
+			slot.offset = cursor;
+		}
+		cursor += slot.size;
+	}
+
+	freeRanges_.clear();
+	if (cursor < capacity_) {
+		freeRanges_.emplace(cursor, capacity_ - cursor);
+	}
+	return moves;
+}
+
+///************************* アクセッサ *************************///
+
+/// <summary>
+/// 最大の空き区間
+/// </summary>
+uint64_t RangeAllocator::GetLargestFreeRange() const
+{
+	uint64_t largest = 0;
+	for (const auto& [offset, size] : freeRanges_) {
+		largest = std::max(largest, size);
+	}
+	return largest;
+}
+
+///************************* 内部処理 *************************///
+
+/// <summary>
+/// 空き区間を戻して前後とつなげる
+/// </summary>
+void RangeAllocator::InsertFreeRange(uint64_t offset, uint64_t size)
+{
+	auto next = freeRanges_.lower_bound(offset);
+
+	// 後ろの空きとつなげる
+	if (next != freeRanges_.end() && offset + size == next->first) {
+		size += next->second;
+		next = freeRanges_.erase(next);
+	}
+
+	// 前の空きとつなげる
+	if (next != freeRanges_.begin()) {
+		auto prev = std::prev(next);
+		assert(prev->first + prev->second <= offset);
+		if (prev->first + prev->second == offset) {
+			prev->second += size;
+			return;
+		}
+	}
+
+	freeRanges_.emplace_hint(next, offset, size);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/// <summary>
+/// 範囲サブアロケータ
+/// 1本のバッファを要素単位（頂点数・インデックス数など）の区間に切り分けて貸し出す
+/// 空き区間はオフセット順に持ち、解放時に前後の空きとつなげる（先頭から探して最初に入る区間を使う）
+/// 貸し出しはハンドルで表し、Defragment で詰め直してもハンドルはそのまま使える
+/// デバイスに依存せずオフセットだけを扱うので、リソースの無い環境でも動作を確認できる
+/// </summary>
+class RangeAllocator
+{
+public:
+	using Handle = uint32_t;
+
+	// 確保失敗
+	static constexpr Handle kInvalidHandle = UINT32_MAX;
+	static constexpr uint64_t kInvalidOffset = UINT64_MAX;
+
+	// Defragment で動いた区間（from から to へ size 個。to は常に from より前）
+	struct Move {
+		Handle handle;
+		uint64_t from;
+		uint64_t to;
+		uint64_t size;
+	};
+
+public:
+	///************************* 基本関数 *************************///
+
+	// 初期化（capacity 個の要素を管理する。既存の貸し出しはすべて無効になる）
+	void Initialize(uint64_t capacity);
+
+	// size 個分の区間を確保（入らなければ kInvalidHandle）
+	Handle Allocate(uint64_t size);
+
+	// 返却
+	void Free(Handle handle);
+
+	// 貸し出し中の区間を先頭へ詰める
+	// 返す移動はオフセットの小さい順で、この順に memmove すれば重なっていても壊れない
+	std::vector<Move> Defragment();
+
+public:
+	///************************* アクセッサ *************************///
+
+	bool IsValid(Handle handle) const { return handle < slots_.size() && slots_[handle].inUse; }
+	uint64_t GetOffset(Handle handle) const { return IsValid(handle) ? slots_[handle].offset : kInvalidOffset; }
+	uint64_t GetSize(Handle handle) const { return IsValid(handle) ? slots_[handle].size : 0; }
+
+	uint64_t GetCapacity() const { return capacity_; }
+	uint64_t GetUsedSize() const { return usedSize_; }
+	uint64_t GetFreeSize() const { return capacity_ - usedSize_; }
+	uint32_t GetAllocationCount() const { return allocationCount_; }
+
+	// 空き区間の数と最大の空き区間（断片化の目安）
+	uint32_t GetFreeRangeCount() const { return static_cast<uint32_t>(freeRanges_.size()); }
+	uint64_t GetLargestFreeRange() const;
+
+private:
+	///************************* 内部処理 *************************///
+
+	// 空き区間を戻して前後とつなげる
+	void InsertFreeRange(uint64_t offset, uint64_t size);
+
+private:
+	///************************* メンバ変数 *************************///
+
+	struct Slot {
+		uint64_t offset = 0;
+		uint64_t size = 0;
+		bool inUse = false;
+	};
+
+	uint64_t capacity_ = 0;
+	uint64_t usedSize_ = 0;
+	uint32_t allocationCount_ = 0;
+
+	// ハンドル → 区間（返却されたハンドルは使い回す）
+	std::vector<Slot> slots_;
+	std::vector<Handle> freeSlots_;
+
+	// 空き区間（オフセット → 要素数）
+	std::map<uint64_t, uint64_t> freeRanges_;
+};
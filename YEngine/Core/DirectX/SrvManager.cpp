@@ -79,6 +79,12 @@ void SrvManager::SetGraphicsRootDescriptorTable(UINT RootParameterIndex, uint32_
 /// </summary>
 uint32_t SrvManager::Allocate()
 {
+	// 返却済みのものがあれば再利用
+	if (!freeIndices_.empty()) {
+		uint32_t index = freeIndices_.back();
+		freeIndices_.pop_back();
+		return index;
+	}
 	return Allocate(1);
 }
 
@@ -95,6 +101,15 @@ uint32_t SrvManager::Allocate(uint32_t count)
 	return index;
 }
 
+/// <summary>
+/// 1個ずつ確保した SRV の返却
+/// </summary>
+void SrvManager::Free(uint32_t index)
+{
+	assert(index < useIndex_);
+	freeIndices_.push_back(index);
+}
+
 /// <summary>
 /// 指定インデックスの SRV CPU ハンドル取得
 /// </summary>
@@ -120,7 +135,7 @@ D3D12_GPU_DESCRIPTOR_HANDLE SrvManager::GetGPUDescriptorHandle(uint32_t index)
 /// </summary>
 bool SrvManager::IsAllocation()
 {
-	return (kMaxSRVCount_ > useIndex_);
+	return (kMaxSRVCount_ > useIndex_) || !freeIndices_.empty();
 }
 
 /// <summary>
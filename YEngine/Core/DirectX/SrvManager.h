@@ -2,6 +2,7 @@
 
 // C++
 #include <cstdint>
+#include <vector>
 #include <wrl.h>
 #include <d3d12.h>
 #include <dxgi1_6.h>
@@ -27,6 +28,9 @@ public:
 	uint32_t Allocate();
 	uint32_t Allocate(uint32_t count);
 
+	// 1個ずつ確保した SRV を返す（GPU が使い終わってから呼ぶ。次の Allocate() で再利用する）
+	void Free(uint32_t index);
+
 	// 描画の前準備
 	void PreDraw();
 
@@ -73,6 +77,8 @@ private:
 	YoRigine::DirectXCommon* dxCommon_ = nullptr;
 	// 次に使用するSRVインデックス
 	uint32_t useIndex_ = 0;
+	// 返却された SRV インデックス
+	std::vector<uint32_t> freeIndices_;
 	// ディスクリプタサイズ
 	uint32_t descriptorSize_ = 0;
 	// デスクリプタヒープ
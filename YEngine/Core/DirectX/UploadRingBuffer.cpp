@@ -0,0 +1,89 @@
+#include "UploadRingBuffer.h"
+
+// Engine
+#include "DeviceManager.h"
+#include "Debugger/Logger.h"
+
+// C++
+#include <cassert>
+#include <format>
+
+/// <summary>
+/// 初期化（全フレーム分を1本のアップロードバッファとして確保し、Map したままにする）
+/// </summary>
+void UploadRingBuffer::Initialize(DeviceManager* deviceManager, uint32_t frameCount, uint64_t bytesPerFrame)
+{
+	assert(deviceManager);
+
+	allocator_.Initialize(bytesPerFrame, frameCount);
+
+	D3D12_HEAP_PROPERTIES uploadHeapProperties{};
+	uploadHeapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+	D3D12_RESOURCE_DESC resourceDesc{};
+	resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+	resourceDesc.Width = allocator_.GetTotalBytes();
+	resourceDesc.Height = 1;
+	resourceDesc.DepthOrArraySize = 1;
+	resourceDesc.MipLevels = 1;
+	resourceDesc.SampleDesc.Count = 1;
+	resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+	HRESULT hr = deviceManager->GetDevice()->CreateCommittedResource(
+		&uploadHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&resource_)
+	);
+	assert(SUCCEEDED(hr));
+	(void)hr;
+
+	resource_->Map(0, nullptr, reinterpret_cast<void**>(&mappedData_));
+	gpuAddress_ = resource_->GetGPUVirtualAddress();
+}
+
+/// <summary>
+/// 終了
+/// </summary>
+void UploadRingBuffer::Finalize()
+{
+	if (resource_ && mappedData_) {
+		resource_->Unmap(0, nullptr);
+	}
+	mappedData_ = nullptr;
+	gpuAddress_ = 0;
+	resource_.Reset();
+}
+
+/// <summary>
+/// フレーム開始
+/// </summary>
+void UploadRingBuffer::BeginFrame(uint32_t frameIndex)
+{
+	allocator_.BeginFrame(frameIndex);
+}
+
+/// <summary>
+/// 切り出し
+/// </summary>
+UploadRingBuffer::Allocation UploadRingBuffer::Allocate(uint64_t sizeInBytes)
+{
+	Allocation allocation;
+	if (!mappedData_) { return allocation; }
+
+	const uint64_t offset = allocator_.Allocate(sizeInBytes);
+	if (offset == FrameRingAllocator::kInvalidOffset) {
+		if (!reportedOverflow_) {
+			Logger(std::format("UploadRingBuffer: frame region exhausted ({} bytes per frame)\n", allocator_.GetBytesPerFrame()));
+			reportedOverflow_ = true;
+		}
+		return allocation;
+	}
+
+	allocation.cpuAddress = mappedData_ + offset;
+	allocation.gpuAddress = gpuAddress_ + offset;
+	allocation.offset = offset;
+	return allocation;
+}
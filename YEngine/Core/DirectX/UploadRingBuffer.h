@@ -0,0 +1,72 @@
+#pragma once
+
+// C++
+#include <d3d12.h>
+#include <wrl.h>
+#include <cstdint>
+#include <cstring>
+
+// Engine
+#include "FrameRingAllocator.h"
+
+class DeviceManager;
+/// <summary>
+/// フレームごとのアップロードバッファ
+/// 永続的に Map した1本のアップロードバッファを FrameRingAllocator で切り分け、
+/// 毎フレーム書き換える定数（WorldTransform の行列など）を 256 バイト単位で渡す
+/// </summary>
+class UploadRingBuffer
+{
+public:
+	// 1フレームあたりの既定容量（256 バイトの定数で 32768 個分）
+	static constexpr uint64_t kDefaultBytesPerFrame = 8ull * 1024 * 1024;
+
+	// 切り出した領域
+	struct Allocation {
+		void* cpuAddress = nullptr;
+		D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+		uint64_t offset = 0;
+
+		bool IsValid() const { return cpuAddress != nullptr; }
+	};
+
+public:
+	///************************* 基本関数 *************************///
+
+	void Initialize(DeviceManager* deviceManager, uint32_t frameCount, uint64_t bytesPerFrame = kDefaultBytesPerFrame);
+	void Finalize();
+
+	// フレーム開始（そのフレームの GPU 処理が完了してから呼ぶこと）
+	void BeginFrame(uint32_t frameIndex);
+
+	// 現在のフレームから切り出す（容量不足なら無効な領域を返す）
+	Allocation Allocate(uint64_t sizeInBytes);
+
+	// 切り出してデータを書き込む
+	template <typename T>
+	Allocation Push(const T& data) {
+		Allocation allocation = Allocate(sizeof(T));
+		if (allocation.IsValid()) {
+			std::memcpy(allocation.cpuAddress, &data, sizeof(T));
+		}
+		return allocation;
+	}
+
+public:
+	///************************* アクセッサ *************************///
+
+	const FrameRingAllocator& GetAllocator() const { return allocator_; }
+	ID3D12Resource* GetResource() const { return resource_.Get(); }
+
+private:
+	///************************* メンバ変数 *************************///
+
+	FrameRingAllocator allocator_;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource_;
+	uint8_t* mappedData_ = nullptr;
+	D3D12_GPU_VIRTUAL_ADDRESS gpuAddress_ = 0;
+
+	// 容量不足の警告を出したか（毎フレーム出さないため）
+	bool reportedOverflow_ = false;
+};
@@ -49,6 +49,18 @@ void Framework::Initialize()
 	textureManager_ = TextureManager::GetInstance();
 	textureManager_->Initialize(dxCommon_, dxCommon_->GetSrvManager());
 
+	//-----------------------------------------
+	// 非同期読み込み
+	//-----------------------------------------
+	assetLoader_ = AssetLoader::GetInstance();
+	assetLoader_->Initialize();
+
+	//-----------------------------------------
+	// JSON の書き出し
+	//-----------------------------------------
+	jsonWriter_ = YoRigine::JsonWriter::GetInstance();
+	jsonWriter_->Initialize();
+
 	//-----------------------------------------
 	// パイプラインマネージャ
 	//-----------------------------------------
@@ -116,7 +128,11 @@ void Framework::Finalize()
 	}
 #endif
 
+	// 読み込み中のものを片付けてからマネージャを破棄する
+	assetLoader_->Finalize();
 	ObjectManager::GetInstance()->Finalize();
+	// 書き込み待ちの JSON を書き出してから終わる
+	jsonWriter_->Finalize();
 	shadowPipeline_->Finalize();
 	pipelineManager_->Finalize();
 	computeShaderManager_->Finalize();
@@ -138,6 +154,12 @@ void Framework::Update()
 	// 入力は毎フレーム最初に更新
 	input_->Update();
 
+	// 非同期読み込みの完了分を GPU へ（描画コマンドより前に積む）
+	assetLoader_->Update();
+
+	// 書き終わった JSON の保存の通知
+	jsonWriter_->Update();
+
 	// ゲームオブジェクト更新
 	ObjectManager::GetInstance()->Update();
 }
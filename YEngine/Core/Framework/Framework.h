@@ -8,6 +8,8 @@
 #include "SrvManager.h"
 #include "DirectXCommon.h"
 #include "Loaders./Texture/TextureManager.h"
+#include "Loaders/Async/AssetLoader.h"
+#include "Loaders/Json/JsonWriter.h"
 #include "Sprite./SpriteCommon.h"
 #include "Object3D/Object3dCommon.h"
 #include "Collision/Core/CollisionManager.h"
@@ -52,6 +54,8 @@ protected:
 	SpriteCommon* spriteCommon_ = nullptr;
 	Object3dCommon* object3dCommon_ = nullptr;
 	TextureManager* textureManager_ = nullptr;
+	AssetLoader* assetLoader_ = nullptr;
+	YoRigine::JsonWriter* jsonWriter_ = nullptr;
 	ModelManager* modelManager_ = nullptr;
 	YoRigine::CollisionManager* collisionManager_ = nullptr;;
 	YoRigine::LightManager* lightManager_ = nullptr;
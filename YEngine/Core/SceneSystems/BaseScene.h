@@ -21,6 +21,8 @@ class BaseScene
 {
 public:
 	///************************* 基本的な関数 *************************///
+	// 先読み（フェードアウトが始まった時点で呼ばれる。LoadModelAsync などで読み込みを始めておく）
+	virtual void Preload() {}
 	// 初期化
 	virtual void Initialize() = 0;
 	// 終了
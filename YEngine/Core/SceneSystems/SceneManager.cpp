@@ -1,6 +1,8 @@
 #include "SceneManager.h"
 #include "Sprite/SpriteCommon.h"
 #include "OffScreen/PostEffectManager.h"
+#include "Loaders/Async/AssetLoader.h"
+#include "Loaders/Asset/AssetRegistry.h"
 #include <assert.h>
 
 std::unique_ptr<SceneManager> SceneManager::instance = nullptr;
@@ -54,7 +56,10 @@ void SceneManager::Update() {
 	// トランジション更新と状態管理
 	//------------------------------------------------------------
 	if (transition_) {
-		transition_->Update();
+		// 読み込み待ちの間は暗いまま止めておく
+		if (transitionState_ != TransitionState::Loading) {
+			transition_->Update();
+		}
 
 		switch (transitionState_) {
 		case TransitionState::FadeOut:
@@ -69,10 +74,13 @@ void SceneManager::Update() {
 				// 新しいシーンに切り替え
 				scene_ = nextScene_;
 				nextScene_ = nullptr;
-				scene_->SetSceneManager(this);
-				scene_->Initialize();
+				EnterScene();
+			}
+			break;
 
-				// フェードイン開始
+		case TransitionState::Loading:
+			// 読み込みが終わったらフェードイン開始
+			if (AssetLoader::GetInstance()->IsIdle()) {
 				transition_->StartTransition();
 				transitionState_ = TransitionState::FadeIn;
 			}
@@ -88,6 +96,8 @@ void SceneManager::Update() {
 		case TransitionState::None:
 			// 次のシーン予約があればフェードアウト開始
 			if (nextScene_) {
+				// フェードアウトと並行して次のシーンの読み込みを進める
+				nextScene_->Preload();
 				transition_->EndTransition();
 				transitionState_ = TransitionState::FadeOut;
 			}
@@ -150,13 +160,41 @@ void SceneManager::ChangeScene(const std::string& sceneName) {
 	if (!scene_) {
 		scene_ = nextScene_;
 		nextScene_ = nullptr;
-		scene_->SetSceneManager(this);
-		scene_->Initialize();
+		scene_->Preload();
+		EnterScene();
 
-		// 初回のみフェードイン開始
-		if (transition_) {
+		// 初回はフェードアウトしていないので、暗い状態から始める
+		if (transition_ && transitionState_ == TransitionState::Loading) {
 			transition_->StartTransition();
-			transitionState_ = TransitionState::FadeIn;
+			transition_->Update();
 		}
 	}
 }
+
+/// <summary>
+/// 新しいシーンの初期化とフェードインの開始
+/// </summary>
+void SceneManager::EnterScene() {
+	scene_->SetSceneManager(this);
+	scene_->Initialize();
+
+	// 前のシーンだけが使っていたモデル・テクスチャを解放する（新しいシーンが参照を取った後に行う）
+	AssetRegistry* assetRegistry = AssetRegistry::GetInstance();
+	if (assetRegistry->UnloadUnused() > 0) {
+		assetRegistry->LogStats();
+	}
+
+	if (!transition_) {
+		return;
+	}
+
+	// 非同期読み込みが残っていれば暗いまま待つ
+	if (!AssetLoader::GetInstance()->IsIdle()) {
+		transitionState_ = TransitionState::Loading;
+		return;
+	}
+
+	// フェードイン開始
+	transition_->StartTransition();
+	transitionState_ = TransitionState::FadeIn;
+}
@@ -46,6 +46,11 @@ public:
 		return "";
 	}
 
+private:
+	///************************* 内部処理 *************************///
+	// 新しいシーンを初期化し、読み込みが残っていれば待ってからフェードインする
+	void EnterScene();
+
 private:
 	///************************* メンバ変数 *************************///
 	static std::unique_ptr<SceneManager> instance;
@@ -66,6 +71,7 @@ private:
 	enum class TransitionState {
 		None,       // トランジションなし
 		FadeOut,    // フェードアウト中（画面が暗くなる）
+		Loading,    // 暗いまま非同期読み込みの完了を待つ
 		FadeIn      // フェードイン中（画面が明るくなる）
 	};
 
@@ -54,6 +54,8 @@ namespace YoRigine {
 		// GPU へ行列転送
 		wt_.SetMapWVP(worldViewProjectionMatrix);
 		wt_.SetMapWorld(worldMatrix);
+		D3D12_GPU_VIRTUAL_ADDRESS transformAddress = wt_.UploadTransformData();
+		if (transformAddress == 0) { return; }
 
 		//-----------------------------------------
 		// パイプライン設定
@@ -74,7 +76,7 @@ namespace YoRigine {
 		//-----------------------------------------
 		// 定数バッファ & テクスチャ設定
 		//-----------------------------------------
-		cmd->SetGraphicsRootConstantBufferView(1, wt_.GetConstBuffer()->GetGPUVirtualAddress());
+		cmd->SetGraphicsRootConstantBufferView(1, transformAddress);
 
 		cmd->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetsrvHandleGPU(textureFilePath_));
 
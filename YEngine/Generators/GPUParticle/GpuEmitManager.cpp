@@ -775,6 +775,7 @@ namespace YoRigine {
 				if (ImGui::Selectable(modelKeys[i].c_str(), isSelected)) {
 					selected = i;
 					p.model = ModelManager::GetInstance()->FindModel(modelKeys[i]);
+					p.modelHandle = ModelManager::GetInstance()->AcquireModel(modelKeys[i]);
 					changed = true;
 				}
 			}
@@ -1966,6 +1967,7 @@ namespace YoRigine {
 				std::string modelName = mp.value("modelName", "");
 				if (!modelName.empty()) {
 					e->meshParams.model = ModelManager::GetInstance()->FindModel(modelName);
+					e->meshParams.modelHandle = ModelManager::GetInstance()->AcquireModel(modelName);
 				}
 
 				e->meshParams.translate = JsonToVector3(mp["translate"]);
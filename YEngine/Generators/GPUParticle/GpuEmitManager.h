@@ -5,6 +5,7 @@
 #include "GPUEmitter.h"
 #include <Systems/Camera/Camera.h>
 #include <GPUParticle/GpuParticleParams.h>
+#include <Loaders/Asset/AssetRegistry.h>
 // Math
 #include <Vector3.h>
 
@@ -73,6 +74,7 @@ namespace YoRigine {
 
 			struct MeshParams {
 				Model* model = nullptr;         // 使用するモデル (UIから指定する)
+				AssetHandle modelHandle;        // 使っている間モデルが解放されないよう持つ参照
 				Vector3 translate = { 0,0,0 };
 				Vector3 scale = { 1,1,1 };
 				Quaternion rotation = { 0,0,0,1 };
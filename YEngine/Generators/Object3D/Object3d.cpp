@@ -6,6 +6,7 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cmath>
 
 // Engine
 #include "Loaders./Texture./TextureManager.h"
@@ -15,6 +16,7 @@
 #include "Debugger/Logger.h"
 #include <LightManager/LightManager.h>
 #include <PipelineManager/ShadowPipeline.h>
+#include "Frustum.h"
 
 
 const std::string Object3d::defaultModelPath_ = "Resources/Models/";
@@ -46,7 +48,7 @@ void Object3d::Initialize()
 /// </summary>
 void Object3d::UpdateAnimation()
 {
-	if (model_) {
+	if (ResolvePendingModel()) {
 		model_->UpdateAnimation();
 	}
 }
@@ -56,6 +58,17 @@ void Object3d::UpdateAnimation()
 /// </summary>
 void Object3d::Draw(Camera* camera, WorldTransform& worldTransform)
 {
+	// 非同期読み込み中は描かない
+	if (!ResolvePendingModel() && pendingModel_) {
+		return;
+	}
+
+	// 見えないものはコマンドを積む前に除く
+	if (model_ && camera && enableCulling_ && enableCameraCulling_ && !IsVisible(*camera, worldTransform)) {
+		// 影は前フレームのスキニング結果を使うので、描かなくても頂点は更新しておく
+		model_->DispatchSkinning();
+		return;
+	}
 
 	cameraData_->viewProjection = camera->GetViewProjectionMatrix();
 
@@ -67,16 +80,10 @@ void Object3d::Draw(Camera* camera, WorldTransform& worldTransform)
 	if (model_) {
 
 		if (camera) {
-			const Matrix4x4& vp = camera->GetViewProjectionMatrix();
-
 			// ボーンの有無でルート行列の扱いが変わる
-			if (!model_->GetHasBones()) {
-				worldViewProjectionMatrix = worldTransform.GetMatWorld() * model_->GetRootNode().GetLocalMatrix() * vp;
-				worldMatrix = worldTransform.GetMatWorld() * model_->GetRootNode().GetLocalMatrix();
-			} else {
-				worldViewProjectionMatrix = worldTransform.GetMatWorld() * vp;
-				worldMatrix = worldTransform.GetMatWorld();
-			}
+			worldMatrix = ComputeWorldMatrix(worldTransform);
+			worldViewProjectionMatrix = worldMatrix * camera->GetViewProjectionMatrix();
+			UpdateLod(*camera, worldMatrix);
 		} else {
 			// カメラ無し（デバッグ）
 			worldViewProjectionMatrix = worldTransform.GetMatWorld();
@@ -87,10 +94,14 @@ void Object3d::Draw(Camera* camera, WorldTransform& worldTransform)
 	worldTransform.SetMapWVP(worldViewProjectionMatrix);
 	worldTransform.SetMapWorld(worldMatrix);
 
+	// このフレームの領域へ書き込む（容量不足なら描かない）
+	D3D12_GPU_VIRTUAL_ADDRESS transformAddress = worldTransform.UploadTransformData();
+	if (transformAddress == 0) { return; }
+
 	auto commandList = object3dCommon_->GetDxCommon()->GetCommandList();
 
 	// ワールド
-	commandList->SetGraphicsRootConstantBufferView(1, worldTransform.GetConstBuffer()->GetGPUVirtualAddress());
+	commandList->SetGraphicsRootConstantBufferView(1, transformAddress);
 
 	// カメラ
 	commandList->SetGraphicsRootConstantBufferView(4, cameraResource_->GetGPUVirtualAddress());
@@ -102,7 +113,7 @@ void Object3d::Draw(Camera* camera, WorldTransform& worldTransform)
 
 	// モデル描画
 	if (model_) {
-		model_->Draw();
+		model_->Draw(lodLevel_);
 	}
 }
 
@@ -118,6 +129,15 @@ void Object3d::DrawBone(Line& line, const Matrix4x4& worldMatrix)
 
 void Object3d::DrawShadow(WorldTransform& worldTransform)
 {
+	if (!ResolvePendingModel()) {
+		return;
+	}
+
+	// ライトの視錐台の外にあるものは影を落とさない
+	if (enableCulling_ && !IsInFrustum(YoRigine::LightManager::GetInstance()->GetShadowFrustum(), GetWorldAABB(worldTransform))) {
+		return;
+	}
+
 	auto commandList = object3dCommon_->GetDxCommon()->GetCommandList().Get();
 	// シャドウ用パイプライン
 	commandList->SetPipelineState(
@@ -127,18 +147,100 @@ void Object3d::DrawShadow(WorldTransform& worldTransform)
 		ShadowPipeline::GetInstance()->GetRootSignature("Shadowmap"));
 
 	// DrawShadow 内
-	if (!model_->GetHasBones()) {
-		objectData_->world =
-			worldTransform.GetMatWorld() * model_->GetRootNode().GetLocalMatrix();
-	} else {
-		objectData_->world = worldTransform.GetMatWorld();
-	}
+	objectData_->world = ComputeWorldMatrix(worldTransform);
 	commandList->SetGraphicsRootConstantBufferView(0, objectCB_->GetGPUVirtualAddress());
 	// b1: lightViewProj
 	commandList->SetGraphicsRootConstantBufferView(1, YoRigine::LightManager::GetInstance()->GetShadowResource()->GetGPUVirtualAddress());
 
 	// モデル描画（Shadow用）
-	model_->DrawShadow();
+	// LOD は最後に描いたときの段を使う（影の細部はそれほど目立たない）
+	model_->DrawShadow(lodLevel_);
+}
+
+/// <summary>
+/// カメラから見えるか（視錐台と距離）
+/// </summary>
+bool Object3d::IsVisible(const Camera& camera, WorldTransform& worldTransform) const
+{
+	if (!model_) { return false; }
+
+	const AABB worldAABB = GetWorldAABB(worldTransform);
+
+	// 距離は AABB 上でカメラに最も近い点で測る
+	if (cullDistance_ > 0.0f) {
+		const Vector3 eye = camera.GetWorldPosition();
+		const Vector3 nearest = {
+			std::clamp(eye.x, worldAABB.min.x, worldAABB.max.x),
+			std::clamp(eye.y, worldAABB.min.y, worldAABB.max.y),
+			std::clamp(eye.z, worldAABB.min.z, worldAABB.max.z),
+		};
+		const Vector3 diff = nearest - eye;
+		if (diff.x * diff.x + diff.y * diff.y + diff.z * diff.z > cullDistance_ * cullDistance_) {
+			return false;
+		}
+	}
+
+	return IsInFrustum(camera.GetFrustum(), worldAABB);
+}
+
+/// <summary>
+/// ワールド空間の AABB
+/// </summary>
+AABB Object3d::GetWorldAABB(WorldTransform& worldTransform) const
+{
+	if (!model_) { return {}; }
+	return TransformAABB(model_->GetLocalAABB(), ComputeWorldMatrix(worldTransform));
+}
+
+/// <summary>
+/// モデルのワールド行列
+/// </summary>
+Matrix4x4 Object3d::ComputeWorldMatrix(WorldTransform& worldTransform) const
+{
+	if (model_ && !model_->GetHasBones()) {
+		return worldTransform.GetMatWorld() * model_->GetRootNode().GetLocalMatrix();
+	}
+	return worldTransform.GetMatWorld();
+}
+
+/// <summary>
+/// LOD の選択
+/// 各段の誤差（ローカル空間の長さ）をワールドの大きさに直し、境界球の手前の面までの距離で画面に映したときの割合を求める
+/// </summary>
+void Object3d::UpdateLod(const Camera& camera, const Matrix4x4& worldMatrix)
+{
+	const uint32_t lodCount = model_->GetLodCount();
+	if (!enableLod_ || lodCount <= 1) {
+		lodLevel_ = 0;
+		return;
+	}
+
+	const Sphere& localSphere = model_->GetLocalSphere();
+	const Sphere worldSphere = TransformSphere(localSphere, worldMatrix);
+	const float scale = localSphere.radius > 0.0f ? worldSphere.radius / localSphere.radius : 1.0f;
+
+	// 近すぎる（カメラが境界球の中にある）ときは元のメッシュ
+	const Vector3 diff = worldSphere.center - camera.GetWorldPosition();
+	const float distance = std::sqrt(diff.x * diff.x + diff.y * diff.y + diff.z * diff.z) - worldSphere.radius;
+	if (distance <= 0.0f) {
+		lodLevel_ = 0;
+		return;
+	}
+
+	// 画面の高さに対する割合（projection の m[1][1] は 1 / tan(fovY / 2)）
+	const float projectionScale = camera.GetProjectionMatrix().m[1][1] * 0.5f * scale / distance;
+
+	// 粗い段から順に、誤差が収まる最初の段を使う
+	// 今より粗い段へは閾値を下げて、今の段以下は閾値を上げて判定するので、境目で行き来しない
+	uint32_t selected = 0;
+	for (uint32_t lod = lodCount - 1; lod > 0; --lod) {
+		const float limit = lodThreshold_ * (lod > lodLevel_ ? 1.0f - kLodHysteresis : 1.0f + kLodHysteresis);
+		if (model_->GetLodError(lod) * projectionScale <= limit) {
+			selected = lod;
+			break;
+		}
+	}
+	lodLevel_ = selected;
 }
 
 /// <summary>
@@ -174,6 +276,26 @@ void Object3d::UpdateUV()
 	SetUvTransform(affine);
 }
 
+/// <summary>
+/// 非同期読み込みの完了確認
+/// </summary>
+bool Object3d::ResolvePendingModel()
+{
+	if (pendingModel_) {
+		ModelManager* modelManager = ModelManager::GetInstance();
+		const PendingModel& pending = *pendingModel_;
+		if (Model* model = modelManager->FindModel(pending.fileName, pending.animationName, pending.isAnimation)) {
+			model_ = model;
+			modelHandle_ = modelManager->AcquireModel(pending.fileName, pending.animationName, pending.isAnimation);
+			pendingModel_.reset();
+		} else if (!modelManager->IsLoading(pending.fileName, pending.animationName, pending.isAnimation)) {
+			// 読み込みに失敗した（ログは ModelManager 側で出している）
+			pendingModel_.reset();
+		}
+	}
+	return model_ != nullptr;
+}
+
 /// <summary>
 /// モデルを読み込みセットする
 /// </summary>
@@ -189,6 +311,9 @@ void Object3d::SetModel(const std::string& filePath, bool isAnimation, const std
 	model_ = ModelManager::GetInstance()->FindModel(
 		fileName, animationName, isAnimation
 	);
+	modelHandle_ = ModelManager::GetInstance()->AcquireModel(
+		fileName, animationName, isAnimation
+	);
 }
 
 /// <summary>
@@ -221,6 +346,22 @@ void Object3d::SetChangeMotion(const std::string& filePath, MotionPlayMode playM
 	}
 }
 
+/// <summary>
+/// モーションデータだけを読み込む
+/// </summary>
+Motion Object3d::LoadMotion(const std::string& filePath, const std::string& animationName)
+{
+	std::string basePath = filePath;
+	std::string fileName;
+
+	if (basePath.ends_with(".gltf")) {
+		basePath = basePath.substr(0, basePath.size() - 5);
+		fileName = basePath + ".gltf";
+	}
+
+	return Model::LoadMotion(defaultModelPath_ + basePath, fileName, animationName);
+}
+
 /// <summary>
 //モーション速度の切り替え
 /// </summary>
@@ -252,5 +393,26 @@ std::unique_ptr<Object3d> Object3d::Create(const std::string& filePath, const st
 	auto newObj = std::make_unique<Object3d>();
 	newObj->Initialize();
 	newObj->model_ = model;
+	newObj->modelHandle_ = ModelManager::GetInstance()->AcquireModel(fileName);
 	return newObj;
-}
\ No newline at end of file
+}
+
+/// <summary>
+/// ファイル名から Object3d を生成（モデルは非同期で読み込む）
+/// </summary>
+std::unique_ptr<Object3d> Object3d::CreateAsync(const std::string& filePath, const std::string& animationName, bool isAnimation)
+{
+	// モデルのパスを解析して正しい形式に変換
+	auto [basePath, fileName] = ModelManager::GetInstance()->ParseModelPath(filePath);
+
+	ModelManager::GetInstance()->LoadModelAsync(
+		defaultModelPath_ + basePath, fileName, animationName, isAnimation
+	);
+
+	auto newObj = std::make_unique<Object3d>();
+	newObj->Initialize();
+	newObj->pendingModel_ = PendingModel{ fileName, animationName, isAnimation };
+	// 読み込み済みならその場で受け取る
+	newObj->ResolvePendingModel();
+	return newObj;
+}
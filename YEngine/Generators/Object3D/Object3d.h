@@ -5,6 +5,7 @@
 #include <d3d12.h>
 #include <string>
 #include <vector>
+#include <optional>
 
 // Engine
 #include "Systems/Camera/Camera.h"
@@ -52,6 +53,9 @@ public:
 
 	static std::unique_ptr<Object3d> Create(const std::string& filePath, const std::string& animationName = "", bool isAnimation = false);
 
+	// モデルを非同期で読み込んで生成（読み込みが終わるまでは描画しない）
+	static std::unique_ptr<Object3d> CreateAsync(const std::string& filePath, const std::string& animationName = "", bool isAnimation = false);
+
 
 	///************************* 基本的な関数 *************************///
 
@@ -72,17 +76,30 @@ public:
 	// デバッグ表示
 	void DebugInfo();
 
+	///************************* カリング *************************///
+	// 視錐台の内側か（カリング距離が設定されていれば距離も見る）
+	bool IsVisible(const Camera& camera, WorldTransform& worldTransform) const;
+	// モデルの境界をワールド空間へ変換した AABB
+	AABB GetWorldAABB(WorldTransform& worldTransform) const;
+
 	///************************* モーション関連 *************************///
 	// アニメーションを切り替える
 	void SetChangeMotion(const std::string& filePath, MotionPlayMode playMode, const std::string& animationName = "");
 
+	// モーションデータだけを読み込む（ブレンドツリー用）
+	Motion LoadMotion(const std::string& filePath, const std::string& animationName = "");
+
 	// 今のアニメーション速度を切り替え
 	void SetMotionSpeed(float speed);
 	// モーションの再生方法
-	void PlayOnce() { model_->PlayOnce(); }
-	void PlayLoop() { model_->PlayLoop(); }
-	void Stop() { model_->Stop(); }
-	void Resume() { model_->Resume(); }
+	// 非同期読み込み中は何もしない
+	void PlayOnce() { if (ResolvePendingModel()) { model_->PlayOnce(); } }
+	void PlayLoop() { if (ResolvePendingModel()) { model_->PlayLoop(); } }
+	void Stop() { if (ResolvePendingModel()) { model_->Stop(); } }
+	void Resume() { if (ResolvePendingModel()) { model_->Resume(); } }
+
+	// モデルの読み込みが終わっているか
+	bool IsModelReady() { return ResolvePendingModel(); }
 
 public:
 	// UVのSRT
@@ -101,6 +118,15 @@ private:
 	// UVの更新
 	void UpdateUV();
 
+	// モデルのワールド行列（ボーンなしはルートノードの行列を掛ける）
+	Matrix4x4 ComputeWorldMatrix(WorldTransform& worldTransform) const;
+
+	// 画面上での大きさから LOD を選ぶ
+	void UpdateLod(const Camera& camera, const Matrix4x4& worldMatrix);
+
+	// 非同期読み込みが終わっていればモデルを受け取る（モデルがあれば true）
+	bool ResolvePendingModel();
+
 public:
 	///************************* アクセッサ *************************///
 
@@ -126,6 +152,25 @@ public:
 	float GetShininess() const { return materialLighting_->GetShininess(); }
 	float GetEnvironmentCoefficient() const { return materialLighting_->GetEnvironmentCoefficient(); }
 
+	// カリング（カメラ・影の両方。false にするとどちらも判定しない）
+	void SetEnableCulling(bool enable) { enableCulling_ = enable; }
+	bool IsCullingEnabled() const { return enableCulling_; }
+	// カメラのカリングだけ切り替える（まとめて判定する側は false にして二重の判定を省く。影の判定は残る）
+	// まとめて判定しているのは LevelDataLoader の配置物だけで、それ以外は Draw のたびに 1 つずつ判定する
+	void SetEnableCameraCulling(bool enable) { enableCameraCulling_ = enable; }
+	bool IsCameraCullingEnabled() const { return enableCameraCulling_; }
+	// カメラからこの距離より遠ければ描かない（0 以下で無効）
+	void SetCullDistance(float distance) { cullDistance_ = distance; }
+	float GetCullDistance() const { return cullDistance_; }
+
+	// LOD（簡略化の誤差を画面に映したときの大きさが、画面の高さに対して threshold 以下になる最も粗い段を使う）
+	void SetEnableLod(bool enable) { enableLod_ = enable; }
+	bool IsLodEnabled() const { return enableLod_; }
+	void SetLodThreshold(float threshold) { lodThreshold_ = threshold; }
+	float GetLodThreshold() const { return lodThreshold_; }
+	// 今使っている段（0 が元のメッシュ）
+	uint32_t GetLodLevel() const { return lodLevel_; }
+
 private:
 	///************************* メンバ変数 *************************///
 
@@ -133,6 +178,16 @@ private:
 	CameraForGPU* cameraData_ = nullptr;
 	Object3dCommon* object3dCommon_ = nullptr;
 	Model* model_ = nullptr;
+	// 使っている間モデルが解放されないよう持つ参照
+	AssetHandle modelHandle_;
+
+	// 非同期読み込み中のモデル
+	struct PendingModel {
+		std::string fileName;
+		std::string animationName;
+		bool isAnimation = false;
+	};
+	std::optional<PendingModel> pendingModel_;
 
 	// マテリアル関連
 	std::unique_ptr<MaterialColor> materialColor_;
@@ -144,5 +199,18 @@ private:
 	// シャドウマップ用リソース
 	Microsoft::WRL::ComPtr<ID3D12Resource> objectCB_;
 	ObjectTransform* objectData_;
+
+	// カリング
+	bool enableCulling_ = true;
+	bool enableCameraCulling_ = true;
+	float cullDistance_ = 0.0f;
+
+	// LOD
+	// 既定は 1080p でおよそ 1 ピクセル。段を切り替える境目では、粗くするときだけ厳しく判定してちらつきを防ぐ
+	static constexpr float kDefaultLodThreshold = 1.0f / 1080.0f;
+	static constexpr float kLodHysteresis = 0.25f;
+	bool enableLod_ = true;
+	float lodThreshold_ = kDefaultLodThreshold;
+	uint32_t lodLevel_ = 0;
 };
 
@@ -1,5 +1,6 @@
 #include "ParticleJsonManager.h"
 #include "Loaders/Json/JsonConverters.h"
+#include "Loaders/Json/JsonWriter.h"
 #include <iostream>
 
 /// <summary>
@@ -52,6 +53,9 @@ std::vector<std::string> ParticleJsonManager::GetAvailablePresets() const {
 /// システム設定ファイルを削除
 /// </summary>
 bool ParticleJsonManager::DeleteSettings(const std::string& systemName) {
+	// 書き込み待ちの保存が消したファイルを作り直さないよう、先に書き出す
+	YoRigine::JsonWriter::GetInstance()->Flush();
+
 	try {
 		std::string filePath = GetSettingsPath(systemName);
 		return std::filesystem::remove(filePath);
@@ -66,6 +70,9 @@ bool ParticleJsonManager::DeleteSettings(const std::string& systemName) {
 /// プリセットファイルを削除
 /// </summary>
 bool ParticleJsonManager::DeletePreset(const std::string& presetName) {
+	// 書き込み待ちの保存が消したファイルを作り直さないよう、先に書き出す
+	YoRigine::JsonWriter::GetInstance()->Flush();
+
 	try {
 		std::string filePath = GetPresetPath(presetName);
 		return std::filesystem::remove(filePath);
@@ -95,10 +102,6 @@ std::string ParticleJsonManager::GetPresetPath(const std::string& presetName) co
 /// </summary>
 bool ParticleJsonManager::SaveToFile(const std::string& filePath, const ParticleSetting& settings) {
 	try {
-		// JSON保存用フォルダ作成
-		std::filesystem::path path(filePath);
-		EnsureDirectoryExists(path.parent_path().string());
-
 		nlohmann::json json;
 
 		// -----------------------
@@ -250,14 +253,12 @@ bool ParticleJsonManager::SaveToFile(const std::string& filePath, const Particle
 		advanced["LOD距離1"] = settings.GetLODDistance1();
 		advanced["LOD距離2"] = settings.GetLODDistance2();
 
-		// JSON をファイル書き込み
-		std::ofstream file(filePath);
-		if (!file.is_open()) {
-			std::cerr << "ファイルが開けません: " << filePath << std::endl;
-			return false;
-		}
-
-		file << json.dump(4); // 見やすいように整形して保存
+		// JSON をファイル書き込み（見やすいように整形。フォルダ作成と書き込みは JsonWriter のスレッドで行う）
+		YoRigine::JsonWriter::GetInstance()->Save(filePath, std::move(json), 4, [filePath](bool succeeded) {
+			if (!succeeded) {
+				std::cerr << "ファイルが開けません: " << filePath << std::endl;
+			}
+			});
 		return true;
 	}
 	catch (const std::exception& e) {
@@ -270,6 +271,9 @@ bool ParticleJsonManager::SaveToFile(const std::string& filePath, const Particle
 /// JSON ファイルから ParticleSetting を復元する
 /// </summary>
 bool ParticleJsonManager::LoadFromFile(const std::string& filePath, ParticleSetting& settings) {
+	// 書き込み待ちの保存があれば、先に書き出してから読む
+	YoRigine::JsonWriter::GetInstance()->Flush();
+
 	try {
 		std::ifstream file(filePath);
 		if (!file.is_open()) {
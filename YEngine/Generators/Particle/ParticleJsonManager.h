@@ -17,7 +17,7 @@ public:
 		return instance;
 	}
 
-	// 保存・読み込み
+	// 保存・読み込み（保存は非同期。受け付けたら true）
 	bool SaveSettings(const std::string& systemName, const ParticleSetting& settings);
 	bool LoadSettings(const std::string& systemName, ParticleSetting& settings);
 
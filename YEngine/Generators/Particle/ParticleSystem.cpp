@@ -7,6 +7,7 @@
 #include "PipelineManager/PipelineManager.h"
 #include "Systems/Camera/Camera.h"
 #include "Mesh/Mesh.h"
+#include "TransformBatch.h"
 
 //C++
 #include <numbers>
@@ -45,6 +46,8 @@ void ParticleSystem::InitializeResources(SrvManager* srvManager) {
 
     // インスタンシングデータ初期化
     instancingData_.resize(kMaxInstances_);
+    worldMatrices_.resize(kMaxInstances_);
+    wvpMatrices_.resize(kMaxInstances_);
 
     // 初期化フラグ
     hasStarted_ = false;
@@ -813,16 +816,20 @@ void ParticleSystem::PrepareInstancingData(Camera* camera) {
             world = Multiply(S, Multiply(R, T));
         }
 
-        Matrix4x4 wvp = Multiply(world, vp);
-
-        // インスタンシングデータに設定
-        instancingData_[instanceCount].WVP = wvp;
-        instancingData_[instanceCount].World = world;
+        // WVP はループ後にまとめて計算する
+        worldMatrices_[instanceCount] = world;
         instancingData_[instanceCount].color = particle.color;
 
         instanceCount++;
     }
 
+    // ワールド行列 × VP を一括で計算してインスタンシングデータに設定
+    MultiplyMatrices(std::span(worldMatrices_.data(), instanceCount), vp, std::span(wvpMatrices_.data(), instanceCount));
+    for (uint32_t i = 0; i < instanceCount; ++i) {
+        instancingData_[i].WVP = wvpMatrices_[i];
+        instancingData_[i].World = worldMatrices_[i];
+    }
+
     instanceCount_ = instanceCount;
 
     // GPUに転送
@@ -193,6 +193,8 @@ private:
 	uint32_t srvIndex_;
 	ParticleForGPU* instancingDataForGPU_;
 	std::vector<ParticleForGPU> instancingData_;
+	std::vector<Matrix4x4> worldMatrices_; // 一括乗算用のワールド行列
+	std::vector<Matrix4x4> wvpMatrices_;   // 一括乗算の結果
 
 	// エミッション制御
 	float emissionTimer_;
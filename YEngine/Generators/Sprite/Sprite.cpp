@@ -25,7 +25,7 @@ void Sprite::Initialize(const std::string& textureFilePath)
 	MaterialResource();
 
 	// テクスチャ読み込み
-	TextureManager::GetInstance()->LoadTexture(textureFilePath);
+	textureHandle_ = TextureManager::GetInstance()->AcquireTexture(textureFilePath);
 
 	// SRVインデックス取得
 	textureIndex_ = TextureManager::GetInstance()->GetTextureIndexByFilePath(textureFilePath);
@@ -282,7 +282,7 @@ void Sprite::ChangeTexture(const std::string textureFilePath)
 {
 	filePath_ = textureFilePath;
 
-	TextureManager::GetInstance()->LoadTexture(textureFilePath);
+	textureHandle_ = TextureManager::GetInstance()->AcquireTexture(textureFilePath);
 
 	textureIndex_ = TextureManager::GetInstance()->GetTextureIndexByFilePath(textureFilePath);
 
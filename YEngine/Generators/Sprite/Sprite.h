@@ -7,6 +7,7 @@
 // Engine
 #include "Systems/Camera/Camera.h"
 #include "SrvManager.h"
+#include "Loaders/Asset/AssetRegistry.h"
 
 // Math
 #include "Vector4.h"
@@ -182,6 +183,8 @@ private:
 	// テクスチャ番号
 	uint32_t textureIndex_ = 0;
 	std::string filePath_;
+	// 使っている間テクスチャが解放されないよう持つ参照
+	AssetHandle textureHandle_;
 
 	// テクスチャ左上座標
 	Vector2 textureLeftTop_ = { 0.0f,0.0f };
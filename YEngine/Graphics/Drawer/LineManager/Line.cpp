@@ -6,6 +6,8 @@
 // Math
 #include "MathFunc.h"
 #include "Matrix4x4.h"
+#include "TransformBatch.h"
+#include <cmath>
 #include  <numbers>
 
 /// <summary>
@@ -73,27 +75,31 @@ void Line::RegisterLine(const Vector3& start, const Vector3& end)
 /// </summary>
 void Line::DrawSphere(const Vector3& center, float radius, int resolution)
 {
+	if (resolution <= 0) {
+		return;
+	}
+
+	// 単位円を XY / XZ / YZ 平面に並べ、半径と中心の行列でまとめて変換する
+	const size_t ringSize = static_cast<size_t>(resolution) + 1;
+	scratchPoints_.resize(ringSize * 3);
+	for (size_t i = 0; i < ringSize; ++i) {
+		float theta = float(i) / resolution * 2.0f * std::numbers::pi_v<float>;
+		float c = std::cos(theta);
+		float s = std::sin(theta);
+		scratchPoints_[i] = { c, s, 0.0f };
+		scratchPoints_[ringSize + i] = { c, 0.0f, s };
+		scratchPoints_[ringSize * 2 + i] = { 0.0f, c, s };
+	}
+	Matrix4x4 matrix = MakeAffineMatrix({ radius, radius, radius }, { 0.0f, 0.0f, 0.0f }, center);
+	TransformAffinePoints(scratchPoints_, matrix, scratchPoints_);
+
+	const Vector3* xy = &scratchPoints_[0];
+	const Vector3* xz = &scratchPoints_[ringSize];
+	const Vector3* yz = &scratchPoints_[ringSize * 2];
 	for (int i = 0; i < resolution; ++i) {
-		float theta1 = float(i) / resolution * 2.0f * std::numbers::pi_v<float>;
-		float theta2 = float(i + 1) / resolution * 2.0f * std::numbers::pi_v<float>;
-
-		// XY 平面
-		RegisterLine(
-			{ center.x + radius * cosf(theta1), center.y + radius * sinf(theta1), center.z },
-			{ center.x + radius * cosf(theta2), center.y + radius * sinf(theta2), center.z }
-		);
-
-		// XZ 平面
-		RegisterLine(
-			{ center.x + radius * cosf(theta1), center.y, center.z + radius * sinf(theta1) },
-			{ center.x + radius * cosf(theta2), center.y, center.z + radius * sinf(theta2) }
-		);
-
-		// YZ 平面
-		RegisterLine(
-			{ center.x, center.y + radius * cosf(theta1), center.z + radius * sinf(theta1) },
-			{ center.x, center.y + radius * cosf(theta2), center.z + radius * sinf(theta2) }
-		);
+		RegisterLine(xy[i], xy[i + 1]);
+		RegisterLine(xz[i], xz[i + 1]);
+		RegisterLine(yz[i], yz[i + 1]);
 	}
 }
 
@@ -129,34 +135,29 @@ void Line::DrawAABB(const Vector3& min, const Vector3& max)
 /// OBB（方向付きバウンディングボックス）のワイヤーフレームを描画登録
 /// </summary>
 /// <param name="center">中心座標</param>
-/// <param name="rotationEuler">回転オイラー角（ラジアン）</param>
+/// <param name="rotation">回転行列</param>
 /// <param name="size">各軸方向のサイズ</param>
-void Line::DrawOBB(const Vector3& center, const Vector3& rotationEuler, const Vector3& size)
+void Line::DrawOBB(const Vector3& center, const Matrix4x4& rotation, const Vector3& size)
 {
-	// オイラー角 → 回転行列
-	Matrix4x4 rotMat = MakeRotateMatrixXYZ(rotationEuler);
-
-	// 回転軸ベクトル × スケール
-	Vector3 orientations[3] = {
-		Transform({1, 0, 0}, rotMat) * size.x,
-		Transform({0, 1, 0}, rotMat) * size.y,
-		Transform({0, 0, 1}, rotMat) * size.z
-	};
-
 	// ローカル頂点（-1〜1）
 	const Vector3 localOffsets[8] = {
 		{-1, -1, -1}, {1, -1, -1}, {1, 1, -1}, {-1, 1, -1},
 		{-1, -1,  1}, {1, -1,  1}, {1, 1,  1}, {-1, 1,  1}
 	};
 
-	Vector3 corners[8];
-	for (int i = 0; i < 8; ++i) {
-		const Vector3& o = localOffsets[i];
-		corners[i] = center +
-			orientations[0] * o.x +
-			orientations[1] * o.y +
-			orientations[2] * o.z;
+	// サイズ・回転・中心をまとめた行列で 8 頂点を一度に変換（S * R * T を行ごとに組み立てる）
+	const float scales[3] = { size.x, size.y, size.z };
+	Matrix4x4 matrix = MakeIdentity4x4();
+	for (int i = 0; i < 3; ++i) {
+		matrix.m[i][0] = rotation.m[i][0] * scales[i];
+		matrix.m[i][1] = rotation.m[i][1] * scales[i];
+		matrix.m[i][2] = rotation.m[i][2] * scales[i];
 	}
+	matrix.m[3][0] = center.x;
+	matrix.m[3][1] = center.y;
+	matrix.m[3][2] = center.z;
+	Vector3 corners[8];
+	TransformAffinePoints(localOffsets, matrix, corners);
 
 	// エッジ（12本）
 	const uint32_t edges[12][2] = {
@@ -4,6 +4,7 @@
 #include <d3d12.h>
 #include <wrl.h>
 #include <array>
+#include <vector>
 
 // Math
 #include "Vector3.h"
@@ -36,7 +37,7 @@ public:
 	// 各形状の描画
 	void DrawSphere(const Vector3& center, float radius, int resolution);
 	void DrawAABB(const Vector3& min, const Vector3& max);
-	void DrawOBB(const Vector3& center, const Vector3& rotationEuler, const Vector3& size);
+	void DrawOBB(const Vector3& center, const Matrix4x4& rotation, const Vector3& size);
 
 private:
 	///************************* 内部処理 *************************///
@@ -90,5 +91,8 @@ private:
 	uint32_t index = 0u;
 	VertexData vertices_[2];
 
+	// 形状の頂点を一括変換するための作業領域
+	std::vector<Vector3> scratchPoints_;
+
 };
 
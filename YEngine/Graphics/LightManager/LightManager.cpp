@@ -10,6 +10,7 @@
 
 // Math
 #include "MathFunc.h"
+#include "TransformBatch.h"
 
 
 #ifdef USE_IMGUI
@@ -119,6 +120,7 @@ namespace YoRigine {
 
 		// 初期値は単位行列
 		shadow_->lightViewProjection = MakeIdentity4x4();
+		shadowFrustum_ = MakeFrustum(shadow_->lightViewProjection);
 	}
 
 
@@ -143,8 +145,8 @@ namespace YoRigine {
 		Matrix4x4 cameraInverseVP = Inverse(camera_->viewProjectionMatrix_);
 
 		// NDC空間の8つの角をワールド座標、さらにライト空間に変換し、AABBを計算
-		std::vector<Vector3> frustumCornersNDC = {
-			// Near Plane (Z=0.0f or -1.0f, depending on API. Assuming DirectX Z=[0, 1] based on context.)
+		const Vector3 frustumCornersNDC[8] = {
+			// Near Plane (DirectX の Z=[0, 1])
 			{ -1.0f, -1.0f, 0.0f }, { -1.0f,  1.0f, 0.0f },
 			{  1.0f,  1.0f, 0.0f }, {  1.0f, -1.0f, 0.0f },
 			// Far Plane (Z=1.0f)
@@ -152,26 +154,17 @@ namespace YoRigine {
 			{  1.0f,  1.0f, 1.0f }, {  1.0f, -1.0f, 1.0f },
 		};
 
-		float minX = std::numeric_limits<float>::max();
-		float minY = std::numeric_limits<float>::max();
-		// Z軸は拡張するため、初期値にはカメラ視錐台の最も遠い点(maxZ)を基準として使う
-		float minZ = std::numeric_limits<float>::max();
-		float maxX = std::numeric_limits<float>::min();
-		float maxY = std::numeric_limits<float>::min();
-		float maxZ = std::numeric_limits<float>::min();
-
-		for (const auto& cornerNDC : frustumCornersNDC) {
-			Vector3 cornerWorld = Transform(cornerNDC, cameraInverseVP);
-			Vector3 cornerLight = Transform(cornerWorld, lightView);
-
-			// AABB（軸並行バウンディングボックス）を更新
-			minX = std::min(minX, cornerLight.x);
-			maxX = std::max(maxX, cornerLight.x);
-			minY = std::min(minY, cornerLight.y);
-			maxY = std::max(maxY, cornerLight.y);
-			minZ = std::min(minZ, cornerLight.z); // カメラ視錐台の最も手前と奥のZを記録
-			maxZ = std::max(maxZ, cornerLight.z);
-		}
+		// lightView はアフィンなので、逆VPと合成してから1回の w 除算で済ませる
+		Vector3 frustumCornersLight[8];
+		TransformPoints(frustumCornersNDC, cameraInverseVP * lightView, frustumCornersLight);
+
+		// AABB（軸並行バウンディングボックス）。Z はカメラ視錐台の最も手前と奥を記録
+		AABB lightBounds = ComputeAABB(frustumCornersLight);
+		float minX = lightBounds.min.x;
+		float minY = lightBounds.min.y;
+		float maxX = lightBounds.max.x;
+		float maxY = lightBounds.max.y;
+		float maxZ = lightBounds.max.z;
 
 		float lightFrustumFarZ = maxZ;
 		float lightFrustumNearZ = lightFrustumFarZ - shadowmapSettings_.farZ;
@@ -179,6 +172,7 @@ namespace YoRigine {
 
 		// 最終的なライトビュー射影行列
 		shadow_->lightViewProjection = lightView * lightProj;
+		shadowFrustum_ = MakeFrustum(shadow_->lightViewProjection);
 	}
 	/*==========================================================================
 	平行光源のセット
@@ -11,6 +11,7 @@
 // Math
 #include "Vector4.h"
 #include "Matrix4x4.h"
+#include "Frustum.h"
 #include "Vector2.h"
 #include "Vector3.h"
 
@@ -52,6 +53,9 @@ namespace YoRigine {
 		ID3D12Resource* GetPointLightResource() const { return pointLightResource_.Get(); }
 		ID3D12Resource* GetShadowResource() const { return shadowResource_.Get(); }
 
+		// 影を描く範囲（lightViewProjection の視錐台。影のカリング用）
+		const Frustum& GetShadowFrustum() const { return shadowFrustum_; }
+
 	private:
 		///************************* 内部処理 *************************///
 		void CreateDirectionalLightResource();
@@ -175,6 +179,7 @@ namespace YoRigine {
 		// シャドウマップ用リソース
 		Microsoft::WRL::ComPtr<ID3D12Resource> shadowResource_;
 		ShadowMatrix* shadow_ = nullptr;
+		Frustum shadowFrustum_{};
 
 		Object3dCommon* object3dCommon_ = nullptr;
 		Camera* camera_ = nullptr;
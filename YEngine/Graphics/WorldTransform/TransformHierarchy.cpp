@@ -0,0 +1,255 @@
+#include "TransformHierarchy.h"
+// C++
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+
+// Engine
+#include "WorldTransform.h"
+
+///************************* 基本関数 *************************///
+
+/// <summary>
+/// 登録
+/// </summary>
+void TransformHierarchy::Register(WorldTransform* transform)
+{
+	assert(transform);
+	if (Contains(transform)) { return; }
+
+	slots_[transform] = static_cast<uint32_t>(transforms_.size());
+	transforms_.push_back(transform);
+	parents_.push_back(transform->parent_);
+	parentSlots_.push_back(-1);
+	externalParentWorlds_.push_back(transform->parent_ ? transform->parent_->matWorld_ : MakeIdentity4x4());
+	states_.push_back(Capture(*transform));
+	dirty_.push_back(1);
+	changed_.push_back(0);
+
+	// 親より先に登録されることもあるので、並びは Update で確定させる
+	needsSort_ = true;
+}
+
+/// <summary>
+/// 登録解除
+/// </summary>
+void TransformHierarchy::Unregister(const WorldTransform* transform)
+{
+	auto it = slots_.find(transform);
+	if (it == slots_.end()) { return; }
+
+	// 末尾と入れ替えて削除（並びが崩れるので次の Update で並べ直す）
+	const uint32_t slot = it->second;
+	const uint32_t last = static_cast<uint32_t>(transforms_.size() - 1);
+	slots_.erase(it);
+
+	if (slot != last) {
+		transforms_[slot] = transforms_[last];
+		parents_[slot] = parents_[last];
+		externalParentWorlds_[slot] = externalParentWorlds_[last];
+		states_[slot] = states_[last];
+		dirty_[slot] = dirty_[last];
+		slots_[transforms_[slot]] = slot;
+	}
+
+	transforms_.pop_back();
+	parents_.pop_back();
+	parentSlots_.pop_back();
+	externalParentWorlds_.pop_back();
+	states_.pop_back();
+	dirty_.pop_back();
+	changed_.pop_back();
+	updatedSlots_.clear();
+
+	needsSort_ = true;
+}
+
+/// <summary>
+/// 全て登録解除
+/// </summary>
+void TransformHierarchy::Clear()
+{
+	transforms_.clear();
+	parents_.clear();
+	parentSlots_.clear();
+	externalParentWorlds_.clear();
+	states_.clear();
+	dirty_.clear();
+	changed_.clear();
+	slots_.clear();
+	updatedSlots_.clear();
+	needsSort_ = false;
+}
+
+/// <summary>
+/// 強制再計算の指定
+/// </summary>
+void TransformHierarchy::MarkDirty(const WorldTransform* transform)
+{
+	auto it = slots_.find(transform);
+	if (it != slots_.end()) {
+		dirty_[it->second] = 1;
+	}
+}
+
+/// <summary>
+/// 更新
+/// </summary>
+void TransformHierarchy::Update()
+{
+	// 親の付け替えがあれば並べ直す
+	for (size_t i = 0; i < transforms_.size() && !needsSort_; ++i) {
+		needsSort_ = transforms_[i]->parent_ != parents_[i];
+	}
+	if (needsSort_) {
+		Sort();
+	}
+
+	updatedSlots_.clear();
+
+	// 親 → 子の順なので、親の変化は1回の走査で子へ伝わる
+	for (size_t i = 0; i < transforms_.size(); ++i) {
+		WorldTransform* transform = transforms_[i];
+		const LocalState state = Capture(*transform);
+
+		bool dirty = dirty_[i] != 0 || !IsSameState(state, states_[i]);
+
+		const int32_t parentSlot = parentSlots_[i];
+		if (parentSlot >= 0) {
+			dirty = dirty || changed_[parentSlot] != 0;
+		} else if (transform->parent_) {
+			// 未登録の親（ジョイントなど）は行列を直接比べる
+			const Matrix4x4& parentWorld = transform->parent_->matWorld_;
+			if (std::memcmp(parentWorld.m, externalParentWorlds_[i].m, sizeof(parentWorld.m)) != 0) {
+				externalParentWorlds_[i] = parentWorld;
+				dirty = true;
+			}
+		}
+
+		changed_[i] = dirty ? 1 : 0;
+		if (!dirty) { continue; }
+
+		states_[i] = state;
+		dirty_[i] = 0;
+		transform->UpdateWorldMatrix();
+		updatedSlots_.push_back(static_cast<uint32_t>(i));
+	}
+
+	// 変化したものだけまとめて転送
+	for (uint32_t slot : updatedSlots_) {
+		transforms_[slot]->TransferData();
+	}
+}
+
+///************************* 内部処理 *************************///
+
+/// <summary>
+/// ローカル値の写しを取る
+/// </summary>
+TransformHierarchy::LocalState TransformHierarchy::Capture(const WorldTransform& transform)
+{
+	LocalState state;
+	state.scale = transform.scale_;
+	state.rotate = transform.rotate_;
+	state.translate = transform.translate_;
+	state.anchorPoint = transform.anchorPoint_;
+	state.quaternion = transform.quaternion_;
+	state.useQuaternion = transform.useQuaternion_;
+	state.useAnchorPoint = transform.useAnchorPoint_;
+	return state;
+}
+
+/// <summary>
+/// ローカル値の比較
+/// </summary>
+bool TransformHierarchy::IsSameState(const LocalState& a, const LocalState& b)
+{
+	if (a.useQuaternion != b.useQuaternion || a.useAnchorPoint != b.useAnchorPoint) { return false; }
+	if (a.scale != b.scale || a.translate != b.translate) { return false; }
+
+	// 使っていない方の回転・アンカーは行列に影響しない
+	if (a.useQuaternion) {
+		if (a.quaternion.x != b.quaternion.x || a.quaternion.y != b.quaternion.y ||
+			a.quaternion.z != b.quaternion.z || a.quaternion.w != b.quaternion.w) {
+			return false;
+		}
+	} else if (a.rotate != b.rotate) {
+		return false;
+	}
+
+	return !a.useAnchorPoint || a.anchorPoint == b.anchorPoint;
+}
+
+/// <summary>
+/// 親の深さ順に並べ直す（同じ深さ内は登録順を保つ）
+/// </summary>
+void TransformHierarchy::Sort()
+{
+	const size_t count = transforms_.size();
+
+	// 親ポインタから登録済みの親の位置を引く
+	std::vector<int32_t> parentOf(count, -1);
+	for (size_t i = 0; i < count; ++i) {
+		parents_[i] = transforms_[i]->parent_;
+		if (!parents_[i]) { continue; }
+		auto it = slots_.find(parents_[i]);
+		if (it != slots_.end()) {
+			parentOf[i] = static_cast<int32_t>(it->second);
+		}
+	}
+
+	// 深さ（未登録の親は根として扱う）
+	std::vector<uint32_t> depth(count, 0);
+	std::vector<uint8_t> resolved(count, 0);
+	std::vector<uint32_t> chain;
+	for (size_t i = 0; i < count; ++i) {
+		// 解決済みの祖先まで遡ってから下りながら埋める
+		chain.clear();
+		int32_t node = static_cast<int32_t>(i);
+		while (node >= 0 && !resolved[node]) {
+			chain.push_back(static_cast<uint32_t>(node));
+			assert(chain.size() <= count && "親子関係が循環しています");
+			node = parentOf[node];
+		}
+		uint32_t d = node >= 0 ? depth[node] + 1 : 0;
+		for (auto it = chain.rbegin(); it != chain.rend(); ++it, ++d) {
+			depth[*it] = d;
+			resolved[*it] = 1;
+		}
+	}
+
+	std::vector<uint32_t> order(count);
+	std::iota(order.begin(), order.end(), 0u);
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return depth[a] < depth[b]; });
+
+	// 並べ替え（並びが変わった直後は全て再計算する）
+	std::vector<WorldTransform*> transforms(count);
+	std::vector<const WorldTransform*> parents(count);
+	std::vector<Matrix4x4> externalParentWorlds(count);
+	std::vector<LocalState> states(count);
+	std::vector<uint32_t> newSlotOf(count);
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t from = order[i];
+		transforms[i] = transforms_[from];
+		parents[i] = parents_[from];
+		externalParentWorlds[i] = externalParentWorlds_[from];
+		states[i] = states_[from];
+		newSlotOf[from] = static_cast<uint32_t>(i);
+	}
+
+	transforms_ = std::move(transforms);
+	parents_ = std::move(parents);
+	externalParentWorlds_ = std::move(externalParentWorlds);
+	states_ = std::move(states);
+	std::fill(dirty_.begin(), dirty_.end(), uint8_t(1));
+	std::fill(changed_.begin(), changed_.end(), uint8_t(0));
+
+	for (size_t i = 0; i < count; ++i) {
+		const int32_t parent = parentOf[order[i]];
+		parentSlots_[i] = parent >= 0 ? static_cast<int32_t>(newSlotOf[parent]) : -1;
+		slots_[transforms_[i]] = static_cast<uint32_t>(i);
+	}
+
+	needsSort_ = false;
+}
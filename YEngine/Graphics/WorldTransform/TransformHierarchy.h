@@ -0,0 +1,92 @@
+#pragma once
+// C++
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Math
+#include "Quaternion.h"
+#include "Matrix4x4.h"
+#include "Vector3.h"
+
+class WorldTransform;
+
+/// <summary>
+/// 座標変換の階層管理クラス
+/// 登録された WorldTransform を親が必ず子より前に来る順で連続配列に並べ、
+/// 1フレームに1回、変更のあった部分木だけ行列を再計算して転送データへまとめて書き込む
+/// </summary>
+/// <remarks>
+/// WorldTransform の scale_ / rotate_ などは直接書き換えられるので、前回値との比較で変更を検出する。
+/// 変更が無ければ行列計算も転送も行わないので、静的なオブジェクトは比較のコストだけで済む。
+/// matWorld_ を直接書き換えた場合は MarkDirty を呼ぶこと。
+/// 登録した WorldTransform は Unregister / Clear するまで破棄・ムーブしないこと。
+/// </remarks>
+class TransformHierarchy
+{
+public:
+	///************************* 基本関数 *************************///
+
+	// 登録（親が未登録でもよい。その場合は親の行列の変化を監視する）
+	void Register(WorldTransform* transform);
+
+	// 登録解除
+	void Unregister(const WorldTransform* transform);
+
+	// 全て登録解除
+	void Clear();
+
+	// 次の Update で強制的に再計算する（子も再計算される）
+	void MarkDirty(const WorldTransform* transform);
+
+	// 変更のあった部分木のみ再計算し、まとめて転送データへ書き込む
+	void Update();
+
+public:
+	///************************* アクセッサ *************************///
+
+	bool Contains(const WorldTransform* transform) const { return slots_.contains(transform); }
+	size_t GetCount() const { return transforms_.size(); }
+	// 直近の Update で再計算した数
+	size_t GetUpdatedCount() const { return updatedSlots_.size(); }
+
+private:
+	///************************* 内部処理 *************************///
+
+	// 行列計算に使うローカル値の写し
+	struct LocalState {
+		Vector3 scale;
+		Vector3 rotate;
+		Vector3 translate;
+		Vector3 anchorPoint;
+		Quaternion quaternion;
+		bool useQuaternion = false;
+		bool useAnchorPoint = false;
+	};
+
+	static LocalState Capture(const WorldTransform& transform);
+	static bool IsSameState(const LocalState& a, const LocalState& b);
+
+	// 親子関係から並べ直し、親の位置を引き直す
+	void Sort();
+
+private:
+	///************************* メンバ変数 *************************///
+
+	// 以下は全て同じ並び（親 → 子の順）
+	std::vector<WorldTransform*> transforms_;
+	std::vector<const WorldTransform*> parents_;  // 並べ替え時の parent_（変化したら並べ直す）
+	std::vector<int32_t> parentSlots_;            // 登録済みの親の位置（-1 なら根か未登録の親）
+	std::vector<Matrix4x4> externalParentWorlds_; // 未登録の親の前回の行列
+	std::vector<LocalState> states_;              // 前回計算時のローカル値
+	std::vector<uint8_t> dirty_;                  // 強制再計算フラグ
+	std::vector<uint8_t> changed_;                // このフレームで行列が変わったか（子へ伝搬）
+
+	// WorldTransform → 位置
+	std::unordered_map<const WorldTransform*, uint32_t> slots_;
+
+	// このフレームで再計算した位置
+	std::vector<uint32_t> updatedSlots_;
+
+	bool needsSort_ = false;
+};
@@ -1,7 +1,6 @@
 #include "WorldTransform.h"
 // Engine
 #include "DirectXCommon.h"
-#include "Object3D/Object3dCommon.h"
 
 // Math
 #include "MathFunc.h"
@@ -11,43 +10,42 @@
 /// </summary>
 void WorldTransform::Initialize()
 {
-	constBuffer_ = Object3dCommon::GetInstance()->GetDxCommon()->CreateBufferResource(sizeof(TransformationMatrix));
-	constBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&transformData_));
-
 	useAnchorPoint_ = true;
 
 	// ワールド行列初期化
 	matWorld_ = MakeAffineMatrix(scale_, rotate_, translate_);
 }
 
-/// <summary>
-/// オイラー角で回転を設定
-/// </summary>
-void WorldTransform::SetRotationEuler(const Vector3& euler)
-{
-	rotate_ = euler;
-	quaternion_ = Normalize(EulerToQuaternion(euler));
-	useQuaternion_ = false;
-}
-
 /// <summary>
 /// クォータニオンで回転を設定
+/// オイラー角への変換は GetRotationEuler で必要になったときだけ行う
 /// </summary>
 void WorldTransform::SetRotationQuaternion(const Quaternion& q)
 {
 	quaternion_ = Normalize(q);
-	rotate_ = QuaternionToEuler(q);
 	useQuaternion_ = true;
 }
 
 /// <summary>
-/// 定数バッファへ行列を転送
+/// 転送データへ行列を書き込む
 /// </summary>
 void WorldTransform::TransferData()
 {
-	transformData_->WVP = MakeIdentity4x4();
-	transformData_->World = matWorld_;
-	transformData_->WorldInverse = TransPose(Inverse(transformData_->World));
+	transformData_.WVP = MakeIdentity4x4();
+	transformData_.World = matWorld_;
+	// アフィン行列なので一般の 4x4 逆行列は使わない。スケールが無ければ転置で済む
+	transformData_.WorldInverse = isRigid_ ? InverseTransposeRigid(matWorld_) : InverseTransposeAffine(matWorld_);
+}
+
+/// <summary>
+/// 転送データをアップロードバッファへ書き込む
+/// 同じ WorldTransform を1フレームに複数回描いても、描画ごとに別の領域になる
+/// </summary>
+D3D12_GPU_VIRTUAL_ADDRESS WorldTransform::UploadTransformData() const
+{
+	UploadRingBuffer::Allocation allocation =
+		YoRigine::DirectXCommon::GetInstance()->GetUploadRingBuffer()->Push(transformData_);
+	return allocation.gpuAddress;
 }
 
 /// <summary>
@@ -55,26 +53,36 @@ void WorldTransform::TransferData()
 /// </summary>
 void WorldTransform::UpdateMatrix()
 {
-	Matrix4x4 rotM = useQuaternion_
-		? MakeRotateMatrix(quaternion_)
-		: MakeRotateMatrixXYZ(rotate_);
+	UpdateWorldMatrix();
+	TransferData();
+}
 
+/// <summary>
+/// ワールド行列のみ計算
+/// </summary>
+void WorldTransform::UpdateWorldMatrix()
+{
+	Vector3 translation = translate_;
 	if (useAnchorPoint_) {
 		Vector3 offset = useQuaternion_
 			? ScaleRotateToAnchor(anchorPoint_, scale_)
 			: ScaleRotateToAnchor(anchorPoint_, scale_, rotate_);
 
-		Vector3 anchoredTranslation = translate_ + anchorPoint_ - offset;
-		matWorld_ = MakeScaleMatrix(scale_) * rotM * MakeTranslateMatrix(anchoredTranslation);
-	} else {
-		matWorld_ = MakeScaleMatrix(scale_) * rotM * MakeTranslateMatrix(translate_);
+		translation = translate_ + anchorPoint_ - offset;
 	}
 
+	// S・R・T を閉形式で直接組み立てる
+	matWorld_ = useQuaternion_
+		? MakeAffineMatrix(scale_, quaternion_, translation)
+		: MakeAffineMatrix(scale_, rotate_, translation);
+
+	// スケールが 1 で親も同様なら回転 + 平行移動のみ
+	isRigid_ = scale_.x == 1.0f && scale_.y == 1.0f && scale_.z == 1.0f;
+
 	if (parent_) {
 		matWorld_ = matWorld_ * parent_->matWorld_;
+		isRigid_ = isRigid_ && parent_->isRigid_;
 	}
-
-	TransferData();
 }
 
 /// <summary>
@@ -96,11 +104,9 @@ void WorldTransform::SetAnchorPoint(const Vector3& anchorPoint) {
 /// </summary>
 Vector3 WorldTransform::ScaleRotateToAnchor(const Vector3& point, const Vector3& scale, const Vector3& rotation)
 {
-	Matrix4x4 scaleM = MakeScaleMatrix(scale);
-	Matrix4x4 rotateM = MakeRotateMatrixXYZ(rotation);
-	Matrix4x4 transform = rotateM * scaleM;
-
-	return Transform(point, transform);
+	// point * R * S（回転してから各軸をスケール）
+	Vector3 rotated = TransformNormal(point, MakeRotateMatrixXYZ(rotation));
+	return { rotated.x * scale.x, rotated.y * scale.y, rotated.z * scale.z };
 }
 
 /// <summary>
@@ -108,8 +114,6 @@ Vector3 WorldTransform::ScaleRotateToAnchor(const Vector3& point, const Vector3&
 /// </summary>
 Vector3 WorldTransform::ScaleRotateToAnchor(const Vector3& point, const Vector3& scale)
 {
-	Matrix4x4 scaleM = MakeScaleMatrix(scale);
-	Matrix4x4 rotateM = MakeRotateMatrix(quaternion_);
-	Matrix4x4 transform = rotateM * scaleM;
-	return Transform(point, transform);
+	Vector3 rotated = TransformNormal(point, MakeRotateMatrix(quaternion_));
+	return { rotated.x * scale.x, rotated.y * scale.y, rotated.z * scale.z };
 }
@@ -65,41 +65,50 @@ public:
 	void SetAnchorPoint(const Vector3& anchorPoint);
 
 	/// <summary>
-	/// 定数バッファの取得
+	/// 転送データをこのフレームのアップロードバッファへ書き込む
 	/// </summary>
-	/// <returns>定数バッファ</returns>
-	const Microsoft::WRL::ComPtr<ID3D12Resource>& GetConstBuffer() const { return constBuffer_; }
+	/// <returns>定数バッファのアドレス（容量不足なら 0）</returns>
+	D3D12_GPU_VIRTUAL_ADDRESS UploadTransformData() const;
 
 	/// <summary>
-	/// マップの設定・取得
+	/// 転送データの設定・取得
 	/// </summary>
 	/// <param name="wvp">WVP行列</param>
-	TransformationMatrix* GetTransformData() { return transformData_; }
-	void SetMapWVP(const Matrix4x4& wvp) { transformData_->WVP = wvp; }
-	void SetMapWorld(const Matrix4x4& world) { transformData_->World = world; }
+	TransformationMatrix* GetTransformData() { return &transformData_; }
+	void SetMapWVP(const Matrix4x4& wvp) { transformData_.WVP = wvp; }
+	void SetMapWorld(const Matrix4x4& world) { transformData_.World = world; }
 	const Matrix4x4& GetMatWorld() { return matWorld_; }
 
 
-	void SetRotationEuler(const Vector3& euler);
+	/// <summary>
+	/// 回転の設定・取得
+	/// 通常は rotate_（オイラー角）が回転の値。SetRotationQuaternion を呼んだ場合のみクォータニオンで回転する
+	/// </summary>
 	void SetRotationQuaternion(const Quaternion& q);
-	Quaternion GetRotationQuaternion() const { return quaternion_; }
+	Quaternion GetRotationQuaternion() const {
+		return useQuaternion_ ? quaternion_ : MakeRotateQuaternionXYZ(rotate_);
+	}
 	Vector3    GetRotationEuler() const {
-		return useQuaternion_ ? QuaternionToEuler(quaternion_) : rotate_;
+		return useQuaternion_ ? QuaternionToEulerXYZ(quaternion_) : rotate_;
 	};
 
 private:
+	friend class TransformHierarchy;
+
+	// ワールド行列のみ計算（転送しない）
+	void UpdateWorldMatrix();
 
-	// 定数バッファ生成
+	// 転送データへ行列を書き込む
 	void TransferData();
 
 	// スケール・回転を適用した座標を計算
 	Vector3 ScaleRotateToAnchor(const Vector3& point, const Vector3& scale, const Vector3& rotation);
 	Vector3 ScaleRotateToAnchor(const Vector3& point, const Vector3& scale);
 private:
-	// 定数バッファ
-	Microsoft::WRL::ComPtr<ID3D12Resource> constBuffer_;
-	// マッピング済みアドレス
-	TransformationMatrix* transformData_ = nullptr;
+	// 転送データ（GPU 側の領域は描画のたびにフレームごとのアップロードバッファから切り出す）
+	TransformationMatrix transformData_{};
+	// ワールド行列が回転 + 平行移動のみか（逆転置行列の計算を省略できる）
+	bool isRigid_ = false;
 };
 
 static_assert(!std::is_copy_assignable_v<WorldTransform>);
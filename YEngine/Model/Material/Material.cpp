@@ -24,5 +24,7 @@ void Material::RecordDrawCommands(ID3D12GraphicsCommandList* command, UINT rootP
 
 void Material::LoadTexture()
 {
-	TextureManager::GetInstance()->LoadTexture(textureFilePath_);
+	// 読み込みが終わるまではプレースホルダー（白）で描画する
+	// モデルが解放されるまで参照を持つ
+	textureHandle_ = TextureManager::GetInstance()->AcquireTextureAsync(textureFilePath_);
 }
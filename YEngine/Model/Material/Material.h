@@ -17,6 +17,9 @@
 // assimp
 #include <assimp/material.h>
 
+// Engine
+#include "Loaders/Asset/AssetRegistry.h"
+
 
 namespace YoRigine {
 	class DirectXCommon;
@@ -32,13 +35,13 @@ public:
 	// melデータ
 	struct MtlData {
 		std::string name;
-		float Ns;
+		float Ns = 0.0f;
 		Vector3 Ka;	// 環境光色
 		Vector3 Kd;	// 拡散反射色
 		Vector3 Ks;	// 鏡面反射光
-		float Ni;
-		float d;
-		uint32_t illum;
+		float Ni = 1.0f;
+		float d = 1.0f;
+		uint32_t illum = 0;
 		std::string textureFilePath;
 		uint32_t textureIndex = 0;
 	};
@@ -59,6 +62,9 @@ public:
 	// コマンドリストを積む
 	void RecordDrawCommands(ID3D12GraphicsCommandList* command, UINT rootParameterIndexCBV, UINT rootParameterIndexSRV);
 
+	// テクスチャの参照を外す（モデルを解放するとき）
+	void ReleaseTexture() { textureHandle_.Reset(); }
+
 private:
 
 	// テクスチャ読み込み
@@ -114,6 +120,7 @@ private:
 	Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
 	MtlData mtlData_;
 	std::string textureFilePath_;
+	AssetHandle textureHandle_;
 	Microsoft::WRL::ComPtr<ID3D12Resource> materialConstantResource_;
 	MaterialConstant* materialConstant_ = nullptr;
 
@@ -2,6 +2,9 @@
 #include "DirectXCommon.h"
 #include "../Skeleton/SkinCluster.h"
 
+// C++
+#include <algorithm>
+
 void Mesh::Initialize() {
 	dxCommon_ = YoRigine::DirectXCommon::GetInstance();
 	meshData_.vertices.clear();
@@ -14,6 +17,7 @@ void Mesh::Initialize(const std::vector<VertexData>& vertices, const std::vector
 	meshData_.vertices = vertices;
 	meshData_.indices = indices;
 	InitResources();
+	ComputeBounds();
 }
 
 void Mesh::RecordDrawCommands(ID3D12GraphicsCommandList* command)
@@ -82,6 +86,28 @@ void Mesh::TransferData()
 	meshResources_.indexResource->Map(0, nullptr, reinterpret_cast<void**>(&indexData_));
 	std::memcpy(indexData_, meshData_.indices.data(), indexSize);
 	meshResources_.indexResource->Unmap(0, nullptr);
+
+	ComputeBounds();
+}
+
+void Mesh::ComputeBounds()
+{
+	if (meshData_.vertices.empty()) {
+		localAABB_ = {};
+		return;
+	}
+
+	const Vector4& first = meshData_.vertices.front().position;
+	localAABB_.min = { first.x, first.y, first.z };
+	localAABB_.max = localAABB_.min;
+	for (const VertexData& vertex : meshData_.vertices) {
+		localAABB_.min.x = std::min(localAABB_.min.x, vertex.position.x);
+		localAABB_.min.y = std::min(localAABB_.min.y, vertex.position.y);
+		localAABB_.min.z = std::min(localAABB_.min.z, vertex.position.z);
+		localAABB_.max.x = std::max(localAABB_.max.x, vertex.position.x);
+		localAABB_.max.y = std::max(localAABB_.max.y, vertex.position.y);
+		localAABB_.max.z = std::max(localAABB_.max.z, vertex.position.z);
+	}
 }
 
 
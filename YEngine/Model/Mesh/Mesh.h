@@ -3,6 +3,7 @@
 // C++
 #include <wrl.h>
 #include <d3d12.h>
+#include <algorithm>
 #include <vector>
 
 
@@ -11,6 +12,7 @@
 #include "Vector3.h"
 #include "Vector4.h"
 #include "Matrix4x4.h"
+#include "MathFunc.h"
 
 
 // Engine
@@ -47,10 +49,17 @@ public:
 
 	///************************* CPU用の構造体 *************************///
 
+	// 簡略化した LOD（頂点は元のメッシュと共有し、インデックスだけを持つ）
+	struct Lod {
+		std::vector<uint32_t> indices;
+		float error = 0.0f;		// 元のメッシュからのずれ（ローカル空間の長さ）
+	};
+
 	// メッシュデータ
 	struct MeshData {
 		std::vector<VertexData> vertices;
 		std::vector<uint32_t> indices;
+		std::vector<Lod> lods;			// lods[0] が LOD 1（元のメッシュが LOD 0）
 		uint32_t materialIndex = 0;
 		uint32_t vertexOffset = 0;
 	};
@@ -69,6 +78,9 @@ public:
 
 	// GPUへ転送
 	void TransferData();
+
+	// 頂点からローカル空間の境界を求める（TransferData で呼ばれる）
+	void ComputeBounds();
 private:
 	///************************* 内部処理 *************************///
 
@@ -88,6 +100,17 @@ public:
 	uint32_t GetVertexCount() const { return static_cast<uint32_t>(meshData_.vertices.size()); }
 	uint32_t GetIndexCount() const { return static_cast<uint32_t>(meshData_.indices.size()); }
 
+	// LOD（0 が元のメッシュ。段数を超えたら最も粗い段）
+	uint32_t GetLodCount() const { return static_cast<uint32_t>(meshData_.lods.size()) + 1; }
+	const std::vector<uint32_t>& GetLodIndices(uint32_t lod) const {
+		lod = (std::min)(lod, GetLodCount() - 1);
+		return lod == 0 ? meshData_.indices : meshData_.lods[lod - 1].indices;
+	}
+	float GetLodError(uint32_t lod) const {
+		lod = (std::min)(lod, GetLodCount() - 1);
+		return lod == 0 ? 0.0f : meshData_.lods[lod - 1].error;
+	}
+
 	// マテリアル関連
 	uint32_t GetMaterialIndex() const { return meshData_.materialIndex; }
 	void SetMaterialIndex(uint32_t index) { meshData_.materialIndex = index; }
@@ -104,6 +127,9 @@ public:
 	void SetHasBones(bool hasBones) { hasBones_ = hasBones; }
 	bool HasBones() const { return hasBones_; }
 
+	// ローカル空間の境界
+	const AABB& GetLocalAABB() const { return localAABB_; }
+
 private:
 	///************************* メンバ変数 *************************///
 	YoRigine::DirectXCommon* dxCommon_ = nullptr;
@@ -115,6 +141,9 @@ private:
 	uint32_t* indexData_ = nullptr;
 	Matrix4x4 worldMatrix_;
 
+	// ローカル空間の境界（カリング用）
+	AABB localAABB_{};
+
 	// ボーン関連
 	bool hasBones_ = false;
 };
@@ -0,0 +1,411 @@
+#include "MeshOptimizer.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+	constexpr uint32_t kNoTriangle = UINT32_MAX;
+
+	// Forsyth のスコア（"Linear-Speed Vertex Cache Optimisation" の既定値）
+	constexpr float kCacheDecayPower = 1.5f;
+	constexpr float kLastTriangleScore = 0.75f;
+	constexpr float kValenceBoostScale = 2.0f;
+	constexpr float kValenceBoostPower = 0.5f;
+
+	// 頂点のスコア（キャッシュ内の位置と、残っている三角形の数から）
+	float VertexScore(int32_t cachePosition, uint32_t remainingTriangles) {
+		if (remainingTriangles == 0) { return -1.0f; }
+
+		float score = 0.0f;
+		if (cachePosition >= 0) {
+			if (cachePosition < 3) {
+				// 直前の三角形の頂点は、同じ辺を共有する三角形が続くように少し下げる
+				score = kLastTriangleScore;
+			} else {
+				const float scaler = 1.0f / static_cast<float>(MeshOptimizer::kOptimizeCacheSize - 3);
+				score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, kCacheDecayPower);
+			}
+		}
+
+		// 残りが少ない頂点を優先して片付ける
+		score += kValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -kValenceBoostPower);
+		return score;
+	}
+
+	const float* GetPosition(const void* vertices, uint32_t vertexStride, uint32_t positionOffset, uint32_t vertex) {
+		return reinterpret_cast<const float*>(static_cast<const uint8_t*>(vertices) + static_cast<size_t>(vertex) * vertexStride + positionOffset);
+	}
+
+} // namespace
+
+///************************* 計測 *************************///
+
+/// <summary>
+/// FIFO キャッシュを模して ACMR / ATVR を求める
+/// </summary>
+MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, uint32_t vertexCount, uint32_t cacheSize)
+{
+	CacheStats stats{};
+	stats.vertexCount = vertexCount;
+	stats.triangleCount = static_cast<uint32_t>(indexCount / 3);
+	if (indexCount == 0 || vertexCount == 0) { return stats; }
+
+	// 頂点ごとにキャッシュへ入った時刻を持ち、そこから cacheSize 回読み込むと追い出されたとみなす
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	uint32_t time = cacheSize + 1;
+	for (size_t i = 0; i < indexCount; ++i) {
+		const uint32_t vertex = indices[i];
+		assert(vertex < vertexCount);
+		if (time - timestamps[vertex] > cacheSize) {
+			timestamps[vertex] = time++;
+			++stats.cacheMisses;
+		}
+	}
+
+	stats.acmr = static_cast<float>(stats.cacheMisses) / static_cast<float>(std::max(stats.triangleCount, 1u));
+	stats.atvr = static_cast<float>(stats.cacheMisses) / static_cast<float>(vertexCount);
+	return stats;
+}
+
+///************************* 各段階 *************************///
+
+/// <summary>
+/// 全く同じ頂点を1つにまとめる
+/// </summary>
+uint32_t MeshOptimizer::WeldVertices(void* vertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t* indices, size_t indexCount, std::vector<uint32_t>* remap)
+{
+	uint8_t* bytes = static_cast<uint8_t*>(vertices);
+
+	// 先にすべての頂点の代表（最初に現れた同じ頂点）を決めてから詰める（詰めるとキーの指す先が変わるため）
+	std::vector<uint32_t> newIndices(vertexCount);
+	{
+		std::unordered_map<std::string_view, uint32_t> uniqueVertices;
+		uniqueVertices.reserve(vertexCount);
+		uint32_t uniqueCount = 0;
+		for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+			const std::string_view key(reinterpret_cast<const char*>(bytes + static_cast<size_t>(vertex) * vertexStride), vertexStride);
+			auto [it, inserted] = uniqueVertices.try_emplace(key, uniqueCount);
+			if (inserted) { ++uniqueCount; }
+			newIndices[vertex] = it->second;
+		}
+	}
+
+	// 新しい番号は現れた順なので、前から詰めれば上書きする前に読める
+	uint32_t uniqueCount = 0;
+	for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+		if (newIndices[vertex] != uniqueCount) { continue; }
+		if (vertex != uniqueCount) {
+			std::memcpy(bytes + static_cast<size_t>(uniqueCount) * vertexStride, bytes + static_cast<size_t>(vertex) * vertexStride, vertexStride);
+		}
+		++uniqueCount;
+	}
+
+	for (size_t i = 0; i < indexCount; ++i) {
+		indices[i] = newIndices[indices[i]];
+	}
+	if (remap) { *remap = std::move(newIndices); }
+	return uniqueCount;
+}
+
+/// <summary>
+/// 頂点キャッシュ向けの三角形の並べ替え
+/// スコアの高い三角形（キャッシュに乗っている頂点と、残りの少ない頂点を使うもの）から順に出力する
+/// </summary>
+void MeshOptimizer::OptimizeVertexCache(uint32_t* indices, size_t indexCount, uint32_t vertexCount)
+{
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount < 2 || vertexCount == 0) { return; }
+
+	// 頂点 → 使っている三角形
+	std::vector<uint32_t> remainingTriangles(vertexCount, 0);
+	for (size_t i = 0; i < triangleCount * 3; ++i) {
+		assert(indices[i] < vertexCount);
+		++remainingTriangles[indices[i]];
+	}
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+	for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+		adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + remainingTriangles[vertex];
+	}
+	std::vector<uint32_t> adjacency(triangleCount * 3);
+	{
+		std::vector<uint32_t> cursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; ++i) {
+			adjacency[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+	}
+
+	// スコアの初期値
+	std::vector<int32_t> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+		vertexScores[vertex] = VertexScore(-1, remainingTriangles[vertex]);
+	}
+	std::vector<float> triangleScores(triangleCount);
+	std::vector<bool> emitted(triangleCount, false);
+	uint32_t bestTriangle = 0;
+	for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+		triangleScores[triangle] = vertexScores[indices[triangle * 3 + 0]] + vertexScores[indices[triangle * 3 + 1]] + vertexScores[indices[triangle * 3 + 2]];
+		if (triangleScores[triangle] > triangleScores[bestTriangle]) {
+			bestTriangle = static_cast<uint32_t>(triangle);
+		}
+	}
+
+	std::vector<uint32_t> output;
+	output.reserve(triangleCount * 3);
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> nextCache;
+	cache.reserve(kOptimizeCacheSize + 3);
+	nextCache.reserve(kOptimizeCacheSize + 3);
+	size_t scanCursor = 0;
+
+	while (output.size() < triangleCount * 3) {
+		// キャッシュの周りに候補が無ければ、まだ出していない三角形を先頭から探す
+		if (bestTriangle == kNoTriangle) {
+			while (emitted[scanCursor]) { ++scanCursor; }
+			bestTriangle = static_cast<uint32_t>(scanCursor);
+		}
+
+		const uint32_t* triangleVertices = indices + static_cast<size_t>(bestTriangle) * 3;
+		output.insert(output.end(), triangleVertices, triangleVertices + 3);
+		emitted[bestTriangle] = true;
+
+		// 出した三角形を各頂点の隣接リストから外す
+		for (uint32_t k = 0; k < 3; ++k) {
+			const uint32_t vertex = triangleVertices[k];
+			uint32_t* begin = adjacency.data() + adjacencyOffsets[vertex];
+			uint32_t* end = begin + remainingTriangles[vertex];
+			uint32_t* found = std::find(begin, end, bestTriangle);
+			if (found != end) {
+				*found = *(end - 1);
+				--remainingTriangles[vertex];
+			}
+		}
+
+		// LRU キャッシュの更新（今の三角形の頂点を先頭へ）
+		nextCache.assign(triangleVertices, triangleVertices + 3);
+		for (uint32_t vertex : cache) {
+			if (vertex != triangleVertices[0] && vertex != triangleVertices[1] && vertex != triangleVertices[2]) {
+				nextCache.push_back(vertex);
+			}
+		}
+
+		// キャッシュに触れた頂点のスコアを更新し、その三角形から次を選ぶ
+		bestTriangle = kNoTriangle;
+		float bestScore = -1.0f;
+		for (size_t position = 0; position < nextCache.size(); ++position) {
+			const uint32_t vertex = nextCache[position];
+			cachePositions[vertex] = position < kOptimizeCacheSize ? static_cast<int32_t>(position) : -1;
+
+			const float score = VertexScore(cachePositions[vertex], remainingTriangles[vertex]);
+			const float delta = score - vertexScores[vertex];
+			vertexScores[vertex] = score;
+
+			const uint32_t* begin = adjacency.data() + adjacencyOffsets[vertex];
+			for (const uint32_t* it = begin; it != begin + remainingTriangles[vertex]; ++it) {
+				triangleScores[*it] += delta;
+				if (triangleScores[*it] > bestScore) {
+					bestScore = triangleScores[*it];
+					bestTriangle = *it;
+				}
+			}
+		}
+
+		if (nextCache.size() > kOptimizeCacheSize) {
+			nextCache.resize(kOptimizeCacheSize);
+		}
+		std::swap(cache, nextCache);
+	}
+
+	std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+}
+
+/// <summary>
+/// オーバードロー向けのクラスタ並べ替え
+/// キャッシュがすべて外れる三角形（どうせキャッシュが切れる所）でクラスタに分けるので、並べ替えても ACMR はほぼ変わらない
+/// </summary>
+void MeshOptimizer::OptimizeOverdraw(uint32_t* indices, size_t indexCount, const void* vertices, uint32_t vertexCount, uint32_t vertexStride,
+	uint32_t positionOffset, float threshold)
+{
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount < 2 || vertexCount == 0) { return; }
+
+	// クラスタの区切り（FIFO キャッシュで3頂点とも外れた三角形から新しいクラスタ）
+	std::vector<size_t> clusterStarts;
+	{
+		std::vector<uint32_t> timestamps(vertexCount, 0);
+		uint32_t time = kSimulatedCacheSize + 1;
+		for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+			uint32_t misses = 0;
+			for (uint32_t k = 0; k < 3; ++k) {
+				const uint32_t vertex = indices[triangle * 3 + k];
+				if (time - timestamps[vertex] > kSimulatedCacheSize) {
+					timestamps[vertex] = time++;
+					++misses;
+				}
+			}
+			if (triangle == 0 || misses == 3) {
+				clusterStarts.push_back(triangle);
+			}
+		}
+	}
+	if (clusterStarts.size() < 2) { return; }
+	clusterStarts.push_back(triangleCount);
+
+	// 各三角形の面積付きの法線と重心
+	auto accumulateTriangle = [&](size_t triangle, float (&centroid)[3], float (&normal)[3], float& area) {
+		const float* p0 = GetPosition(vertices, vertexStride, positionOffset, indices[triangle * 3 + 0]);
+		const float* p1 = GetPosition(vertices, vertexStride, positionOffset, indices[triangle * 3 + 1]);
+		const float* p2 = GetPosition(vertices, vertexStride, positionOffset, indices[triangle * 3 + 2]);
+		const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+		const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+		const float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+		const float doubleArea = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		for (int axis = 0; axis < 3; ++axis) {
+			centroid[axis] += (p0[axis] + p1[axis] + p2[axis]) / 3.0f * doubleArea;
+			normal[axis] += n[axis];
+		}
+		area += doubleArea;
+	};
+
+	// メッシュ全体の重心
+	float meshCentroid[3] = {};
+	{
+		float meshNormal[3] = {};
+		float meshArea = 0.0f;
+		for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+			accumulateTriangle(triangle, meshCentroid, meshNormal, meshArea);
+		}
+		if (meshArea <= 0.0f) { return; }
+		for (float& value : meshCentroid) { value /= meshArea; }
+	}
+
+	// クラスタごとの向き（重心から外を向いているほど手前にあり、他を隠しやすい）
+	const size_t clusterCount = clusterStarts.size() - 1;
+	std::vector<float> sortKeys(clusterCount, 0.0f);
+	for (size_t cluster = 0; cluster < clusterCount; ++cluster) {
+		float centroid[3] = {};
+		float normal[3] = {};
+		float area = 0.0f;
+		for (size_t triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; ++triangle) {
+			accumulateTriangle(triangle, centroid, normal, area);
+		}
+		const float normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		if (area <= 0.0f || normalLength <= 0.0f) { continue; }
+		for (int axis = 0; axis < 3; ++axis) {
+			sortKeys[cluster] += (centroid[axis] / area - meshCentroid[axis]) * (normal[axis] / normalLength);
+		}
+	}
+
+	std::vector<size_t> order(clusterCount);
+	std::iota(order.begin(), order.end(), size_t{ 0 });
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+	std::vector<uint32_t> sorted;
+	sorted.reserve(triangleCount * 3);
+	for (size_t cluster : order) {
+		sorted.insert(sorted.end(), indices + clusterStarts[cluster] * 3, indices + clusterStarts[cluster + 1] * 3);
+	}
+
+	// キャッシュ効率が落ちすぎるなら元のまま
+	const float baseline = AnalyzeVertexCache(indices, triangleCount * 3, vertexCount).acmr;
+	const float reordered = AnalyzeVertexCache(sorted.data(), sorted.size(), vertexCount).acmr;
+	if (reordered > baseline * threshold) { return; }
+
+	std::memcpy(indices, sorted.data(), sorted.size() * sizeof(uint32_t));
+}
+
+/// <summary>
+/// 頂点を最初に使われる順に並べ替える
+/// </summary>
+uint32_t MeshOptimizer::OptimizeVertexFetch(void* vertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t* indices, size_t indexCount, std::vector<uint32_t>* remap)
+{
+	std::vector<uint32_t> newIndices(vertexCount, kUnusedVertex);
+	uint32_t usedCount = 0;
+	for (size_t i = 0; i < indexCount; ++i) {
+		uint32_t& newIndex = newIndices[indices[i]];
+		if (newIndex == kUnusedVertex) {
+			newIndex = usedCount++;
+		}
+		indices[i] = newIndex;
+	}
+
+	uint8_t* bytes = static_cast<uint8_t*>(vertices);
+	std::vector<uint8_t> reordered(static_cast<size_t>(usedCount) * vertexStride);
+	for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+		if (newIndices[vertex] == kUnusedVertex) { continue; }
+		std::memcpy(reordered.data() + static_cast<size_t>(newIndices[vertex]) * vertexStride, bytes + static_cast<size_t>(vertex) * vertexStride, vertexStride);
+	}
+	if (!reordered.empty()) {
+		std::memcpy(bytes, reordered.data(), reordered.size());
+	}
+
+	if (remap) { *remap = std::move(newIndices); }
+	return usedCount;
+}
+
+///************************* インデックス形式 *************************///
+
+bool MeshOptimizer::CanUse16BitIndices(uint32_t vertexCount)
+{
+	return vertexCount <= kMax16BitVertexCount;
+}
+
+std::vector<uint16_t> MeshOptimizer::ConvertTo16BitIndices(const uint32_t* indices, size_t indexCount)
+{
+	std::vector<uint16_t> result(indexCount);
+	for (size_t i = 0; i < indexCount; ++i) {
+		assert(indices[i] <= kMax16BitVertexCount);
+		result[i] = static_cast<uint16_t>(indices[i]);
+	}
+	return result;
+}
+
+///************************* まとめて実行 *************************///
+
+/// <summary>
+/// すべての段階を順に行う
+/// </summary>
+MeshOptimizer::Report MeshOptimizer::Optimize(void* vertices, uint32_t& vertexCount, uint32_t vertexStride, std::vector<uint32_t>& indices,
+	const Options& options, std::vector<uint32_t>* remap)
+{
+	Report report{};
+	indices.resize(indices.size() / 3 * 3);
+	report.before = AnalyzeVertexCache(indices.data(), indices.size(), vertexCount);
+
+	// 元の頂点 → 今の頂点
+	std::vector<uint32_t> totalRemap(vertexCount);
+	std::iota(totalRemap.begin(), totalRemap.end(), 0u);
+	const uint32_t originalCount = vertexCount;
+
+	if (options.weld) {
+		std::vector<uint32_t> weldRemap;
+		vertexCount = WeldVertices(vertices, vertexCount, vertexStride, indices.data(), indices.size(), &weldRemap);
+		report.weldedVertexCount = originalCount - vertexCount;
+		totalRemap = std::move(weldRemap);
+	}
+
+	OptimizeVertexCache(indices.data(), indices.size(), vertexCount);
+	if (options.overdraw) {
+		OptimizeOverdraw(indices.data(), indices.size(), vertices, vertexCount, vertexStride, options.positionOffset, options.overdrawThreshold);
+	}
+
+	std::vector<uint32_t> fetchRemap;
+	const uint32_t weldedCount = vertexCount;
+	vertexCount = OptimizeVertexFetch(vertices, vertexCount, vertexStride, indices.data(), indices.size(), &fetchRemap);
+	report.removedVertexCount = weldedCount - vertexCount;
+	for (uint32_t& index : totalRemap) {
+		index = fetchRemap[index];
+	}
+
+	report.after = AnalyzeVertexCache(indices.data(), indices.size(), vertexCount);
+	report.canUse16BitIndices = CanUse16BitIndices(vertexCount);
+	if (remap) { *remap = std::move(totalRemap); }
+	return report;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/// <summary>
+/// インポート時のメッシュ最適化
+/// 頂点の結合 → 頂点キャッシュ向けの三角形の並べ替え（Forsyth） → オーバードロー向けのクラスタ並べ替え
+/// → 頂点の並べ替え（最初に使う順）の順に行う
+/// 頂点は stride バイトの塊として扱い、位置だけ float3 として読むので、頂点形式やデバイスには依存しない
+/// </summary>
+namespace MeshOptimizer {
+
+	// 使われていない頂点（remap の値）
+	inline constexpr uint32_t kUnusedVertex = UINT32_MAX;
+
+	// ACMR の計測に使う FIFO キャッシュのサイズ
+	inline constexpr uint32_t kSimulatedCacheSize = 16;
+
+	// 並べ替えで想定する LRU キャッシュのサイズ
+	inline constexpr uint32_t kOptimizeCacheSize = 32;
+
+	// 16 ビットのインデックスで表せる頂点数
+	inline constexpr uint32_t kMax16BitVertexCount = 0xFFFF;
+
+	// 頂点キャッシュの効率
+	struct CacheStats {
+		uint32_t vertexCount = 0;
+		uint32_t triangleCount = 0;
+		uint32_t cacheMisses = 0;
+		float acmr = 0.0f;	// 三角形あたりの頂点シェーダー実行数（0.5 〜 3、小さいほどよい）
+		float atvr = 0.0f;	// 頂点あたりの頂点シェーダー実行数（1 が理想）
+	};
+
+	// 最適化の設定
+	struct Options {
+		bool weld = true;					// 全く同じ頂点をまとめる（ボーンのウェイトが頂点ごとにあるメッシュでは切る）
+		bool overdraw = true;				// 外側を向いたクラスタから描くように並べ替える
+		float overdrawThreshold = 1.05f;	// オーバードロー向けの並べ替えで許す ACMR の悪化（倍率）
+		uint32_t positionOffset = 0;		// 頂点内の位置（float3）のバイトオフセット
+	};
+
+	// 最適化の結果
+	struct Report {
+		CacheStats before;
+		CacheStats after;
+		uint32_t weldedVertexCount = 0;		// 結合で減った頂点数
+		uint32_t removedVertexCount = 0;	// どの三角形からも使われず削除した頂点数
+		bool canUse16BitIndices = false;
+	};
+
+	///************************* 計測 *************************///
+
+	// FIFO キャッシュを模して ACMR / ATVR を求める
+	CacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, uint32_t vertexCount, uint32_t cacheSize = kSimulatedCacheSize);
+
+	///************************* 各段階 *************************///
+
+	// 全く同じバイト列の頂点を1つにまとめ、インデックスを付け替える（新しい頂点数を返す）
+	// remap には 元の頂点 → 新しい頂点 が入る
+	uint32_t WeldVertices(void* vertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t* indices, size_t indexCount, std::vector<uint32_t>* remap = nullptr);
+
+	// 頂点キャッシュに乗りやすい順に三角形を並べ替える（Forsyth の線形時間アルゴリズム）
+	void OptimizeVertexCache(uint32_t* indices, size_t indexCount, uint32_t vertexCount);
+
+	// キャッシュが切れる所でクラスタに分け、外側を向いたクラスタから描くように並べ替える
+	// ACMR が threshold 倍より悪くなる場合は何もしない
+	void OptimizeOverdraw(uint32_t* indices, size_t indexCount, const void* vertices, uint32_t vertexCount, uint32_t vertexStride,
+		uint32_t positionOffset = 0, float threshold = 1.05f);
+
+	// 頂点をインデックスで最初に使われる順に並べ替え、使われていない頂点を詰める（新しい頂点数を返す）
+	// remap には 元の頂点 → 新しい頂点（使われていなければ kUnusedVertex）が入る
+	uint32_t OptimizeVertexFetch(void* vertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t* indices, size_t indexCount, std::vector<uint32_t>* remap = nullptr);
+
+	///************************* インデックス形式 *************************///
+
+	bool CanUse16BitIndices(uint32_t vertexCount);
+	std::vector<uint16_t> ConvertTo16BitIndices(const uint32_t* indices, size_t indexCount);
+
+	///************************* まとめて実行 *************************///
+
+	// すべての段階を順に行う（vertexCount は最適化後の頂点数に更新される）
+	// remap には 元の頂点 → 新しい頂点（使われていなければ kUnusedVertex）が入る
+	Report Optimize(void* vertices, uint32_t& vertexCount, uint32_t vertexStride, std::vector<uint32_t>& indices,
+		const Options& options = {}, std::vector<uint32_t>* remap = nullptr);
+
+	template<class Vertex>
+	Report Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, const Options& options = {}, std::vector<uint32_t>* remap = nullptr) {
+		uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+		Report report = Optimize(vertices.data(), vertexCount, static_cast<uint32_t>(sizeof(Vertex)), indices, options, remap);
+		vertices.resize(vertexCount);
+		return report;
+	}
+
+} // namespace MeshOptimizer
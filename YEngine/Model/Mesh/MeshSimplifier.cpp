@@ -0,0 +1,413 @@
+#include "MeshSimplifier.h"
+
+// C++
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <unordered_map>
+
+// Engine
+#include "MeshOptimizer.h"
+
+namespace {
+
+	///************************* 二次誤差 *************************///
+
+	// 平面までの距離の二乗和を表す対称 4x4 行列（上三角だけ持つ）と重みの合計
+	struct Quadric {
+		double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+		double a11 = 0, a12 = 0, a13 = 0;
+		double a22 = 0, a23 = 0;
+		double a33 = 0;
+		double weight = 0;
+
+		Quadric& operator+=(const Quadric& other) {
+			a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+			a11 += other.a11; a12 += other.a12; a13 += other.a13;
+			a22 += other.a22; a23 += other.a23;
+			a33 += other.a33;
+			weight += other.weight;
+			return *this;
+		}
+	};
+
+	// 平面 ax + by + cz + d = 0 を重み付きで足す
+	void AddPlane(Quadric& q, double a, double b, double c, double d, double weight) {
+		q.a00 += weight * a * a; q.a01 += weight * a * b; q.a02 += weight * a * c; q.a03 += weight * a * d;
+		q.a11 += weight * b * b; q.a12 += weight * b * c; q.a13 += weight * b * d;
+		q.a22 += weight * c * c; q.a23 += weight * c * d;
+		q.a33 += weight * d * d;
+		q.weight += weight;
+	}
+
+	// 点から平面までの距離の二乗の重み付き平均
+	double Evaluate(const Quadric& q, const std::array<float, 3>& p) {
+		const double x = p[0], y = p[1], z = p[2];
+		const double sum =
+			q.a00 * x * x + 2.0 * q.a01 * x * y + 2.0 * q.a02 * x * z + 2.0 * q.a03 * x +
+			q.a11 * y * y + 2.0 * q.a12 * y * z + 2.0 * q.a13 * y +
+			q.a22 * z * z + 2.0 * q.a23 * z +
+			q.a33;
+		return q.weight > 0.0 ? std::max(sum, 0.0) / q.weight : 0.0;
+	}
+
+	///************************* 補助 *************************///
+
+	std::array<float, 3> ReadPosition(const void* vertices, uint32_t vertexStride, uint32_t positionOffset, uint32_t vertex) {
+		std::array<float, 3> p;
+		std::memcpy(p.data(), static_cast<const uint8_t*>(vertices) + static_cast<size_t>(vertex) * vertexStride + positionOffset, sizeof(float) * 3);
+		return p;
+	}
+
+	std::array<float, 3> Cross(const std::array<float, 3>& a, const std::array<float, 3>& b) {
+		return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+	}
+
+	std::array<float, 3> Sub(const std::array<float, 3>& a, const std::array<float, 3>& b) {
+		return { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+	}
+
+	float Dot(const std::array<float, 3>& a, const std::array<float, 3>& b) {
+		return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+	}
+
+	// 位置が全く同じかどうかで頂点をまとめるキー
+	struct PositionKeyHash {
+		size_t operator()(const std::array<uint32_t, 3>& key) const {
+			return (static_cast<size_t>(key[0]) * 73856093u) ^ (static_cast<size_t>(key[1]) * 19349663u) ^ (static_cast<size_t>(key[2]) * 83492791u);
+		}
+	};
+
+	// 縮約の候補（from の位置を to へ寄せる）
+	struct Collapse {
+		uint32_t from;
+		uint32_t to;
+		double cost;
+	};
+
+} // namespace
+
+///************************* 簡略化 *************************///
+
+/// <summary>
+/// メッシュの大きさ
+/// </summary>
+float MeshSimplifier::ComputeMeshExtent(const void* vertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t positionOffset)
+{
+	if (vertexCount == 0) { return 0.0f; }
+	std::array<float, 3> min = ReadPosition(vertices, vertexStride, positionOffset, 0);
+	std::array<float, 3> max = min;
+	for (uint32_t vertex = 1; vertex < vertexCount; ++vertex) {
+		const std::array<float, 3> p = ReadPosition(vertices, vertexStride, positionOffset, vertex);
+		for (int axis = 0; axis < 3; ++axis) {
+			min[axis] = std::min(min[axis], p[axis]);
+			max[axis] = std::max(max[axis], p[axis]);
+		}
+	}
+	return std::max({ max[0] - min[0], max[1] - min[1], max[2] - min[2] });
+}
+
+/// <summary>
+/// 辺の縮約による簡略化
+/// 1回の走査で、誤差の小さい順に、周りがまだ変わっていない辺だけを縮約する。これを目標に届くまで繰り返す
+/// </summary>
+std::vector<uint32_t> MeshSimplifier::Simplify(const uint32_t* indices, size_t indexCount, const void* vertices, uint32_t vertexCount, uint32_t vertexStride,
+	size_t targetIndexCount, float targetError, const Options& options, float* resultError)
+{
+	if (resultError) { *resultError = 0.0f; }
+
+	const float extent = ComputeMeshExtent(vertices, vertexCount, vertexStride, options.positionOffset);
+	std::vector<uint32_t> result(indices, indices + indexCount / 3 * 3);
+	if (extent <= 0.0f || result.size() <= targetIndexCount) { return result; }
+
+	// 大きさを 1 にそろえた位置（誤差をメッシュの大きさに対する割合で扱う）
+	const float invExtent = 1.0f / extent;
+	std::vector<std::array<float, 3>> positions(vertexCount);
+	for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+		positions[vertex] = ReadPosition(vertices, vertexStride, options.positionOffset, vertex);
+		for (float& value : positions[vertex]) { value *= invExtent; }
+	}
+
+	//------------------------------------------------------------
+	// 同じ位置の頂点（UV や法線の継ぎ目）をまとめる
+	// 縮約は代表の頂点で考え、代表ごとに同じ位置の頂点を循環リストでたどれるようにする
+	//------------------------------------------------------------
+	std::vector<uint32_t> representatives(vertexCount);
+	std::vector<uint32_t> wedgeNext(vertexCount);
+	{
+		std::unordered_map<std::array<uint32_t, 3>, uint32_t, PositionKeyHash> uniquePositions;
+		uniquePositions.reserve(vertexCount);
+		for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+			std::array<uint32_t, 3> key;
+			std::memcpy(key.data(), positions[vertex].data(), sizeof(key));
+			auto [it, inserted] = uniquePositions.try_emplace(key, vertex);
+			representatives[vertex] = it->second;
+			if (inserted) {
+				wedgeNext[vertex] = vertex;
+			} else {
+				wedgeNext[vertex] = wedgeNext[it->second];
+				wedgeNext[it->second] = vertex;
+			}
+		}
+	}
+	const auto rep = [&](uint32_t index) { return representatives[index]; };
+
+	// 位置で見て潰れている三角形は最初に除く
+	{
+		size_t write = 0;
+		for (size_t i = 0; i < result.size(); i += 3) {
+			const uint32_t r0 = rep(result[i]), r1 = rep(result[i + 1]), r2 = rep(result[i + 2]);
+			if (r0 == r1 || r1 == r2 || r2 == r0) { continue; }
+			std::copy_n(result.begin() + i, 3, result.begin() + write);
+			write += 3;
+		}
+		result.resize(write);
+	}
+
+	//------------------------------------------------------------
+	// 開いた縁（1枚の三角形にしか使われない辺）と、3枚以上で共有される辺の頂点は動かさない
+	//------------------------------------------------------------
+	std::vector<bool> locked(vertexCount, false);
+	{
+		std::unordered_map<uint64_t, uint32_t> edgeUseCounts;
+		edgeUseCounts.reserve(result.size());
+		for (size_t i = 0; i < result.size(); i += 3) {
+			for (int k = 0; k < 3; ++k) {
+				const uint32_t a = rep(result[i + k]);
+				const uint32_t b = rep(result[i + (k + 1) % 3]);
+				++edgeUseCounts[(static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b)];
+			}
+		}
+		for (const auto& [edge, count] : edgeUseCounts) {
+			if (count != 2) {
+				locked[static_cast<uint32_t>(edge >> 32)] = true;
+				locked[static_cast<uint32_t>(edge & 0xFFFFFFFFu)] = true;
+			}
+		}
+	}
+
+	//------------------------------------------------------------
+	// 代表の頂点ごとに、周りの三角形の平面を面積で重み付けして足す
+	//------------------------------------------------------------
+	std::vector<Quadric> quadrics(vertexCount);
+	for (size_t i = 0; i < result.size(); i += 3) {
+		const uint32_t r0 = rep(result[i]), r1 = rep(result[i + 1]), r2 = rep(result[i + 2]);
+		std::array<float, 3> normal = Cross(Sub(positions[r1], positions[r0]), Sub(positions[r2], positions[r0]));
+		const float length = std::sqrt(Dot(normal, normal));
+		if (length <= 0.0f) { continue; }
+		for (float& value : normal) { value /= length; }
+		const double d = -static_cast<double>(Dot(normal, positions[r0]));
+		const double area = static_cast<double>(length) * 0.5;
+		for (uint32_t r : { r0, r1, r2 }) {
+			AddPlane(quadrics[r], normal[0], normal[1], normal[2], d, area);
+		}
+	}
+
+	// 属性の差（寄せる先の同じ位置の頂点のうち、最も近いものとの距離の二乗）
+	const auto attributeDistance = [&](uint32_t a, uint32_t b) {
+		const uint8_t* base = static_cast<const uint8_t*>(vertices) + options.attributeOffset;
+		float sum = 0.0f;
+		for (uint32_t k = 0; k < options.attributeCount; ++k) {
+			float va, vb;
+			std::memcpy(&va, base + static_cast<size_t>(a) * vertexStride + k * sizeof(float), sizeof(float));
+			std::memcpy(&vb, base + static_cast<size_t>(b) * vertexStride + k * sizeof(float), sizeof(float));
+			sum += (va - vb) * (va - vb);
+		}
+		return sum;
+	};
+	const auto nearestWedge = [&](uint32_t vertex, uint32_t target, float* distance) {
+		uint32_t best = target;
+		float bestDistance = options.attributeCount > 0 ? attributeDistance(vertex, target) : 0.0f;
+		for (uint32_t wedge = wedgeNext[target]; wedge != target && options.attributeCount > 0; wedge = wedgeNext[wedge]) {
+			const float d = attributeDistance(vertex, wedge);
+			if (d < bestDistance) {
+				bestDistance = d;
+				best = wedge;
+			}
+		}
+		if (distance) { *distance = bestDistance; }
+		return best;
+	};
+
+	const double maxCost = static_cast<double>(targetError) * static_cast<double>(targetError);
+	double usedCost = 0.0;
+	size_t triangleCount = result.size() / 3;
+	const size_t targetTriangleCount = targetIndexCount / 3;
+
+	std::vector<uint32_t> vertexRemap(vertexCount);
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+	std::vector<uint32_t> adjacency;
+	std::vector<uint64_t> edges;
+	std::vector<Collapse> collapses;
+	std::vector<bool> touched(vertexCount);
+
+	while (triangleCount > targetTriangleCount) {
+		//------------------------------------------------------------
+		// 代表の頂点 → 三角形
+		//------------------------------------------------------------
+		std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0u);
+		for (uint32_t index : result) { ++adjacencyOffsets[rep(index) + 1]; }
+		for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) { adjacencyOffsets[vertex + 1] += adjacencyOffsets[vertex]; }
+		adjacency.resize(result.size());
+		{
+			std::vector<uint32_t> cursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (size_t i = 0; i < result.size(); ++i) {
+				adjacency[cursors[rep(result[i])]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+		const auto trianglesOf = [&](uint32_t r) {
+			return std::make_pair(adjacency.data() + adjacencyOffsets[r], adjacency.data() + adjacencyOffsets[r + 1]);
+		};
+
+		//------------------------------------------------------------
+		// 辺ごとに安い向きの縮約を候補にする
+		//------------------------------------------------------------
+		edges.clear();
+		for (size_t i = 0; i < result.size(); i += 3) {
+			for (int k = 0; k < 3; ++k) {
+				const uint32_t a = rep(result[i + k]);
+				const uint32_t b = rep(result[i + (k + 1) % 3]);
+				edges.push_back((static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b));
+			}
+		}
+		std::sort(edges.begin(), edges.end());
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+		const auto collapseCost = [&](uint32_t from, uint32_t to) {
+			Quadric q = quadrics[from];
+			q += quadrics[to];
+			double cost = Evaluate(q, positions[to]);
+			if (options.attributeCount > 0) {
+				float worst = 0.0f;
+				uint32_t wedge = from;
+				do {
+					float distance = 0.0f;
+					nearestWedge(wedge, to, &distance);
+					worst = std::max(worst, distance);
+					wedge = wedgeNext[wedge];
+				} while (wedge != from);
+				cost += static_cast<double>(options.attributeWeight) * worst;
+			}
+			return cost;
+		};
+
+		collapses.clear();
+		for (uint64_t edge : edges) {
+			const uint32_t a = static_cast<uint32_t>(edge >> 32);
+			const uint32_t b = static_cast<uint32_t>(edge & 0xFFFFFFFFu);
+			const double costAB = locked[a] ? maxCost * 2.0 + 1.0 : collapseCost(a, b);
+			const double costBA = locked[b] ? maxCost * 2.0 + 1.0 : collapseCost(b, a);
+			const Collapse collapse = costAB <= costBA ? Collapse{ a, b, costAB } : Collapse{ b, a, costBA };
+			if (collapse.cost <= maxCost) {
+				collapses.push_back(collapse);
+			}
+		}
+		if (collapses.empty()) { break; }
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+		//------------------------------------------------------------
+		// 安い順に縮約（周りが変わった頂点はこの走査では触らない）
+		//------------------------------------------------------------
+		std::iota(vertexRemap.begin(), vertexRemap.end(), 0u);
+		std::fill(touched.begin(), touched.end(), false);
+		size_t applied = 0;
+		for (const Collapse& collapse : collapses) {
+			if (triangleCount <= targetTriangleCount) { break; }
+			if (touched[collapse.from] || touched[collapse.to]) { continue; }
+
+			// 寄せたときに裏返る・潰れる三角形があれば縮約しない
+			const auto [begin, end] = trianglesOf(collapse.from);
+			bool flips = false;
+			size_t removed = 0;
+			for (const uint32_t* it = begin; it != end && !flips; ++it) {
+				const size_t t = static_cast<size_t>(*it) * 3;
+				const uint32_t r[3] = { rep(result[t]), rep(result[t + 1]), rep(result[t + 2]) };
+				if (r[0] == collapse.to || r[1] == collapse.to || r[2] == collapse.to) {
+					++removed;
+					continue;
+				}
+				std::array<float, 3> moved[3] = { positions[r[0]], positions[r[1]], positions[r[2]] };
+				const std::array<float, 3> before = Cross(Sub(moved[1], moved[0]), Sub(moved[2], moved[0]));
+				for (int k = 0; k < 3; ++k) {
+					if (r[k] == collapse.from) { moved[k] = positions[collapse.to]; }
+				}
+				const std::array<float, 3> after = Cross(Sub(moved[1], moved[0]), Sub(moved[2], moved[0]));
+				const float lengths = std::sqrt(Dot(before, before) * Dot(after, after));
+				flips = lengths <= 0.0f || Dot(before, after) < 0.25f * lengths;
+			}
+			if (flips) { continue; }
+
+			// 同じ位置の頂点をすべて、寄せる先の属性の近い頂点へつなぐ
+			uint32_t wedge = collapse.from;
+			do {
+				vertexRemap[wedge] = nearestWedge(wedge, collapse.to, nullptr);
+				wedge = wedgeNext[wedge];
+			} while (wedge != collapse.from);
+			quadrics[collapse.to] += quadrics[collapse.from];
+
+			for (const uint32_t* it = begin; it != end; ++it) {
+				const size_t t = static_cast<size_t>(*it) * 3;
+				for (int k = 0; k < 3; ++k) { touched[rep(result[t + k])] = true; }
+			}
+			triangleCount -= removed;
+			usedCost = std::max(usedCost, collapse.cost);
+			++applied;
+		}
+		if (applied == 0) { break; }
+
+		// インデックスを付け替え、潰れた三角形を除く
+		size_t write = 0;
+		for (size_t i = 0; i < result.size(); i += 3) {
+			const uint32_t v0 = vertexRemap[result[i]], v1 = vertexRemap[result[i + 1]], v2 = vertexRemap[result[i + 2]];
+			if (rep(v0) == rep(v1) || rep(v1) == rep(v2) || rep(v2) == rep(v0)) { continue; }
+			result[write++] = v0;
+			result[write++] = v1;
+			result[write++] = v2;
+		}
+		result.resize(write);
+		triangleCount = result.size() / 3;
+	}
+
+	if (resultError) { *resultError = static_cast<float>(std::sqrt(usedCost)) * extent; }
+	return result;
+}
+
+///************************* LOD *************************///
+
+/// <summary>
+/// 段ごとに簡略化して LOD を作る
+/// </summary>
+std::vector<MeshSimplifier::Lod> MeshSimplifier::GenerateLods(const std::vector<uint32_t>& indices, const void* vertices, uint32_t vertexCount, uint32_t vertexStride,
+	const LodOptions& options)
+{
+	std::vector<Lod> lods;
+	const float extent = ComputeMeshExtent(vertices, vertexCount, vertexStride, options.simplify.positionOffset);
+	if (extent <= 0.0f) { return lods; }
+
+	const size_t errorLevelCount = std::size(options.maxErrorPerLevel);
+	for (uint32_t level = 0; level < options.maxLodCount; ++level) {
+		const std::vector<uint32_t>& source = lods.empty() ? indices : lods.back().indices;
+		const size_t sourceTriangles = source.size() / 3;
+		const size_t targetIndexCount = static_cast<size_t>(static_cast<float>(sourceTriangles) * options.reductionPerLevel) * 3;
+		const float maxError = options.maxErrorPerLevel[std::min<size_t>(level, errorLevelCount - 1)];
+
+		float error = 0.0f;
+		std::vector<uint32_t> simplified = Simplify(source.data(), source.size(), vertices, vertexCount, vertexStride,
+			targetIndexCount, maxError, options.simplify, &error);
+
+		// ほとんど減らなければ、それ以上の段は作らない
+		if (simplified.empty() || static_cast<float>(simplified.size()) > static_cast<float>(source.size()) * options.minReduction) {
+			break;
+		}
+
+		MeshOptimizer::OptimizeVertexCache(simplified.data(), simplified.size(), vertexCount);
+
+		// 前の段からの誤差を足していく（元のメッシュからのずれの上限）
+		const float previousError = lods.empty() ? 0.0f : lods.back().error;
+		lods.push_back({ std::move(simplified), previousError + error });
+	}
+	return lods;
+}
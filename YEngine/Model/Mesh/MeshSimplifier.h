@@ -0,0 +1,53 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/// <summary>
+/// 二次誤差（QEM）による辺の縮約でメッシュを簡略化し、LOD を作る
+/// 頂点は動かさず、端点の一方へ寄せる縮約（half-edge collapse）だけを行うので、
+/// どの LOD も元の頂点バッファをそのまま使い、インデックスだけが別になる
+/// 穴が開かないよう開いた縁の頂点は動かさない。UV や法線の継ぎ目は、寄せる先の同じ位置にある頂点のうち属性の近いものへつなぐ
+/// 頂点は stride バイトの塊として扱い、位置（float3）と属性（float の並び）だけを読む
+/// </summary>
+namespace MeshSimplifier {
+
+	// 簡略化の設定
+	struct Options {
+		uint32_t positionOffset = 0;		// 頂点内の位置（float3）のバイトオフセット
+		uint32_t attributeOffset = 0;		// 頂点内の属性（UV・法線など）のバイトオフセット
+		uint32_t attributeCount = 0;		// 属性の float の数（0 なら位置だけで判定する）
+		float attributeWeight = 1e-3f;		// 属性の差を誤差に足すときの重み
+	};
+
+	// LOD の作り方
+	struct LodOptions {
+		Options simplify;
+		uint32_t maxLodCount = 3;						// 作る LOD の数（元のメッシュは含まない）
+		float reductionPerLevel = 0.5f;					// 1段ごとの三角形数の目標（前の段に対する割合）
+		float maxErrorPerLevel[3] = { 0.01f, 0.03f, 0.08f };	// 段ごとに許す誤差（メッシュの大きさに対する割合）
+		float minReduction = 0.8f;						// 前の段よりこの割合以上残るなら、それ以上は作らない
+	};
+
+	// 1段分の LOD
+	struct Lod {
+		std::vector<uint32_t> indices;
+		float error = 0.0f;		// 元のメッシュからのずれ（位置と同じ単位）
+	};
+
+	// 三角形を targetIndexCount 個以下のインデックスになるまで、誤差が targetError（メッシュの大きさに対する割合）を
+	// 超えない範囲で減らす。resultError には実際の誤差（位置と同じ単位）が入る
+	std::vector<uint32_t> Simplify(const uint32_t* indices, size_t indexCount, const void* vertices, uint32_t vertexCount, uint32_t vertexStride,
+		size_t targetIndexCount, float targetError, const Options& options = {}, float* resultError = nullptr);
+
+	// 段ごとに Simplify をかけて LOD を作る（各段は頂点キャッシュ向けに並べ替え済み）
+	// 誤差は段が進むほど大きくなる（前の段の結果から簡略化するため）
+	std::vector<Lod> GenerateLods(const std::vector<uint32_t>& indices, const void* vertices, uint32_t vertexCount, uint32_t vertexStride,
+		const LodOptions& options = {});
+
+	// メッシュの大きさ（位置の AABB の最長辺。誤差の割合の基準）
+	float ComputeMeshExtent(const void* vertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t positionOffset = 0);
+
+} // namespace MeshSimplifier
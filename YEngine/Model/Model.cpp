@@ -13,6 +13,9 @@
 #include <Debugger/Logger.h>
 #include <json.hpp>
 #include "Debugger/DebugConsole.h"
+#include "Frustum.h"
+#include "Mesh/MeshOptimizer.h"
+#include "Mesh/MeshSimplifier.h"
 
 // C++
 #include <fstream>
@@ -20,6 +23,9 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <format>
+#include <cstring>
+#include <cstddef>
 
 
 // assimp
@@ -36,19 +42,29 @@ const std::string Model::binPath = "Resources/Binary/";
 std::unordered_map<std::string, Motion> Model::animationCache_;
 std::list<std::string> Model::cacheOrder_;
 std::unordered_map<std::string, std::list<std::string>::iterator> Model::cacheIterators_;
+std::mutex Model::cacheMutex_;
 
 
-void Model::Initialize(ModelCommon* modelCommon, const std::string& directorypath, const std::string& filename, const std::string& animationName, bool isMotion)
+bool Model::Initialize(ModelCommon* modelCommon, const std::string& directorypath, const std::string& filename, const std::string& animationName, bool isMotion)
+{
+	if (!LoadFromFile(modelCommon, directorypath, filename, animationName, isMotion)) {
+		return false;
+	}
+	CreateResources();
+	return true;
+}
+
+bool Model::LoadFromFile(ModelCommon* modelCommon, const std::string& directorypath, const std::string& filename, const std::string& animationName, bool isMotion)
 {
 
 	isMotion_ = isMotion;
 	// 引数から受け取ってメンバ変数に記録する
 	modelCommon_ = modelCommon;
 
-	srvManager_ = SrvManager::GetInstance();
-
 	// モデル読み込み
-	LoadModelIndexFile(directorypath, filename);
+	if (!LoadModelIndexFile(directorypath, filename)) {
+		return false;
+	}
 
 	motionSystem_ = std::make_unique<MotionSystem>();
 
@@ -56,92 +72,91 @@ void Model::Initialize(ModelCommon* modelCommon, const std::string& directorypat
 	if (isMotion_) {
 		LoadMotionFile(directorypath, filename, animationName);
 
-
 		if (hasBones_) {
 			// 骨の作成
 			skeleton_ = std::make_unique<Skeleton>();
 			skeleton_->Create(*rootNode_);
-			size_t totalVertexCount = 0;
-			for (const auto& mesh : meshes_) {
-				totalVertexCount += mesh->GetVertexCount();
-			}
+		}
+	}
+	return true;
+}
 
-			skinCluster_->CreateResourceCS(skeleton_->GetJoints().size(), totalVertexCount, skeleton_->GetJointMap());
-			std::vector<SkinCluster::Vertex> allVertices;
-			for (size_t meshIndex = 0; meshIndex < meshes_.size(); ++meshIndex) {
-				const auto& meshData = meshes_[meshIndex]->GetMeshData();
-				for (const auto& v : meshData.vertices) {
-					SkinCluster::Vertex vertex;
-					vertex.position = v.position;
-					vertex.normal = v.normal;
-					vertex.texcoord = v.texcoord;
-					allVertices.push_back(vertex);
-				}
-			}
-			skinCluster_->SetInputVertices(allVertices);
+void Model::CreateResources()
+{
+	srvManager_ = SrvManager::GetInstance();
 
+	// 頂点・インデックスの転送
+	TransferMeshes();
 
+	// マテリアル（テクスチャは非同期で読み込み、終わるまではプレースホルダー）
+	for (size_t materialIndex = 0; materialIndex < materials_.size(); ++materialIndex) {
+		materials_[materialIndex]->Initialize(materialTexturePaths_[materialIndex]);
+	}
+	materialTexturePaths_.clear();
 
-			motionSystem_->Initialize(motion_, *skeleton_, *skinCluster_, rootNode_.get());
+	if (!isMotion_) { return; }
 
-		} else {
-			motionSystem_->Initialize(motion_, rootNode_.get());
+	if (hasBones_) {
+		size_t totalVertexCount = 0;
+		for (const auto& mesh : meshes_) {
+			totalVertexCount += mesh->GetVertexCount();
 		}
+
+		skinCluster_->CreateResourceCS(skeleton_->GetJoints().size(), totalVertexCount, skeleton_->GetJointMap());
+		std::vector<SkinCluster::Vertex> allVertices;
+		for (size_t meshIndex = 0; meshIndex < meshes_.size(); ++meshIndex) {
+			const auto& meshData = meshes_[meshIndex]->GetMeshData();
+			for (const auto& v : meshData.vertices) {
+				SkinCluster::Vertex vertex;
+				vertex.position = v.position;
+				vertex.normal = v.normal;
+				vertex.texcoord = v.texcoord;
+				allVertices.push_back(vertex);
+			}
+		}
+		skinCluster_->SetInputVertices(allVertices);
+
+
+
+		motionSystem_->Initialize(motion_, *skeleton_, *skinCluster_, rootNode_.get());
+
+	} else {
+		motionSystem_->Initialize(motion_, rootNode_.get());
 	}
 }
 
 void Model::UpdateAnimation()
 {
 	if (!motionSystem_) return;
+
+	// 前フレームで読み戻した GPU スキニング結果があれば検証
+	if (skinCluster_) {
+		skinCluster_->VerifyReadback();
+	}
 	motionSystem_->Update(YoRigine::GameTime::GetDeltaTime());
 
 
-	if (!motionSystem_->IsFinished()) {
+	if (!motionSystem_->IsFinished() || motionSystem_->HasBlendTree()) {
 		motionSystem_->Apply();
 	}
 }
 
-void Model::Draw() {
+void Model::Draw(uint32_t lod) {
 	auto commandList = modelCommon_->GetDxCommon()->GetCommandList().Get();
 
-	if (hasBones_) {
-
-		YoRigine::DirectXCommon::GetInstance()->TransitionBarrier(
-			skinCluster_->GetOutputResource(),
-			D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER,
-			D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
-
-		skinCluster_->ExecuteSkinningCS();
-		commandList->SetPipelineState(
-			PipelineManager::GetInstance()->GetPipeLineStateObject("Object"));
-		commandList->SetGraphicsRootSignature(
-			PipelineManager::GetInstance()->GetRootSignature("Object"));
-
-		YoRigine::DirectXCommon::GetInstance()->TransitionBarrier(
-			skinCluster_->GetOutputResource(),
-			D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-			D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
-	} else {
-		commandList->SetPipelineState(PipelineManager::GetInstance()->GetPipeLineStateObject("Object"));
-		commandList->SetGraphicsRootSignature(PipelineManager::GetInstance()->GetRootSignature("Object"));
+	// メッシュごとのバッファには LOD 0 しか置いていない
+	if (!meshAllocation_.IsValid()) {
+		lod = 0;
 	}
 
+	if (hasBones_) {
+		DispatchSkinning();
+	}
+	commandList->SetPipelineState(PipelineManager::GetInstance()->GetPipeLineStateObject("Object"));
+	commandList->SetGraphicsRootSignature(PipelineManager::GetInstance()->GetRootSignature("Object"));
 
 
 
-	/*=================================================================
-
-							 オフセットの計算
-
-	=================================================================*/
-
-	std::vector<size_t> vertexOffsets(meshes_.size());
-	size_t accumulatedVertexOffset = 0;
-	for (size_t i = 0; i < meshes_.size(); ++i) {
-		vertexOffsets[i] = accumulatedVertexOffset;
-		accumulatedVertexOffset += meshes_[i]->GetVertexCount();
-	}
-
 
 	/*=================================================================
 
@@ -151,6 +166,8 @@ void Model::Draw() {
 
 	auto shadowHandle = YoRigine::DirectXCommon::GetInstance()->GetShadowDepthGPUHandle();
 	commandList->SetGraphicsRootDescriptorTable(11, shadowHandle);
+	BindMeshBuffers(commandList);
+	bool isSkinBound = false;
 	for (size_t i = 0; i < meshes_.size(); ++i) {
 		auto& mesh = meshes_[i];
 		materials_[mesh->GetMaterialIndex()]->RecordDrawCommands(commandList, 9, 2);
@@ -160,64 +177,170 @@ void Model::Draw() {
 			commandList->SetGraphicsRootDescriptorTable(10, envHandle);
 		}
 
-		if (mesh->HasBones()) {
-			mesh->RecordDrawCommands(commandList, *skinCluster_);
-			commandList->DrawIndexedInstanced(mesh->GetIndexCount(), 1, 0, static_cast<INT>(vertexOffsets[i]), 0);
-		} else {
-			mesh->RecordDrawCommands(commandList);
-			commandList->DrawIndexedInstanced(mesh->GetIndexCount(), 1, 0, 0, 0);
-		}
+		RecordMeshDraw(commandList, i, lod, isSkinBound);
 
 #ifdef USE_IMGUI
-		DebugConsole::GetInstance()->RecordDrawCall(mesh->GetIndexCount(), 1);
+		DebugConsole::GetInstance()->RecordDrawCall(static_cast<uint32_t>(mesh->GetLodIndices(lod).size()), 1);
 #endif // _DEBUG
 	}
 }
 
-void Model::DrawShadow()
+void Model::DispatchSkinning()
 {
+	if (!hasBones_ || !skinCluster_) { return; }
 
-	/*=================================================================
+	YoRigine::DirectXCommon::GetInstance()->TransitionBarrier(
+		skinCluster_->GetOutputResource(),
+		D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER,
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 
-						 オフセットの計算
+	skinCluster_->ExecuteSkinningCS();
 
-	=================================================================*/
-
-	std::vector<size_t> vertexOffsets(meshes_.size());
-	size_t accumulatedVertexOffset = 0;
-	for (size_t i = 0; i < meshes_.size(); ++i) {
-		vertexOffsets[i] = accumulatedVertexOffset;
-		accumulatedVertexOffset += meshes_[i]->GetVertexCount();
+	// 検証要求があれば GPU 出力を読み戻し用バッファへコピー
+	if (skinCluster_->IsReadbackRequested()) {
+		skinCluster_->RecordReadback();
 	}
+
+	YoRigine::DirectXCommon::GetInstance()->TransitionBarrier(
+		skinCluster_->GetOutputResource(),
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+		D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+}
+
+void Model::DrawShadow(uint32_t lod)
+{
 	auto commandList = modelCommon_->GetDxCommon()->GetCommandList().Get();
+	if (!meshAllocation_.IsValid()) {
+		lod = 0;
+	}
+
 	// DrawCalls
-	for (size_t i = 0; i < meshes_.size(); ++i)
-	{
-		auto& mesh = meshes_[i];
+	BindMeshBuffers(commandList);
+	bool isSkinBound = false;
+	for (size_t i = 0; i < meshes_.size(); ++i) {
+		RecordMeshDraw(commandList, i, lod, isSkinBound);
+	}
+}
+
+/// <summary>
+/// 全メッシュの頂点・インデックスを共有バッファへまとめて書き込む
+/// </summary>
+void Model::TransferMeshes()
+{
+	// 各メッシュの先頭（ボーンありの描画でもスキニング結果の並びとして使う）
+	// インデックスはメッシュごとに LOD 0, 1, ... の順に並べる（どの LOD も同じ頂点を使う）
+	meshVertexStarts_.resize(meshes_.size());
+	meshIndexStarts_.resize(meshes_.size());
+	uint32_t totalVertexCount = 0;
+	uint32_t totalIndexCount = 0;
+	for (size_t i = 0; i < meshes_.size(); ++i) {
+		meshVertexStarts_[i] = totalVertexCount;
+		totalVertexCount += meshes_[i]->GetVertexCount();
+		meshIndexStarts_[i].resize(meshes_[i]->GetLodCount());
+		for (uint32_t lod = 0; lod < meshes_[i]->GetLodCount(); ++lod) {
+			meshIndexStarts_[i][lod] = totalIndexCount;
+			totalIndexCount += static_cast<uint32_t>(meshes_[i]->GetLodIndices(lod).size());
+		}
+	}
+
+	// 1区間にまとめる（インデックスはメッシュ内のままで、描画時に baseVertex で足す）
+	std::vector<Mesh::VertexData> vertices;
+	std::vector<uint32_t> indices;
+	vertices.reserve(totalVertexCount);
+	indices.reserve(totalIndexCount);
+	for (const auto& mesh : meshes_) {
+		const Mesh::MeshData& meshData = mesh->GetMeshData();
+		vertices.insert(vertices.end(), meshData.vertices.begin(), meshData.vertices.end());
+		for (uint32_t lod = 0; lod < mesh->GetLodCount(); ++lod) {
+			const std::vector<uint32_t>& lodIndices = mesh->GetLodIndices(lod);
+			indices.insert(indices.end(), lodIndices.begin(), lodIndices.end());
+		}
+	}
+
+	MeshBufferArena* arena = modelCommon_->GetDxCommon()->GetMeshBufferArena();
+	if (arena) {
+		meshAllocation_ = arena->Allocate(vertices.data(), totalVertexCount, indices.data(), totalIndexCount);
+	}
+	if (meshAllocation_.IsValid()) { return; }
+
+	// 共有バッファに入らなければメッシュごとにバッファを作る
+	for (const auto& mesh : meshes_) {
+		mesh->TransferData();
+	}
+}
+
+/// <summary>
+/// 共有バッファを張る
+/// </summary>
+void Model::BindMeshBuffers(ID3D12GraphicsCommandList* commandList)
+{
+	if (!meshAllocation_.IsValid()) { return; }
 
-		// ボーンあり（Skinning）
+	MeshBufferArena* arena = modelCommon_->GetDxCommon()->GetMeshBufferArena();
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandList->IASetVertexBuffers(0, 1, &arena->GetVertexBufferView());
+	commandList->IASetIndexBuffer(&arena->GetIndexBufferView());
+}
+
+/// <summary>
+/// メッシュ1つ分の描画
+/// </summary>
+void Model::RecordMeshDraw(ID3D12GraphicsCommandList* commandList, size_t meshIndex, uint32_t lod, bool& isSkinBound)
+{
+	const auto& mesh = meshes_[meshIndex];
+
+	// メッシュごとのバッファ
+	if (!meshAllocation_.IsValid()) {
 		if (mesh->HasBones()) {
 			mesh->RecordDrawCommands(commandList, *skinCluster_);
-			commandList->DrawIndexedInstanced(mesh->GetIndexCount(), 1, 0, static_cast<INT>(vertexOffsets[i]), 0);
+			commandList->DrawIndexedInstanced(mesh->GetIndexCount(), 1, 0, static_cast<INT>(meshVertexStarts_[meshIndex]), 0);
 		} else {
-			// ボーンなし
 			mesh->RecordDrawCommands(commandList);
 			commandList->DrawIndexedInstanced(mesh->GetIndexCount(), 1, 0, 0, 0);
 		}
+		return;
 	}
 
-
+	// 共有バッファ（インデックスは共有のまま、ボーンありは頂点だけスキニング結果に張り替える）
+	// LOD が足りないメッシュは最も粗い段を描く
+	lod = (std::min)(lod, mesh->GetLodCount() - 1);
+	const UINT firstIndex = meshAllocation_.GetFirstIndex() + meshIndexStarts_[meshIndex][lod];
+	const UINT indexCount = static_cast<UINT>(mesh->GetLodIndices(lod).size());
+	if (mesh->HasBones()) {
+		if (!isSkinBound) {
+			D3D12_VERTEX_BUFFER_VIEW vbv = skinCluster_->GetOutputBufferView();
+			commandList->IASetVertexBuffers(0, 1, &vbv);
+			isSkinBound = true;
+		}
+		commandList->DrawIndexedInstanced(indexCount, 1, firstIndex, static_cast<INT>(meshVertexStarts_[meshIndex]), 0);
+	} else {
+		if (isSkinBound) {
+			commandList->IASetVertexBuffers(0, 1, &modelCommon_->GetDxCommon()->GetMeshBufferArena()->GetVertexBufferView());
+			isSkinBound = false;
+		}
+		const INT baseVertex = static_cast<INT>(meshAllocation_.GetBaseVertex() + meshVertexStarts_[meshIndex]);
+		commandList->DrawIndexedInstanced(indexCount, 1, firstIndex, baseVertex, 0);
+	}
 }
 
+bool Model::LoadModelIndexFile(const std::string& directoryPath, const std::string& filename)
+{
+	std::string filePath = directoryPath + "/" + filename;
 
+	// 変換済みのバイナリがあれば assimp を通さずに読む
+	const ModelBinary::SourceStamp stamp = ModelBinary::GetSourceStamp(filePath);
+	const std::filesystem::path binaryPath = ModelBinary::MakeBinaryPath(filePath, binPath);
+	if (stamp.fileSize != 0 && LoadModelBinary(binaryPath, stamp)) {
+		return true;
+	}
 
-void Model::LoadModelIndexFile(const std::string& directoryPath, const std::string& filename)
-{
 	// ファイル読み込み
 	Assimp::Importer importer;
-	std::string filePath = directoryPath + "/" + filename;
 	const aiScene* scene = importer.ReadFile(filePath.c_str(), aiProcess_FlipWindingOrder | aiProcess_FlipUVs);
-	assert(scene->HasMeshes());
+	if (!scene || !scene->HasMeshes()) {
+		Logger("モデルを読み込めませんでした: " + filePath + " (" + importer.GetErrorString() + ")\n");
+		return false;
+	}
 	LoadNode(scene);
 	hasBones_ = HasBones(scene);
 	LoadMesh(scene);
@@ -225,28 +348,251 @@ void Model::LoadModelIndexFile(const std::string& directoryPath, const std::stri
 	if (hasBones_) {
 		LoadSkinCluster(scene);
 	}
+	OptimizeMeshes(filePath);
+	GenerateLods(filePath);
+	ComputeBounds();
+	ComputeLodErrors();
+
+	// 次回からは assimp を通さない
+	if (stamp.fileSize != 0 && !SaveModelBinary(binaryPath, stamp)) {
+		Logger("モデルのバイナリを書き出せませんでした: " + binaryPath.string() + "\n");
+	}
+	return true;
+}
+
+namespace {
+
+	// ノードは親から順に（名前・SRT・ローカル行列・子の数）
+	void WriteNodeBinary(ModelBinary::Writer& writer, const Node& node) {
+		writer.WriteString(node.name_);
+		writer.Write(node.transform_);
+		writer.Write(node.localMatrix_);
+		writer.Write(static_cast<uint32_t>(node.children_.size()));
+		for (const Node& child : node.children_) {
+			WriteNodeBinary(writer, child);
+		}
+	}
+
+	bool ReadNodeBinary(ModelBinary::Reader& reader, Node& node) {
+		uint32_t childCount = 0;
+		if (!reader.ReadString(node.name_) || !reader.Read(node.transform_) ||
+			!reader.Read(node.localMatrix_) || !reader.Read(childCount)) {
+			return false;
+		}
+		node.children_.resize(childCount);
+		for (Node& child : node.children_) {
+			if (!ReadNodeBinary(reader, child)) { return false; }
+		}
+		return true;
+	}
+
+} // namespace
+
+bool Model::SaveModelBinary(const std::filesystem::path& path, const ModelBinary::SourceStamp& stamp) const
+{
+	ModelBinary::Writer writer;
+	writer.WriteHeader(sizeof(Mesh::VertexData), stamp);
+	writer.Write(static_cast<uint32_t>(hasBones_ ? 1 : 0));
+
+	// ノード
+	WriteNodeBinary(writer, *rootNode_);
+
+	// メッシュ（頂点・インデックスはそれぞれ連続したブロック）
+	writer.Write(static_cast<uint32_t>(meshes_.size()));
+	for (const auto& mesh : meshes_) {
+		const Mesh::MeshData& meshData = mesh->GetMeshData();
+		writer.Write(meshData.materialIndex);
+		writer.Write(static_cast<uint32_t>(mesh->HasBones() ? 1 : 0));
+		writer.WriteArray(meshData.vertices);
+		writer.WriteArray(meshData.indices);
+		writer.Write(static_cast<uint32_t>(meshData.lods.size()));
+		for (const Mesh::Lod& lod : meshData.lods) {
+			writer.Write(lod.error);
+			writer.WriteArray(lod.indices);
+		}
+	}
+
+	// マテリアル（テクスチャはパスだけ）
+	writer.Write(static_cast<uint32_t>(materials_.size()));
+	for (size_t materialIndex = 0; materialIndex < materials_.size(); ++materialIndex) {
+		const Material& material = *materials_[materialIndex];
+		writer.Write(material.GetKd());
+		writer.Write(material.GetKa());
+		writer.Write(material.GetKs());
+		writer.Write(material.GetNi());
+		writer.Write(material.GetIllum());
+		writer.WriteString(materialTexturePaths_[materialIndex]);
+	}
+
+	// スキン（メッシュごとにジョイント名・逆バインドポーズ・ウェイト）
+	if (hasBones_) {
+		const auto& allMeshJointData = skinCluster_->GetSkinClusterDataPerMesh();
+		const auto& meshVertexCounts = skinCluster_->GetMeshVertexCounts();
+		writer.Write(static_cast<uint32_t>(allMeshJointData.size()));
+		for (size_t meshIndex = 0; meshIndex < allMeshJointData.size(); ++meshIndex) {
+			writer.Write(static_cast<uint64_t>(meshVertexCounts[meshIndex]));
+			writer.Write(static_cast<uint32_t>(allMeshJointData[meshIndex].size()));
+			for (const auto& [jointName, jointWeightData] : allMeshJointData[meshIndex]) {
+				writer.WriteString(jointName);
+				writer.Write(jointWeightData.inverseBindPoseMatrix);
+				writer.WriteArray(jointWeightData.vertexWeights);
+			}
+		}
+	}
+
+	return writer.SaveToFile(path);
+}
+
+bool Model::LoadModelBinary(const std::filesystem::path& path, const ModelBinary::SourceStamp& stamp)
+{
+	ModelBinary::Reader reader;
+	if (!reader.LoadFromFile(path) || !reader.ReadHeader(sizeof(Mesh::VertexData), stamp)) {
+		return false;
+	}
+
+	// 途中で失敗しても中途半端な状態にしないよう、全部読めてからメンバへ移す
+	uint32_t hasBones = 0;
+	reader.Read(hasBones);
+
+	auto rootNode = std::make_unique<Node>();
+	if (!ReadNodeBinary(reader, *rootNode)) { return false; }
+
+	uint32_t meshCount = 0;
+	reader.Read(meshCount);
+	std::vector<std::unique_ptr<Mesh>> meshes;
+	for (uint32_t meshIndex = 0; meshIndex < meshCount && reader.IsValid(); ++meshIndex) {
+		auto mesh = std::make_unique<Mesh>();
+		mesh->Initialize();
+		Mesh::MeshData& meshData = mesh->GetMeshData();
+		uint32_t meshHasBones = 0;
+		reader.Read(meshData.materialIndex);
+		reader.Read(meshHasBones);
+		reader.ReadArray(meshData.vertices);
+		reader.ReadArray(meshData.indices);
+		uint32_t lodCount = 0;
+		reader.Read(lodCount);
+		for (uint32_t lodIndex = 0; lodIndex < lodCount && reader.IsValid(); ++lodIndex) {
+			Mesh::Lod& lod = meshData.lods.emplace_back();
+			reader.Read(lod.error);
+			reader.ReadArray(lod.indices);
+		}
+		mesh->SetHasBones(meshHasBones != 0);
+		mesh->SetMaterialIndex(meshData.materialIndex);
+		mesh->ComputeBounds();
+		meshes.push_back(std::move(mesh));
+	}
+
+	uint32_t materialCount = 0;
+	reader.Read(materialCount);
+	std::vector<std::unique_ptr<Material>> materials;
+	std::vector<std::string> materialTexturePaths(materialCount);
+	for (uint32_t materialIndex = 0; materialIndex < materialCount && reader.IsValid(); ++materialIndex) {
+		auto material = std::make_unique<Material>();
+		Vector3 kd, ka, ks;
+		float ni = 1.0f;
+		uint32_t illum = 0;
+		reader.Read(kd);
+		reader.Read(ka);
+		reader.Read(ks);
+		reader.Read(ni);
+		reader.Read(illum);
+		reader.ReadString(materialTexturePaths[materialIndex]);
+		material->SetKd(kd);
+		material->SetKa(ka);
+		material->SetKs(ks);
+		material->SetNi(ni);
+		material->SetIllum(illum);
+		materials.push_back(std::move(material));
+	}
+
+	std::unique_ptr<SkinCluster> skinCluster;
+	if (hasBones != 0) {
+		uint32_t skinMeshCount = 0;
+		reader.Read(skinMeshCount);
+		std::vector<std::map<std::string, SkinCluster::JointWeightData>> allMeshJointData(skinMeshCount);
+		std::vector<size_t> meshVertexCounts(skinMeshCount);
+		for (uint32_t meshIndex = 0; meshIndex < skinMeshCount && reader.IsValid(); ++meshIndex) {
+			uint64_t vertexCount = 0;
+			uint32_t jointCount = 0;
+			reader.Read(vertexCount);
+			reader.Read(jointCount);
+			meshVertexCounts[meshIndex] = static_cast<size_t>(vertexCount);
+			for (uint32_t jointIndex = 0; jointIndex < jointCount && reader.IsValid(); ++jointIndex) {
+				std::string jointName;
+				reader.ReadString(jointName);
+				SkinCluster::JointWeightData& jointWeightData = allMeshJointData[meshIndex][jointName];
+				reader.Read(jointWeightData.inverseBindPoseMatrix);
+				reader.ReadArray(jointWeightData.vertexWeights);
+			}
+		}
+		skinCluster = std::make_unique<SkinCluster>();
+		skinCluster->SetSkinClusterDataPerMesh(allMeshJointData);
+		skinCluster->SetMeshVertexCounts(meshVertexCounts);
+	}
+
+	if (!reader.IsValid()) {
+		return false;
+	}
+
+	rootNode_ = std::move(rootNode);
+	hasBones_ = hasBones != 0;
+	meshes_ = std::move(meshes);
+	materials_ = std::move(materials);
+	materialTexturePaths_ = std::move(materialTexturePaths);
+	skinCluster_ = std::move(skinCluster);
+	ComputeBounds();
+	ComputeLodErrors();
+	return true;
 }
 
 void Model::LoadMotionFile(const std::string& directoryPath, const std::string& filename, const std::string& animationName) {
+	motion_ = LoadMotion(directoryPath, filename, animationName);
+}
+
+Motion Model::LoadMotion(const std::string& directoryPath, const std::string& filename, const std::string& animationName) {
 	std::string fullPath = directoryPath + "/" + filename;
 
 	// キャッシュキー（GLTF + アニメ名）
 	std::string cacheKey = fullPath + "#" + animationName;
-	if (animationCache_.contains(cacheKey)) {
-		motion_ = animationCache_.at(cacheKey);
-		AddToCache(cacheKey, motion_);
-		return;
+	{
+		// 非同期読み込みのワーカーからも呼ばれる
+		std::lock_guard<std::mutex> lock(cacheMutex_);
+		if (animationCache_.contains(cacheKey)) {
+			Motion motion = animationCache_.at(cacheKey);
+			AddToCache(cacheKey, motion);
+			return motion;
+		}
 	}
 
 	// バイナリの保存パス（新方式：個別アニメファイル）
 	std::filesystem::path fileStem = std::filesystem::path(filename).stem(); // 例: "Player"
 	std::string binFile = binPath + fileStem.string() + "_" + animationName + ".anim";
 
+	Motion motion;
+
+	// 保存前に冗長なキーフレームを削減
+	auto reduceKeyframes = [&]() {
+		Motion::ReductionReport report = motion.ReduceKeyframes();
+		Logger("キーフレーム削減 [" + fileStem.string() + "_" + animationName + "] : "
+			+ std::to_string(report.sourceKeyCount) + " -> " + std::to_string(report.reducedKeyCount)
+			+ " (圧縮率 " + std::to_string(report.GetCompressionRatio() * 100.0f) + "%, 定数チャンネル "
+			+ std::to_string(report.constantChannelCount) + ")\n");
+		};
+
 	// バイナリが存在していればそれを読み込む
 	if (std::filesystem::exists(binFile)) {
-		motion_ = motion_.LoadBinary(binFile);
-		animationCache_[cacheKey] = motion_;
-		return;
+		const bool isStale = Motion::ReadBinaryVersion(binFile) < Motion::kBinaryVersion;
+		motion = motion.LoadBinary(binFile);
+
+		// 削減前の旧形式なら、削減して今の形式で書き直す（GLTF から読み直す必要はない）
+		if (isStale) {
+			reduceKeyframes();
+			motion.SaveBinary(motion, animationName, binPath + fileStem.string());
+		}
+
+		std::lock_guard<std::mutex> lock(cacheMutex_);
+		animationCache_[cacheKey] = motion;
+		return motion;
 	}
 
 	// ここまで来たらGLTFから生成（初回 or バイナリ無し）
@@ -256,12 +602,15 @@ void Model::LoadMotionFile(const std::string& directoryPath, const std::string&
 		throw std::runtime_error("アニメーション読み込み失敗: " + fullPath);
 	}
 
-	motion_ = Motion::LoadFromScene(scene, fullPath, animationName);
+	motion = Motion::LoadFromScene(scene, fullPath, animationName);
+	reduceKeyframes();
 
 	// 安全なファイル名（バイナリ保存）
-	motion_.SaveBinary(motion_, animationName, binPath + fileStem.string());
+	motion.SaveBinary(motion, animationName, binPath + fileStem.string());
 
-	animationCache_[cacheKey] = motion_;
+	std::lock_guard<std::mutex> lock(cacheMutex_);
+	animationCache_[cacheKey] = motion;
+	return motion;
 }
 
 void Model::AddToCache(const std::string& key, const Motion& motion) {
@@ -283,6 +632,7 @@ void Model::AddToCache(const std::string& key, const Motion& motion) {
 
 // キャッシュクリア用の静的メソッドも追加
 void Model::ClearAnimationCache() {
+	std::lock_guard<std::mutex> lock(cacheMutex_);
 	animationCache_.clear();
 	cacheOrder_.clear();
 	cacheIterators_.clear();
@@ -291,6 +641,7 @@ void Model::ClearAnimationCache() {
 
 // デバッグ用：現在のキャッシュサイズを取得
 size_t Model::GetCacheSize() {
+	std::lock_guard<std::mutex> lock(cacheMutex_);
 	return animationCache_.size();
 }
 
@@ -316,6 +667,41 @@ bool Model::HasBones(const aiScene* scene)
 	return false;
 }
 
+void Model::ComputeBounds()
+{
+	if (meshes_.empty()) { return; }
+
+	localAABB_ = meshes_.front()->GetLocalAABB();
+	for (const auto& mesh : meshes_) {
+		localAABB_ = MergeAABB(localAABB_, mesh->GetLocalAABB());
+	}
+
+	// ボーンありはアニメーションで手足がはみ出すので、中心から広げておく
+	if (hasBones_) {
+		const Vector3 center = (localAABB_.min + localAABB_.max) * 0.5f;
+		const Vector3 extent = (localAABB_.max - localAABB_.min) * (0.5f * kSkinnedBoundsScale);
+		localAABB_ = { center - extent, center + extent };
+	}
+
+	localSphere_ = MakeBoundingSphere(localAABB_);
+}
+
+void Model::ComputeLodErrors()
+{
+	uint32_t lodCount = 1;
+	for (const auto& mesh : meshes_) {
+		lodCount = (std::max)(lodCount, mesh->GetLodCount());
+	}
+
+	// 段が足りないメッシュは最も粗い段を描くので、その誤差を使う
+	lodErrors_.assign(lodCount, 0.0f);
+	for (uint32_t lod = 1; lod < lodCount; ++lod) {
+		for (const auto& mesh : meshes_) {
+			lodErrors_[lod] = (std::max)(lodErrors_[lod], mesh->GetLodError(lod));
+		}
+	}
+}
+
 void Model::SetChangeMotion(const std::string& directoryPath, const std::string& filename, MotionPlayMode playMode, const std::string& animationName)
 {
 	// 既存のアニメーションと同じ場合はスキップ
@@ -384,6 +770,9 @@ void Model::DebugInfo()
 
 		ImGui::Text("メッシュ数: %d", static_cast<int>(meshes_.size()));
 		ImGui::Text("マテリアル数: %d", static_cast<int>(materials_.size()));
+		for (uint32_t lod = 1; lod < GetLodCount(); ++lod) {
+			ImGui::Text("LOD %u 誤差: %.4f", lod, lodErrors_[lod]);
+		}
 
 		if (skeleton_) {
 			if (ImGui::TreeNode("骨")) {
@@ -399,12 +788,63 @@ void Model::DebugInfo()
 				ImGui::TreePop(); // Skeleton
 			}
 		}
+
+		if (skinCluster_ && ImGui::TreeNode("スキニング")) {
+			ImGui::Text("頂点数: %d", static_cast<int>(skinCluster_->GetMappedInfluence().size()));
+
+			// GPU の出力を CPU スキニングと比較
+			if (ImGui::Button("GPU結果を検証")) {
+				skinCluster_->RequestReadback();
+			}
+			if (const auto& result = skinCluster_->GetLastVerification()) {
+				ImGui::Text("不一致: %d / %d", static_cast<int>(result->mismatchCount), static_cast<int>(result->vertexCount));
+				ImGui::Text("最大誤差 位置: %.6f 法線: %.6f", result->maxPositionError, result->maxNormalError);
+			}
+
+			// CPU スキニングの計測（1スレッドと全スレッド）
+			if (ImGui::Button("CPUスキニング計測")) {
+				for (uint32_t threadCount : { 1u, 0u }) {
+					CpuSkinning::BenchmarkResult result = skinCluster_->BenchmarkSkinningCPU(100, threadCount);
+					Logger("CPUスキニング計測 [" + name_ + "] 頂点 " + std::to_string(result.vertexCount)
+						+ " / スレッド " + std::to_string(result.threadCount)
+						+ " : " + std::to_string(result.averageMilliseconds) + " ms ("
+						+ std::to_string(result.GetMegaVerticesPerSecond()) + " Mverts/s)\n");
+				}
+			}
+
+			ImGui::TreePop();
+		}
 	}
 #endif // _DEBUG
 
 
 }
 
+/// <summary>
+/// マテリアルが持つテクスチャの参照を外す
+/// </summary>
+void Model::ReleaseTextures()
+{
+	for (const auto& material : materials_) {
+		material->ReleaseTexture();
+	}
+}
+
+/// <summary>
+/// 頂点・インデックス（LOD 含む）の使用量
+/// </summary>
+uint64_t Model::GetMeshMemorySize() const
+{
+	uint64_t size = 0;
+	for (const auto& mesh : meshes_) {
+		size += static_cast<uint64_t>(mesh->GetVertexCount()) * sizeof(Mesh::VertexData);
+		for (uint32_t lod = 0; lod < mesh->GetLodCount(); ++lod) {
+			size += static_cast<uint64_t>(mesh->GetLodIndices(lod).size()) * sizeof(uint32_t);
+		}
+	}
+	return size;
+}
+
 void Model::LoadMesh(const aiScene* scene)
 {
 	meshes_.resize(scene->mNumMeshes); // メッシュ数分のメモリを確保
@@ -413,7 +853,7 @@ void Model::LoadMesh(const aiScene* scene)
 		aiMesh* mesh = scene->mMeshes[meshIndex];
 		assert(mesh->HasNormals());
 		std::unique_ptr<Mesh> meshs = std::make_unique<Mesh>();
-		// 初期化（リソース確保、転送など）
+		// 初期化（リソースの確保と転送は CreateResources で行う）
 		meshs->Initialize();
 
 		if (mesh->mNumBones > 0) {
@@ -442,7 +882,8 @@ void Model::LoadMesh(const aiScene* scene)
 			}
 		}
 
-		// インデックスデータの設定
+		// インデックスデータの設定（四角形は2枚に分けるので多めに確保）
+		meshData.indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
 		for (uint32_t faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex) {
 			aiFace& face = mesh->mFaces[faceIndex];
 			if (face.mNumIndices == 4) {
@@ -473,7 +914,7 @@ void Model::LoadMesh(const aiScene* scene)
 		meshData.materialIndex = mesh->mMaterialIndex;
 
 		meshs->SetMaterialIndex(mesh->mMaterialIndex);
-		meshs->TransferData();
+		meshs->ComputeBounds();
 
 		meshes_[meshIndex] = std::move(meshs); // メッシュを格納
 	}
@@ -482,6 +923,7 @@ void Model::LoadMesh(const aiScene* scene)
 void Model::LoadMaterial(const aiScene* scene, std::string directoryPath)
 {
 	materials_.resize(scene->mNumMaterials);
+	materialTexturePaths_.resize(scene->mNumMaterials);
 
 	for (uint32_t materialIndex = 0; materialIndex < scene->mNumMaterials; ++materialIndex) {
 		aiMaterial* materialSrc = scene->mMaterials[materialIndex];
@@ -523,12 +965,11 @@ void Model::LoadMaterial(const aiScene* scene, std::string directoryPath)
 			material.SetIllum(illumModel);
 		}
 
-		if (hasTexture) {
-			material.Initialize(fullPath);
-		} else {
+		// テクスチャの読み込みとGPUリソースの生成は CreateResources で行う
+		if (!hasTexture) {
 			fullPath = "Resources/images/white.png"; // テクスチャが無い場合は白を指定
-			material.Initialize(fullPath);
 		}
+		materialTexturePaths_[materialIndex] = fullPath;
 	}
 }
 
@@ -538,6 +979,159 @@ void Model::LoadSkinCluster(const aiScene* scene)
 	skinCluster_->LoadFromScene(scene);
 }
 
+namespace {
+
+	// 頂点はバイト列で比べて結合するので、詰め物が無いこと
+	static_assert(sizeof(Mesh::VertexData) == sizeof(Vector4) + sizeof(Vector2) + sizeof(Vector3));
+
+	/// <summary>
+	/// ボーンありのメッシュの最適化
+	/// ウェイトが違う頂点まで結合しないよう、ウェイトのハッシュを頂点の後ろに付けて比べ、最後にウェイトの頂点番号を付け替える
+	/// </summary>
+	MeshOptimizer::Report OptimizeSkinnedMesh(Mesh::MeshData& meshData, std::map<std::string, SkinCluster::JointWeightData>& jointData) {
+		struct KeyedVertex {
+			Mesh::VertexData vertex;
+			uint32_t skinKey[2];
+		};
+		static_assert(sizeof(KeyedVertex) == sizeof(Mesh::VertexData) + sizeof(uint32_t) * 2);
+
+		// 頂点ごとのウェイトのハッシュ（FNV-1a。ジョイントは名前順に番号を振る）
+		std::vector<uint64_t> skinKeys(meshData.vertices.size(), 14695981039346656037ull);
+		uint32_t jointOrdinal = 0;
+		for (const auto& [jointName, joint] : jointData) {
+			for (const SkinCluster::VertexWeightData& weight : joint.vertexWeights) {
+				if (weight.vertexIndex >= skinKeys.size()) { continue; }
+				uint32_t weightBits = 0;
+				std::memcpy(&weightBits, &weight.weight, sizeof(weightBits));
+				for (uint32_t value : { jointOrdinal, weightBits }) {
+					skinKeys[weight.vertexIndex] = (skinKeys[weight.vertexIndex] ^ value) * 1099511628211ull;
+				}
+			}
+			++jointOrdinal;
+		}
+
+		std::vector<KeyedVertex> keyedVertices(meshData.vertices.size());
+		for (size_t i = 0; i < keyedVertices.size(); ++i) {
+			keyedVertices[i].vertex = meshData.vertices[i];
+			keyedVertices[i].skinKey[0] = static_cast<uint32_t>(skinKeys[i]);
+			keyedVertices[i].skinKey[1] = static_cast<uint32_t>(skinKeys[i] >> 32);
+		}
+
+		std::vector<uint32_t> remap;
+		const MeshOptimizer::Report report = MeshOptimizer::Optimize(keyedVertices, meshData.indices, {}, &remap);
+
+		meshData.vertices.resize(keyedVertices.size());
+		for (size_t i = 0; i < keyedVertices.size(); ++i) {
+			meshData.vertices[i] = keyedVertices[i].vertex;
+		}
+
+		// ウェイトの頂点番号を付け替える（結合した頂点はウェイトも同じなので1つだけ残す）
+		for (auto& [jointName, joint] : jointData) {
+			std::vector<bool> assigned(keyedVertices.size(), false);
+			std::vector<SkinCluster::VertexWeightData> remapped;
+			remapped.reserve(joint.vertexWeights.size());
+			for (const SkinCluster::VertexWeightData& weight : joint.vertexWeights) {
+				if (weight.vertexIndex >= remap.size()) { continue; }
+				const uint32_t vertexIndex = remap[weight.vertexIndex];
+				if (vertexIndex == MeshOptimizer::kUnusedVertex || assigned[vertexIndex]) { continue; }
+				assigned[vertexIndex] = true;
+				remapped.push_back({ weight.weight, vertexIndex });
+			}
+			joint.vertexWeights = std::move(remapped);
+		}
+		return report;
+	}
+
+} // namespace
+
+/// <summary>
+/// 読み込んだメッシュの最適化
+/// assimp から受け取った頂点は面の角ごとに別々なので、同じ頂点を結合してから並べ替える
+/// バイナリへ書き出す前に行うので、2回目以降の読み込みでは何もしない
+/// </summary>
+void Model::OptimizeMeshes(const std::string& filePath)
+{
+	std::vector<std::map<std::string, SkinCluster::JointWeightData>> skinData;
+	std::vector<size_t> meshVertexCounts;
+	if (skinCluster_) {
+		skinData = skinCluster_->GetSkinClusterDataPerMesh();
+		meshVertexCounts = skinCluster_->GetMeshVertexCounts();
+	}
+
+	uint64_t missesBefore = 0;
+	uint64_t missesAfter = 0;
+	uint64_t triangleCount = 0;
+	uint64_t verticesBefore = 0;
+	uint64_t verticesAfter = 0;
+	for (size_t meshIndex = 0; meshIndex < meshes_.size(); ++meshIndex) {
+		Mesh::MeshData& meshData = meshes_[meshIndex]->GetMeshData();
+
+		MeshOptimizer::Report report;
+		if (meshIndex < skinData.size() && !skinData[meshIndex].empty()) {
+			report = OptimizeSkinnedMesh(meshData, skinData[meshIndex]);
+		} else {
+			report = MeshOptimizer::Optimize(meshData.vertices, meshData.indices);
+		}
+		if (meshIndex < meshVertexCounts.size()) {
+			meshVertexCounts[meshIndex] = meshData.vertices.size();
+		}
+		meshes_[meshIndex]->ComputeBounds();
+
+		missesBefore += report.before.cacheMisses;
+		missesAfter += report.after.cacheMisses;
+		triangleCount += report.after.triangleCount;
+		verticesBefore += report.before.vertexCount;
+		verticesAfter += report.after.vertexCount;
+	}
+
+	if (skinCluster_) {
+		skinCluster_->SetSkinClusterDataPerMesh(skinData);
+		skinCluster_->SetMeshVertexCounts(meshVertexCounts);
+	}
+
+	if (triangleCount > 0) {
+		Logger(std::format("メッシュを最適化しました: {} 頂点 {} -> {}, ACMR {:.3f} -> {:.3f}\n", filePath,
+			verticesBefore, verticesAfter,
+			static_cast<double>(missesBefore) / static_cast<double>(triangleCount),
+			static_cast<double>(missesAfter) / static_cast<double>(triangleCount)));
+	}
+}
+
+/// <summary>
+/// 最適化したメッシュを簡略化して LOD を作る
+/// どの段も頂点は元のメッシュのものを使うので、ボーンありのメッシュもスキニング結果をそのまま使える
+/// </summary>
+void Model::GenerateLods(const std::string& filePath)
+{
+	// 位置（float4）の後ろの UV を継ぎ目の判定に使う。法線の違いは形の誤差に任せる
+	MeshSimplifier::LodOptions options;
+	options.simplify.positionOffset = static_cast<uint32_t>(offsetof(Mesh::VertexData, position));
+	options.simplify.attributeOffset = static_cast<uint32_t>(offsetof(Mesh::VertexData, texcoord));
+	options.simplify.attributeCount = 2;
+
+	uint64_t triangleCount = 0;
+	std::vector<uint64_t> lodTriangleCounts;
+	for (const auto& mesh : meshes_) {
+		Mesh::MeshData& meshData = mesh->GetMeshData();
+		meshData.lods.clear();
+		std::vector<MeshSimplifier::Lod> lods = MeshSimplifier::GenerateLods(meshData.indices, meshData.vertices.data(),
+			static_cast<uint32_t>(meshData.vertices.size()), sizeof(Mesh::VertexData), options);
+
+		triangleCount += meshData.indices.size() / 3;
+		lodTriangleCounts.resize((std::max)(lodTriangleCounts.size(), lods.size()));
+		for (size_t lod = 0; lod < lods.size(); ++lod) {
+			lodTriangleCounts[lod] += lods[lod].indices.size() / 3;
+			meshData.lods.push_back({ std::move(lods[lod].indices), lods[lod].error });
+		}
+	}
+
+	std::string counts = std::to_string(triangleCount);
+	for (uint64_t count : lodTriangleCounts) {
+		counts += " / " + std::to_string(count);
+	}
+	Logger(std::format("LOD を作りました: {} 三角形 {}\n", filePath, counts));
+}
+
 void Model::LoadNode(const aiScene* scene)
 {
 	rootNode_ = std::make_unique<Node>(Node::ReadNode(scene->mRootNode));
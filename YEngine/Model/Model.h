@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <unordered_map>
 #include <list>
+#include <mutex>
 
 // Engine
 #include "DirectXCommon.h"
@@ -18,6 +19,7 @@
 #include "Material/MaterialManager.h"
 #include "Mesh/Mesh.h"
 #include "Node/Node.h"
+#include "ModelBinary.h"
 
 // Math
 #include "MathFunc.h"
@@ -41,8 +43,15 @@ class Model
 public:
 	///************************* 基本関数 *************************///
 
-	// 初期化
-	void Initialize(ModelCommon* modelCommon, const std::string& directoryPath, const std::string& filename, const std::string& animationName = "", bool isMotion = false);
+	// 初期化（モデルファイルを読めなければ false）
+	bool Initialize(ModelCommon* modelCommon, const std::string& directoryPath, const std::string& filename, const std::string& animationName = "", bool isMotion = false);
+
+	// 非同期読み込み用に Initialize を2段階に分けたもの
+	// LoadFromFile：ファイル読み込みと CPU 側のデータ構築のみ（ワーカースレッドで呼べる）
+	// CreateResources：GPU リソースの生成と転送（メインスレッド）
+	// LoadFromFile が false を返したら CreateResources は呼ばない
+	bool LoadFromFile(ModelCommon* modelCommon, const std::string& directoryPath, const std::string& filename, const std::string& animationName = "", bool isMotion = false);
+	void CreateResources();
 
 	// アニメーション更新
 	void UpdateAnimation();
@@ -50,10 +59,15 @@ public:
 	// モーション変更
 	void SetChangeMotion(const std::string& directoryPath, const std::string& filename, MotionPlayMode playMode, const std::string& animationName = "");
 
-	// 描画
-	void Draw();
+	// モーションデータのみ読み込み（再生中のモーションは変更しない。ブレンドツリーのクリップ用）
+	static Motion LoadMotion(const std::string& directoryPath, const std::string& filename, const std::string& animationName = "");
+
+	// 描画（lod：0 が元のメッシュ。LOD が無いメッシュは元のまま描く）
+	void Draw(uint32_t lod = 0);
+	// スキニングだけ実行（カリングで描画しないフレームでも影用の頂点を更新する）
+	void DispatchSkinning();
 	// 影描画
-	void DrawShadow();
+	void DrawShadow(uint32_t lod = 0);
 	// ボーン描画
 	void DrawBone(Line& line, const Matrix4x4& worldMatrix);
 
@@ -66,11 +80,21 @@ public:
 	// デバッグ情報
 	void DebugInfo();
 
+	// マテリアルが持つテクスチャの参照を外す（ModelManager が解放するとき）
+	void ReleaseTextures();
+
+	// 頂点・インデックス（LOD 含む）の使用量
+	uint64_t GetMeshMemorySize() const;
+
 private:
 	///************************* 読み込み処理 *************************///
 
-	// モデルインデックス読み込み
-	void LoadModelIndexFile(const std::string& directoryPath, const std::string& filename);
+	// モデルインデックス読み込み（変換済みのバイナリがあればそちらを読む。読めなければ false）
+	bool LoadModelIndexFile(const std::string& directoryPath, const std::string& filename);
+
+	// バイナリ（*.ymdl）の書き出し・読み込み
+	bool SaveModelBinary(const std::filesystem::path& path, const ModelBinary::SourceStamp& stamp) const;
+	bool LoadModelBinary(const std::filesystem::path& path, const ModelBinary::SourceStamp& stamp);
 
 	// モーションファイル読み込み
 	void LoadMotionFile(const std::string& directoryPath, const std::string& filename, const std::string& animationName = "");
@@ -96,12 +120,36 @@ private:
 	// スキンクラスター読み込み
 	void LoadSkinCluster(const aiScene* scene);
 
+	// 読み込んだメッシュの最適化（頂点の結合、頂点キャッシュ・オーバードロー向けの並べ替え）
+	void OptimizeMeshes(const std::string& filePath);
+
+	// 最適化したメッシュを簡略化して LOD を作る
+	void GenerateLods(const std::string& filePath);
+
 	// キャッシュサイズ取得
 	static size_t GetCacheSize();
 
 	// ボーン有無確認
 	static bool HasBones(const aiScene* scene);
 
+	// 全メッシュの境界をまとめる
+	void ComputeBounds();
+
+	// モデル全体の LOD ごとの誤差をまとめる（各段で最も大きいメッシュの誤差）
+	void ComputeLodErrors();
+
+	///************************* 描画処理 *************************///
+
+	// 全メッシュの頂点・インデックスを共有バッファの1区間にまとめて書き込む（入らなければメッシュごとのバッファ）
+	void TransferMeshes();
+
+	// 共有バッファを張る（共有バッファを使っていなければ何もしない）
+	void BindMeshBuffers(ID3D12GraphicsCommandList* commandList);
+
+	// メッシュ1つ分の描画
+	// ボーンありのメッシュはスキニング結果の頂点バッファに張り替えるので、戻すかどうかを isSkinBound で受け渡す
+	void RecordMeshDraw(ID3D12GraphicsCommandList* commandList, size_t meshIndex, uint32_t lod, bool& isSkinBound);
+
 public:
 	///************************* アクセッサ *************************///
 
@@ -132,18 +180,41 @@ public:
 	// メッシュ取得
 	const std::vector<std::unique_ptr<Mesh>>& GetMeshes() const { return meshes_; }
 
+	// ローカル空間の境界（ボーンありはバインドポーズを広げたもの）
+	const AABB& GetLocalAABB() const { return localAABB_; }
+	const Sphere& GetLocalSphere() const { return localSphere_; }
+
+	// LOD の段数（元のメッシュを含む）と、各段の元のメッシュからのずれ（ローカル空間の長さ）
+	uint32_t GetLodCount() const { return static_cast<uint32_t>(lodErrors_.size()); }
+	float GetLodError(uint32_t lod) const { return lod < lodErrors_.size() ? lodErrors_[lod] : 0.0f; }
+
 private:
 	///************************* ポインタ *************************///
 
 	ModelCommon* modelCommon_;
 	std::vector<std::unique_ptr<Mesh>> meshes_;
 	std::vector<std::unique_ptr<Material>> materials_;
+	std::vector<std::string> materialTexturePaths_;	// CreateResources まで保持するテクスチャパス
 	std::unique_ptr<MotionSystem> motionSystem_;
 	std::unique_ptr<Skeleton> skeleton_;
 	std::unique_ptr<SkinCluster> skinCluster_;
 	std::unique_ptr<Node> rootNode_;
 	SrvManager* srvManager_ = nullptr;
 
+	///************************* 頂点・インデックス *************************///
+
+	// 共有バッファ上の区間と、その中での各メッシュの先頭
+	// ボーンありのメッシュはスキニング結果も同じ並びなので、meshVertexStarts_ をそのまま使う
+	// インデックスはメッシュごとに LOD 0, 1, ... の順に並べ、meshIndexStarts_[メッシュ][LOD] で引く
+	MeshBufferArena::Allocation meshAllocation_;
+	std::vector<uint32_t> meshVertexStarts_;
+	std::vector<std::vector<uint32_t>> meshIndexStarts_;
+
+	///************************* LOD *************************///
+
+	// LOD ごとの誤差（[0] は元のメッシュで 0）
+	std::vector<float> lodErrors_;
+
 	///************************* モーション関連 *************************///
 
 	Motion motion_;
@@ -151,6 +222,14 @@ private:
 	bool hasBones_;
 	float deltaTime_;
 
+	///************************* 境界 *************************///
+
+	// ボーンありのモデルはポーズで形が変わるので、バインドポーズの境界をこの倍率で広げる
+	static constexpr float kSkinnedBoundsScale = 1.5f;
+
+	AABB localAABB_{};
+	Sphere localSphere_{};
+
 	///************************* キャッシュ管理 *************************///
 
 	std::string name_;
@@ -159,4 +238,5 @@ private:
 	static const size_t MAX_CACHE_SIZE = 50;
 	static std::list<std::string> cacheOrder_;
 	static std::unordered_map<std::string, std::list<std::string>::iterator> cacheIterators_;
+	static std::mutex cacheMutex_;
 };
@@ -0,0 +1,162 @@
+#include "ModelBinary.h"
+
+// C++
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+	constexpr char kMagic[4] = { 'Y', 'M', 'D', 'L' };
+
+	// パスのハッシュ（FNV-1a。同じ名前のモデルが別フォルダにあっても衝突しないように）
+	uint32_t HashPath(const std::string& text) {
+		uint32_t h = 2166136261u;
+		for (unsigned char c : text) {
+			h ^= c;
+			h *= 16777619u;
+		}
+		return h;
+	}
+
+	size_t AlignUp(size_t value) {
+		return (value + ModelBinary::kBlockAlignment - 1) & ~(ModelBinary::kBlockAlignment - 1);
+	}
+
+} // namespace
+
+///************************* 元ファイル *************************///
+
+/// <summary>
+/// 元ファイルのサイズと更新時刻
+/// </summary>
+ModelBinary::SourceStamp ModelBinary::GetSourceStamp(const std::filesystem::path& sourcePath)
+{
+	SourceStamp stamp{};
+	std::error_code error;
+	const uintmax_t size = std::filesystem::file_size(sourcePath, error);
+	if (error) { return stamp; }
+	const auto writeTime = std::filesystem::last_write_time(sourcePath, error);
+	if (error) { return stamp; }
+
+	stamp.fileSize = static_cast<uint64_t>(size);
+	stamp.writeTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+	return stamp;
+}
+
+/// <summary>
+/// 元ファイルに対応するバイナリのパス
+/// </summary>
+std::filesystem::path ModelBinary::MakeBinaryPath(const std::string& sourcePath, const std::filesystem::path& binaryDirectory)
+{
+	char suffix[16];
+	std::snprintf(suffix, sizeof(suffix), "_%08x", HashPath(sourcePath));
+	return binaryDirectory / (std::filesystem::path(sourcePath).stem().string() + suffix + ".ymdl");
+}
+
+///************************* 書き出し *************************///
+
+void ModelBinary::Writer::WriteHeader(uint32_t vertexStride, const SourceStamp& stamp)
+{
+	for (char c : kMagic) { Write(c); }
+	Write(kVersion);
+	Write(vertexStride);
+	Write(stamp.fileSize);
+	Write(stamp.writeTime);
+}
+
+void ModelBinary::Writer::WriteString(const std::string& text)
+{
+	Write(static_cast<uint32_t>(text.size()));
+	const size_t offset = buffer_.size();
+	buffer_.resize(offset + text.size());
+	std::memcpy(buffer_.data() + offset, text.data(), text.size());
+}
+
+bool ModelBinary::Writer::SaveToFile(const std::filesystem::path& path) const
+{
+	std::error_code error;
+	std::filesystem::create_directories(path.parent_path(), error);
+
+	std::filesystem::path tempPath = path;
+	tempPath += ".tmp";
+	{
+		std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+		if (!ofs) { return false; }
+		ofs.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+		if (!ofs) { return false; }
+	}
+
+	std::filesystem::rename(tempPath, path, error);
+	if (error) {
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	return true;
+}
+
+void ModelBinary::Writer::Align()
+{
+	buffer_.resize(AlignUp(buffer_.size()), 0);
+}
+
+///************************* 読み込み *************************///
+
+bool ModelBinary::Reader::LoadFromFile(const std::filesystem::path& path)
+{
+	std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+	if (!ifs) { return false; }
+
+	const std::streamsize size = ifs.tellg();
+	if (size <= 0) { return false; }
+	ifs.seekg(0);
+
+	buffer_.resize(static_cast<size_t>(size));
+	ifs.read(reinterpret_cast<char*>(buffer_.data()), size);
+	cursor_ = 0;
+	failed_ = !ifs;
+	return !failed_;
+}
+
+bool ModelBinary::Reader::ReadHeader(uint32_t vertexStride, const SourceStamp& stamp)
+{
+	char magic[4]{};
+	for (char& c : magic) { Read(c); }
+	uint32_t version = 0, stride = 0;
+	SourceStamp fileStamp{};
+	Read(version);
+	Read(stride);
+	Read(fileStamp.fileSize);
+	Read(fileStamp.writeTime);
+
+	return IsValid() && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0 &&
+		version == kVersion && stride == vertexStride && fileStamp == stamp;
+}
+
+bool ModelBinary::Reader::ReadString(std::string& text)
+{
+	uint32_t length = 0;
+	if (!Read(length) || !Reserve(length)) { return false; }
+	text.assign(reinterpret_cast<const char*>(buffer_.data() + cursor_), length);
+	cursor_ += length;
+	return true;
+}
+
+bool ModelBinary::Reader::Reserve(size_t size)
+{
+	if (failed_ || size > buffer_.size() - cursor_) {
+		failed_ = true;
+		return false;
+	}
+	return true;
+}
+
+bool ModelBinary::Reader::Align()
+{
+	const size_t aligned = AlignUp(cursor_);
+	if (failed_ || aligned > buffer_.size()) {
+		failed_ = true;
+		return false;
+	}
+	cursor_ = aligned;
+	return true;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+///************************* モデルのバイナリ形式 *************************///
+///
+/// assimp で読み込んだモデルを、エンジンの頂点形式のまま書き出したもの（*.ymdl）
+/// 頂点・インデックス・スキンのウェイトは 16 バイト境界に揃えた連続したブロックで持つので、
+/// ファイルを一度に読み込むか、そのままメモリにマップして先頭から順に読める
+///
+/// 元ファイルのサイズと更新時刻を記録しておき、変わっていたら読み直す
+///
+namespace ModelBinary {
+
+	// 形式を変えたら上げる（既存のバイナリをすべて無効にする）
+	// 2: 頂点の結合と並べ替え（MeshOptimizer）をかけたメッシュを書き出す
+	// 3: メッシュごとに簡略化した LOD のインデックスを書き出す
+	constexpr uint32_t kVersion = 3;
+
+	// 配列ブロックの境界
+	constexpr size_t kBlockAlignment = 16;
+
+	// 元ファイルの識別（どちらかが変わっていれば作り直す）
+	struct SourceStamp {
+		uint64_t fileSize = 0;
+		int64_t writeTime = 0;
+
+		bool operator==(const SourceStamp&) const = default;
+	};
+
+	// 元ファイルの識別を取得（読めなければ fileSize = 0）
+	SourceStamp GetSourceStamp(const std::filesystem::path& sourcePath);
+
+	// 元ファイルに対応するバイナリのパス（<ディレクトリ>/<名前>_<パスのハッシュ>.ymdl）
+	std::filesystem::path MakeBinaryPath(const std::string& sourcePath, const std::filesystem::path& binaryDirectory);
+
+	///************************* 書き出し *************************///
+
+	// メモリ上に積んでから一度に書き出す
+	class Writer
+	{
+	public:
+		// ヘッダー
+		void WriteHeader(uint32_t vertexStride, const SourceStamp& stamp);
+
+		// 値（memcpy できる型）
+		template<class T>
+		void Write(const T& value) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			const size_t offset = buffer_.size();
+			buffer_.resize(offset + sizeof(T));
+			std::memcpy(buffer_.data() + offset, &value, sizeof(T));
+		}
+
+		// 配列（要素数のあと 16 バイト境界から中身）
+		template<class T>
+		void WriteArray(const std::vector<T>& values) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			Write(static_cast<uint64_t>(values.size()));
+			Align();
+			const size_t offset = buffer_.size();
+			buffer_.resize(offset + sizeof(T) * values.size());
+			if (!values.empty()) {
+				std::memcpy(buffer_.data() + offset, values.data(), sizeof(T) * values.size());
+			}
+		}
+
+		// 文字列（長さ + 中身）
+		void WriteString(const std::string& text);
+
+		// 一時ファイルに書いてから置き換える（途中で落ちても壊れたファイルを残さない）
+		bool SaveToFile(const std::filesystem::path& path) const;
+
+	private:
+		void Align();
+
+		std::vector<uint8_t> buffer_;
+	};
+
+	///************************* 読み込み *************************///
+
+	// ファイル全体を一度に読み込み、先頭から順に取り出す
+	// 範囲外を読もうとしたら以降はすべて失敗する（IsValid で確認）
+	class Reader
+	{
+	public:
+		// ファイル全体を読み込む
+		bool LoadFromFile(const std::filesystem::path& path);
+
+		// ヘッダーを確認（形式・頂点サイズ・元ファイルが一致しなければ false）
+		bool ReadHeader(uint32_t vertexStride, const SourceStamp& stamp);
+
+		template<class T>
+		bool Read(T& value) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			if (!Reserve(sizeof(T))) { return false; }
+			std::memcpy(&value, buffer_.data() + cursor_, sizeof(T));
+			cursor_ += sizeof(T);
+			return true;
+		}
+
+		template<class T>
+		bool ReadArray(std::vector<T>& values) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			uint64_t count = 0;
+			if (!Read(count) || !Align()) { return false; }
+			if (count > (buffer_.size() - cursor_) / sizeof(T)) { failed_ = true; return false; }
+			values.resize(static_cast<size_t>(count));
+			if (count > 0) {
+				std::memcpy(values.data(), buffer_.data() + cursor_, sizeof(T) * values.size());
+			}
+			cursor_ += sizeof(T) * values.size();
+			return true;
+		}
+
+		bool ReadString(std::string& text);
+
+		bool IsValid() const { return !failed_; }
+
+	private:
+		bool Reserve(size_t size);
+		bool Align();
+
+		std::vector<uint8_t> buffer_;
+		size_t cursor_ = 0;
+		bool failed_ = false;
+	};
+}
@@ -1,5 +1,6 @@
 #include "ModelManager.h"
 #include "Debugger/Logger.h"
+#include "Loaders/Async/AssetLoader.h"
 
 // シングルトンインスタンスの初期化
 std::unique_ptr<ModelManager> ModelManager::instance = nullptr;
@@ -33,22 +34,71 @@ void ModelManager::Initialze(YoRigine::DirectXCommon* dxCommon)
 void ModelManager::LoadModel(const std::string& directoryPath, const std::string& filePath, const std::string& animationName, bool isAnimation)
 {
 	// アニメーション名を含んだユニークキーを生成
-	std::string modelKey = filePath;
-	if (isAnimation) {
-		modelKey += "#" + animationName;
-	}
+	std::string modelKey = MakeModelKey(filePath, animationName, isAnimation);
 
 	// 読み込まれているモデルを検索
 	if (models.contains(modelKey)) {
 		return;
 	}
 
+	// 非同期で読み込み中なら終わるまで待つ
+	if (loadingKeys_.contains(modelKey)) {
+		AssetLoader::GetInstance()->Flush();
+		return;
+	}
+
 	// モデル生成と初期化
 	std::unique_ptr<Model> model = std::make_unique<Model>();
-	model->Initialize(ModelCommon::GetInstance(), directoryPath, filePath, animationName, isAnimation);
+	if (!model->Initialize(ModelCommon::GetInstance(), directoryPath, filePath, animationName, isAnimation)) {
+		Logger("Error: Failed to load model: " + filePath + "\n");
+		return;
+	}
 	model->SetName(filePath);
 	// 登録
-	models.insert(std::make_pair(modelKey, std::move(model)));
+	RegisterModel(modelKey, std::move(model));
+}
+
+/// <summary>
+/// モデルファイルの非同期読み込み
+/// </summary>
+/// <param name="filePath">読み込むモデルのファイルパス</param>
+void ModelManager::LoadModelAsync(const std::string& directoryPath, const std::string& filePath, const std::string& animationName, bool isAnimation)
+{
+	std::string modelKey = MakeModelKey(filePath, animationName, isAnimation);
+
+	// 読み込み済み・読み込み中
+	if (models.contains(modelKey) || loadingKeys_.contains(modelKey)) {
+		return;
+	}
+	loadingKeys_.insert(modelKey);
+
+	// std::function はコピーできる必要があるので shared_ptr で受け渡す
+	auto model = std::make_shared<std::unique_ptr<Model>>(std::make_unique<Model>());
+	auto loaded = std::make_shared<bool>(false);
+
+	AssetLoader::GetInstance()->Enqueue(
+		[model, loaded, directoryPath, filePath, animationName, isAnimation]() {
+			*loaded = (*model)->LoadFromFile(ModelCommon::GetInstance(), directoryPath, filePath, animationName, isAnimation);
+		},
+		[this, model, loaded, modelKey, filePath]() {
+			loadingKeys_.erase(modelKey);
+			if (!*loaded) {
+				Logger("Error: Failed to load model: " + filePath + "\n");
+				return;
+			}
+
+			(*model)->CreateResources();
+			(*model)->SetName(filePath);
+			RegisterModel(modelKey, std::move(*model));
+		});
+}
+
+/// <summary>
+/// 非同期で読み込み中か
+/// </summary>
+bool ModelManager::IsLoading(const std::string& filePath, const std::string& animationName, bool isAnimation) const
+{
+	return loadingKeys_.contains(MakeModelKey(filePath, animationName, isAnimation));
 }
 
 /// <summary>
@@ -58,10 +108,7 @@ void ModelManager::LoadModel(const std::string& directoryPath, const std::string
 /// <returns>モデルが見つかった場合、そのポインタ。見つからなければnullptr。</returns>
 Model* ModelManager::FindModel(const std::string& filePath, const std::string& animationName, bool isAnimation)
 {
-	std::string modelKey = filePath;
-	if (isAnimation) {
-		modelKey += "#" + animationName;
-	}
+	std::string modelKey = MakeModelKey(filePath, animationName, isAnimation);
 
 	if (models.contains(modelKey)) {
 		return models.at(modelKey).get();
@@ -69,6 +116,63 @@ Model* ModelManager::FindModel(const std::string& filePath, const std::string& a
 	return nullptr;
 }
 
+/// <summary>
+/// 読み込み済みのモデルの参照を取る
+/// </summary>
+AssetHandle ModelManager::AcquireModel(const std::string& filePath, const std::string& animationName, bool isAnimation)
+{
+	auto it = assetIds_.find(MakeModelKey(filePath, animationName, isAnimation));
+	if (it == assetIds_.end()) {
+		return AssetHandle{};
+	}
+	return AssetRegistry::GetInstance()->Acquire(it->second);
+}
+
+/// <summary>
+/// 一覧と AssetRegistry への登録
+/// </summary>
+void ModelManager::RegisterModel(const std::string& modelKey, std::unique_ptr<Model> model)
+{
+	const uint64_t size = model->GetMeshMemorySize();
+	models.insert(std::make_pair(modelKey, std::move(model)));
+	assetIds_[modelKey] = AssetRegistry::GetInstance()->Register(
+		AssetType::Model, modelKey, size,
+		[this, modelKey]() { return UnloadModel(modelKey); });
+}
+
+/// <summary>
+/// モデルの解放（AssetRegistry から呼ばれる）
+/// </summary>
+bool ModelManager::UnloadModel(const std::string& modelKey)
+{
+	assetIds_.erase(modelKey);
+	auto it = models.find(modelKey);
+	if (it == models.end()) {
+		return true;
+	}
+
+	// テクスチャはこの場で参照を外し、同じ UnloadUnused の中で解放できるようにする
+	it->second->ReleaseTextures();
+
+	// 共有バッファの区間や定数バッファは描画に使い終わってから返す
+	std::shared_ptr<Model> model = std::move(it->second);
+	models.erase(it);
+	YoRigine::DirectXCommon::GetInstance()->GetDeferredReleaseQueue()->Retire([model]() {});
+	return true;
+}
+
+/// <summary>
+/// アニメーション名を含んだユニークキー
+/// </summary>
+std::string ModelManager::MakeModelKey(const std::string& filePath, const std::string& animationName, bool isAnimation)
+{
+	std::string modelKey = filePath;
+	if (isAnimation) {
+		modelKey += "#" + animationName;
+	}
+	return modelKey;
+}
+
 /// <summary>
 /// パスから「拡張子なしのベース名」と「拡張子付きファイル名」を分離する
 /// 例: "Enemy/Slime.obj"
@@ -6,11 +6,14 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 // Engine
 #include "Model.h"
 #include "ModelCommon.h"
 #include "DirectXCommon.h"
+#include "Loaders/Asset/AssetRegistry.h"
 
 // モデルを一元管理するクラス
 class ModelManager
@@ -37,9 +40,20 @@ public:
 	// モデル読み込み
 	void LoadModel(const std::string& directoryPath, const std::string& filePath, const std::string& animationName = "", bool isAnimation = false);
 
+	// モデルの非同期読み込み
+	// ファイルの読み込みはワーカー、GPU リソースの生成はメインスレッドで行い、終わると FindModel で見つかるようになる
+	void LoadModelAsync(const std::string& directoryPath, const std::string& filePath, const std::string& animationName = "", bool isAnimation = false);
+
+	// 非同期で読み込み中か
+	bool IsLoading(const std::string& filePath, const std::string& animationName = "", bool isAnimation = false) const;
+
 	// モデル検索
 	Model* FindModel(const std::string& filePath, const std::string& animationName = "", bool isAnimation = false);
 
+	// 読み込み済みのモデルの参照を取る（無ければ空のハンドル）
+	// ハンドルが全部無くなると AssetRegistry::UnloadUnused で解放されるので、FindModel で得たポインタはハンドルと一緒に持つ
+	AssetHandle AcquireModel(const std::string& filePath, const std::string& animationName = "", bool isAnimation = false);
+
 	// パスから「拡張子なしのベース名」と「拡張子付きファイル名」を分離する
 	std::pair<std::string, std::string> ParseModelPath(const std::string& filePath);
 
@@ -51,6 +65,18 @@ public:
 
 	// Model* を直接返す一覧（必要なら）
 	std::vector<Model*> GetAllModels() const;
+private:
+	///************************* 内部処理 *************************///
+
+	// アニメーション名を含んだユニークキー
+	static std::string MakeModelKey(const std::string& filePath, const std::string& animationName, bool isAnimation);
+
+	// 読み込んだモデルを一覧と AssetRegistry に登録する
+	void RegisterModel(const std::string& modelKey, std::unique_ptr<Model> model);
+
+	// AssetRegistry からの解放
+	bool UnloadModel(const std::string& modelKey);
+
 private:
 	///************************* シングルトン管理 *************************///
 
@@ -67,4 +93,10 @@ private:
 
 	// モデルリスト
 	std::map<std::string, std::unique_ptr<Model>> models;
+
+	// 非同期で読み込み中のキー
+	std::unordered_set<std::string> loadingKeys_;
+
+	// AssetRegistry での識別子
+	std::unordered_map<std::string, AssetId> assetIds_;
 };
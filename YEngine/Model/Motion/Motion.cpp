@@ -6,6 +6,7 @@
 #include <json.hpp>
 #include "Quaternion.h"
 #include <iostream>
+#include <algorithm>
 #include <assimp/Importer.hpp>
 #include <Debugger/Logger.h>
 
@@ -86,6 +87,125 @@ Motion Motion::LoadFromScene(const aiScene* scene, const std::string& gltfFilePa
 	return anim;
 }
 
+namespace {
+
+	// ベクトル同士の誤差
+	float KeyError(const Vector3& a, const Vector3& b) {
+		return Length(a - b);
+	}
+
+	// 回転同士の誤差（ラジアン）
+	float KeyError(const Quaternion& a, const Quaternion& b) {
+		float dot = std::min(std::abs(Dot(a, b)), 1.0f);
+		return 2.0f * std::acos(dot);
+	}
+
+	// 区間補間（実行時のサンプリングと同じ補間を使う）
+	Vector3 KeyInterpolate(const Vector3& a, const Vector3& b, float t) {
+		return Lerp(a, b, t);
+	}
+
+	Quaternion KeyInterpolate(const Quaternion& a, const Quaternion& b, float t) {
+		return SlerpFast(a, b, t);
+	}
+
+	/// <summary>
+	/// 1チャンネル分のキーフレームを削減する
+	/// 戻り値は定数チャンネルにまとめたかどうか
+	/// </summary>
+	template<typename tValue>
+	bool ReduceCurve(std::vector<Motion::Keyframe<tValue>>& keyframes, Motion::InterpolationType interpolationType, float tolerance) {
+		if (keyframes.size() <= 1) {
+			return false;
+		}
+
+		// 全キーが先頭と同じ値なら1キーに集約
+		bool isConstant = std::all_of(keyframes.begin() + 1, keyframes.end(), [&](const Motion::Keyframe<tValue>& kf) {
+			return KeyError(kf.value, keyframes.front().value) <= tolerance;
+			});
+		if (isConstant) {
+			keyframes.resize(1);
+			return true;
+		}
+
+		// CubicSplineは前後のキーを参照するので形状が変わらないよう定数化のみ
+		if (interpolationType == Motion::InterpolationType::CubicSpline) {
+			return false;
+		}
+
+		std::vector<Motion::Keyframe<tValue>> reduced;
+		reduced.reserve(keyframes.size());
+		reduced.push_back(keyframes.front());
+
+		if (interpolationType == Motion::InterpolationType::Step) {
+			// 直前に残したキーと同じ値のキーは不要
+			for (size_t i = 1; i < keyframes.size(); ++i) {
+				if (KeyError(keyframes[i].value, reduced.back().value) > tolerance) {
+					reduced.push_back(keyframes[i]);
+				}
+			}
+			keyframes = std::move(reduced);
+			return false;
+		}
+
+		// 線形補間: アンカーから次のキーまでを補間して、間のキーが全て許容誤差内なら削除
+		size_t anchor = 0;
+		for (size_t candidate = 1; candidate + 1 < keyframes.size(); ++candidate) {
+			const auto& start = keyframes[anchor];
+			const auto& end = keyframes[candidate + 1];
+			float span = end.time - start.time;
+
+			bool removable = span > 0.0f;
+			for (size_t i = anchor + 1; removable && i <= candidate; ++i) {
+				float t = (keyframes[i].time - start.time) / span;
+				tValue approx = KeyInterpolate(start.value, end.value, t);
+				removable = KeyError(approx, keyframes[i].value) <= tolerance;
+			}
+
+			if (!removable) {
+				reduced.push_back(keyframes[candidate]);
+				anchor = candidate;
+			}
+		}
+		reduced.push_back(keyframes.back());
+
+		keyframes = std::move(reduced);
+		return false;
+	}
+}
+
+Motion::ReductionReport Motion::ReduceKeyframes()
+{
+	return ReduceKeyframes(ReductionSettings{});
+}
+
+Motion::ReductionReport Motion::ReduceKeyframes(const ReductionSettings& settings)
+{
+	ReductionReport report;
+
+	for (auto& [nodeName, nodeAnimation] : animation_.nodeAnimations_) {
+		report.sourceKeyCount += nodeAnimation.translate.keyframes.size();
+		report.sourceKeyCount += nodeAnimation.rotate.keyframes.size();
+		report.sourceKeyCount += nodeAnimation.scale.keyframes.size();
+
+		if (ReduceCurve(nodeAnimation.translate.keyframes, nodeAnimation.interpolationType, settings.translateTolerance)) {
+			++report.constantChannelCount;
+		}
+		if (ReduceCurve(nodeAnimation.rotate.keyframes, nodeAnimation.interpolationType, settings.rotateTolerance)) {
+			++report.constantChannelCount;
+		}
+		if (ReduceCurve(nodeAnimation.scale.keyframes, nodeAnimation.interpolationType, settings.scaleTolerance)) {
+			++report.constantChannelCount;
+		}
+
+		report.reducedKeyCount += nodeAnimation.translate.keyframes.size();
+		report.reducedKeyCount += nodeAnimation.rotate.keyframes.size();
+		report.reducedKeyCount += nodeAnimation.scale.keyframes.size();
+	}
+
+	return report;
+}
+
 std::string Motion::ParseGLTFInterpolation(const std::string& gltfFilePath, uint32_t samplerIndex) {
 	// GLTFファイルを開く
 	std::ifstream file(gltfFilePath);
@@ -126,6 +246,8 @@ void Motion::SaveBinary(const Motion& motion, const std::string& animationName,
 
 	// ヘッダー
 	ofs.write("ANIM", 4);
+	uint32_t version = kBinaryVersion;
+	ofs.write(reinterpret_cast<const char*>(&version), sizeof(uint32_t));
 	uint32_t animCount = 1;
 	ofs.write(reinterpret_cast<const char*>(&animCount), sizeof(uint32_t));
 
@@ -192,8 +314,13 @@ Motion Motion::LoadBinary(const std::string& path)
 		throw std::runtime_error("バイナリファイル形式が不正です" + path);
 	}
 
-	uint32_t animCount;
-	ifs.read(reinterpret_cast<char*>(&animCount), sizeof(uint32_t));
+	// 旧形式はバージョン欄が無く、この位置がアニメーション数
+	uint32_t version;
+	ifs.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
+	uint32_t animCount = version;
+	if (version >= 2) {
+		ifs.read(reinterpret_cast<char*>(&animCount), sizeof(uint32_t));
+	}
 	if (animCount != 1) {
 		throw std::runtime_error("このファイルには複数のアニメーションが含まれています: " + path);
 	}
@@ -256,6 +383,19 @@ Motion Motion::LoadBinary(const std::string& path)
 
 }
 
+uint32_t Motion::ReadBinaryVersion(const std::string& path)
+{
+	std::ifstream ifs(path, std::ios::binary);
+	char header[4] = {};
+	uint32_t version = 0;
+	ifs.read(header, 4);
+	ifs.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
+	if (!ifs || std::strncmp(header, "ANIM", 4) != 0) {
+		return 0;
+	}
+	return version;
+}
+
 
 void Motion::ApplyAnimation(std::vector<Joint>& joints, float animationtime)
 {
@@ -316,7 +456,7 @@ Quaternion Motion::CalculateValue(const AnimationCurve<Quaternion>& curve, float
 		if (curve.keyframes[index].time <= time && time <= curve.keyframes[nextIndex].time) {
 			// 範囲内を補間する
 			float t = (time - curve.keyframes[index].time) / (curve.keyframes[nextIndex].time - curve.keyframes[index].time);
-			return Slerp(curve.keyframes[index].value, curve.keyframes[nextIndex].value, t);
+			return SlerpFast(curve.keyframes[index].value, curve.keyframes[nextIndex].value, t);
 		}
 	}
 	// ここまできた場合は一番後の時刻よりも後ろなので最後の値を返すことになる
@@ -383,7 +523,7 @@ Quaternion Motion::CalculateValueNew(const std::vector<KeyframeQuaternion>& keyf
 
 			switch (interpolationType) {
 			case InterpolationType::Linear:
-				return Slerp(keyframes[index].value, keyframes[nextIndex].value, t);
+				return SlerpFast(keyframes[index].value, keyframes[nextIndex].value, t);
 
 			case InterpolationType::Step:
 				return keyframes[index].value;
@@ -393,7 +533,7 @@ Quaternion Motion::CalculateValueNew(const std::vector<KeyframeQuaternion>& keyf
 			}
 
 			default:
-				return Slerp(keyframes[index].value, keyframes[nextIndex].value, t);
+				return SlerpFast(keyframes[index].value, keyframes[nextIndex].value, t);
 			}
 		}
 	}
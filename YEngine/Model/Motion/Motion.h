@@ -59,6 +59,25 @@ public:
 		std::map<std::string, NodeAnimation> nodeAnimations_;
 	};
 
+	// キーフレーム削減の許容誤差
+	struct ReductionSettings {
+		float translateTolerance = 1.0e-4f; // 位置の許容誤差
+		float rotateTolerance = 1.0e-3f;    // 回転の許容誤差（ラジアン）
+		float scaleTolerance = 1.0e-4f;     // スケールの許容誤差
+	};
+
+	// キーフレーム削減の結果
+	struct ReductionReport {
+		size_t sourceKeyCount = 0;       // 削減前のキー数
+		size_t reducedKeyCount = 0;      // 削減後のキー数
+		size_t constantChannelCount = 0; // 定数にまとめたチャンネル数
+
+		// 圧縮率（削減後 / 削減前）
+		float GetCompressionRatio() const {
+			return sourceKeyCount == 0 ? 1.0f : static_cast<float>(reducedKeyCount) / static_cast<float>(sourceKeyCount);
+		}
+	};
+
 public:
 	///************************* 基本関数 *************************///
 
@@ -68,12 +87,24 @@ public:
 	// 補間タイプ解析
 	static std::string ParseGLTFInterpolation(const std::string& gltfFilePath, uint32_t samplerIndex);
 
+	// キーフレーム削減（冗長なキーの除去と定数チャンネルの集約）
+	ReductionReport ReduceKeyframes();
+	ReductionReport ReduceKeyframes(const ReductionSettings& settings);
+
+	// バイナリの形式のバージョン（"ANIM" の直後に書く）
+	// 1: バージョン欄が無い旧形式（この位置にアニメーション数 1 が入っている）。キーフレーム削減前
+	// 2: キーフレーム削減後
+	static constexpr uint32_t kBinaryVersion = 2;
+
 	// バイナリ保存
 	void SaveBinary(const Motion& motion, const std::string& animationName, const std::string& path);
 
-	// バイナリ読み込み
+	// バイナリ読み込み（旧形式も読める）
 	Motion LoadBinary(const std::string& path);
 
+	// バイナリの形式のバージョン（開けない・形式が違うなら 0）
+	static uint32_t ReadBinaryVersion(const std::string& path);
+
 	// アニメーション適用
 	void ApplyAnimation(std::vector<Joint>& joints, float animationTime);
 
@@ -0,0 +1,513 @@
+#include "MotionBlendTree.h"
+
+// Engine
+#include "../ModelUtils.h"
+#include "Debugger/Logger.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+	// 同じ半球にそろえて重み付き加算（nlerp の累積）
+	void AccumulateRotation(Quaternion& sum, const Quaternion& q, float weight) {
+		float dot = sum.x * q.x + sum.y * q.y + sum.z * q.z + sum.w * q.w;
+		float sign = (dot < 0.0f) ? -1.0f : 1.0f;
+		sum.x += q.x * weight * sign;
+		sum.y += q.y * weight * sign;
+		sum.z += q.z * weight * sign;
+		sum.w += q.w * weight * sign;
+	}
+
+	// ゼロ除算を避けたスケールの比
+	float SafeRatio(float numerator, float denominator) {
+		return (std::fabs(denominator) > 1.0e-6f) ? numerator / denominator : 1.0f;
+	}
+
+	// ポーズをゼロで埋める（累積用）
+	void FillZero(MotionBlendTree::Pose& pose) {
+		for (QuaternionTransform& transform : pose) {
+			transform.translate = { 0.0f, 0.0f, 0.0f };
+			transform.rotate = { 0.0f, 0.0f, 0.0f, 0.0f };
+			transform.scale = { 0.0f, 0.0f, 0.0f };
+		}
+	}
+}
+
+///************************* ポーズプール *************************///
+
+void MotionBlendTree::PosePool::Initialize(size_t poseCount, size_t jointCount) {
+	poses_.assign(poseCount, Pose(jointCount));
+	used_ = 0;
+}
+
+MotionBlendTree::Pose& MotionBlendTree::PosePool::Acquire() {
+	assert(used_ < poses_.size() && "MotionBlendTree のポーズプールが不足しています");
+	return poses_[used_++];
+}
+
+void MotionBlendTree::PosePool::Release() {
+	assert(used_ > 0);
+	--used_;
+}
+
+///************************* 基本関数 *************************///
+
+/// <summary>
+/// 初期化
+/// </summary>
+void MotionBlendTree::Initialize(Skeleton& skeleton, uint32_t maxLayers, uint32_t maxClipsPerLayer) {
+	std::vector<Joint>& joints = skeleton.GetJoints();
+	const size_t jointCount = joints.size();
+
+	maxLayers_ = maxLayers;
+	maxClipsPerLayer_ = maxClipsPerLayer;
+
+	// クリップはノードへのポインタを持つため、再確保で移動しないよう先に確保しておく
+	layers_.clear();
+	layers_.reserve(maxLayers_);
+
+	jointNames_.resize(jointCount);
+	jointParents_.resize(jointCount);
+	ignoredJoints_.resize(jointCount);
+	restPose_.resize(jointCount);
+	jointWeights_.assign(jointCount, 0.0f);
+
+	for (size_t i = 0; i < jointCount; ++i) {
+		jointNames_[i] = NormalizeNodeName(joints[i].GetName());
+		std::optional<int32_t>& parent = joints[i].GetParent();
+		jointParents_[i] = parent ? *parent : -1;
+		ignoredJoints_[i] = ignoreNodes.count(jointNames_[i]) ? 1 : 0;
+		restPose_[i] = joints[i].GetTransform();
+	}
+
+	// 結果 / レイヤー / クリップのサンプリング用
+	posePool_.Initialize(4, jointCount);
+}
+
+/// <summary>
+/// 時間を進める
+/// </summary>
+void MotionBlendTree::Update(float deltaTime) {
+	const float delta = deltaTime * speed_;
+
+	for (Layer& layer : layers_) {
+		if (layer.clips.empty()) { continue; }
+
+		if (layer.blendSpace == BlendSpaceType::None) {
+			// 各クリップが独立して進む
+			for (Clip& clip : layer.clips) {
+				clip.time = AdvanceTime(clip.time, delta * clip.speed, clip.motion.GetDuration(), clip.loop);
+			}
+			continue;
+		}
+
+		// ブレンドスペースは重み付き平均の長さで位相を同期させる（足滑り防止）
+		ComputeClipWeights(layer);
+		float duration = 0.0f;
+		for (const Clip& clip : layer.clips) {
+			duration += clip.motion.GetDuration() / std::max(clip.speed, 1.0e-4f) * clip.effectiveWeight;
+		}
+		if (duration > 0.0f) {
+			layer.phase = AdvanceTime(layer.phase, delta / duration, 1.0f, true);
+		}
+		for (Clip& clip : layer.clips) {
+			clip.time = layer.phase * clip.motion.GetDuration();
+		}
+	}
+}
+
+/// <summary>
+/// ジョイントへポーズを書き込む
+/// </summary>
+void MotionBlendTree::Evaluate(std::vector<Joint>& joints) {
+	assert(joints.size() == restPose_.size());
+	if (layers_.empty()) { return; }
+
+	Pose& result = posePool_.Acquire();
+	Pose& layerPose = posePool_.Acquire();
+
+	// 初期ポーズから積み上げる
+	std::copy(restPose_.begin(), restPose_.end(), result.begin());
+
+	for (Layer& layer : layers_) {
+		if (layer.clips.empty() || layer.weight <= 0.0f) { continue; }
+
+		EvaluateLayer(layer, layerPose, jointWeights_);
+
+		for (size_t j = 0; j < result.size(); ++j) {
+			float weight = layer.weight * jointWeights_[j];
+			if (!layer.mask.empty()) { weight *= layer.mask[j]; }
+			if (weight <= 0.0f) { continue; }
+			weight = std::min(weight, 1.0f);
+
+			QuaternionTransform& dst = result[j];
+			const QuaternionTransform& src = layerPose[j];
+
+			if (layer.mode == LayerMode::Override) {
+				dst.translate = Lerp(dst.translate, src.translate, weight);
+				dst.rotate = SlerpFast(dst.rotate, src.rotate, weight);
+				dst.scale = Lerp(dst.scale, src.scale, weight);
+			} else {
+				// 差分を重みぶんだけ適用
+				dst.translate = dst.translate + src.translate * weight;
+				dst.rotate = Normalize(Multiply(dst.rotate, SlerpFast(Quaternion::Identity(), src.rotate, weight)));
+				dst.scale.x *= 1.0f + (src.scale.x - 1.0f) * weight;
+				dst.scale.y *= 1.0f + (src.scale.y - 1.0f) * weight;
+				dst.scale.z *= 1.0f + (src.scale.z - 1.0f) * weight;
+			}
+		}
+	}
+
+	for (size_t j = 0; j < joints.size(); ++j) {
+		if (ignoredJoints_[j]) { continue; }
+		joints[j].SetTransform(result[j]);
+	}
+
+	posePool_.Release();
+	posePool_.Release();
+}
+
+///************************* 構築 *************************///
+
+/// <summary>
+/// レイヤー追加
+/// </summary>
+uint32_t MotionBlendTree::AddLayer(const std::string& name, LayerMode mode, float weight) {
+	if (layers_.size() >= maxLayers_) {
+		Logger("MotionBlendTree : レイヤー数の上限を超えています (" + name + ")\n");
+		return kInvalidIndex;
+	}
+
+	Layer& layer = layers_.emplace_back();
+	layer.name = name;
+	layer.mode = mode;
+	layer.weight = weight;
+	layer.clips.reserve(maxClipsPerLayer_);
+	layer.sortedClips.reserve(maxClipsPerLayer_);
+	return static_cast<uint32_t>(layers_.size() - 1);
+}
+
+/// <summary>
+/// クリップ追加
+/// </summary>
+uint32_t MotionBlendTree::AddClip(uint32_t layerIndex, const Motion& motion, bool loop) {
+	return AddClip(layerIndex, motion, Vector2(0.0f, 0.0f), loop);
+}
+
+/// <summary>
+/// ブレンドスペース上の位置付きでクリップ追加
+/// </summary>
+uint32_t MotionBlendTree::AddClip(uint32_t layerIndex, const Motion& motion, const Vector2& position, bool loop) {
+	assert(layerIndex < layers_.size());
+	Layer& layer = layers_[layerIndex];
+	if (layer.clips.size() >= maxClipsPerLayer_) {
+		Logger("MotionBlendTree : クリップ数の上限を超えています (" + layer.name + ")\n");
+		return kInvalidIndex;
+	}
+
+	Clip& clip = layer.clips.emplace_back();
+	clip.motion = motion;
+	clip.position = position;
+	clip.loop = loop;
+	BindClip(clip);
+
+	// 加算用の参照ポーズは先頭フレーム
+	clip.referencePose.resize(restPose_.size());
+	SampleClip(clip, 0.0f, clip.referencePose);
+
+	// x 順の並びを更新
+	uint32_t clipIndex = static_cast<uint32_t>(layer.clips.size() - 1);
+	auto it = std::upper_bound(layer.sortedClips.begin(), layer.sortedClips.end(), clipIndex,
+		[&layer](uint32_t lhs, uint32_t rhs) { return layer.clips[lhs].position.x < layer.clips[rhs].position.x; });
+	layer.sortedClips.insert(it, clipIndex);
+
+	return clipIndex;
+}
+
+/// <summary>
+/// ブレンドスペースの種類設定
+/// </summary>
+void MotionBlendTree::SetBlendSpace(uint32_t layerIndex, BlendSpaceType type) {
+	assert(layerIndex < layers_.size());
+	layers_[layerIndex].blendSpace = type;
+	layers_[layerIndex].phase = 0.0f;
+}
+
+/// <summary>
+/// 指定ジョイント以下を対象とするマスクを設定
+/// </summary>
+void MotionBlendTree::SetLayerMask(uint32_t layerIndex, const std::vector<std::string>& rootJointNames) {
+	assert(layerIndex < layers_.size());
+	Layer& layer = layers_[layerIndex];
+
+	if (rootJointNames.empty()) {
+		layer.mask.clear();
+		return;
+	}
+
+	layer.mask.assign(jointNames_.size(), 0.0f);
+	for (const std::string& rootName : rootJointNames) {
+		std::string normalized = NormalizeNodeName(rootName);
+		auto it = std::find(jointNames_.begin(), jointNames_.end(), normalized);
+		if (it == jointNames_.end()) {
+			Logger("MotionBlendTree : マスク対象のジョイントが見つかりません (" + rootName + ")\n");
+			continue;
+		}
+		layer.mask[std::distance(jointNames_.begin(), it)] = 1.0f;
+	}
+
+	// ジョイントは親が先に並んでいるので、1回の走査で子孫へ伝播できる
+	for (size_t j = 0; j < jointNames_.size(); ++j) {
+		int32_t parent = jointParents_[j];
+		if (parent >= 0) {
+			layer.mask[j] = std::max(layer.mask[j], layer.mask[parent]);
+		}
+	}
+}
+
+/// <summary>
+/// ジョイント単位でマスクの重みを設定
+/// </summary>
+void MotionBlendTree::SetLayerMaskWeight(uint32_t layerIndex, const std::string& jointName, float weight) {
+	assert(layerIndex < layers_.size());
+	Layer& layer = layers_[layerIndex];
+
+	if (layer.mask.empty()) {
+		layer.mask.assign(jointNames_.size(), 1.0f);
+	}
+
+	std::string normalized = NormalizeNodeName(jointName);
+	auto it = std::find(jointNames_.begin(), jointNames_.end(), normalized);
+	if (it != jointNames_.end()) {
+		layer.mask[std::distance(jointNames_.begin(), it)] = std::clamp(weight, 0.0f, 1.0f);
+	}
+}
+
+///************************* アクセッサ *************************///
+
+void MotionBlendTree::SetParameter(uint32_t layerIndex, float x, float y) {
+	assert(layerIndex < layers_.size());
+	layers_[layerIndex].parameter = Vector2(x, y);
+}
+
+void MotionBlendTree::SetLayerWeight(uint32_t layerIndex, float weight) {
+	assert(layerIndex < layers_.size());
+	layers_[layerIndex].weight = std::clamp(weight, 0.0f, 1.0f);
+}
+
+float MotionBlendTree::GetLayerWeight(uint32_t layerIndex) const {
+	assert(layerIndex < layers_.size());
+	return layers_[layerIndex].weight;
+}
+
+void MotionBlendTree::SetClipWeight(uint32_t layerIndex, uint32_t clipIndex, float weight) {
+	assert(layerIndex < layers_.size() && clipIndex < layers_[layerIndex].clips.size());
+	layers_[layerIndex].clips[clipIndex].weight = std::max(weight, 0.0f);
+}
+
+void MotionBlendTree::SetClipSpeed(uint32_t layerIndex, uint32_t clipIndex, float speed) {
+	assert(layerIndex < layers_.size() && clipIndex < layers_[layerIndex].clips.size());
+	layers_[layerIndex].clips[clipIndex].speed = speed;
+}
+
+uint32_t MotionBlendTree::FindLayer(const std::string& name) const {
+	for (size_t i = 0; i < layers_.size(); ++i) {
+		if (layers_[i].name == name) { return static_cast<uint32_t>(i); }
+	}
+	return kInvalidIndex;
+}
+
+void MotionBlendTree::ResetTime() {
+	for (Layer& layer : layers_) {
+		layer.phase = 0.0f;
+		for (Clip& clip : layer.clips) {
+			clip.time = 0.0f;
+		}
+	}
+}
+
+///************************* 内部処理 *************************///
+
+/// <summary>
+/// ジョイント番号からチャンネルへの対応表を作る（毎フレームの名前検索を無くす）
+/// </summary>
+void MotionBlendTree::BindClip(Clip& clip) {
+	clip.channels.assign(jointNames_.size(), nullptr);
+
+	for (const auto& [nodeName, nodeAnimation] : clip.motion.animation_.nodeAnimations_) {
+		std::string normalized = NormalizeNodeName(nodeName);
+		auto it = std::find(jointNames_.begin(), jointNames_.end(), normalized);
+		if (it == jointNames_.end()) { continue; }
+		clip.channels[std::distance(jointNames_.begin(), it)] = &nodeAnimation;
+	}
+}
+
+/// <summary>
+/// クリップを指定時間でサンプリング（チャンネルの無いジョイントは初期ポーズ）
+/// </summary>
+void MotionBlendTree::SampleClip(Clip& clip, float time, Pose& outPose) {
+	for (size_t j = 0; j < outPose.size(); ++j) {
+		const Motion::NodeAnimation* channel = clip.channels[j];
+		QuaternionTransform& out = outPose[j];
+		out = restPose_[j];
+		if (!channel) { continue; }
+
+		if (!channel->translate.keyframes.empty()) {
+			out.translate = clip.motion.CalculateValueNew(channel->translate.keyframes, time, channel->interpolationType);
+		}
+		if (!channel->rotate.keyframes.empty()) {
+			out.rotate = clip.motion.CalculateValueNew(channel->rotate.keyframes, time, channel->interpolationType);
+		}
+		if (!channel->scale.keyframes.empty()) {
+			out.scale = clip.motion.CalculateValueNew(channel->scale.keyframes, time, channel->interpolationType);
+		}
+	}
+}
+
+/// <summary>
+/// レイヤー内のクリップ重みを計算
+/// </summary>
+void MotionBlendTree::ComputeClipWeights(Layer& layer) {
+	for (Clip& clip : layer.clips) {
+		clip.effectiveWeight = 0.0f;
+	}
+
+	switch (layer.blendSpace) {
+	case BlendSpaceType::None: {
+		float total = 0.0f;
+		for (const Clip& clip : layer.clips) { total += clip.weight; }
+		if (total <= 0.0f) { return; }
+		for (Clip& clip : layer.clips) { clip.effectiveWeight = clip.weight / total; }
+		return;
+	}
+
+	case BlendSpaceType::Linear1D: {
+		const std::vector<uint32_t>& sorted = layer.sortedClips;
+		const float x = layer.parameter.x;
+
+		// 範囲外は端のクリップ
+		if (x <= layer.clips[sorted.front()].position.x) {
+			layer.clips[sorted.front()].effectiveWeight = 1.0f;
+			return;
+		}
+		if (x >= layer.clips[sorted.back()].position.x) {
+			layer.clips[sorted.back()].effectiveWeight = 1.0f;
+			return;
+		}
+
+		for (size_t i = 0; i + 1 < sorted.size(); ++i) {
+			Clip& lower = layer.clips[sorted[i]];
+			Clip& upper = layer.clips[sorted[i + 1]];
+			if (x < lower.position.x || x > upper.position.x) { continue; }
+
+			float range = upper.position.x - lower.position.x;
+			float t = (range > 0.0f) ? (x - lower.position.x) / range : 0.0f;
+			lower.effectiveWeight = 1.0f - t;
+			upper.effectiveWeight = t;
+			return;
+		}
+		return;
+	}
+
+	case BlendSpaceType::Cartesian2D: {
+		// 逆距離の二乗で重み付け（位置が一致したクリップはそれのみ）
+		float total = 0.0f;
+		for (Clip& clip : layer.clips) {
+			float dx = layer.parameter.x - clip.position.x;
+			float dy = layer.parameter.y - clip.position.y;
+			float distanceSq = dx * dx + dy * dy;
+			if (distanceSq < 1.0e-8f) {
+				for (Clip& other : layer.clips) { other.effectiveWeight = 0.0f; }
+				clip.effectiveWeight = 1.0f;
+				return;
+			}
+			clip.effectiveWeight = 1.0f / distanceSq;
+			total += clip.effectiveWeight;
+		}
+		for (Clip& clip : layer.clips) { clip.effectiveWeight /= total; }
+		return;
+	}
+	}
+}
+
+/// <summary>
+/// レイヤーのポーズを作る
+/// </summary>
+void MotionBlendTree::EvaluateLayer(Layer& layer, Pose& outPose, std::vector<float>& outJointWeights) {
+	ComputeClipWeights(layer);
+
+	Pose& clipPose = posePool_.Acquire();
+	FillZero(outPose);
+	std::fill(outJointWeights.begin(), outJointWeights.end(), 0.0f);
+
+	for (Clip& clip : layer.clips) {
+		const float weight = clip.effectiveWeight;
+		if (weight <= 0.0f) { continue; }
+
+		SampleClip(clip, clip.time, clipPose);
+
+		for (size_t j = 0; j < outPose.size(); ++j) {
+			// チャンネルの無いジョイントはこのクリップの影響を受けない
+			if (!clip.channels[j]) { continue; }
+
+			QuaternionTransform sample = clipPose[j];
+			if (layer.mode == LayerMode::Additive) {
+				// 参照ポーズからの差分へ変換
+				const QuaternionTransform& reference = clip.referencePose[j];
+				sample.translate = sample.translate - reference.translate;
+				sample.rotate = Multiply(Inverse(reference.rotate), sample.rotate);
+				sample.scale = {
+					SafeRatio(sample.scale.x, reference.scale.x),
+					SafeRatio(sample.scale.y, reference.scale.y),
+					SafeRatio(sample.scale.z, reference.scale.z)
+				};
+			}
+
+			QuaternionTransform& out = outPose[j];
+			out.translate = out.translate + sample.translate * weight;
+			AccumulateRotation(out.rotate, sample.rotate, weight);
+			out.scale = out.scale + sample.scale * weight;
+			outJointWeights[j] += weight;
+		}
+	}
+
+	// 実際に寄与した重みで正規化
+	for (size_t j = 0; j < outPose.size(); ++j) {
+		float total = outJointWeights[j];
+		QuaternionTransform& out = outPose[j];
+		if (total <= 0.0f) {
+			if (layer.mode == LayerMode::Additive) {
+				out.translate = { 0.0f, 0.0f, 0.0f };
+				out.rotate = Quaternion::Identity();
+				out.scale = { 1.0f, 1.0f, 1.0f };
+			}
+			continue;
+		}
+		float inv = 1.0f / total;
+		out.translate = out.translate * inv;
+		out.rotate = Normalize(out.rotate);
+		out.scale = out.scale * inv;
+		outJointWeights[j] = std::min(total, 1.0f);
+	}
+
+	posePool_.Release();
+}
+
+/// <summary>
+/// クリップ時間を進める
+/// </summary>
+float MotionBlendTree::AdvanceTime(float time, float delta, float duration, bool loop) {
+	if (duration <= 0.0f) { return 0.0f; }
+
+	time += delta;
+	if (loop) {
+		time = std::fmod(time, duration);
+		if (time < 0.0f) { time += duration; }
+	} else {
+		time = std::clamp(time, 0.0f, duration);
+	}
+	return time;
+}
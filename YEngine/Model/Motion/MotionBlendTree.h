@@ -0,0 +1,177 @@
+#pragma once
+
+// C++
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Engine
+#include "Motion.h"
+#include "../Skeleton/Skeleton.h"
+
+// Math
+#include "Quaternion.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+/// <summary>
+/// 複数レイヤーのモーションブレンドツリー
+/// レイヤーごとに N 個のクリップを重み付き合成し、上書き / 加算 / ジョイントマスクで積み上げる
+/// 評価時のポーズは初期化時に確保したプールから取り出すため、毎フレームのヒープ確保は発生しない
+/// </summary>
+class MotionBlendTree {
+public:
+	///************************* 定義 *************************///
+
+	// レイヤーの合成方法
+	enum class LayerMode {
+		Override, // 下のレイヤーを重みで上書き
+		Additive  // 参照ポーズとの差分を加算
+	};
+
+	// レイヤー内のクリップ重みの決め方
+	enum class BlendSpaceType {
+		None,        // クリップごとに設定した重みをそのまま使う
+		Linear1D,    // パラメータ x で隣接する2クリップを線形補間
+		Cartesian2D  // パラメータ (x, y) からの距離の逆数で重み付け
+	};
+
+	// ジョイント数分のローカルポーズ
+	using Pose = std::vector<QuaternionTransform>;
+
+	// 無効なインデックス
+	static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+public:
+	///************************* 基本関数 *************************///
+
+	// 初期化（スケルトンのジョイント数でポーズプールを確保）
+	void Initialize(Skeleton& skeleton, uint32_t maxLayers = 4, uint32_t maxClipsPerLayer = 8);
+
+	// 時間を進める
+	void Update(float deltaTime);
+
+	// ジョイントへポーズを書き込む
+	void Evaluate(std::vector<Joint>& joints);
+
+	///************************* 構築 *************************///
+
+	// レイヤー追加
+	uint32_t AddLayer(const std::string& name, LayerMode mode, float weight = 1.0f);
+
+	// クリップ追加（ジョイントとチャンネルの対応はここで解決する）
+	uint32_t AddClip(uint32_t layerIndex, const Motion& motion, bool loop = true);
+
+	// ブレンドスペース上の位置付きでクリップ追加
+	uint32_t AddClip(uint32_t layerIndex, const Motion& motion, const Vector2& position, bool loop = true);
+
+	// ブレンドスペースの種類設定
+	void SetBlendSpace(uint32_t layerIndex, BlendSpaceType type);
+
+	// 指定ジョイント以下を対象とするマスクを設定（空なら全ジョイント）
+	void SetLayerMask(uint32_t layerIndex, const std::vector<std::string>& rootJointNames);
+
+	// ジョイント単位でマスクの重みを設定
+	void SetLayerMaskWeight(uint32_t layerIndex, const std::string& jointName, float weight);
+
+public:
+	///************************* アクセッサ *************************///
+
+	// ブレンドスペースのパラメータ設定
+	void SetParameter(uint32_t layerIndex, float x, float y = 0.0f);
+
+	// レイヤー重み
+	void SetLayerWeight(uint32_t layerIndex, float weight);
+	float GetLayerWeight(uint32_t layerIndex) const;
+
+	// クリップ重み（BlendSpaceType::None のとき有効）
+	void SetClipWeight(uint32_t layerIndex, uint32_t clipIndex, float weight);
+
+	// クリップの再生速度
+	void SetClipSpeed(uint32_t layerIndex, uint32_t clipIndex, float speed);
+
+	// ツリー全体の再生速度
+	void SetSpeed(float speed) { speed_ = speed; }
+	float GetSpeed() const { return speed_; }
+
+	// レイヤー数取得
+	uint32_t GetLayerCount() const { return static_cast<uint32_t>(layers_.size()); }
+
+	// レイヤー名からインデックス取得
+	uint32_t FindLayer(const std::string& name) const;
+
+	// 再生時間を先頭に戻す
+	void ResetTime();
+
+private:
+	///************************* 内部定義 *************************///
+
+	// 1クリップの再生状態
+	struct Clip {
+		Motion motion;
+		std::vector<const Motion::NodeAnimation*> channels; // ジョイント番号 -> チャンネル（無ければ nullptr）
+		Pose referencePose;                                 // 加算レイヤー用の参照ポーズ（先頭フレーム）
+		Vector2 position;                                   // ブレンドスペース上の位置
+		float time = 0.0f;
+		float speed = 1.0f;
+		float weight = 1.0f;                                // ユーザー指定の重み
+		float effectiveWeight = 0.0f;                       // 今フレームの正規化済み重み
+		bool loop = true;
+	};
+
+	// 1レイヤー
+	struct Layer {
+		std::string name;
+		LayerMode mode = LayerMode::Override;
+		BlendSpaceType blendSpace = BlendSpaceType::None;
+		float weight = 1.0f;
+		Vector2 parameter;
+		float phase = 0.0f;                  // ブレンドスペース時の正規化再生位置
+		std::vector<Clip> clips;
+		std::vector<uint32_t> sortedClips;   // Linear1D 用に x でソートしたクリップ番号
+		std::vector<float> mask;             // ジョイントごとの重み（空なら全て 1）
+	};
+
+	// 事前確保したポーズのプール
+	class PosePool {
+	public:
+		void Initialize(size_t poseCount, size_t jointCount);
+		Pose& Acquire();
+		void Release();
+	private:
+		std::vector<Pose> poses_;
+		size_t used_ = 0;
+	};
+
+private:
+	///************************* 内部処理 *************************///
+
+	// クリップのチャンネル解決
+	void BindClip(Clip& clip);
+
+	// クリップを指定時間でサンプリング
+	void SampleClip(Clip& clip, float time, Pose& outPose);
+
+	// レイヤー内のクリップ重みを計算
+	void ComputeClipWeights(Layer& layer);
+
+	// レイヤーのポーズを作る（加算レイヤーは差分ポーズ）
+	void EvaluateLayer(Layer& layer, Pose& outPose, std::vector<float>& outJointWeights);
+
+	// クリップ時間を進める
+	static float AdvanceTime(float time, float delta, float duration, bool loop);
+
+private:
+	///************************* メンバ変数 *************************///
+
+	std::vector<Layer> layers_;
+	std::vector<std::string> jointNames_;      // 正規化済みジョイント名
+	std::vector<int32_t> jointParents_;        // 親ジョイント（ルートは -1）
+	std::vector<uint8_t> ignoredJoints_;       // 書き込まないジョイント
+	Pose restPose_;                            // 初期化時のローカルポーズ
+	PosePool posePool_;
+	std::vector<float> jointWeights_;          // レイヤー評価時のジョイント毎の有効重み
+	uint32_t maxLayers_ = 0;
+	uint32_t maxClipsPerLayer_ = 0;
+	float speed_ = 1.0f;
+};
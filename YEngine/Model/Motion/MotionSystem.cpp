@@ -29,6 +29,12 @@ void MotionSystem::Initialize(Motion& Motion, Node* rootNode)
 
 void MotionSystem::Update(float deltaTime)
 {
+	// ブレンドツリー再生中はツリー側の時間だけ進める
+	if (HasBlendTree()) {
+		blendTree_->Update(deltaTime * motionSpeed_);
+		return;
+	}
+
 	if (!animation_ || playMode_ == MotionPlayMode::Stop || isFinished_) return;
 
 	// ブレンド中の処理
@@ -70,6 +76,15 @@ void MotionSystem::Update(float deltaTime)
 // アニメーション適用
 void MotionSystem::Apply()
 {
+	if (HasBlendTree()) {
+		blendTree_->Evaluate(skeleton_->GetJoints());
+		skeleton_->Update();
+		if (skinCluster_) {
+			skinCluster_->UpdateMatrixPalette(*skeleton_);
+		}
+		return;
+	}
+
 	if (!animation_ || playMode_ == MotionPlayMode::Stop) return;
 
 	if (animationBlendState_.isBlending && skeleton_) {
@@ -79,13 +94,13 @@ void MotionSystem::Apply()
 
 		skeleton_->Update();
 		if (skinCluster_) {
-			skinCluster_->UpdateMatrixPalette(skeleton_->GetJoints());
+			skinCluster_->UpdateMatrixPalette(*skeleton_);
 		}
 	} else if (skeleton_) {
 		animation_->ApplyAnimation(skeleton_->GetJoints(), animationTime_);
 		skeleton_->Update();
 		if (skinCluster_) {
-			skinCluster_->UpdateMatrixPalette(skeleton_->GetJoints());
+			skinCluster_->UpdateMatrixPalette(*skeleton_);
 		}
 	} else if (node_) {
 		animation_->PlayerAnimation(animationTime_, *node_);
@@ -214,7 +229,7 @@ void MotionSystem::BlendAndApplyAnimation(const Motion& from, const Motion& to,
 
 		QuaternionTransform blended;
 		blended.translate = Lerp(fromTr.translate, toTr.translate, t);
-		blended.rotate = Slerp(fromTr.rotate, toTr.rotate, t);
+		blended.rotate = SlerpFast(fromTr.rotate, toTr.rotate, t);
 		blended.scale = Lerp(fromTr.scale, toTr.scale, t);
 
 		joint.SetTransform(blended);
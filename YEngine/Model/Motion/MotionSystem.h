@@ -1,5 +1,6 @@
 #pragma once
 #include "Motion.h"
+#include "MotionBlendTree.h"
 #include "../Skeleton/Skeleton.h"
 #include "../Skeleton/SkinCluster.h"
 #include "../Node/Node.h"
@@ -73,6 +74,11 @@ public:
 	// 実際の再生速度
 	float GetEffectiveSpeed() const { return motionSpeed_ * currentAnimationSpeed_; }
 
+	// ブレンドツリー（設定中は単一クリップの再生より優先）
+	void SetBlendTree(MotionBlendTree* blendTree) { blendTree_ = blendTree; }
+	MotionBlendTree* GetBlendTree() const { return blendTree_; }
+	bool HasBlendTree() const { return blendTree_ != nullptr && skeleton_ != nullptr; }
+
 private:
 	///************************* 内部処理 *************************///
 
@@ -94,6 +100,9 @@ private:
 	// ノードデータ
 	Node* node_ = nullptr;
 
+	// ブレンドツリー（所有しない）
+	MotionBlendTree* blendTree_ = nullptr;
+
 	// アニメーション時間
 	float animationTime_ = 0.0f;
 
@@ -0,0 +1,190 @@
+#include "CpuSkinning.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// Math
+#include "MathSimd.h"
+
+namespace {
+
+	// 法線長さの二乗がこれ以下なら既定の向きにする（シェーダーと同じ値）
+	constexpr float kMinNormalLengthSq = 0.000001f;
+
+	/// <summary>
+	/// 1頂点のスキニング
+	/// 重み付きの行列和を作ってから1回だけ変換する（各行列で変換して足すのと同じ結果）
+	/// </summary>
+	void SkinVertex(const CpuSkinning::Vertex& input, const CpuSkinning::VertexInfluence& influence,
+		std::span<const CpuSkinning::WellForGPU> palette, CpuSkinning::Vertex& output) {
+		const int32_t paletteSize = static_cast<int32_t>(palette.size());
+
+		using namespace YMathSimd;
+		Float4 m0 = ZeroFloat4(), m1 = ZeroFloat4(), m2 = ZeroFloat4(), m3 = ZeroFloat4();
+		Float4 n0 = ZeroFloat4(), n1 = ZeroFloat4(), n2 = ZeroFloat4();
+
+		for (int i = 0; i < 4; ++i) {
+			const float weight = influence.weights[i];
+			const int32_t jointIndex = influence.jointindices[i];
+			if (weight == 0.0f || jointIndex < 0 || jointIndex >= paletteSize) { continue; }
+
+			const CpuSkinning::WellForGPU& well = palette[jointIndex];
+			const Float4 w = SplatFloat4(weight);
+			m0 = MultiplyAddFloat4(w, LoadFloat4(well.skeletonSpaceMatrix.m[0]), m0);
+			m1 = MultiplyAddFloat4(w, LoadFloat4(well.skeletonSpaceMatrix.m[1]), m1);
+			m2 = MultiplyAddFloat4(w, LoadFloat4(well.skeletonSpaceMatrix.m[2]), m2);
+			m3 = MultiplyAddFloat4(w, LoadFloat4(well.skeletonSpaceMatrix.m[3]), m3);
+			n0 = MultiplyAddFloat4(w, LoadFloat4(well.skeletonSpaceInverseTransposeMatrix.m[0]), n0);
+			n1 = MultiplyAddFloat4(w, LoadFloat4(well.skeletonSpaceInverseTransposeMatrix.m[1]), n1);
+			n2 = MultiplyAddFloat4(w, LoadFloat4(well.skeletonSpaceInverseTransposeMatrix.m[2]), n2);
+		}
+
+		// 位置（行ベクトル × 行列）
+		Float4 position = MulFloat4(SplatFloat4(input.position.x), m0);
+		position = MultiplyAddFloat4(SplatFloat4(input.position.y), m1, position);
+		position = MultiplyAddFloat4(SplatFloat4(input.position.z), m2, position);
+		position = MultiplyAddFloat4(SplatFloat4(input.position.w), m3, position);
+
+		// 法線（上3x3のみ）
+		Float4 normal = MulFloat4(SplatFloat4(input.normal.x), n0);
+		normal = MultiplyAddFloat4(SplatFloat4(input.normal.y), n1, normal);
+		normal = MultiplyAddFloat4(SplatFloat4(input.normal.z), n2, normal);
+
+		float p[4];
+		float n[4];
+		StoreFloat4(p, position);
+		StoreFloat4(n, normal);
+
+		output.position = { p[0], p[1], p[2], 1.0f };
+		output.texcoord = input.texcoord;
+
+		float lengthSq = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+		if (lengthSq > kMinNormalLengthSq) {
+			float invLength = 1.0f / std::sqrt(lengthSq);
+			output.normal = { n[0] * invLength, n[1] * invLength, n[2] * invLength };
+		} else {
+			output.normal = { 0.0f, 1.0f, 0.0f };
+		}
+	}
+}
+
+///************************* 基本関数 *************************///
+
+/// <summary>
+/// スキニング（頂点を均等に分割してスレッドへ割り当てる）
+/// </summary>
+void CpuSkinning::Skin(std::span<const Vertex> input, std::span<const VertexInfluence> influences,
+	std::span<const WellForGPU> palette, std::span<Vertex> output, uint32_t threadCount) {
+	const size_t vertexCount = std::min({ input.size(), influences.size(), output.size() });
+	if (vertexCount == 0) { return; }
+
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// 小さいメッシュは分割するとスレッド生成の方が高くつく
+	const size_t maxThreads = std::max<size_t>(1, vertexCount / kMinVerticesPerThread);
+	const size_t usedThreads = std::min<size_t>(threadCount, maxThreads);
+	if (usedThreads <= 1) {
+		SkinRange(input, influences, palette, output, 0, vertexCount);
+		return;
+	}
+
+	const size_t chunk = (vertexCount + usedThreads - 1) / usedThreads;
+	std::vector<std::thread> workers;
+	workers.reserve(usedThreads - 1);
+
+	for (size_t t = 1; t < usedThreads; ++t) {
+		size_t begin = t * chunk;
+		size_t end = std::min(vertexCount, begin + chunk);
+		if (begin >= end) { break; }
+		workers.emplace_back([=]() { SkinRange(input, influences, palette, output, begin, end); });
+	}
+
+	// 先頭の範囲は呼び出し元スレッドで処理
+	SkinRange(input, influences, palette, output, 0, std::min(chunk, vertexCount));
+
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+/// <summary>
+/// 指定範囲の頂点のみスキニング
+/// </summary>
+void CpuSkinning::SkinRange(std::span<const Vertex> input, std::span<const VertexInfluence> influences,
+	std::span<const WellForGPU> palette, std::span<Vertex> output, size_t begin, size_t end) {
+	assert(end <= input.size() && end <= influences.size() && end <= output.size());
+
+	for (size_t i = begin; i < end; ++i) {
+		SkinVertex(input[i], influences[i], palette, output[i]);
+	}
+}
+
+/// <summary>
+/// 2つの結果を比較
+/// </summary>
+CpuSkinning::VerificationResult CpuSkinning::Verify(std::span<const Vertex> expected, std::span<const Vertex> actual,
+	float positionTolerance, float normalTolerance) {
+	VerificationResult result;
+	result.vertexCount = std::min(expected.size(), actual.size());
+
+	float worstError = 0.0f;
+	for (size_t i = 0; i < result.vertexCount; ++i) {
+		const Vertex& e = expected[i];
+		const Vertex& a = actual[i];
+
+		float positionError = std::max({
+			std::fabs(e.position.x - a.position.x),
+			std::fabs(e.position.y - a.position.y),
+			std::fabs(e.position.z - a.position.z) });
+		float normalError = std::max({
+			std::fabs(e.normal.x - a.normal.x),
+			std::fabs(e.normal.y - a.normal.y),
+			std::fabs(e.normal.z - a.normal.z) });
+
+		result.maxPositionError = std::max(result.maxPositionError, positionError);
+		result.maxNormalError = std::max(result.maxNormalError, normalError);
+
+		if (positionError > positionTolerance || normalError > normalTolerance) {
+			++result.mismatchCount;
+		}
+
+		// 許容誤差で正規化した誤差が最大の頂点を記録
+		float error = std::max(positionError / positionTolerance, normalError / normalTolerance);
+		if (error > worstError) {
+			worstError = error;
+			result.worstVertex = i;
+		}
+	}
+
+	return result;
+}
+
+/// <summary>
+/// 計測
+/// </summary>
+CpuSkinning::BenchmarkResult CpuSkinning::Benchmark(std::span<const Vertex> input, std::span<const VertexInfluence> influences,
+	std::span<const WellForGPU> palette, std::span<Vertex> output, uint32_t iterations, uint32_t threadCount) {
+	BenchmarkResult result;
+	result.vertexCount = std::min({ input.size(), influences.size(), output.size() });
+	result.threadCount = threadCount == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threadCount;
+	result.iterations = std::max(1u, iterations);
+
+	// 1回目はキャッシュを温めるため計測しない
+	Skin(input, influences, palette, output, result.threadCount);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (uint32_t i = 0; i < result.iterations; ++i) {
+		Skin(input, influences, palette, output, result.threadCount);
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	result.averageMilliseconds = std::chrono::duration<double, std::milli>(end - start).count() / result.iterations;
+	return result;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+// C++
+#include <array>
+#include <cstdint>
+#include <span>
+
+// Math
+#include "Matrix4x4.h"
+#include "Vector4.h"
+#include "Vector3.h"
+#include "Vector2.h"
+
+/// <summary>
+/// CPU スキニング
+/// SkinningCS と同じ頂点 / インフルエンス / パレット形式を入力に取り、デバイス無しで同じ結果を出す
+/// ヘッドレス実行、スキンメッシュへの CPU 側クエリ、GPU 結果の検証に使う
+/// </summary>
+class CpuSkinning
+{
+public:
+	///************************* 構造体定義 *************************///
+
+	// 頂点データ（Skinning.CS.hlsl の Vertex と同じ並び）
+	struct Vertex {
+		Vector4 position;
+		Vector2 texcoord;
+		Vector3 normal;
+	};
+
+	// 頂点影響情報（最大4ジョイント）
+	struct VertexInfluence {
+		std::array<float, 4> weights;
+		std::array<int32_t, 4> jointindices;
+	};
+
+	// パレット1要素（Skinning.CS.hlsl の Well と同じ並び）
+	struct WellForGPU {
+		Matrix4x4 skeletonSpaceMatrix;
+		Matrix4x4 skeletonSpaceInverseTransposeMatrix;
+	};
+
+	// 検証結果
+	struct VerificationResult {
+		size_t vertexCount = 0;        // 比較した頂点数
+		size_t mismatchCount = 0;      // 許容誤差を超えた頂点数
+		size_t worstVertex = 0;        // 最大誤差の頂点
+		float maxPositionError = 0.0f; // 位置の最大誤差
+		float maxNormalError = 0.0f;   // 法線の最大誤差
+
+		bool IsValid() const { return mismatchCount == 0; }
+	};
+
+	// 計測結果
+	struct BenchmarkResult {
+		size_t vertexCount = 0;
+		uint32_t threadCount = 0;
+		uint32_t iterations = 0;
+		double averageMilliseconds = 0.0;
+
+		// 1秒あたりの処理頂点数（百万）
+		double GetMegaVerticesPerSecond() const {
+			return averageMilliseconds <= 0.0 ? 0.0 : static_cast<double>(vertexCount) / (averageMilliseconds * 1000.0);
+		}
+	};
+
+	// 1スレッドに割り当てる最小頂点数（これ未満なら分割しない）
+	static constexpr size_t kMinVerticesPerThread = 4096;
+
+public:
+	///************************* 基本関数 *************************///
+
+	// スキニング（threadCount が 0 ならハードウェアスレッド数）
+	static void Skin(std::span<const Vertex> input, std::span<const VertexInfluence> influences,
+		std::span<const WellForGPU> palette, std::span<Vertex> output, uint32_t threadCount = 0);
+
+	// 指定範囲の頂点のみスキニング
+	static void SkinRange(std::span<const Vertex> input, std::span<const VertexInfluence> influences,
+		std::span<const WellForGPU> palette, std::span<Vertex> output, size_t begin, size_t end);
+
+	// 2つの結果を比較
+	static VerificationResult Verify(std::span<const Vertex> expected, std::span<const Vertex> actual,
+		float positionTolerance = 1.0e-3f, float normalTolerance = 1.0e-2f);
+
+	// 計測
+	static BenchmarkResult Benchmark(std::span<const Vertex> input, std::span<const VertexInfluence> influences,
+		std::span<const WellForGPU> palette, std::span<Vertex> output, uint32_t iterations, uint32_t threadCount = 0);
+};
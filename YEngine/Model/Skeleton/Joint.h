@@ -13,21 +13,15 @@
 #include "Quaternion.h"
 #include "Vector3.h"
 
+class Skeleton;
+
 // ジョイントクラス
+// 姿勢と行列は Skeleton 側の SoA 配列に置き、ジョイントは名前と階層情報を持つハンドルとして扱う
 class Joint
 {
 public:
 	///************************* 基本関数 *************************///
 
-	// 初期化
-	void Initialize();
-
-	// ジョイント更新
-	void Update(std::vector<Joint>& joints);
-
-	// ジョイント作成
-	static int32_t CreateJoint(const Node& node, const std::optional<int32_t>& parent, std::vector<Joint>& joints);
-
 	// ジョイント位置抽出
 	static Vector3 ExtractJointPosition(const Joint& joint);
 
@@ -35,10 +29,11 @@ public:
 	///************************* アクセッサ *************************///
 
 	// トランスフォーム設定
-	void SetTransform(const QuaternionTransform& _transform) { transform_ = _transform; }
+	void SetTransform(const QuaternionTransform& _transform);
+	QuaternionTransform GetTransform() const;
 
 	// スケルトンスペース行列取得
-	Matrix4x4 GetSkeletonSpaceMatrix() const { return skeletonSpaceMatrix_; }
+	const Matrix4x4& GetSkeletonSpaceMatrix() const;
 
 	// 名前取得
 	const std::string& GetName() const { return name_; }
@@ -49,23 +44,22 @@ public:
 	// 親ジョイント取得
 	std::optional<int32_t>& GetParent() { return parent_; }
 
-	// ワールドトランスフォーム取得
-	WorldTransform& GetWorldTransform() { return wt_; }
+	// 子ジョイント取得
+	const std::vector<int32_t>& GetChildren() const { return children_; }
 
-private:
-	///************************* メンバ変数 *************************///
+	// ワールドトランスフォーム取得（初回取得時にアタッチ対象として登録され、以降スケルトン更新時に計算される）
+	WorldTransform& GetWorldTransform();
 
-	// ワールドトランスフォーム
-	WorldTransform wt_;
+private:
+	friend class Skeleton;
 
-	// トランスフォーム
-	QuaternionTransform transform_;
+	///************************* メンバ変数 *************************///
 
-	// ローカル行列
-	Matrix4x4 localMatrix_;
+	// 所属するスケルトン
+	Skeleton* skeleton_ = nullptr;
 
-	// スケルトンスペース行列
-	Matrix4x4 skeletonSpaceMatrix_;
+	// ワールドトランスフォーム（アタッチされたジョイントのみ更新）
+	WorldTransform wt_;
 
 	// ジョイント名
 	std::string name_;
@@ -74,8 +68,11 @@ private:
 	std::vector<int32_t> children_;
 
 	// 自身のインデックス
-	int32_t index_;
+	int32_t index_ = 0;
 
 	// 親ジョイントのインデックス
 	std::optional<int32_t> parent_;
+
+	// ワールドトランスフォームを参照されているか
+	bool isAttached_ = false;
 };
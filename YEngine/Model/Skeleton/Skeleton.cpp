@@ -1,30 +1,85 @@
 #include "Skeleton.h"
 #include "Drawer/LineManager/Line.h"
+#include "TransformBatch.h"
+
+// C++
+#include <algorithm>
 
 void Skeleton::Create(const Node& rootNode)
 {
-	root_ = Joint::CreateJoint(rootNode, {}, joints_);
+	root_ = CreateJoint(rootNode, {});
 
 	// 名前とindexのマッピングを行いアクセスしやすくなる
 	for ( Joint& joint : joints_) {
 		jointMap_.emplace(joint.GetName() , joint.GetIndex());
 
-		joint.Initialize();
-
 		if (joint.GetParent().has_value()) {
 			connections_.emplace_back(joint.GetParent().value(), joint.GetIndex());
 		}
 	}
 
+	// 初期姿勢のモデル空間行列を求めておく
+	localMatrices_.resize(joints_.size());
+	modelMatrices_.resize(joints_.size());
+	localDirty_.assign(joints_.size(), 1);
+	modelDirty_.assign(joints_.size(), 1);
+	Update();
 }
 
 void Skeleton::Update()
 {
-	// すべてのJointを更新。親が若いので通常ループで処理が可能になっている
-	for (Joint& joint : joints_) {
-	
-		joint.Update(joints_);
+	const size_t jointCount = parentIndices_.size();
+
+	// ローカル行列は親に依存しないので先に作る
+	// アニメーション再生中は全ジョイントが変わるので、SoA 配列のまままとめて行列化する
+	const size_t localDirtyCount = static_cast<size_t>(std::count(localDirty_.begin(), localDirty_.end(), uint8_t(1)));
+	if (localDirtyCount == jointCount) {
+		MakeAffineMatrices(localScales_, localRotates_, localTranslates_, localMatrices_);
+	} else if (localDirtyCount > 0) {
+		for (size_t i = 0; i < jointCount; ++i) {
+			if (localDirty_[i]) {
+				localMatrices_[i] = MakeAffineMatrix(localScales_[i], localRotates_[i], localTranslates_[i]);
+			}
+		}
+	}
+
+	// 親が必ず先に並んでいるので、1回の線形ループで親の行列とダーティ状態を参照できる
+	for (size_t i = 0; i < jointCount; ++i) {
+		int32_t parent = parentIndices_[i];
+		bool dirty = localDirty_[i] || (parent >= 0 && modelDirty_[parent]);
+		modelDirty_[i] = dirty ? 1 : 0;
+		localDirty_[i] = 0;
+		if (!dirty) { continue; }
+
+		modelMatrices_[i] = (parent < 0) ? localMatrices_[i] : localMatrices_[i] * modelMatrices_[parent];
 	}
+
+	// 武器などが接続されているジョイントだけワールド行列を求める（親のワールド行列は毎フレーム変わりうる）
+	for (int32_t index : attachedJoints_) {
+		UpdateAttachedJoint(index);
+	}
+}
+
+void Skeleton::SetLocalTransform(int32_t index, const QuaternionTransform& transform)
+{
+	const Quaternion& rotate = localRotates_[index];
+	bool changed =
+		localScales_[index] != transform.scale ||
+		localTranslates_[index] != transform.translate ||
+		rotate.x != transform.rotate.x || rotate.y != transform.rotate.y ||
+		rotate.z != transform.rotate.z || rotate.w != transform.rotate.w;
+	if (!changed) { return; }
+
+	localScales_[index] = transform.scale;
+	localRotates_[index] = transform.rotate;
+	localTranslates_[index] = transform.translate;
+	localDirty_[index] = 1;
+}
+
+void Skeleton::AttachJoint(int32_t index)
+{
+	attachedJoints_.push_back(index);
+	UpdateAttachedJoint(index);
 }
 
 void Skeleton::Draw(Line& line, const Matrix4x4& worldMatrix)
@@ -33,19 +88,47 @@ void Skeleton::Draw(Line& line, const Matrix4x4& worldMatrix)
 		return;
 	}
 
+	// 全ジョイントの位置をまとめてワールド座標へ変換
+	drawPositions_.resize(modelMatrices_.size());
+	for (size_t i = 0; i < modelMatrices_.size(); ++i) {
+		drawPositions_[i] = ExtractTranslation(modelMatrices_[i]);
+	}
+	TransformPoints(drawPositions_, worldMatrix, drawPositions_);
+
 	// スケルトン内の全ての接続を描画
 	for (const auto& connection : connections_) {
-		int32_t parentIndex = connection.first;
-		int32_t childIndex = connection.second;
-
-		// 親ジョイントと子ジョイントのワールド座標を取得
-		const Vector3& parentPosition = Joint::ExtractJointPosition(joints_[parentIndex]);
-		const Vector3& childPosition = Joint::ExtractJointPosition(joints_[childIndex]);
-		
-		Vector3 parentWorld = Transform(parentPosition, worldMatrix);
-		Vector3 childWorld = Transform(childPosition, worldMatrix);
-		
-		line.RegisterLine(parentWorld, childWorld);
+		line.RegisterLine(drawPositions_[connection.first], drawPositions_[connection.second]);
 	}
 	line.DrawLine();
 }
+
+int32_t Skeleton::CreateJoint(const Node& node, const std::optional<int32_t>& parent)
+{
+	int32_t index = static_cast<int32_t>(joints_.size()); // 現在登録されているIndexに
+
+	Joint& joint = joints_.emplace_back();
+	joint.skeleton_ = this;
+	joint.name_ = node.name_;
+	joint.index_ = index;
+	joint.parent_ = parent;
+
+	// SoA 配列へ初期姿勢を登録
+	parentIndices_.push_back(parent ? *parent : -1);
+	localScales_.push_back(node.transform_.scale);
+	localRotates_.push_back(node.transform_.rotate);
+	localTranslates_.push_back(node.transform_.translate);
+
+	for (const Node& child : node.children_) {
+		// 子Jointを作成し、そのIndex
+		int32_t childIndex = CreateJoint(child, index);
+		joints_[index].children_.push_back(childIndex);
+	}
+	// 自身のIndexを返す
+	return index;
+}
+
+void Skeleton::UpdateAttachedJoint(int32_t index)
+{
+	WorldTransform& wt = joints_[index].wt_;
+	wt.matWorld_ = rootParent_ ? modelMatrices_[index] * rootParent_->matWorld_ : modelMatrices_[index];
+}
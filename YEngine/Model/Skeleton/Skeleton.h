@@ -21,10 +21,16 @@ class Skeleton
 public:
 	///************************* 基本関数 *************************///
 
+	Skeleton() = default;
+
+	// ジョイントが自身へのポインタを持つためコピー・移動禁止
+	Skeleton(const Skeleton&) = delete;
+	Skeleton& operator=(const Skeleton&) = delete;
+
 	// スケルトン作成
 	void Create(const Node& rootNode);
 
-	// スケルトン更新
+	// スケルトン更新（親が先に並んだ配列を1回走査してモデル空間行列を求める）
 	void Update();
 
 	// スケルトン描画
@@ -59,13 +65,42 @@ public:
 	}
 
 	// ルートの親設定
-	void SetRootParent(WorldTransform* parent) {
-		joints_[root_].GetWorldTransform().parent_ = parent;
-	}
+	void SetRootParent(const WorldTransform* parent) { rootParent_ = parent; }
 
 	// 接続情報取得
 	std::vector<std::pair<int32_t, int32_t>>& GetConnections() { return connections_; }
 
+	// ジョイント数取得
+	size_t GetJointCount() const { return parentIndices_.size(); }
+
+	// 親インデックス配列取得（ルートは -1）
+	const std::vector<int32_t>& GetParentIndices() const { return parentIndices_; }
+
+	// ローカル姿勢（値が変わったときだけダーティにする）
+	void SetLocalTransform(int32_t index, const QuaternionTransform& transform);
+	QuaternionTransform GetLocalTransform(int32_t index) const {
+		return { localScales_[index], localRotates_[index], localTranslates_[index] };
+	}
+
+	// モデル空間行列取得
+	const Matrix4x4& GetModelMatrix(int32_t index) const { return modelMatrices_[index]; }
+	const std::vector<Matrix4x4>& GetModelMatrices() const { return modelMatrices_; }
+
+	// 直前の Update でモデル空間行列が変化したジョイント（0 / 1）
+	const std::vector<uint8_t>& GetModelDirtyFlags() const { return modelDirty_; }
+
+	// ワールドトランスフォームを毎フレーム更新するジョイントとして登録
+	void AttachJoint(int32_t index);
+
+private:
+	///************************* 内部処理 *************************///
+
+	// ノードからジョイントを再帰的に作成
+	int32_t CreateJoint(const Node& node, const std::optional<int32_t>& parent);
+
+	// アタッチされたジョイントのワールド行列を更新
+	void UpdateAttachedJoint(int32_t index);
+
 private:
 	///************************* メンバ変数 *************************///
 
@@ -80,4 +115,33 @@ private:
 
 	// 接続情報
 	std::vector<std::pair<int32_t, int32_t>> connections_;
+
+	///************************* SoA 配列 *************************///
+
+	// 親インデックス（トポロジカル順、ルートは -1）
+	std::vector<int32_t> parentIndices_;
+
+	// ローカル姿勢
+	std::vector<Vector3> localScales_;
+	std::vector<Quaternion> localRotates_;
+	std::vector<Vector3> localTranslates_;
+
+	// ローカル行列（ローカル姿勢が変わったときだけ作り直す）
+	std::vector<Matrix4x4> localMatrices_;
+
+	// モデル空間行列
+	std::vector<Matrix4x4> modelMatrices_;
+
+	// ダーティフラグ（ローカル姿勢の変更 / 親から伝播したモデル行列の変更）
+	std::vector<uint8_t> localDirty_;
+	std::vector<uint8_t> modelDirty_;
+
+	// ワールドトランスフォームを参照されているジョイント
+	std::vector<int32_t> attachedJoints_;
+
+	// デバッグ描画用のジョイント位置（毎回の確保を避けるため保持）
+	std::vector<Vector3> drawPositions_;
+
+	// ルートの親
+	const WorldTransform* rootParent_ = nullptr;
 };
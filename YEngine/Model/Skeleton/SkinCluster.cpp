@@ -7,31 +7,120 @@
 #include "../ModelUtils.h"
 #include "Debugger/Logger.h"
 
+// Math
+#include "MathSimd.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+	// 行列式がこれ以下なら逆行列を取らない
+	constexpr float kDeterminantEpsilon = 1.0e-12f;
+
+	/// <summary>
+	/// 法線行列（上3x3の逆転置）を最大4ジョイント分まとめて計算する
+	/// 逆転置は余因子行列 / 行列式に等しく、余因子行列の各行は残り2行の外積で求まる
+	/// シェーダーは上3x3しか使わないので、平行移動成分は持たせない
+	/// </summary>
+	void ComputeNormalMatrices(const Matrix4x4* const (&src)[4], Matrix4x4* const (&dst)[4], size_t count) {
+		using namespace YMathSimd;
+
+		// a[r][c] の各レーンに4ジョイント分を並べる
+		Float4 a[3][3];
+		for (int r = 0; r < 3; ++r) {
+			for (int c = 0; c < 3; ++c) {
+				a[r][c] = SetFloat4(src[0]->m[r][c], src[1]->m[r][c], src[2]->m[r][c], src[3]->m[r][c]);
+			}
+		}
+
+		auto cross = [](const Float4(&u)[3], const Float4(&v)[3], Float4(&out)[3]) {
+			out[0] = SubFloat4(MulFloat4(u[1], v[2]), MulFloat4(u[2], v[1]));
+			out[1] = SubFloat4(MulFloat4(u[2], v[0]), MulFloat4(u[0], v[2]));
+			out[2] = SubFloat4(MulFloat4(u[0], v[1]), MulFloat4(u[1], v[0]));
+			};
+
+		Float4 cof[3][3];
+		cross(a[1], a[2], cof[0]);
+		cross(a[2], a[0], cof[1]);
+		cross(a[0], a[1], cof[2]);
+
+		// 行列式（特異なレーンは 1 として余因子行列をそのまま使う）
+		Float4 det = MulFloat4(a[0][0], cof[0][0]);
+		det = MultiplyAddFloat4(a[0][1], cof[0][1], det);
+		det = MultiplyAddFloat4(a[0][2], cof[0][2], det);
+		float dets[4];
+		StoreFloat4(dets, det);
+		for (float& d : dets) {
+			if (!(std::fabs(d) > kDeterminantEpsilon)) { d = 1.0f; }
+		}
+		const Float4 invDet = DivFloat4(SplatFloat4(1.0f), LoadFloat4(dets));
+
+		float lanes[3][3][4];
+		for (int r = 0; r < 3; ++r) {
+			for (int c = 0; c < 3; ++c) {
+				StoreFloat4(lanes[r][c], MulFloat4(cof[r][c], invDet));
+			}
+		}
 
-void SkinCluster::UpdateMatrixPalette(const std::vector<Joint>& joints) {
-	if (matrixCache_.size() != joints.size()) {
-		matrixCache_.resize(joints.size());
+		for (size_t lane = 0; lane < count; ++lane) {
+			Matrix4x4& out = *dst[lane];
+			for (int r = 0; r < 3; ++r) {
+				out.m[r][0] = lanes[r][0][lane];
+				out.m[r][1] = lanes[r][1][lane];
+				out.m[r][2] = lanes[r][2][lane];
+				out.m[r][3] = 0.0f;
+			}
+			out.m[3][0] = 0.0f; out.m[3][1] = 0.0f; out.m[3][2] = 0.0f; out.m[3][3] = 1.0f;
+		}
 	}
+}
 
 
-	for (size_t jointIndex = 0; jointIndex < joints.size(); ++jointIndex) {
+void SkinCluster::UpdateMatrixPalette(const Skeleton& skeleton) {
+	const std::vector<Matrix4x4>& modelMatrices = skeleton.GetModelMatrices();
+	const std::vector<uint8_t>& dirtyFlags = skeleton.GetModelDirtyFlags();
+	const size_t jointCount = std::min(modelMatrices.size(), mappedPalette_.size());
 
-		const Matrix4x4& current = joints[jointIndex].GetSkeletonSpaceMatrix();
-		Matrix4x4 finalMatrix = inverseBindposeMatrices_[jointIndex] * current;
-		mappedPalette_[jointIndex].skeletonSpaceMatrix = finalMatrix;
+	if (palette_.size() != jointCount) {
+		palette_.resize(jointCount);
+		dirtyJoints_.reserve(jointCount);
+		isPaletteValid_ = false;
+	}
+
+	// モデル空間行列が変化したジョイントだけを集める（初回は全て）
+	dirtyJoints_.clear();
+	for (size_t jointIndex = 0; jointIndex < jointCount; ++jointIndex) {
+		if (!isPaletteValid_ || dirtyFlags[jointIndex]) {
+			dirtyJoints_.push_back(static_cast<int32_t>(jointIndex));
+		}
+	}
+	isPaletteValid_ = true;
+	if (dirtyJoints_.empty()) { return; }
+
+	// スキニング行列（バインドポーズ逆行列 × モデル空間行列）
+	for (int32_t jointIndex : dirtyJoints_) {
+		YMathSimd::MultiplyMatrix(inverseBindposeMatrices_[jointIndex].m, modelMatrices[jointIndex].m, palette_[jointIndex].skeletonSpaceMatrix.m);
+	}
 
-		// キャッシュが有効で、行列が変わっていなければ再利用
-		if (matrixCache_[jointIndex].valid && matrixCache_[jointIndex].lastMatrix == finalMatrix) {
-			mappedPalette_[jointIndex].skeletonSpaceInverseTransposeMatrix = matrixCache_[jointIndex].inverseTranspose;
-		} else {
-			// 計算＆キャッシュ保存
-			Matrix4x4 inverseT = TransPose(Inverse(finalMatrix));
-			mappedPalette_[jointIndex].skeletonSpaceInverseTransposeMatrix = inverseT;
-			matrixCache_[jointIndex].lastMatrix = finalMatrix;
-			matrixCache_[jointIndex].inverseTranspose = inverseT;
-			matrixCache_[jointIndex].valid = true;
+	// 法線行列は4ジョイントずつまとめて計算
+	for (size_t i = 0; i < dirtyJoints_.size(); i += 4) {
+		const size_t count = std::min<size_t>(4, dirtyJoints_.size() - i);
+		const Matrix4x4* src[4];
+		Matrix4x4* dst[4];
+		for (size_t lane = 0; lane < 4; ++lane) {
+			// 端数のレーンは先頭を複製して埋める（書き込みはしない）
+			int32_t jointIndex = dirtyJoints_[i + std::min(lane, count - 1)];
+			src[lane] = &palette_[jointIndex].skeletonSpaceMatrix;
+			dst[lane] = &palette_[jointIndex].skeletonSpaceInverseTransposeMatrix;
 		}
+		ComputeNormalMatrices(src, dst, count);
+	}
 
+	// アップロードバッファへは変化したものだけを順に書き込む（読み戻しはしない）
+	for (int32_t jointIndex : dirtyJoints_) {
+		mappedPalette_[jointIndex] = palette_[jointIndex];
 	}
 }
 
@@ -110,9 +199,10 @@ void SkinCluster::CreateResourceCS(size_t jointsSize, size_t verticesSize, std::
 		vertexOffset += meshVertexCount;
 	}
 
-	// 正規化＋4つまでに絞って書き込み
+	// 正規化＋4つまでに絞って書き込み（CPU スキニング用に複製を持ち、まとめて転送する）
+	influences_.assign(verticesSize, VertexInfluence{});
 	for (const auto& [vertexIndex, influences] : tempInfluences) {
-		auto& dst = mappedInfluence_[vertexIndex];
+		auto& dst = influences_[vertexIndex];
 
 		auto sorted = influences;
 		std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
@@ -137,6 +227,7 @@ void SkinCluster::CreateResourceCS(size_t jointsSize, size_t verticesSize, std::
 		}
 	}
 
+	std::memcpy(mappedInfluence_.data(), influences_.data(), sizeof(VertexInfluence) * verticesSize);
 
 	rootSignature_ = ComputeShaderManager::GetInstance()->GetRootSignature("SkinningCS");
 	graphicsPipelineState_ = ComputeShaderManager::GetInstance()->GetComputePipelineState("SkinningCS");
@@ -148,6 +239,7 @@ void SkinCluster::SetInputVertices(const std::vector<Vertex>& vertices) {
 	assert(mappedInputVertices_);
 	assert(vertices.size() <= mappedInfluence_.size());
 	std::memcpy(mappedInputVertices_, vertices.data(), sizeof(Vertex) * vertices.size());
+	inputVertices_ = vertices;
 }
 
 
@@ -224,6 +316,71 @@ void SkinCluster::ExecuteSkinningCS()
 
 }
 
+void SkinCluster::ExecuteSkinningCPU(uint32_t threadCount)
+{
+	cpuSkinnedVertices_.resize(inputVertices_.size());
+	CpuSkinning::Skin(inputVertices_, influences_, palette_, cpuSkinnedVertices_, threadCount);
+}
+
+CpuSkinning::BenchmarkResult SkinCluster::BenchmarkSkinningCPU(uint32_t iterations, uint32_t threadCount)
+{
+	cpuSkinnedVertices_.resize(inputVertices_.size());
+	return CpuSkinning::Benchmark(inputVertices_, influences_, palette_, cpuSkinnedVertices_, iterations, threadCount);
+}
+
+void SkinCluster::RecordReadback()
+{
+	auto* dxCommon = YoRigine::DirectXCommon::GetInstance();
+	const size_t sizeInBytes = sizeof(Vertex) * inputVertices_.size();
+	if (sizeInBytes == 0) { return; }
+
+	if (!readbackResource_) {
+		readbackResource_ = dxCommon->CreateBufferResourceReadback(sizeInBytes);
+	}
+
+	dxCommon->TransitionBarrier(outputResource_.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+	dxCommon->GetCommandList()->CopyBufferRegion(readbackResource_.Get(), 0, outputResource_.Get(), 0, sizeInBytes);
+	dxCommon->TransitionBarrier(outputResource_.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+	// ディスパッチ時と同じパレットで CPU 側の期待値を作っておく
+	ExecuteSkinningCPU();
+
+	isReadbackRequested_ = false;
+	isReadbackPending_ = true;
+}
+
+std::optional<CpuSkinning::VerificationResult> SkinCluster::VerifyReadback()
+{
+	if (!isReadbackPending_) { return std::nullopt; }
+
+	// コピーを積んだフレームの完了を待つ
+	YoRigine::DirectXCommon::GetInstance()->WaitForAllFrames();
+
+	const size_t vertexCount = cpuSkinnedVertices_.size();
+	Vertex* mapped = nullptr;
+	D3D12_RANGE readRange{ 0, sizeof(Vertex) * vertexCount };
+	HRESULT hr = readbackResource_->Map(0, &readRange, reinterpret_cast<void**>(&mapped));
+	if (FAILED(hr)) {
+		Logger("SkinCluster : 読み戻しバッファのマップに失敗しました\n");
+		isReadbackPending_ = false;
+		return std::nullopt;
+	}
+
+	CpuSkinning::VerificationResult result = CpuSkinning::Verify(cpuSkinnedVertices_, { mapped, vertexCount });
+
+	D3D12_RANGE writeRange{ 0, 0 };
+	readbackResource_->Unmap(0, &writeRange);
+
+	Logger("SkinCluster 検証 : 頂点 " + std::to_string(result.vertexCount)
+		+ " / 不一致 " + std::to_string(result.mismatchCount)
+		+ " / 最大位置誤差 " + std::to_string(result.maxPositionError)
+		+ " / 最大法線誤差 " + std::to_string(result.maxNormalError) + "\n");
+
+	isReadbackPending_ = false;
+	lastVerification_ = result;
+	return result;
+}
+
 SkinCluster::~SkinCluster()
 {
 	if (paletteResource_) {
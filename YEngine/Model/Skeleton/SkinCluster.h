@@ -15,6 +15,7 @@
 #include "Joint.h"
 #include "../Node/Node.h"
 #include "Skeleton.h"
+#include "CpuSkinning.h"
 
 // Math
 #include "Quaternion.h"
@@ -44,42 +45,25 @@ public:
 	// 最大影響数
 	static const uint32_t kNumMaxInfluence = 4u;
 
-	// 頂点影響情報
-	struct VertexInfluence {
-		std::array<float, 4> weights;
-		std::array<int32_t, 4> jointindices;
-	};
+	// 頂点影響情報（CPU スキニングと共通）
+	using VertexInfluence = CpuSkinning::VertexInfluence;
 
-	// GPU用マトリックス
-	struct WellForGPU {
-		Matrix4x4 skeletonSpaceMatrix;
-		Matrix4x4 skeletonSpaceInverseTransposeMatrix;
-	};
+	// GPU用マトリックス（CPU スキニングと共通）
+	using WellForGPU = CpuSkinning::WellForGPU;
 
 	// スキニング情報
 	struct SkinningInformation {
 		uint32_t numVertices;
 	};
 
-	// 頂点データ
-	struct Vertex {
-		Vector4 position;
-		Vector2 texcoord;
-		Vector3 normal;
-	};
-
-	// 法線計算用キャッシュ
-	struct MatrixCache {
-		Matrix4x4 lastMatrix;
-		Matrix4x4 inverseTranspose;
-		bool valid = false;
-	};
+	// 頂点データ（CPU スキニングと共通）
+	using Vertex = CpuSkinning::Vertex;
 
 public:
 	///************************* 基本関数 *************************///
 
-	// マトリクスパレット更新
-	void UpdateMatrixPalette(const std::vector<Joint>& joints);
+	// マトリクスパレット更新（スケルトンのダーティフラグが立ったジョイントのみ再計算）
+	void UpdateMatrixPalette(const Skeleton& skeleton);
 
 	// コンピュートリソース作成
 	void CreateResourceCS(size_t jointsSize, size_t verticesSize, std::map<std::string, int32_t> jointMap);
@@ -93,6 +77,22 @@ public:
 	// スキニング実行
 	void ExecuteSkinningCS();
 
+	// CPU でスキニング実行（結果は GetCpuSkinnedVertices で取得）
+	void ExecuteSkinningCPU(uint32_t threadCount = 0);
+
+	// CPU スキニングの計測
+	CpuSkinning::BenchmarkResult BenchmarkSkinningCPU(uint32_t iterations, uint32_t threadCount = 0);
+
+	// GPU 出力の読み戻しを要求（次の描画で RecordReadback が呼ばれる）
+	void RequestReadback() { isReadbackRequested_ = true; }
+	bool IsReadbackRequested() const { return isReadbackRequested_; }
+
+	// 出力を読み戻し用バッファへコピーするコマンドを積む（出力は UAV 状態であること）
+	void RecordReadback();
+
+	// 読み戻した GPU 出力を CPU スキニング結果と比較（コピーを積んだフレームの完了後に呼ぶ）
+	std::optional<CpuSkinning::VerificationResult> VerifyReadback();
+
 	// 終了処理
 	void Finalize();
 
@@ -139,10 +139,21 @@ public:
 
 	// 各メッシュデータ
 	void SetSkinClusterDataPerMesh(const std::vector<std::map<std::string, JointWeightData>>& allData) { allMeshJointData_ = allData; }
+	const std::vector<std::map<std::string, JointWeightData>>& GetSkinClusterDataPerMesh() const { return allMeshJointData_; }
+
+	// 各メッシュの頂点数（LoadFromScene を通さない場合は設定する）
+	void SetMeshVertexCounts(const std::vector<size_t>& counts) { meshVertexCounts_ = counts; }
+	const std::vector<size_t>& GetMeshVertexCounts() const { return meshVertexCounts_; }
 
 	// READBACKリソース
 	ID3D12Resource* GetReadbackResource() const { return readbackResource_.Get(); }
 
+	// CPU スキニング結果
+	const std::vector<Vertex>& GetCpuSkinnedVertices() const { return cpuSkinnedVertices_; }
+
+	// 最後の検証結果
+	const std::optional<CpuSkinning::VerificationResult>& GetLastVerification() const { return lastVerification_; }
+
 private:
 	///************************* メンバ変数 *************************///
 
@@ -175,12 +186,22 @@ private:
 	std::vector<size_t> meshVertexOffset_;
 	std::vector<size_t> meshVertexCounts_;
 
-	// キャッシュ関連
-	std::vector<MatrixCache> matrixCache_;
+	// パレット更新関連（CPU側の複製。アップロードバッファからは読まない）
+	std::vector<WellForGPU> palette_;
+	std::vector<int32_t> dirtyJoints_;
+	bool isPaletteValid_ = false;
 
 	// GPUリソース
 	Microsoft::WRL::ComPtr<ID3D12Resource> readbackResource_;
 
+	// CPU スキニング関連（アップロードバッファの内容の CPU 側複製）
+	std::vector<Vertex> inputVertices_;
+	std::vector<VertexInfluence> influences_;
+	std::vector<Vertex> cpuSkinnedVertices_;
+	bool isReadbackRequested_ = false;
+	bool isReadbackPending_ = false;
+	std::optional<CpuSkinning::VerificationResult> lastVerification_;
+
 	// パイプライン
 	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_ = nullptr;
 	Microsoft::WRL::ComPtr<ID3D12PipelineState> graphicsPipelineState_ = nullptr;
@@ -73,8 +73,8 @@ namespace YoRigine {
 
 		const OBB& ob = obb->GetOBB();
 
-		// 回転行列を作成（オイラー角 → 回転行列）
-		Matrix4x4 rotMat = MakeRotateMatrixXYZ(ob.rotation);
+		// 回転行列（OBBが保持しているものをそのまま使う）
+		const Matrix4x4& rotMat = ob.rotation;
 
 		// ワールド→ローカル変換：回転行列の転置を使う（回転の逆）
 		Matrix4x4 invRot = TransPose(rotMat);
@@ -109,8 +109,8 @@ namespace YoRigine {
 		}
 
 		// 回転行列を取得
-		Matrix4x4 matA = MakeRotateMatrixXYZ(obbA.rotation);
-		Matrix4x4 matB = MakeRotateMatrixXYZ(obbB.rotation);
+		const Matrix4x4& matA = obbA.rotation;
+		const Matrix4x4& matB = obbB.rotation;
 
 		// 各OBBの軸を抽出
 		Vector3 axesA[3] = {
@@ -190,7 +190,7 @@ namespace YoRigine {
 		OBB aabbAsOBB;
 		aabbAsOBB.center = (aabb->GetAABB().min + aabb->GetAABB().max) * 0.5f;
 		aabbAsOBB.size = (aabb->GetAABB().max - aabb->GetAABB().min) * 0.5f;
-		aabbAsOBB.rotation = { 0.0f,0.0f,0.0f };
+		aabbAsOBB.rotation = MakeIdentity4x4();
 		return Collision::Check(aabbAsOBB, obb->GetOBB());
 
 	}
@@ -259,7 +259,7 @@ namespace YoRigine {
 		OBB aabbAcObb;
 		aabbAcObb.center = (aabb.min + aabb.max) * 0.5f;
 		aabbAcObb.size = (aabb.max - aabb.min) * 0.5f;
-		aabbAcObb.rotation = { 0.0f,0.0f,0.0f }; // AABBは回転しない
+		aabbAcObb.rotation = MakeIdentity4x4(); // AABBは回転しない
 
 		HitDirection dir;
 		bool hit = CheckHitDirection(aabbAcObb, obb, &dir);
@@ -275,8 +275,8 @@ namespace YoRigine {
 		const float EPSILON = 1e-6f; // 数値的に安定した閾値
 
 		// 回転行列取得
-		Matrix4x4 matA = MakeRotateMatrixXYZ(obbA.rotation);
-		Matrix4x4 matB = MakeRotateMatrixXYZ(obbB.rotation);
+		const Matrix4x4& matA = obbA.rotation;
+		const Matrix4x4& matB = obbB.rotation;
 
 		// 各OBBの軸を抽出
 		Vector3 axesA[3] = {
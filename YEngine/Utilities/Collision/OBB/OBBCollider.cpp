@@ -4,6 +4,7 @@
 void OBBCollider::InitJson(YoRigine::JsonManager* jsonManager)
 {
 	jsonManager->SetCategory("Colliders");
+	jsonManager->BeginRegister();
 
 	jsonManager->Register("OBB Offset Center X", &obbOffset_.center.x);
 	jsonManager->Register("OBB Offset Center Y", &obbOffset_.center.y);
@@ -14,6 +15,7 @@ void OBBCollider::InitJson(YoRigine::JsonManager* jsonManager)
 	jsonManager->Register("OBB Offset Size Z", &obbOffset_.size.z);
 
 	jsonManager->Register("OBB Offset Euler (degrees)", &obbEulerOffset_);
+	jsonManager->EndRegister();
 }
 
 Vector3 OBBCollider::GetCenterPosition() const
@@ -63,8 +65,6 @@ void OBBCollider::Update()
 		worldMatrix.m[3][2]
 	};
 
-	Vector3 worldRotation = MatrixToEuler(worldMatrix);
-
 	// スケールを抽出（各軸のベクトルの長さ）
 	Vector3 worldScale = {
 		Length(Vector3(worldMatrix.m[0][0], worldMatrix.m[0][1], worldMatrix.m[0][2])),
@@ -72,6 +72,16 @@ void OBBCollider::Update()
 		Length(Vector3(worldMatrix.m[2][0], worldMatrix.m[2][1], worldMatrix.m[2][2]))
 	};
 
+	// ワールド回転行列（各行からスケールを除くだけで求まるので、オイラー角を経由しない）
+	Matrix4x4 worldRotMatrix = MakeIdentity4x4();
+	const float scales[3] = { worldScale.x, worldScale.y, worldScale.z };
+	for (int i = 0; i < 3; ++i) {
+		const float invScale = scales[i] > 0.0f ? 1.0f / scales[i] : 0.0f;
+		worldRotMatrix.m[i][0] = worldMatrix.m[i][0] * invScale;
+		worldRotMatrix.m[i][1] = worldMatrix.m[i][1] * invScale;
+		worldRotMatrix.m[i][2] = worldMatrix.m[i][2] * invScale;
+	}
+
 	// オフセットを適用したOBBの中心位置を計算
 	Vector3 offsetEulerRad = {
 		DegToRad(obbEulerOffset_.x),
@@ -82,9 +92,6 @@ void OBBCollider::Update()
 	// オフセット回転行列を作成
 	Matrix4x4 offsetRotMatrix = MakeRotateMatrixXYZ(offsetEulerRad);
 
-	// ワールド回転行列を作成
-	Matrix4x4 worldRotMatrix = MakeRotateMatrixXYZ(worldRotation);
-
 	// 回転を合成（ワールド回転 * オフセット回転）
 	Matrix4x4 combinedRotMatrix = Multiply(worldRotMatrix, offsetRotMatrix);
 
@@ -101,8 +108,8 @@ void OBBCollider::Update()
 		obbOffset_.size.z * std::abs(worldScale.z)
 	};
 
-	// 最終的な回転
-	obb_.rotation = MatrixToEuler(combinedRotMatrix);
+	// 最終的な回転（オイラー角に戻すとジンバル付近で精度が落ちるため行列のまま保持）
+	obb_.rotation = combinedRotMatrix;
 
 }
 
@@ -9,6 +9,7 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <mutex>
 
 class LogSystem {
 public:
@@ -17,15 +18,20 @@ public:
 		return instance;
 	}
 
+	// 読み込みスレッドからも呼ばれるのでロックする
 	void Add(const std::string& msg) {
+		std::lock_guard<std::mutex> lock(mutex_);
 		logs_.push_back(msg);
 	}
 
-	const std::vector<std::string>& GetLogs() const {
+	// 追加と競合しないようコピーを返す
+	std::vector<std::string> GetLogs() const {
+		std::lock_guard<std::mutex> lock(mutex_);
 		return logs_;
 	}
 
 private:
+	mutable std::mutex mutex_;
 	std::vector<std::string> logs_;
 };
 
@@ -0,0 +1,333 @@
+#include "AssetRegistry.h"
+#include "Debugger/Logger.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <format>
+
+// シングルトンインスタンスの初期化
+std::unique_ptr<AssetRegistry> AssetRegistry::instance = nullptr;
+std::once_flag AssetRegistry::initInstanceFlag;
+bool AssetRegistry::isDestroyed_ = false;
+
+///************************* AssetHandle *************************///
+
+AssetHandle::AssetHandle(const AssetHandle& other)
+	: id_(other.id_)
+{
+	AssetRegistry::AddRef(id_);
+}
+
+AssetHandle& AssetHandle::operator=(const AssetHandle& other)
+{
+	if (this != &other) {
+		AssetRegistry::AddRef(other.id_);
+		Reset();
+		id_ = other.id_;
+	}
+	return *this;
+}
+
+AssetHandle::AssetHandle(AssetHandle&& other) noexcept
+	: id_(other.id_)
+{
+	other.id_ = AssetId{};
+}
+
+AssetHandle& AssetHandle::operator=(AssetHandle&& other) noexcept
+{
+	if (this != &other) {
+		Reset();
+		id_ = other.id_;
+		other.id_ = AssetId{};
+	}
+	return *this;
+}
+
+/// <summary>
+/// 参照を外す
+/// </summary>
+void AssetHandle::Reset()
+{
+	if (!id_.IsValid()) { return; }
+
+	AssetRegistry::Release(id_);
+	id_ = AssetId{};
+}
+
+///************************* AssetRegistry *************************///
+
+/// <summary>
+/// シングルトンインスタンスの取得
+/// </summary>
+AssetRegistry* AssetRegistry::GetInstance()
+{
+	std::call_once(initInstanceFlag, []() {
+		instance = std::make_unique<AssetRegistry>();
+		});
+	return instance.get();
+}
+
+AssetRegistry::~AssetRegistry()
+{
+	// 終了時に残っているハンドルが破棄されても触らないようにする
+	isDestroyed_ = true;
+}
+
+/// <summary>
+/// アセットの登録
+/// </summary>
+AssetId AssetRegistry::Register(AssetType type, const std::string& name, uint64_t sizeInBytes, UnloadFunction unload)
+{
+	uint32_t index;
+	if (!freeIndices_.empty()) {
+		index = freeIndices_.back();
+		freeIndices_.pop_back();
+	} else {
+		index = static_cast<uint32_t>(entries_.size());
+		entries_.emplace_back();
+	}
+
+	Entry& entry = entries_[index];
+	entry.type = type;
+	entry.name = name;
+	entry.sizeInBytes = sizeInBytes;
+	entry.unload = std::move(unload);
+	entry.refCount = 0;
+	entry.isAlive = true;
+	entry.isAcquired = false;
+	entry.isPinned = false;
+
+	++stats_[static_cast<size_t>(type)].count;
+	AddSize(type, static_cast<int64_t>(sizeInBytes));
+
+	return AssetId{ index, entry.generation };
+}
+
+/// <summary>
+/// 登録を外す
+/// </summary>
+void AssetRegistry::Unregister(AssetId id)
+{
+	if (Find(id)) {
+		RemoveEntry(id.index);
+	}
+}
+
+/// <summary>
+/// 指定した種類の登録をすべて外す
+/// </summary>
+void AssetRegistry::UnregisterAll(AssetType type)
+{
+	for (uint32_t index = 0; index < entries_.size(); ++index) {
+		if (entries_[index].isAlive && entries_[index].type == type) {
+			RemoveEntry(index);
+		}
+	}
+}
+
+/// <summary>
+/// 参照を取る
+/// </summary>
+AssetHandle AssetRegistry::Acquire(AssetId id)
+{
+	Entry* entry = Find(id);
+	if (!entry) { return AssetHandle{}; }
+
+	++entry->refCount;
+	entry->isAcquired = true;
+	return AssetHandle(id);
+}
+
+/// <summary>
+/// 解放しないようにする
+/// </summary>
+void AssetRegistry::Pin(AssetId id)
+{
+	if (Entry* entry = Find(id)) {
+		entry->isPinned = true;
+	}
+}
+
+/// <summary>
+/// 参照の無くなったアセットを解放する
+/// </summary>
+uint32_t AssetRegistry::UnloadUnused()
+{
+	uint32_t unloadCount = 0;
+
+	// モデルを解放するとテクスチャの参照が外れるので、解放できるものが無くなるまで繰り返す
+	bool progressed = true;
+	while (progressed) {
+		progressed = false;
+		for (uint32_t index = 0; index < entries_.size(); ++index) {
+			Entry& entry = entries_[index];
+			if (!entry.isAlive || entry.isPinned || !entry.isAcquired || entry.refCount > 0) { continue; }
+
+			// コールバックの中で登録・解除されても壊れないようにコピーしてから呼ぶ
+			const UnloadFunction unload = entry.unload;
+			const AssetType type = entry.type;
+			if (unload && !unload()) { continue; }
+
+			if (entries_[index].isAlive) {
+				RemoveEntry(index);
+			}
+			++stats_[static_cast<size_t>(type)].unloadCount;
+			++unloadCount;
+			progressed = true;
+		}
+	}
+	return unloadCount;
+}
+
+/// <summary>
+/// 参照数の取得
+/// </summary>
+uint32_t AssetRegistry::GetRefCount(AssetId id) const
+{
+	const Entry* entry = Find(id);
+	return entry ? entry->refCount : 0;
+}
+
+/// <summary>
+/// 使用量の更新
+/// </summary>
+void AssetRegistry::SetSize(AssetId id, uint64_t sizeInBytes)
+{
+	Entry* entry = Find(id);
+	if (!entry) { return; }
+
+	const int64_t delta = static_cast<int64_t>(sizeInBytes) - static_cast<int64_t>(entry->sizeInBytes);
+	entry->sizeInBytes = sizeInBytes;
+	AddSize(entry->type, delta);
+}
+
+/// <summary>
+/// 予算の設定
+/// </summary>
+void AssetRegistry::SetBudget(AssetType type, uint64_t budgetInBytes)
+{
+	stats_[static_cast<size_t>(type)].budgetInBytes = budgetInBytes;
+	overBudgetWarned_[static_cast<size_t>(type)] = false;
+	AddSize(type, 0);
+}
+
+/// <summary>
+/// 種類ごとの使用量をログに出す
+/// </summary>
+void AssetRegistry::LogStats() const
+{
+	for (size_t i = 0; i < stats_.size(); ++i) {
+		const Stats& stats = stats_[i];
+		std::string budget = stats.budgetInBytes > 0
+			? std::format("{:.1f}MB", static_cast<double>(stats.budgetInBytes) / (1024.0 * 1024.0))
+			: std::string("なし");
+		Logger(std::format("AssetRegistry: {} {}件 {:.1f}MB（最大 {:.1f}MB / 予算 {}）解放 {}件\n",
+			GetTypeName(static_cast<AssetType>(i)),
+			stats.count,
+			static_cast<double>(stats.sizeInBytes) / (1024.0 * 1024.0),
+			static_cast<double>(stats.peakInBytes) / (1024.0 * 1024.0),
+			budget,
+			stats.unloadCount));
+	}
+}
+
+/// <summary>
+/// 種類の名前
+/// </summary>
+const char* AssetRegistry::GetTypeName(AssetType type)
+{
+	switch (type) {
+	case AssetType::Model:   return "Model";
+	case AssetType::Texture: return "Texture";
+	default:                 return "Unknown";
+	}
+}
+
+/// <summary>
+/// 参照を増やす
+/// </summary>
+void AssetRegistry::AddRef(AssetId id)
+{
+	if (isDestroyed_ || !instance) { return; }
+
+	if (Entry* entry = instance->Find(id)) {
+		++entry->refCount;
+	}
+}
+
+/// <summary>
+/// 参照を減らす
+/// </summary>
+void AssetRegistry::Release(AssetId id)
+{
+	if (isDestroyed_ || !instance) { return; }
+
+	if (Entry* entry = instance->Find(id)) {
+		assert(entry->refCount > 0);
+		--entry->refCount;
+	}
+}
+
+AssetRegistry::Entry* AssetRegistry::Find(AssetId id)
+{
+	if (id.index >= entries_.size()) { return nullptr; }
+
+	Entry& entry = entries_[id.index];
+	return (entry.isAlive && entry.generation == id.generation) ? &entry : nullptr;
+}
+
+const AssetRegistry::Entry* AssetRegistry::Find(AssetId id) const
+{
+	if (id.index >= entries_.size()) { return nullptr; }
+
+	const Entry& entry = entries_[id.index];
+	return (entry.isAlive && entry.generation == id.generation) ? &entry : nullptr;
+}
+
+/// <summary>
+/// 登録を外して番号を空ける
+/// </summary>
+void AssetRegistry::RemoveEntry(uint32_t index)
+{
+	Entry& entry = entries_[index];
+
+	--stats_[static_cast<size_t>(entry.type)].count;
+	AddSize(entry.type, -static_cast<int64_t>(entry.sizeInBytes));
+
+	entry.isAlive = false;
+	entry.unload = nullptr;
+	entry.name.clear();
+	entry.sizeInBytes = 0;
+	entry.refCount = 0;
+	// 残っているハンドルで引けないよう世代を進める
+	++entry.generation;
+
+	freeIndices_.push_back(index);
+}
+
+/// <summary>
+/// 使用量の増減と予算の確認
+/// </summary>
+void AssetRegistry::AddSize(AssetType type, int64_t delta)
+{
+	const size_t typeIndex = static_cast<size_t>(type);
+	Stats& stats = stats_[typeIndex];
+	stats.sizeInBytes = static_cast<uint64_t>(static_cast<int64_t>(stats.sizeInBytes) + delta);
+	stats.peakInBytes = (std::max)(stats.peakInBytes, stats.sizeInBytes);
+
+	if (stats.budgetInBytes == 0 || stats.sizeInBytes <= stats.budgetInBytes) {
+		overBudgetWarned_[typeIndex] = false;
+		return;
+	}
+
+	// 超えている間は1回だけ出す
+	if (!overBudgetWarned_[typeIndex]) {
+		overBudgetWarned_[typeIndex] = true;
+		Logger(std::format("Warning: AssetRegistry: {} の使用量 {:.1f}MB が予算 {:.1f}MB を超えました\n",
+			GetTypeName(type),
+			static_cast<double>(stats.sizeInBytes) / (1024.0 * 1024.0),
+			static_cast<double>(stats.budgetInBytes) / (1024.0 * 1024.0)));
+	}
+}
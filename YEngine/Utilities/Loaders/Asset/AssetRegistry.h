@@ -0,0 +1,172 @@
+#pragma once
+
+// C++
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+///************************* アセットの種類 *************************///
+enum class AssetType : uint8_t {
+	Model,
+	Texture,
+	Count,
+};
+
+///************************* アセットの識別子 *************************///
+///
+/// 登録時に払い出す番号と世代の組
+/// 解放された番号は再利用されるが、世代が変わるので古い識別子では引けない
+///
+struct AssetId {
+	static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+	uint32_t index = kInvalidIndex;
+	uint32_t generation = 0;
+
+	bool IsValid() const { return index != kInvalidIndex; }
+};
+
+///************************* アセットの参照 *************************///
+///
+/// 持っている間はアセットが解放されない（コピーで参照を増やし、破棄で減らす）
+///
+class AssetHandle
+{
+public:
+	AssetHandle() = default;
+	~AssetHandle() { Reset(); }
+	AssetHandle(const AssetHandle& other);
+	AssetHandle& operator=(const AssetHandle& other);
+	AssetHandle(AssetHandle&& other) noexcept;
+	AssetHandle& operator=(AssetHandle&& other) noexcept;
+
+	// 参照を外す
+	void Reset();
+
+	bool IsValid() const { return id_.IsValid(); }
+	const AssetId& GetId() const { return id_; }
+
+private:
+	friend class AssetRegistry;
+	explicit AssetHandle(AssetId id) : id_(id) {}
+
+	AssetId id_;
+};
+
+///************************* アセット登録簿 *************************///
+///
+/// ModelManager・TextureManager が読み込んだアセットを種類ごとにまとめて数え、参照数と使用量を管理する
+/// アセットの実体と重複排除は今まで通り各マネージャーが持ち、ここには解放の方法（コールバック）だけを預ける
+///
+/// 解放はシーン切り替えなどで UnloadUnused を呼んだときにまとめて行う
+/// 参照が 0 になった瞬間に解放しないのは、同じアセットを使う次のシーンで読み直さずに済ませるため
+/// 一度もハンドルを取られていないもの・Pin されたもの（パスやSRV番号で直接使われているもの）は解放しない
+///
+/// メインスレッド専用
+///
+class AssetRegistry
+{
+public:
+	// 解放の方法（まだ解放できないとき（読み込み中など）は false を返す）
+	using UnloadFunction = std::function<bool()>;
+
+	// 種類ごとの使用量
+	struct Stats {
+		uint32_t count = 0;			// 登録数
+		uint64_t sizeInBytes = 0;	// 使用量の合計
+		uint64_t peakInBytes = 0;	// 使用量の最大
+		uint64_t budgetInBytes = 0;	// 予算（0 なら無制限）
+		uint32_t unloadCount = 0;	// 解放した数の累計
+	};
+
+public:
+	///************************* 基本関数 *************************///
+
+	static AssetRegistry* GetInstance();
+	AssetRegistry() = default;
+	~AssetRegistry();
+
+	// アセットを登録する（sizeInBytes は後から SetSize で変えられる）
+	AssetId Register(AssetType type, const std::string& name, uint64_t sizeInBytes, UnloadFunction unload);
+
+	// 登録を外す（解放はしない。マネージャーの終了時など）
+	void Unregister(AssetId id);
+	void UnregisterAll(AssetType type);
+
+	// 参照を取る（無効な識別子なら空のハンドル）
+	AssetHandle Acquire(AssetId id);
+
+	// 参照に関係なく解放しない
+	void Pin(AssetId id);
+
+	// 参照の無くなったアセットを解放する（解放した数を返す）
+	uint32_t UnloadUnused();
+
+public:
+	///************************* アクセッサ *************************///
+
+	bool IsAlive(AssetId id) const { return Find(id) != nullptr; }
+	uint32_t GetRefCount(AssetId id) const;
+
+	// 使用量の更新（非同期読み込みが終わったときなど）
+	void SetSize(AssetId id, uint64_t sizeInBytes);
+
+	// 予算（超えたらログに警告を出す）
+	void SetBudget(AssetType type, uint64_t budgetInBytes);
+	const Stats& GetStats(AssetType type) const { return stats_[static_cast<size_t>(type)]; }
+
+	// 種類ごとの使用量をログに出す
+	void LogStats() const;
+
+	static const char* GetTypeName(AssetType type);
+
+private:
+	///************************* 内部処理 *************************///
+
+	struct Entry {
+		AssetType type = AssetType::Model;
+		std::string name;
+		uint64_t sizeInBytes = 0;
+		UnloadFunction unload;
+		uint32_t generation = 0;
+		uint32_t refCount = 0;
+		bool isAlive = false;
+		bool isAcquired = false;	// 一度でも参照を取られたか
+		bool isPinned = false;
+	};
+
+	friend class AssetHandle;
+
+	// ハンドルからの参照の増減（登録簿が先に破棄されていれば何もしない）
+	static void AddRef(AssetId id);
+	static void Release(AssetId id);
+
+	Entry* Find(AssetId id);
+	const Entry* Find(AssetId id) const;
+
+	// 登録を外して番号を空ける
+	void RemoveEntry(uint32_t index);
+
+	// 使用量を増減し、予算を超えたら警告する
+	void AddSize(AssetType type, int64_t delta);
+
+private:
+	///************************* メンバ変数 *************************///
+
+	static std::unique_ptr<AssetRegistry> instance;
+	static std::once_flag initInstanceFlag;
+	static bool isDestroyed_;
+
+	AssetRegistry(AssetRegistry&) = delete;
+	AssetRegistry& operator=(AssetRegistry&) = delete;
+
+	std::vector<Entry> entries_;
+	std::vector<uint32_t> freeIndices_;
+
+	std::array<Stats, static_cast<size_t>(AssetType::Count)> stats_{};
+	std::array<bool, static_cast<size_t>(AssetType::Count)> overBudgetWarned_{};
+};
@@ -0,0 +1,173 @@
+#include "AssetLoader.h"
+#include "Debugger/Logger.h"
+
+// C++
+#include <chrono>
+#include <exception>
+
+// シングルトンインスタンスの初期化
+std::unique_ptr<AssetLoader> AssetLoader::instance = nullptr;
+std::once_flag AssetLoader::initInstanceFlag;
+
+/// <summary>
+/// シングルトンインスタンスの取得
+/// </summary>
+AssetLoader* AssetLoader::GetInstance()
+{
+	std::call_once(initInstanceFlag, []() {
+		instance = std::make_unique<AssetLoader>();
+		});
+	return instance.get();
+}
+
+AssetLoader::~AssetLoader()
+{
+	Finalize();
+}
+
+/// <summary>
+/// ワーカーの起動
+/// </summary>
+void AssetLoader::Initialize(uint32_t threadCount)
+{
+	if (!workers_.empty()) { return; }
+
+	// メインスレッドの分を1つ空けておく
+	if (threadCount == 0) {
+		const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+		threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
+
+	stopRequested_ = false;
+	workers_.reserve(threadCount);
+	for (uint32_t i = 0; i < threadCount; ++i) {
+		workers_.emplace_back([this]() { WorkerLoop(); });
+	}
+}
+
+/// <summary>
+/// 残りのジョブを片付けてワーカーを止める
+/// </summary>
+void AssetLoader::Finalize()
+{
+	if (workers_.empty()) { return; }
+
+	Flush();
+
+	{
+		std::lock_guard<std::mutex> lock(jobMutex_);
+		stopRequested_ = true;
+	}
+	jobCondition_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
+}
+
+/// <summary>
+/// 完了したジョブの後処理（予算の範囲）
+/// </summary>
+void AssetLoader::Update()
+{
+	using Clock = std::chrono::steady_clock;
+	const auto start = Clock::now();
+
+	// 少なくとも1件は進める
+	while (RunOneFinalize()) {
+		const float elapsedMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		if (elapsedMs >= finalizeBudgetMs_) { break; }
+	}
+}
+
+/// <summary>
+/// 全ジョブの完了を待つ
+/// </summary>
+void AssetLoader::Flush()
+{
+	while (pendingCount_.load() > 0) {
+		if (RunOneFinalize()) { continue; }
+
+		// 後処理が来るまで待つ
+		std::unique_lock<std::mutex> lock(finishedMutex_);
+		finishedCondition_.wait(lock, [this]() { return !finished_.empty() || pendingCount_.load() == 0; });
+	}
+}
+
+/// <summary>
+/// ジョブの追加
+/// </summary>
+void AssetLoader::Enqueue(std::function<void()> work, std::function<void()> finalize)
+{
+	// ワーカーが無ければ同期で実行
+	if (workers_.empty()) {
+		if (work) { work(); }
+		if (finalize) { finalize(); }
+		return;
+	}
+
+	++pendingCount_;
+	{
+		std::lock_guard<std::mutex> lock(jobMutex_);
+		jobs_.push_back({ std::move(work), std::move(finalize) });
+	}
+	jobCondition_.notify_one();
+}
+
+/// <summary>
+/// ワーカースレッド
+/// </summary>
+void AssetLoader::WorkerLoop()
+{
+#ifdef _WIN32
+	// WIC は COM を使うのでスレッドごとに初期化する
+	const HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+	while (true) {
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(jobMutex_);
+			jobCondition_.wait(lock, [this]() { return stopRequested_ || !jobs_.empty(); });
+			if (jobs_.empty()) { break; }
+			job = std::move(jobs_.front());
+			jobs_.pop_front();
+		}
+
+		// 失敗しても後処理は呼ぶ（待っている側が止まらないよう、結果の確認は後処理側で行う）
+		try {
+			if (job.work) { job.work(); }
+		} catch (const std::exception& e) {
+			Logger(std::string("AssetLoader: ") + e.what() + "\n");
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(finishedMutex_);
+			finished_.push_back(job.finalize ? std::move(job.finalize) : std::function<void()>([]() {}));
+		}
+		finishedCondition_.notify_all();
+	}
+
+#ifdef _WIN32
+	if (SUCCEEDED(comResult)) { CoUninitialize(); }
+#endif
+}
+
+/// <summary>
+/// 後処理を1件実行
+/// </summary>
+bool AssetLoader::RunOneFinalize()
+{
+	std::function<void()> finalize;
+	{
+		std::lock_guard<std::mutex> lock(finishedMutex_);
+		if (finished_.empty()) { return false; }
+		finalize = std::move(finished_.front());
+		finished_.pop_front();
+	}
+
+	finalize();
+	--pendingCount_;
+	finishedCondition_.notify_all();
+	return true;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///************************* 非同期読み込みキュー *************************///
+///
+/// ファイル読み込み・画像の展開・assimp の読み込みなどの重い CPU 処理をワーカースレッドで行い、
+/// GPU リソースの生成と転送コマンドの記録はメインスレッドの Update でまとめて行う
+///
+/// ジョブは「ワーカーで実行する処理」と「完了後にメインスレッドで実行する処理」の組
+/// 後者はフレームの先頭（描画コマンドを積む前）に予算の範囲で順に実行する
+///
+class AssetLoader
+{
+public:
+	///************************* 基本関数 *************************///
+
+	static AssetLoader* GetInstance();
+	AssetLoader() = default;
+	~AssetLoader();
+
+	// ワーカーを起動（0 なら CPU のスレッド数 - 1）
+	void Initialize(uint32_t threadCount = 0);
+
+	// 残りのジョブを待ってワーカーを止める
+	void Finalize();
+
+	// メインスレッド：完了したジョブの後処理を予算の範囲で実行する（フレームの先頭で呼ぶ）
+	void Update();
+
+	// 全ジョブの完了を待ち、後処理まで済ませる（メインスレッド）
+	void Flush();
+
+public:
+	///************************* ジョブ *************************///
+
+	// work をワーカーで実行し、終わったら finalize をメインスレッドで実行する
+	// ワーカーが無いとき（Initialize 前）はその場で両方を実行する
+	void Enqueue(std::function<void()> work, std::function<void()> finalize = nullptr);
+
+public:
+	///************************* アクセッサ *************************///
+
+	// 後処理まで終わっていないジョブがあるか
+	bool IsIdle() const { return pendingCount_.load() == 0; }
+	uint32_t GetPendingCount() const { return pendingCount_.load(); }
+
+	// 1フレームに後処理へ使う時間（ミリ秒。最低1件は実行する）
+	void SetFinalizeBudget(float milliseconds) { finalizeBudgetMs_ = milliseconds; }
+	float GetFinalizeBudget() const { return finalizeBudgetMs_; }
+
+private:
+	///************************* 内部処理 *************************///
+
+	struct Job {
+		std::function<void()> work;
+		std::function<void()> finalize;
+	};
+
+	// ワーカースレッドの本体
+	void WorkerLoop();
+
+	// 完了済みの後処理を1件取り出して実行（無ければ false）
+	bool RunOneFinalize();
+
+private:
+	///************************* メンバ変数 *************************///
+
+	static std::unique_ptr<AssetLoader> instance;
+	static std::once_flag initInstanceFlag;
+
+	AssetLoader(AssetLoader&) = delete;
+	AssetLoader& operator=(AssetLoader&) = delete;
+
+	std::vector<std::thread> workers_;
+
+	// ワーカー待ちのジョブ
+	std::mutex jobMutex_;
+	std::condition_variable jobCondition_;
+	std::deque<Job> jobs_;
+	bool stopRequested_ = false;
+
+	// メインスレッド待ちの後処理
+	std::mutex finishedMutex_;
+	std::condition_variable finishedCondition_;
+	std::deque<std::function<void()>> finished_;
+
+	std::atomic<uint32_t> pendingCount_ = 0;
+	float finalizeBudgetMs_ = 4.0f;
+};
@@ -1,5 +1,6 @@
 #include "JsonManager.h"
 #include <filesystem>
+#include "JsonWriter.h"
 #include "Debugger/Logger.h"
 
 namespace YoRigine {
@@ -22,7 +23,7 @@ namespace YoRigine {
 		if (instances.find(fullKey_) == instances.end())
 		{
 			instances[fullKey_] = this;
-			LoadAll();
+			GetDocument();
 		}
 	}
 
@@ -81,18 +82,16 @@ namespace YoRigine {
 			variables_.erase(it);
 		}
 
-		// JSONファイルから削除
+		// JSONファイルから削除（読み込み済みの内容を使う）
 		std::string fullPath = MakeFullPath(folderPath_, fileName_);
-		std::ifstream ifs(fullPath);
-		if (!ifs)
+		const CachedDocument* document = GetDocument();
+		if (!document)
 		{
 			std::cerr << "ファイルを開けませんでした: " << fullPath << std::endl;
 			return;
 		}
 
-		nlohmann::json jsonData;
-		ifs >> jsonData;
-		ifs.close();
+		nlohmann::json jsonData = document->json;
 
 		// JSONデータから該当のキーを削除
 		if (jsonData.contains(name))
@@ -101,14 +100,7 @@ namespace YoRigine {
 		}
 
 		// 更新されたJSONデータを保存
-		std::ofstream ofs(fullPath);
-		if (!ofs)
-		{
-			std::cerr << "ファイルを開けませんでした: " << fullPath << std::endl;
-			return;
-		}
-		ofs << jsonData.dump(4);
-		ofs.close();
+		WriteDocument(jsonData);
 	}
 
 	void JsonManager::Reset(bool clearVariables)
@@ -124,10 +116,14 @@ namespace YoRigine {
 			}
 		}
 
+		// 書き込み待ちの保存が後から中身を戻さないよう、先に書き出しておく
+		JsonWriter::GetInstance()->Flush();
+
 		// JSON ファイルを空にする
 		std::string fullPath = MakeFullPath(folderPath_, fileName_);
 		std::ofstream ofs(fullPath, std::ofstream::trunc);
 		ofs.close();
+		documentCache_.erase(fullKey_);
 	}
 
 	void JsonManager::Save()
@@ -142,61 +138,154 @@ namespace YoRigine {
 			variablePtr->SaveToJson(jsonData[name]);
 		}
 
-		// フルパス生成（フォルダパス + "/" + ファイル名）
-		std::string fullPath = MakeFullPath(folderPath_, fileName_);
+		// ファイルに書き出し（インデント4で整形。書き込みは JsonWriter のスレッドで行う）
+		WriteDocument(jsonData);
+	}
 
-		// ファイルに書き出し
-		std::ofstream ofs(fullPath);
-		if (!ofs)
+	void JsonManager::LoadAll()
+	{
+		// 明示的な読み直しなので、キャッシュがあっても読み込む
+		if (!GetDocument(true))
 		{
-			std::cerr << "ファイルを開けませんでした: " << fullPath << std::endl;
+			// ファイルが存在しない場合などは何もしない
 			return;
 		}
-		ofs << jsonData.dump(4); // インデント4で整形して出力
-		ofs.close();
+
+		pendingKeys_.clear();
+		for (const auto& pair : variables_)
+		{
+			pendingKeys_.push_back(pair.first);
+		}
+		ApplyPendingRegisters();
 	}
 
-	void JsonManager::LoadAll()
+	void JsonManager::EndRegister()
 	{
-		std::string fullPath = MakeFullPath(folderPath_, fileName_);
-		std::ifstream ifs(fullPath);
-		if (!ifs)
+		if (registerDepth_ > 0 && --registerDepth_ == 0)
+		{
+			ApplyPendingRegisters();
+		}
+	}
+
+	void JsonManager::ApplyPendingRegisters()
+	{
+		if (pendingKeys_.empty())
+		{
+			return;
+		}
+
+		const CachedDocument* document = GetDocument();
+		if (!document)
 		{
 			// ファイルが存在しない場合などは何もしない
+			pendingKeys_.clear();
 			return;
 		}
 
+		// ファイルサイズが 0（空）なら新規ファイルとして、登録された変数の初期値を書き出す
+		if (document->isEmpty)
+		{
+			pendingKeys_.clear();
+			Save();
+			return;
+		}
+
+		// JSON から登録した変数にだけ反映
+		for (const std::string& name : pendingKeys_)
+		{
+			auto variable = variables_.find(name);
+			auto value = document->json.find(name);
+			if (variable != variables_.end() && value != document->json.end())
+			{
+				variable->second->LoadFromJson(*value);
+			}
+		}
+		pendingKeys_.clear();
+	}
+
+	const JsonManager::CachedDocument* JsonManager::GetDocument(bool forceReload)
+	{
+		// 書き込み待ちの保存があれば、ファイルよりキャッシュの方が新しい
+		auto pending = documentCache_.find(fullKey_);
+		if (pending != documentCache_.end() && pending->second.pendingWrites > 0)
+		{
+			return &pending->second;
+		}
+
+		std::error_code error;
+		const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(fullKey_, error);
+		if (error)
+		{
+			documentCache_.erase(fullKey_);
+			return nullptr;
+		}
+
+		// 前回読んだときから書き換えられていなければ、そのまま使う
+		auto it = documentCache_.find(fullKey_);
+		if (!forceReload && it != documentCache_.end() && it->second.writeTime == writeTime)
+		{
+			return &it->second;
+		}
+
+		std::ifstream ifs(fullKey_);
+		if (!ifs)
+		{
+			return nullptr;
+		}
+
+		CachedDocument document;
+		document.writeTime = writeTime;
+
 		// ファイルサイズをチェックするために末尾にシーク
 		ifs.seekg(0, std::ios::end);
-		std::streampos fileSize = ifs.tellg();
+		document.isEmpty = ifs.tellg() == std::streampos(0);
 		ifs.seekg(0, std::ios::beg);
 
-		// ファイルサイズが 0（空）なら、新規ファイルとして扱う
-		if (fileSize == 0)
+		// JSON として読み込み
+		if (!document.isEmpty)
 		{
-			// いったん閉じる
-			ifs.close();
+			ifs >> document.json;
+		}
 
-			// 登録された変数で Save()（=「初期値をJSONとして書き出し」）し、終了
-			Save();
+		CachedDocument& cached = documentCache_[fullKey_];
+		cached = std::move(document);
+		return &cached;
+	}
+
+	void JsonManager::WriteDocument(const nlohmann::json& json)
+	{
+		CachedDocument& cached = documentCache_[fullKey_];
+		cached.json = json;
+		cached.isEmpty = false;
+		++cached.pendingWrites;
+
+		// インスタンスが先に破棄されてもよいよう、通知にはパスだけを渡す
+		const std::string fullPath = fullKey_;
+		JsonWriter::GetInstance()->Save(fullPath, json, 4,
+			[fullPath](bool succeeded) { OnDocumentWritten(fullPath, succeeded); });
+	}
+
+	void JsonManager::OnDocumentWritten(const std::string& fullPath, bool succeeded)
+	{
+		auto it = documentCache_.find(fullPath);
+		if (it == documentCache_.end() || it->second.pendingWrites == 0)
+		{
+			return;
+		}
+		if (--it->second.pendingWrites > 0)
+		{
 			return;
 		}
 
-		// JSON として読み込み
-		nlohmann::json jsonData;
-		ifs >> jsonData;
-		ifs.close();
-
-		// JSON から各変数に反映
-		for (auto& pair : variables_)
+		// 書けなかったときは、次に使うときにファイルから読み直す
+		std::error_code error;
+		const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(fullPath, error);
+		if (!succeeded || error)
 		{
-			const std::string& name = pair.first;
-			auto& variablePtr = pair.second;
-			if (jsonData.contains(name))
-			{
-				variablePtr->LoadFromJson(jsonData[name]);
-			}
+			documentCache_.erase(it);
+			return;
 		}
+		it->second.writeTime = writeTime;
 	}
 
 	void JsonManager::ImGuiManager()
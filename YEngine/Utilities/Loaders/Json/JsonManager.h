@@ -2,6 +2,8 @@
 
 // C++
 #include <string>
+#include <vector>
+#include <filesystem>
 #include <unordered_map>
 #include <unordered_set>
 #include <fstream>
@@ -33,7 +35,9 @@ namespace YoRigine {
 	public:
 		///************************* 変数登録 *************************///
 
-		// 変数を登録し、自動的にJSONから読み込む
+		// 変数を登録し、読み込み済みのJSONから値を反映する
+		// ファイルは最初に一度だけ読み込み、以降は更新時刻が変わったときだけ読み直す
+		// BeginRegister 〜 EndRegister の間は、反映を EndRegister でまとめて行う
 		template <typename T>
 		void Register(const std::string& name, T* ptr)
 		{
@@ -47,9 +51,18 @@ namespace YoRigine {
 			}
 
 			variables_[fullKey] = std::make_unique<VariableJson<T>>(ptr);
-			LoadAll();
+			pendingKeys_.push_back(fullKey);
+			if (registerDepth_ == 0) {
+				ApplyPendingRegisters();
+			}
 		}
 
+		// まとめて登録する範囲の開始（入れ子にできる）
+		void BeginRegister() { ++registerDepth_; }
+
+		// まとめて登録する範囲の終了（一番外側で、登録した変数へまとめて値を反映する）
+		void EndRegister();
+
 		// 指定した変数を登録解除
 		void Unregister(const std::string& name);
 
@@ -62,7 +75,7 @@ namespace YoRigine {
 		// 登録済みの変数をすべてJSONファイルに保存
 		void Save();
 
-		// 登録済みの変数をすべてJSONファイルから読み込み
+		// JSONファイルを読み直し、登録済みの変数すべてへ反映
 		void LoadAll();
 
 	public:
@@ -116,6 +129,27 @@ namespace YoRigine {
 		// フォルダとファイル名を結合して完全パスを生成
 		std::string MakeFullPath(const std::string& folder, const std::string& file) const;
 
+		// ファイルごとの読み込み済みの内容（同じファイルを使うインスタンスで共有）
+		struct CachedDocument {
+			nlohmann::json json;
+			std::filesystem::file_time_type writeTime{};
+			bool isEmpty = false;	// ファイルはあるが中身が空（新規作成）
+			uint32_t pendingWrites = 0;	// 書き込み待ちの保存の数（0 になるまではファイルより新しい）
+		};
+
+		// 読み込み済みの内容を取得（更新時刻が変わっていれば読み直す。ファイルが無ければ nullptr）
+		// 書き込み待ちの保存があるうちは、ファイルを見ずにキャッシュを返す
+		const CachedDocument* GetDocument(bool forceReload = false);
+
+		// 内容をキャッシュへ反映し、JsonWriter で書き出す（読み直さずに済むように）
+		void WriteDocument(const nlohmann::json& json);
+
+		// 書き込みが終わったらキャッシュの更新時刻をファイルに合わせる（メインスレッド）
+		static void OnDocumentWritten(const std::string& fullPath, bool succeeded);
+
+		// 登録待ちの変数へ JSON の値を反映（空のファイルなら今の値で書き出す）
+		void ApplyPendingRegisters();
+
 	private:
 		///************************* メンバ変数 *************************///
 
@@ -161,6 +195,13 @@ namespace YoRigine {
 		// 登録されたキーの集合
 		std::unordered_set<std::string> treeKeys_;
 
+		// まとめて登録する範囲の深さと、値の反映を待っているキー
+		int registerDepth_ = 0;
+		std::vector<std::string> pendingKeys_;
+
+		// ファイルの完全パスごとの読み込み済みの内容
+		static inline std::unordered_map<std::string, CachedDocument> documentCache_;
+
 	private:
 		///************************* シーンインスタンス取得 *************************///
 
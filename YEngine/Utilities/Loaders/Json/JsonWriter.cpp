@@ -0,0 +1,245 @@
+#include "JsonWriter.h"
+#include "Debugger/Logger.h"
+
+// C++
+#include <algorithm>
+#include <fstream>
+
+namespace YoRigine {
+
+	// シングルトンインスタンスの初期化
+	std::unique_ptr<JsonWriter> JsonWriter::instance = nullptr;
+	std::once_flag JsonWriter::initInstanceFlag;
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	JsonWriter* JsonWriter::GetInstance()
+	{
+		std::call_once(initInstanceFlag, []() {
+			instance = std::make_unique<JsonWriter>();
+			});
+		return instance.get();
+	}
+
+	JsonWriter::~JsonWriter()
+	{
+		Finalize();
+	}
+
+	/// <summary>
+	/// 書き込みスレッドの起動
+	/// </summary>
+	void JsonWriter::Initialize()
+	{
+		if (worker_.joinable()) { return; }
+
+		stopRequested_ = false;
+		worker_ = std::thread([this]() { WorkerLoop(); });
+	}
+
+	/// <summary>
+	/// 残りを書き出してスレッドを止める
+	/// </summary>
+	void JsonWriter::Finalize()
+	{
+		if (!worker_.joinable()) { return; }
+
+		Flush();
+
+		{
+			std::lock_guard<std::mutex> lock(requestMutex_);
+			stopRequested_ = true;
+		}
+		requestCondition_.notify_all();
+		worker_.join();
+	}
+
+	/// <summary>
+	/// 終わった書き込みの通知
+	/// </summary>
+	void JsonWriter::Update()
+	{
+		while (RunOneCompletion()) {}
+	}
+
+	/// <summary>
+	/// 待っている保存をすぐに書き出す
+	/// </summary>
+	void JsonWriter::Flush()
+	{
+		if (pendingCount_.load() == 0) { return; }
+
+		{
+			std::lock_guard<std::mutex> lock(requestMutex_);
+			flushRequested_ = true;
+		}
+		requestCondition_.notify_all();
+
+		while (pendingCount_.load() > 0) {
+			if (RunOneCompletion()) { continue; }
+
+			// 書き終わるまで待つ
+			std::unique_lock<std::mutex> lock(completedMutex_);
+			completedCondition_.wait(lock, [this]() { return !completed_.empty() || pendingCount_.load() == 0; });
+		}
+
+		std::lock_guard<std::mutex> lock(requestMutex_);
+		flushRequested_ = false;
+	}
+
+	/// <summary>
+	/// 保存の予約
+	/// </summary>
+	void JsonWriter::Save(const std::string& path, nlohmann::json json, int indent, Callback onComplete)
+	{
+		// スレッドが無ければその場で書く
+		if (!worker_.joinable()) {
+			const bool succeeded = Write(path, json, indent);
+			if (onComplete) { onComplete(succeeded); }
+			return;
+		}
+
+		// 書き方の違う同じパスを1件にまとめる
+		const std::string key = std::filesystem::path(path).lexically_normal().generic_string();
+		const Clock::time_point now = Clock::now();
+		const auto debounce = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(debounceSeconds_));
+		const auto maxDelay = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(maxDelaySeconds_));
+
+		{
+			std::lock_guard<std::mutex> lock(requestMutex_);
+			auto it = requests_.find(key);
+			if (it == requests_.end()) {
+				it = requests_.emplace(key, Request{}).first;
+				it->second.firstRequested = now;
+				++pendingCount_;
+			} else {
+				// まだ書いていない前の内容は捨てる
+				++coalescedCount_;
+			}
+
+			Request& request = it->second;
+			request.json = std::move(json);
+			request.indent = indent;
+			request.deadline = (std::min)(now + debounce, request.firstRequested + maxDelay);
+			if (onComplete) {
+				request.callbacks.push_back(std::move(onComplete));
+			}
+		}
+		requestCondition_.notify_one();
+	}
+
+	/// <summary>
+	/// 一時ファイルへ書いてから置き換える
+	/// </summary>
+	bool JsonWriter::WriteAtomically(const std::filesystem::path& path, const std::string& text)
+	{
+		std::error_code error;
+		if (path.has_parent_path()) {
+			std::filesystem::create_directories(path.parent_path(), error);
+		}
+
+		std::filesystem::path tempPath = path;
+		tempPath += ".tmp";
+		{
+			// 改行の扱いを今までの保存と揃えるため、テキストモードで書く
+			std::ofstream ofs(tempPath, std::ios::trunc);
+			if (!ofs) { return false; }
+			ofs << text;
+			if (!ofs) {
+				ofs.close();
+				std::filesystem::remove(tempPath, error);
+				return false;
+			}
+		}
+
+		std::filesystem::rename(tempPath, path, error);
+		if (error) {
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// 書き込みスレッド
+	/// </summary>
+	void JsonWriter::WorkerLoop()
+	{
+		std::unique_lock<std::mutex> lock(requestMutex_);
+		while (true) {
+			if (requests_.empty()) {
+				if (stopRequested_) { break; }
+				requestCondition_.wait(lock);
+				continue;
+			}
+
+			// 期限の最も早いものから書く（Flush 中・終了時は待たない）
+			auto next = std::min_element(requests_.begin(), requests_.end(),
+				[](const auto& a, const auto& b) { return a.second.deadline < b.second.deadline; });
+			if (!flushRequested_ && !stopRequested_ && Clock::now() < next->second.deadline) {
+				requestCondition_.wait_until(lock, next->second.deadline);
+				continue;
+			}
+
+			// 書いている間に来た同じパスへの保存は、新しい1件として後で書く
+			const std::string path = next->first;
+			Request request = std::move(next->second);
+			requests_.erase(next);
+			lock.unlock();
+
+			const bool succeeded = Write(path, request.json, request.indent);
+
+			{
+				std::lock_guard<std::mutex> completedLock(completedMutex_);
+				completed_.push_back({ std::move(request.callbacks), succeeded });
+			}
+			completedCondition_.notify_all();
+
+			lock.lock();
+		}
+	}
+
+	/// <summary>
+	/// 文字列化して書き込む
+	/// </summary>
+	bool JsonWriter::Write(const std::string& path, const nlohmann::json& json, int indent)
+	{
+		std::string text;
+		try {
+			text = json.dump(indent);
+		} catch (const nlohmann::json::exception& e) {
+			Logger("JsonWriter: " + path + " の文字列化に失敗しました: " + e.what() + "\n");
+			return false;
+		}
+
+		if (!WriteAtomically(path, text)) {
+			Logger("JsonWriter: " + path + " に書き込めませんでした\n");
+			return false;
+		}
+
+		++writeCount_;
+		return true;
+	}
+
+	/// <summary>
+	/// 通知を1件行う
+	/// </summary>
+	bool JsonWriter::RunOneCompletion()
+	{
+		Completion completion;
+		{
+			std::lock_guard<std::mutex> lock(completedMutex_);
+			if (completed_.empty()) { return false; }
+			completion = std::move(completed_.front());
+			completed_.pop_front();
+		}
+
+		for (const Callback& callback : completion.callbacks) {
+			callback(completion.succeeded);
+		}
+		--pendingCount_;
+		completedCondition_.notify_all();
+		return true;
+	}
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <json.hpp>
+
+///************************* JSON 書き出しキュー *************************///
+///
+/// JSON の保存を専用スレッドで行い、ゲームループでのファイル書き込み待ちを無くす
+/// 呼び出し側は JSON の内容（コピー）を渡すだけで、文字列化と書き込みはスレッド側で行う
+///
+/// 同じファイルへの保存が短い間に続いたときは、最後の内容だけを書く（スライダーを動かし続けても毎フレーム書かない）
+/// 書き込みは一時ファイルへ書いてから置き換えるので、途中で落ちても元のファイルが壊れない
+/// 書き込み結果の通知はメインスレッドの Update で行う
+///
+namespace YoRigine {
+	class JsonWriter
+	{
+	public:
+		// 書き込みが終わったときに呼ばれる（成功したら true。メインスレッドで呼ぶ）
+		using Callback = std::function<void(bool succeeded)>;
+
+		///************************* 基本関数 *************************///
+
+		static JsonWriter* GetInstance();
+		JsonWriter() = default;
+		~JsonWriter();
+
+		// 書き込みスレッドを起動
+		void Initialize();
+
+		// 残りを書き出してスレッドを止める
+		void Finalize();
+
+		// メインスレッド：終わった書き込みの通知を行う（フレームの先頭で呼ぶ）
+		void Update();
+
+		// 待っている保存をすぐに書き出し、通知まで済ませる（メインスレッド）
+		// 保存したファイルを読み直す前に呼ぶ（待ちが無ければ何もしない）
+		void Flush();
+
+	public:
+		///************************* 保存 *************************///
+
+		// json を path へ保存する（indent は dump の字下げ）
+		// 同じパスへの保存がまだ書かれていなければ、内容を置き換えて書き込みを少し遅らせる
+		// スレッドが無いとき（Initialize 前・Finalize 後）はその場で書き込む
+		void Save(const std::string& path, nlohmann::json json, int indent = 4, Callback onComplete = nullptr);
+
+		// 一時ファイルに書いてから置き換える（フォルダが無ければ作る。同期）
+		static bool WriteAtomically(const std::filesystem::path& path, const std::string& text);
+
+	public:
+		///************************* アクセッサ *************************///
+
+		// 通知まで終わっていない保存があるか
+		bool IsIdle() const { return pendingCount_.load() == 0; }
+		uint32_t GetPendingCount() const { return pendingCount_.load(); }
+
+		// 最後の保存からこの時間（秒）だけ待ってから書く
+		void SetDebounce(float seconds) { debounceSeconds_ = seconds; }
+		float GetDebounce() const { return debounceSeconds_; }
+		// 保存が続いても、最初の保存からこの時間（秒）が経てば書く
+		void SetMaxDelay(float seconds) { maxDelaySeconds_ = seconds; }
+		float GetMaxDelay() const { return maxDelaySeconds_; }
+
+		// 書き込んだ回数と、まとめたことで省いた回数
+		uint32_t GetWriteCount() const { return writeCount_.load(); }
+		uint32_t GetCoalescedCount() const { return coalescedCount_.load(); }
+
+	private:
+		///************************* 内部処理 *************************///
+
+		using Clock = std::chrono::steady_clock;
+
+		// 書き込み待ちの保存（パスごとに1件）
+		struct Request {
+			nlohmann::json json;
+			int indent = 4;
+			Clock::time_point firstRequested;
+			Clock::time_point deadline;
+			std::vector<Callback> callbacks;
+		};
+
+		// 書き終わった保存の通知
+		struct Completion {
+			std::vector<Callback> callbacks;
+			bool succeeded = false;
+		};
+
+		// 書き込みスレッドの本体
+		void WorkerLoop();
+
+		// 文字列化して書き込む（失敗はログに出す）
+		bool Write(const std::string& path, const nlohmann::json& json, int indent);
+
+		// 終わった書き込みの通知を1件行う（無ければ false）
+		bool RunOneCompletion();
+
+	private:
+		///************************* メンバ変数 *************************///
+
+		static std::unique_ptr<JsonWriter> instance;
+		static std::once_flag initInstanceFlag;
+
+		JsonWriter(JsonWriter&) = delete;
+		JsonWriter& operator=(JsonWriter&) = delete;
+
+		std::thread worker_;
+
+		// 書き込み待ち
+		std::mutex requestMutex_;
+		std::condition_variable requestCondition_;
+		std::unordered_map<std::string, Request> requests_;
+		bool flushRequested_ = false;
+		bool stopRequested_ = false;
+
+		// メインスレッド待ちの通知
+		std::mutex completedMutex_;
+		std::condition_variable completedCondition_;
+		std::deque<Completion> completed_;
+
+		std::atomic<uint32_t> pendingCount_ = 0;
+		std::atomic<uint32_t> writeCount_ = 0;
+		std::atomic<uint32_t> coalescedCount_ = 0;
+		float debounceSeconds_ = 0.25f;
+		float maxDelaySeconds_ = 2.0f;
+	};
+}
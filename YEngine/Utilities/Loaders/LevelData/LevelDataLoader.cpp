@@ -1,192 +1,367 @@
 #include "LevelDataLoader.h"
 #include "Model.h"
 #include "ModelManager.h"
+#include "Debugger/Logger.h"
+
+// C++
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
 
 const std::string LevelDataLoader::defaultPath = "Resources/Json/LevelData/";
 const std::string LevelDataLoader::defaultFileName = "t.json";
 const std::string LevelDataLoader::defaultModelPath_ = "Resources/Models/";
 
-void LevelDataLoader::Initialize()
-{
-	FileCheck();
-	ScanningObjects();
-	SetScene();
-}
-
-void LevelDataLoader::FileCheck()
-{
-	const  std::string fullPath = defaultPath + defaultFileName;
-	std::ifstream file;
-
-	file.open(fullPath);
-
-	if (file.fail()) {
-		assert(0);
-	}
-	// 解答
-	file >> deserialized_;
-
-	// 正しいレベルデータファイルかチェック
-	assert(deserialized_.is_object());
-	assert(deserialized_.contains("name"));
-	assert(deserialized_["name"].is_string());
+namespace {
 
-	// name を文字列として取得
-	std::string name = deserialized_["name"].get<std::string>();
+	///************************* SAX 読み込み *************************///
+	///
+	/// レベルデータの JSON を DOM を作らずに読み、値を ObjectData へ直接詰める
+	/// 入れ子の位置をスタックで覚え、知らないキーの中身は読み飛ばす
+	///
+	class LevelSaxHandler : public nlohmann::json_sax<nlohmann::json>
+	{
+	public:
+		using ObjectData = LevelDataLoader::ObjectData;
+		using LevelData = LevelDataLoader::LevelData;
+
+		explicit LevelSaxHandler(LevelData& levelData) : levelData_(levelData) {}
+
+		// ルートの "name"（正しいファイルなら "scene"）
+		const std::string& GetSceneName() const { return sceneName_; }
+		const std::string& GetError() const { return error_; }
+
+		bool null() override { return true; }
+		bool boolean(bool) override { return true; }
+		bool number_integer(number_integer_t value) override { return Number(static_cast<float>(value)); }
+		bool number_unsigned(number_unsigned_t value) override { return Number(static_cast<float>(value)); }
+		bool number_float(number_float_t value, const string_t&) override { return Number(static_cast<float>(value)); }
+		bool binary(binary_t&) override { return true; }
+
+		bool string(string_t& value) override
+		{
+			if (stack_.empty()) { return true; }
+			const Frame& frame = stack_.back();
+
+			switch (frame.kind) {
+			case Kind::Root:
+				if (key_ == "name") { sceneName_ = value; }
+				break;
+			case Kind::Object: {
+				ObjectData& object = levelData_.objData[frame.object];
+				if (key_ == "type") {
+					object.isMesh = value == "MESH";
+				} else if (key_ == "name") {
+					object.name = value;
+				} else if (key_ == "file_name") {
+					object.modelIndex = FindOrAddModel(value);
+				}
+				break;
+			}
+			case Kind::Collider:
+				if (key_ == "type") { levelData_.objData[frame.object].colliderType = value; }
+				break;
+			default:
+				break;
+			}
+			return true;
+		}
 
-	// 正しいレベルデータファイルかチェック
-	assert(name.compare("scene") == 0);
+		bool start_object(std::size_t) override
+		{
+			if (stack_.empty()) {
+				stack_.push_back({ Kind::Root });
+				return true;
+			}
 
-}
+			const Frame frame = stack_.back();
+			switch (frame.kind) {
+			case Kind::Objects:
+			case Kind::Children: {
+				// 配列の要素が1つのオブジェクト（子は親の後ろに並ぶ）
+				ObjectData object;
+				object.parent = frame.kind == Kind::Children ? frame.object : LevelDataLoader::kNone;
+				levelData_.objData.push_back(std::move(object));
+				stack_.push_back({ Kind::Object, static_cast<uint32_t>(levelData_.objData.size() - 1) });
+				return true;
+			}
+			case Kind::Object:
+				if (key_ == "transform") {
+					stack_.push_back({ Kind::Transform, frame.object });
+					return true;
+				}
+				if (key_ == "collider") {
+					stack_.push_back({ Kind::Collider, frame.object });
+					return true;
+				}
+				break;
+			default:
+				break;
+			}
 
-void LevelDataLoader::ScanningObjects()
-{
+			stack_.push_back({ Kind::Skip });
+			return true;
+		}
 
-	levelData_ = std::make_unique<LevelData>();
+		bool end_object() override
+		{
+			stack_.pop_back();
+			return true;
+		}
 
-	// objects の全オブジェクト走査
-	for (nlohmann::json& object : deserialized_["objects"]) {
-		assert(object.contains("type"));
+		bool start_array(std::size_t) override
+		{
+			const Frame frame = stack_.empty() ? Frame{ Kind::Skip } : stack_.back();
+			Frame next = { Kind::Skip };
+
+			switch (frame.kind) {
+			case Kind::Root:
+				if (key_ == "objects") { next = { Kind::Objects }; }
+				break;
+			case Kind::Object:
+				if (key_ == "children") { next = { Kind::Children, frame.object }; }
+				break;
+			case Kind::Transform:
+				if (key_ == "translation") { next = { Kind::Vector, frame.object, &ObjectData::translation }; }
+				else if (key_ == "rotation") { next = { Kind::Vector, frame.object, &ObjectData::rotation }; }
+				else if (key_ == "scaling") { next = { Kind::Vector, frame.object, &ObjectData::scale }; }
+				break;
+			case Kind::Collider:
+				if (key_ == "center") { next = { Kind::Vector, frame.object, &ObjectData::colliderCenter }; }
+				else if (key_ == "size") { next = { Kind::Vector, frame.object, &ObjectData::colliderSize }; }
+				break;
+			default:
+				break;
+			}
 
-		// 種別を取得
-		std::string type = object["type"].get<std::string>();
+			stack_.push_back(next);
+			return true;
+		}
 
+		bool end_array() override
+		{
+			stack_.pop_back();
+			return true;
+		}
 
-		/*----------------------------------------------------------------------------
+		bool key(string_t& value) override
+		{
+			key_ = value;
+			return true;
+		}
 
+		bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& e) override
+		{
+			error_ = std::to_string(position) + ": " + e.what();
+			return false;
+		}
 
-								 ここからオブジェクトの情報読み込み
+	private:
+		// 今読んでいる場所
+		enum class Kind {
+			Root,		// ファイルのルート
+			Objects,	// "objects" 配列
+			Object,		// オブジェクト1つ
+			Children,	// "children" 配列
+			Transform,	// "transform"
+			Collider,	// "collider"
+			Vector,		// 3 要素の数値配列
+			Skip,		// 使わない値
+		};
+
+		struct Frame {
+			Kind kind = Kind::Skip;
+			uint32_t object = LevelDataLoader::kNone;
+			Vector3 ObjectData::* vector = nullptr;	// Vector のときの書き込み先
+			uint32_t component = 0;					// Vector の何番目の要素か
+		};
+
+		// 3 要素の配列の数値だけを受け取る
+		bool Number(float value)
+		{
+			if (stack_.empty()) { return true; }
+			Frame& frame = stack_.back();
+			if (frame.kind != Kind::Vector) { return true; }
+
+			Vector3& vector = levelData_.objData[frame.object].*frame.vector;
+			switch (frame.component++) {
+			case 0: vector.x = value; break;
+			case 1: vector.y = value; break;
+			case 2: vector.z = value; break;
+			default: break;
+			}
+			return true;
+		}
 
+		// 同じモデルは1つにまとめる
+		uint32_t FindOrAddModel(const std::string& fileName)
+		{
+			auto it = modelIndices_.find(fileName);
+			if (it != modelIndices_.end()) { return it->second; }
 
-		-----------------------------------------------------------------------------*/
+			const uint32_t index = static_cast<uint32_t>(levelData_.modelFiles.size());
+			levelData_.modelFiles.push_back(fileName);
+			modelIndices_.emplace(fileName, index);
+			return index;
+		}
 
-		/// Mesh
-		if (type.compare("MESH") == 0) {
-			// 要素追加
-			levelData_->objData.emplace_back(ObjectData{});
-			ObjectData& objectData = levelData_->objData.back();
+		LevelData& levelData_;
+		std::vector<Frame> stack_;
+		std::string key_;
+		std::string sceneName_;
+		std::string error_;
+		std::unordered_map<std::string, uint32_t> modelIndices_;
+	};
 
-			if (object.contains("file_name")) {
-				objectData.fileName = object["file_name"];
-			}
-			/// Transform
-			nlohmann::json transform = object["transform"];
-
-			// Translate
-			objectData.translation.x = static_cast<float>(transform["translation"][0]);
-			objectData.translation.y = static_cast<float>(transform["translation"][1]);
-			objectData.translation.z = static_cast<float>(transform["translation"][2]);
-
-			// Rotation
-			objectData.rotation.x = static_cast<float>(transform["rotation"][0]);
-			objectData.rotation.y = static_cast<float>(transform["rotation"][1]);
-			objectData.rotation.z = static_cast<float>(transform["rotation"][2]);
-
-			// Scale
-			objectData.scale.x = static_cast<float>(transform["scaling"][0]);
-			objectData.scale.y = static_cast<float>(transform["scaling"][1]);
-			objectData.scale.z = static_cast<float>(transform["scaling"][2]);
-
-
-			/// オブジェクト走査を再起関数にまとめ、再起的に呼び出す
-			if (object.contains("children")) {
-				for (const auto& child : object["children"]) {
-					ObjectData childData;
-					LoadObjectRecursive(child, childData);
-					objectData.children.push_back(std::move(childData));
-				}
-			}
+} // namespace
 
+void LevelDataLoader::Initialize(Camera* camera)
+{
+	camera_ = camera;
+	LoadFile(defaultPath + defaultFileName);
+	SetScene();
+}
 
+void LevelDataLoader::LoadFile(const std::string& fullPath)
+{
+	levelData_ = std::make_unique<LevelData>();
 
-		}
+	// まとめて読んでから解析する（ストリームから1文字ずつ読むより速い）
+	std::ifstream file(fullPath, std::ios::binary | std::ios::ate);
+	if (file.fail()) {
+		assert(0);
+		return;
+	}
+	std::string text(static_cast<size_t>(file.tellg()), '\0');
+	file.seekg(0);
+	file.read(text.data(), static_cast<std::streamsize>(text.size()));
+
+	LevelSaxHandler handler(*levelData_);
+	const bool parsed = nlohmann::json::sax_parse(text, &handler);
+	if (!parsed) {
+		Logger("LevelDataLoader: " + fullPath + " を読めませんでした（" + handler.GetError() + "）\n");
 	}
+
+	// 正しいレベルデータファイルかチェック
+	assert(parsed);
+	assert(handler.GetSceneName().compare("scene") == 0);
 }
 
-void LevelDataLoader::LoadObjectRecursive(const nlohmann::json& jsonObject, ObjectData& parent)
+void LevelDataLoader::SetScene()
 {
-	// 共通の読み込み処理
-	if (jsonObject.contains("file_name")) {
-		parent.fileName = jsonObject["file_name"];
-	}
-	if (jsonObject.contains("transform")) {
-		auto& t = jsonObject["transform"];
-
-		if (t.contains("translation") && t["translation"].is_array() && t["translation"].size() == 3) {
-			parent.translation.x = t["translation"][0];
-			parent.translation.y = t["translation"][1];
-			parent.translation.z = t["translation"][2];
-		}
-		if (t.contains("rotation") && t["rotation"].is_array() && t["rotation"].size() == 3) {
-			parent.rotation.x = t["rotation"][0];
-			parent.rotation.y = t["rotation"][1];
-			parent.rotation.z = t["rotation"][2];
-		}
-		if (t.contains("scaling") && t["scaling"].is_array() && t["scaling"].size() == 3) {
-			parent.scale.x = t["scaling"][0];
-			parent.scale.y = t["scaling"][1];
-			parent.scale.z = t["scaling"][2];
+	pendingObjects_.clear();
+	if (!levelData_) { return; }
+
+	// 最上位のメッシュだけを作る（子はデータとして持つだけ）
+	for (uint32_t i = 0; i < levelData_->objData.size(); ++i) {
+		const ObjectData& data = levelData_->objData[i];
+		if (data.parent == kNone && data.isMesh && data.modelIndex != kNone) {
+			pendingObjects_.push_back(i);
 		}
 	}
 
-	if (jsonObject.contains("collider")) {
-		auto& c = jsonObject["collider"];
+	const Vector3 eye = camera_ ? camera_->GetWorldPosition() : Vector3{};
+	SortPendingObjects(eye);
 
-		if (c.contains("type")) {
-			parent.colliderType = c["type"];
-		}
-		if (c.contains("center") && c["center"].is_array() && c["center"].size() == 3) {
-			parent.colliderCenter.x = c["center"][0];
-			parent.colliderCenter.y = c["center"][1];
-			parent.colliderCenter.z = c["center"][2];
-		}
-		if (c.contains("size") && c["size"].is_array() && c["size"].size() == 3) {
-			parent.colliderSize.x = c["size"][0];
-			parent.colliderSize.y = c["size"][1];
-			parent.colliderSize.z = c["size"][2];
-		}
-	}
+	// 近いものから使うモデルの読み込みを始めておく（同じモデルは1回だけ）
+	std::vector<uint8_t> requested(levelData_->modelFiles.size(), 0);
+	for (auto it = pendingObjects_.rbegin(); it != pendingObjects_.rend(); ++it) {
+		const uint32_t modelIndex = levelData_->objData[*it].modelIndex;
+		if (requested[modelIndex]) { continue; }
+		requested[modelIndex] = 1;
 
-	// childrenがある場合は再帰的に処理
-	if (jsonObject.contains("children") && jsonObject["children"].is_array()) {
-		for (const auto& childJson : jsonObject["children"]) {
-			ObjectData child;
-			LoadObjectRecursive(childJson, child);
-			parent.children.push_back(std::move(child));
-		}
+		auto [basePath, fileName] = ModelManager::GetInstance()->ParseModelPath(levelData_->modelFiles[modelIndex]);
+		ModelManager::GetInstance()->LoadModelAsync(defaultModelPath_ + basePath, fileName);
 	}
+
+	objects_.reserve(objects_.size() + pendingObjects_.size());
+	worldTransforms_.reserve(worldTransforms_.size() + pendingObjects_.size());
 }
 
-void LevelDataLoader::SetScene()
+void LevelDataLoader::SortPendingObjects(const Vector3& eye)
 {
-	for (auto& data : levelData_->objData)
-	{
-		auto obj = Object3d::Create(data.fileName);
-		if (!obj) continue;
-
-		auto wt = std::make_unique<WorldTransform>();
-		wt->Initialize();
-		wt->translate_ = ConvertPosition(data.translation);
-		wt->rotate_ = data.rotation;
-		wt->scale_ = data.scale;
+	sortedEye_ = eye;
+
+	// 距離はレベルデータの位置で測る（作る前なのでモデルの大きさは分からない）
+	std::vector<std::pair<float, uint32_t>> keyed;
+	keyed.reserve(pendingObjects_.size());
+	for (uint32_t index : pendingObjects_) {
+		const Vector3 diff = ConvertPosition(levelData_->objData[index].translation) - eye;
+		keyed.emplace_back(diff.x * diff.x + diff.y * diff.y + diff.z * diff.z, index);
+	}
+	std::sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
 
-		objects_.push_back(std::move(obj));
-		worldTransforms_.push_back(std::move(wt));
+	for (size_t i = 0; i < keyed.size(); ++i) {
+		pendingObjects_[i] = keyed[i].second;
 	}
 }
 
+void LevelDataLoader::CreateObject(const ObjectData& data)
+{
+	// モデルは SetScene で読み込みを始めているので、終わるまでは描画しない
+	auto obj = Object3d::CreateAsync(levelData_->modelFiles[data.modelIndex]);
+	if (!obj) { return; }
+	// カメラの視錐台の判定は Draw でまとめて行う（影の判定は Object3d に任せる）
+	obj->SetEnableCameraCulling(false);
+
+	auto wt = std::make_unique<WorldTransform>();
+	wt->Initialize();
+	wt->translate_ = ConvertPosition(data.translation);
+	wt->rotate_ = data.rotation;
+	wt->scale_ = data.scale;
+
+	transformHierarchy_.Register(wt.get());
+
+	objects_.push_back(std::move(obj));
+	worldTransforms_.push_back(std::move(wt));
+}
+
 
 void LevelDataLoader::Update()
 {
-	for (size_t i = 0; i < worldTransforms_.size(); ++i) {
-		worldTransforms_[i]->UpdateMatrix();
+	// 生成待ちをカメラに近い順に、予算の範囲で作る（最低1つ）
+	if (!pendingObjects_.empty()) {
+		if (camera_) {
+			const Vector3 eye = camera_->GetWorldPosition();
+			const Vector3 moved = eye - sortedEye_;
+			if (moved.x * moved.x + moved.y * moved.y + moved.z * moved.z > kResortDistance * kResortDistance) {
+				SortPendingObjects(eye);
+			}
+		}
+
+		using Clock = std::chrono::steady_clock;
+		const auto start = Clock::now();
+		do {
+			const uint32_t index = pendingObjects_.back();
+			pendingObjects_.pop_back();
+			CreateObject(levelData_->objData[index]);
+		} while (!pendingObjects_.empty() &&
+			std::chrono::duration<float, std::milli>(Clock::now() - start).count() < instantiateBudgetMs_);
 	}
+
+	// 配置物はほぼ静的なので、動いたものだけ再計算・転送する
+	transformHierarchy_.Update();
 }
 
 void LevelDataLoader::Draw(Camera* camera)
 {
+	if (!camera) {
+		for (size_t i = 0; i < objects_.size(); ++i) {
+			objects_[i]->Draw(camera, *worldTransforms_[i]);
+		}
+		return;
+	}
+
+	// 全オブジェクトの AABB を一括で視錐台と判定し、見えるものだけコマンドを積む
+	// IsModelReady は判定の前に全オブジェクトで呼ぶ（画面外でも読み込みの完了をここで拾う）
+	const std::span<const uint8_t> visible = culler_.Cull(camera->GetFrustum(), objects_.size(),
+		[&](size_t i) { return objects_[i]->IsModelReady(); },
+		[&](size_t i) { return objects_[i]->GetWorldAABB(*worldTransforms_[i]); });
+
 	for (size_t i = 0; i < objects_.size(); ++i) {
-		objects_[i]->Draw(camera, *worldTransforms_[i]);
+		if (visible[i]) {
+			objects_[i]->Draw(camera, *worldTransforms_[i]);
+		}
 	}
 }
 
@@ -7,9 +7,13 @@
 #include <fstream>
 #include <filesystem>
 #include <memory>
+#include <cstdint>
+#include <vector>
 
 // Engine
 #include "WorldTransform/WorldTransform.h"
+#include "WorldTransform/TransformHierarchy.h"
+#include "LevelObjectCuller.h"
 #include "Object3D/Object3d.h"
 #include "Systems/Camera/Camera.h"
 
@@ -20,60 +24,82 @@
 /// モデル、トランスフォーム、コライダー情報などを読み取り、
 /// 階層構造を再現してシーンを構築する。
 ///
+/// JSON は DOM を作らずに SAX で読み、必要な値だけを ObjectData へ直接詰める。
+/// オブジェクトはすぐには作らず、カメラに近い順に 1 フレームの予算の範囲で Update から少しずつ作る。
+/// モデルは重複を除いて非同期で読み込むので、大きなレベルでもすぐに動き始められる。
+///
 class LevelDataLoader
 {
 public:
 	///************************* 内部構造体 *************************///
 
+	static constexpr uint32_t kNone = UINT32_MAX;
+
 	// オブジェクト情報構造体
 	struct ObjectData {
-		std::string fileName;        // モデルファイル名
-		std::string name;            // オブジェクト名（Blenderの "name"）
-		Vector3 translation;         // 位置（translation）
-		Vector3 rotation;            // 回転（rotation）
-		Vector3 scale;               // スケーリング（scaling）
+		std::string name;                   // オブジェクト名（Blenderの "name"）
+		uint32_t modelIndex = kNone;        // モデルファイル名（LevelData::modelFiles の添字。無ければ kNone）
+		uint32_t parent = kNone;            // 親（LevelData::objData の添字。最上位なら kNone）
+		bool isMesh = false;                // 種類が "MESH" か
+		Vector3 translation = {};           // 位置（translation）
+		Vector3 rotation = {};              // 回転（rotation）
+		Vector3 scale = { 1.0f,1.0f,1.0f }; // スケーリング（scaling）
 
 		// コライダー情報
-		std::string colliderType;    // コライダーの種類（Sphere, AABB, OBBなど）
-		Vector3 colliderCenter;      // コライダー中心位置
-		Vector3 colliderSize;        // コライダーサイズ
-
-		// 子オブジェクト（階層構造対応）
-		std::vector<ObjectData> children;
+		std::string colliderType;           // コライダーの種類（Sphere, AABB, OBBなど）
+		Vector3 colliderCenter = {};        // コライダー中心位置
+		Vector3 colliderSize = {};          // コライダーサイズ
 	};
 
 	// レベル全体の情報構造体
 	struct LevelData {
-		std::vector<ObjectData> objData; // 含まれるオブジェクト一覧
+		std::vector<ObjectData> objData;     // 含まれるオブジェクト一覧（子は親より後ろに並ぶ）
+		std::vector<std::string> modelFiles; // 使うモデルファイル名（重複なし）
 	};
 
 public:
 	///************************* 基本処理 *************************///
 
-	// 初期化処理（ファイルロード準備）
-	void Initialize();
-
-	// ファイル存在チェック（JSONパス検証）
-	void FileCheck();
+	// 初期化処理（ファイルを読んで、オブジェクトの生成とモデルの読み込みを予約する）
+	// camera があれば、カメラに近いものから作る
+	void Initialize(Camera* camera = nullptr);
 
-	// JSONファイル内のオブジェクトを走査・解析
-	void ScanningObjects();
+	// JSONファイルを SAX で読み、levelData_ を作る
+	void LoadFile(const std::string& fullPath);
 
-	// JSONオブジェクトを再帰的に読み取り、階層構造を再現
-	void LoadObjectRecursive(const nlohmann::json& jsonObject, ObjectData& parent);
-
-	// 読み込んだデータをもとにシーンを構築
+	// 読み込んだデータをもとに、生成待ちの一覧を作ってモデルの読み込みを始める
 	void SetScene();
 
 public:
 	///************************* 更新・描画 *************************///
 
-	// フレーム更新処理
+	// フレーム更新処理（生成待ちのオブジェクトを予算の範囲で作る）
 	void Update();
 
 	// 読み込んだ全オブジェクトを描画
 	void Draw(Camera* camera);
 
+public:
+	///************************* アクセッサ *************************///
+
+	// 生成待ちが残っていないか
+	bool IsSceneReady() const { return pendingObjects_.empty(); }
+	size_t GetPendingObjectCount() const { return pendingObjects_.size(); }
+	size_t GetObjectCount() const { return objects_.size(); }
+
+	// 1フレームにオブジェクトの生成へ使う時間（ミリ秒。最低1つは作る）
+	void SetInstantiateBudget(float milliseconds) { instantiateBudgetMs_ = milliseconds; }
+	float GetInstantiateBudget() const { return instantiateBudgetMs_; }
+
+private:
+	///************************* 内部処理 *************************///
+
+	// 生成待ちをカメラから遠い順に並べる（末尾が最も近い）
+	void SortPendingObjects(const Vector3& eye);
+
+	// 1つ分のオブジェクトを作る
+	void CreateObject(const ObjectData& data);
+
 private:
 	///************************* メンバ変数 *************************///
 
@@ -81,11 +107,18 @@ private:
 	static const std::string defaultFileName;		// デフォルトのファイル名
 	static const std::string defaultModelPath_;		// モデル格納パス
 
-	nlohmann::json deserialized_;					// デシリアライズ済みJSONデータ
-
 	std::unique_ptr<LevelData> levelData_;			// レベルデータ本体
-	std::map<std::string, Model*> models_;			// モデルキャッシュ
+	Camera* camera_ = nullptr;						// 生成の優先度を決めるカメラ
+
+	// 生成待ち（levelData_->objData の添字。末尾から作る）
+	std::vector<uint32_t> pendingObjects_;
+	Vector3 sortedEye_ = {};						// 最後に並べ替えたときのカメラ位置
+	float instantiateBudgetMs_ = 2.0f;
+	// カメラがこの距離より動いたら並べ替え直す
+	static constexpr float kResortDistance = 4.0f;
 
 	std::vector<std::unique_ptr<Object3d>> objects_;		 // シーン上の3Dオブジェクト
 	std::vector<std::unique_ptr<WorldTransform>> worldTransforms_; // オブジェクトの変換情報
+	TransformHierarchy transformHierarchy_;                        // 変換の階層管理（変更があったものだけ更新）
+	LevelObjectCuller culler_;                                     // 描画時の一括カリング（読み込み中のものは除く）
 };
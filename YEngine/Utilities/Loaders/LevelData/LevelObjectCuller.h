@@ -0,0 +1,53 @@
+#pragma once
+
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Math
+#include "Frustum.h"
+
+///************************* レベル配置物の一括カリング *************************///
+///
+/// 配置物のワールド AABB を集めて CullAABBs でまとめて視錐台と判定する。
+/// 非同期読み込み中のオブジェクトはモデルが無いので AABB も無い（原点の大きさ0の箱になる）。
+/// それを判定すると原点が画面外のあいだ見えない扱いになり、読み込みの完了を確かめる Draw が
+/// 呼ばれないまま残ってしまう。そこで isReady を毎回全オブジェクトに対して呼んで完了を確かめ、
+/// 準備できたものだけを判定する（読み込み中のものは見えない扱い）。
+///
+class LevelObjectCuller
+{
+public:
+	/// <summary>
+	/// count 個のオブジェクトを判定し、見えるものが 1 の配列を返す（次の Cull まで有効）
+	/// </summary>
+	/// <param name="isReady">isReady(i): i 番目のモデルが使えるか（読み込み中なら完了を確かめる）</param>
+	/// <param name="getAABB">getAABB(i): i 番目のワールド AABB（isReady(i) が true のものにだけ呼ぶ）</param>
+	template <class IsReady, class GetAABB>
+	std::span<const uint8_t> Cull(const Frustum& frustum, size_t count, IsReady&& isReady, GetAABB&& getAABB)
+	{
+		aabbs_.resize(count);
+		readyFlags_.resize(count);
+		visibleFlags_.resize(count);
+
+		for (size_t i = 0; i < count; ++i) {
+			const bool ready = isReady(i);
+			readyFlags_[i] = ready ? 1 : 0;
+			aabbs_[i] = ready ? getAABB(i) : AABB{};
+		}
+		CullAABBs(frustum, aabbs_, visibleFlags_);
+
+		// 読み込み中のものは AABB が仮なので、判定の結果によらず描かない
+		for (size_t i = 0; i < count; ++i) {
+			if (!readyFlags_[i]) { visibleFlags_[i] = 0; }
+		}
+		return visibleFlags_;
+	}
+
+private:
+	std::vector<AABB> aabbs_;           // ワールド AABB（作業領域）
+	std::vector<uint8_t> readyFlags_;   // モデルが使えるか
+	std::vector<uint8_t> visibleFlags_; // 視錐台判定の結果
+};
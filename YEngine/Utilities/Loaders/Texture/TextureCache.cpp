@@ -0,0 +1,148 @@
+#include "TextureCache.h"
+
+// C++
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+	// ファイルを読む単位（8 の倍数にして、最後の塊以外で端数が出ないようにする）
+	constexpr size_t kReadChunkSize = 64 * 1024;
+
+	// 64bit の混ぜ込み（splitmix64 の最終段）
+	uint64_t Mix(uint64_t h) {
+		h ^= h >> 30;
+		h *= 0xBF58476D1CE4E5B9ull;
+		h ^= h >> 27;
+		h *= 0x94D049BB133111EBull;
+		h ^= h >> 31;
+		return h;
+	}
+
+	// 8バイトずつ積む（暗号用途ではないので衝突しにくければよい）
+	uint64_t Accumulate(uint64_t h, uint64_t word) {
+		h ^= word;
+		h *= 0x9E3779B97F4A7C15ull;
+		return h ^ (h >> 32);
+	}
+
+	std::string ToLower(std::string text) {
+		std::transform(text.begin(), text.end(), text.begin(),
+			[](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return text;
+	}
+
+	bool EndsWith(std::string_view text, std::string_view suffix) {
+		return text.size() >= suffix.size() && text.substr(text.size() - suffix.size()) == suffix;
+	}
+
+} // namespace
+
+///************************* 種類の判定 *************************///
+
+/// <summary>
+/// ファイル名の接尾辞からテクスチャの種類を決める
+/// </summary>
+TextureCache::Kind TextureCache::ClassifyTexture(const std::filesystem::path& sourcePath)
+{
+	const std::string stem = ToLower(sourcePath.stem().string());
+
+	constexpr std::array<std::string_view, 3> kNormalSuffixes = { "_normal", "_nrm", "_n" };
+	constexpr std::array<std::string_view, 6> kMaskSuffixes = { "_mask", "_rough", "_roughness", "_metal", "_ao", "_height" };
+
+	for (std::string_view suffix : kNormalSuffixes) {
+		if (EndsWith(stem, suffix)) { return Kind::Normal; }
+	}
+	for (std::string_view suffix : kMaskSuffixes) {
+		if (EndsWith(stem, suffix)) { return Kind::Mask; }
+	}
+	return Kind::Color;
+}
+
+/// <summary>
+/// 変換の対象になる拡張子か
+/// </summary>
+bool TextureCache::IsCookableExtension(const std::filesystem::path& sourcePath)
+{
+	const std::string extension = ToLower(sourcePath.extension().string());
+	return extension == ".png" || extension == ".jpg" || extension == ".jpeg" ||
+		extension == ".bmp" || extension == ".tga";
+}
+
+///************************* ハッシュ *************************///
+
+/// <summary>
+/// 元画像の内容・種類・変換バージョンからハッシュを作る
+/// </summary>
+uint64_t TextureCache::HashSource(const std::filesystem::path& sourcePath)
+{
+	std::ifstream file(sourcePath, std::ios::binary);
+	if (!file) { return 0; }
+
+	uint64_t h = Mix(0x6A09E667F3BCC908ull ^ kCookVersion);
+	h = Accumulate(h, static_cast<uint64_t>(ClassifyTexture(sourcePath)));
+
+	std::vector<char> buffer(kReadChunkSize);
+	uint64_t totalSize = 0;
+	while (file) {
+		file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		const size_t readSize = static_cast<size_t>(file.gcount());
+		if (readSize == 0) { break; }
+		totalSize += readSize;
+
+		size_t offset = 0;
+		for (; offset + sizeof(uint64_t) <= readSize; offset += sizeof(uint64_t)) {
+			uint64_t word = 0;
+			std::memcpy(&word, buffer.data() + offset, sizeof(word));
+			h = Accumulate(h, word);
+		}
+
+		// 端数（最後の塊だけ）
+		if (offset < readSize) {
+			uint64_t word = 0;
+			std::memcpy(&word, buffer.data() + offset, readSize - offset);
+			h = Accumulate(h, word);
+		}
+	}
+
+	// 0 は「読めなかった」に使うので避ける
+	const uint64_t hash = Mix(h ^ totalSize);
+	return hash != 0 ? hash : 1;
+}
+
+///************************* パス *************************///
+
+/// <summary>
+/// ハッシュに対応するキャッシュのパス
+/// </summary>
+std::filesystem::path TextureCache::MakeCookedPath(uint64_t hash, const std::filesystem::path& cacheDirectory)
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.dds", static_cast<unsigned long long>(hash));
+	return cacheDirectory / name;
+}
+
+/// <summary>
+/// 元画像に対応する変換済みファイルを探す
+/// </summary>
+std::filesystem::path TextureCache::FindCooked(const std::filesystem::path& sourcePath, const std::filesystem::path& cacheDirectory)
+{
+	if (!IsCookableExtension(sourcePath)) { return {}; }
+
+	std::error_code error;
+	if (!std::filesystem::is_directory(cacheDirectory, error)) { return {}; }
+
+	const uint64_t hash = HashSource(sourcePath);
+	if (hash == 0) { return {}; }
+
+	std::filesystem::path cookedPath = MakeCookedPath(hash, cacheDirectory);
+	if (!std::filesystem::exists(cookedPath, error)) { return {}; }
+	return cookedPath;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <filesystem>
+
+///************************* テクスチャキャッシュ *************************///
+///
+/// TextureCooker が書き出す変換済み DDS の置き場所と名前の規則
+/// 元画像の内容と変換設定からハッシュを作り、<キャッシュ>/<ハッシュ>.dds として保存する
+/// 元画像を差し替えるとハッシュも変わるので、古い変換結果を読むことはない
+///
+/// DirectX / Windows には依存しない（エンジンとツールの両方でビルドする）
+///
+namespace TextureCache {
+
+	// 変換設定を変えたら上げる（既存のキャッシュをすべて無効にする）
+	constexpr uint32_t kCookVersion = 1;
+
+	// キャッシュの既定の置き場所（実行時のカレントディレクトリから）
+	inline const std::filesystem::path kDefaultCacheDirectory = "Resources/Cooked/Textures";
+
+	// 圧縮形式を決めるためのテクスチャの種類
+	enum class Kind {
+		Color,		// sRGB カラー → BC7
+		Normal,		// 法線マップ（xy のみ） → BC5
+		Mask,		// 1チャンネルのマスク → BC4（シェーダーでは .r を読む）
+	};
+
+	// ファイル名の接尾辞から種類を決める
+	// *_normal / *_n → Normal、*_mask / *_rough / *_metal / *_ao / *_height → Mask、それ以外は Color
+	Kind ClassifyTexture(const std::filesystem::path& sourcePath);
+
+	// 変換の対象になる拡張子か（DDS は変換済みとみなして対象外）
+	bool IsCookableExtension(const std::filesystem::path& sourcePath);
+
+	// 元画像の内容と種類・変換バージョンから作るハッシュ（読めなければ 0）
+	uint64_t HashSource(const std::filesystem::path& sourcePath);
+
+	// ハッシュに対応するキャッシュのパス
+	std::filesystem::path MakeCookedPath(uint64_t hash, const std::filesystem::path& cacheDirectory = kDefaultCacheDirectory);
+
+	// 元画像に対応する変換済みファイルがあればそのパス、なければ空
+	std::filesystem::path FindCooked(const std::filesystem::path& sourcePath, const std::filesystem::path& cacheDirectory = kDefaultCacheDirectory);
+}
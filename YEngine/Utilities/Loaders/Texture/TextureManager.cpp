@@ -1,8 +1,12 @@
 #include "TextureManager.h"
 #include "Debugger/Logger.h"
+#include "TextureCache.h"
+#include "Loaders/Async/AssetLoader.h"
 
 
 // C++
+#include <cstring>
+#include <filesystem>
 #include <mutex>
 #include <assert.h>
 #include <d3dx12.h>
@@ -27,6 +31,8 @@ TextureManager* TextureManager::GetInstance()
 /// </summary>
 void TextureManager::Finalize()
 {
+	// 残っているテクスチャはここでまとめて破棄する
+	AssetRegistry::GetInstance()->UnregisterAll(AssetType::Texture);
 
 	instance.reset(); // インスタンスをリセットし、メモリを解放
 }
@@ -50,6 +56,9 @@ void TextureManager::Initialize(YoRigine::DirectXCommon* dxCommon, SrvManager* s
 
 	// テクスチャデータのバケット数を予約
 	textureDatas.reserve(SrvManager::kMaxSRVCount_);
+
+	// 非同期読み込み中の代わり
+	CreatePlaceholder();
 }
 
 /// <summary>
@@ -57,55 +66,226 @@ void TextureManager::Initialize(YoRigine::DirectXCommon* dxCommon, SrvManager* s
 /// </summary>
 /// <param name="filePath">読み込むファイルパス</param>
 void TextureManager::LoadTexture(const std::string& filePath)
+{
+	if (TextureData* textureData = LoadTextureData(filePath)) {
+		AssetRegistry::GetInstance()->Pin(textureData->assetId);
+	}
+}
+
+/// <summary>
+/// テクスチャファイルの非同期読み込み
+/// </summary>
+/// <param name="filePath">読み込むファイルパス</param>
+void TextureManager::LoadTextureAsync(const std::string& filePath)
+{
+	if (TextureData* textureData = LoadTextureDataAsync(filePath)) {
+		AssetRegistry::GetInstance()->Pin(textureData->assetId);
+	}
+}
+
+/// <summary>
+/// テクスチャを読み込んで参照を取る
+/// </summary>
+AssetHandle TextureManager::AcquireTexture(const std::string& filePath)
+{
+	TextureData* textureData = LoadTextureData(filePath);
+	return textureData ? AssetRegistry::GetInstance()->Acquire(textureData->assetId) : AssetHandle{};
+}
+
+/// <summary>
+/// テクスチャを非同期で読み込んで参照を取る
+/// </summary>
+AssetHandle TextureManager::AcquireTextureAsync(const std::string& filePath)
+{
+	TextureData* textureData = LoadTextureDataAsync(filePath);
+	return textureData ? AssetRegistry::GetInstance()->Acquire(textureData->assetId) : AssetHandle{};
+}
+
+/// <summary>
+/// テクスチャファイルの読み込みと登録
+/// </summary>
+TextureManager::TextureData* TextureManager::LoadTextureData(const std::string& filePath)
 {
 
 	if (!srvManager_ || !dxCommon_) {
 		Logger("Error: srvManager_ or dxCommon_ is null in TextureManager::LoadTexture");
-		return;
+		return nullptr;
 	}
 
-	// 既に読み込み済みであれば早期リターン
-	if (textureDatas.contains(filePath)) {
-		return;
+	// 既に読み込み済みであれば早期リターン（非同期で読み込み中なら終わるまで待つ）
+	if (auto it = textureDatas.find(filePath); it != textureDatas.end()) {
+		if (!it->second.isReady) {
+			AssetLoader::GetInstance()->Flush();
+		}
+		return &it->second;
 	}
 
 	// テクスチャ上限枚数チェック
 	assert(srvManager_->IsAllocation());
 
-	// テクスチャファイルをWICから読み込み
+	DirectX::ScratchImage mipImages{};
+	HRESULT hr = DecodeTexture(filePath, mipImages);
+	assert(SUCCEEDED(hr));
+	if (FAILED(hr)) {
+		return nullptr;
+	}
+
+	// テクスチャデータの追加
+	TextureData& textureData = textureDatas[filePath];
+	textureData.srvIndex = srvManager_->Allocate();
+	CreateTextureFromImage(textureData, mipImages);
+
+	textureData.assetId = AssetRegistry::GetInstance()->Register(
+		AssetType::Texture, filePath, GetResourceSize(textureData.resource.Get()),
+		[this, filePath]() { return UnloadTexture(filePath); });
+	return &textureData;
+}
+
+/// <summary>
+/// テクスチャファイルの非同期読み込みと登録
+/// </summary>
+TextureManager::TextureData* TextureManager::LoadTextureDataAsync(const std::string& filePath)
+{
+	if (!srvManager_ || !dxCommon_) {
+		Logger("Error: srvManager_ or dxCommon_ is null in TextureManager::LoadTextureAsync");
+		return nullptr;
+	}
+
+	// 既に読み込み済み・読み込み中
+	if (auto it = textureDatas.find(filePath); it != textureDatas.end()) {
+		return &it->second;
+	}
+
+	// テクスチャ上限枚数チェック
+	assert(srvManager_->IsAllocation());
+
+	// SRV の番号は先に確保して、読み込みが終わるまではプレースホルダーを指しておく
+	// 番号は変わらないので、GPUハンドルやインデックスを保持している側もそのまま使える
+	TextureData& textureData = textureDatas[filePath];
+	textureData.srvIndex = srvManager_->Allocate();
+	textureData.metadata = placeholder_.metadata;
+	textureData.srvHandleCPU = srvManager_->GetCPUDescriptorHandle(textureData.srvIndex);
+	textureData.srvHandleGPU = srvManager_->GetGPUDescriptorHandle(textureData.srvIndex);
+	textureData.isReady = false;
+	srvManager_->CreateSRVforTexture2D(textureData.srvIndex, placeholder_.resource.Get(), placeholder_.metadata);
+
+	// 使用量は読み込みが終わってから設定する
+	textureData.assetId = AssetRegistry::GetInstance()->Register(
+		AssetType::Texture, filePath, 0,
+		[this, filePath]() { return UnloadTexture(filePath); });
+
+	// 展開はワーカー、リソース生成と転送はメインスレッド
+	auto mipImages = std::make_shared<DirectX::ScratchImage>();
+	auto result = std::make_shared<HRESULT>(E_FAIL);
+	AssetLoader::GetInstance()->Enqueue(
+		[this, filePath, mipImages, result]() {
+			*result = DecodeTexture(filePath, *mipImages);
+		},
+		[this, filePath, mipImages, result]() {
+			auto it = textureDatas.find(filePath);
+			if (it == textureDatas.end()) { return; }
+
+			// 失敗したらプレースホルダーのまま使う
+			if (FAILED(*result)) {
+				Logger("Error: Failed to load texture: " + filePath + "\n");
+			} else {
+				CreateTextureFromImage(it->second, *mipImages);
+				AssetRegistry::GetInstance()->SetSize(it->second.assetId, GetResourceSize(it->second.resource.Get()));
+			}
+			it->second.isReady = true;
+		});
+	return &textureData;
+}
+
+/// <summary>
+/// テクスチャの解放（AssetRegistry から呼ばれる）
+/// </summary>
+bool TextureManager::UnloadTexture(const std::string& filePath)
+{
+	auto it = textureDatas.find(filePath);
+	if (it == textureDatas.end()) { return true; }
+
+	// 読み込み中はワーカーが書き込むので解放しない
+	if (!it->second.isReady) { return false; }
+
+	// 描画に使い終わってからリソースと SRV 番号を返す
+	DeferredReleaseQueue* releaseQueue = dxCommon_->GetDeferredReleaseQueue();
+	releaseQueue->Retire(std::move(it->second.resource));
+	const uint32_t srvIndex = it->second.srvIndex;
+	SrvManager* srvManager = srvManager_;
+	releaseQueue->Retire([srvManager, srvIndex]() { srvManager->Free(srvIndex); });
+
+	textureDatas.erase(it);
+	return true;
+}
+
+/// <summary>
+/// GPU 上の使用量
+/// </summary>
+uint64_t TextureManager::GetResourceSize(ID3D12Resource* resource) const
+{
+	if (!resource) { return 0; }
+
+	const D3D12_RESOURCE_DESC desc = resource->GetDesc();
+	return dxCommon_->GetDevice()->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+}
+
+/// <summary>
+/// 読み込みが終わっているか
+/// </summary>
+bool TextureManager::IsTextureReady(const std::string& filePath) const
+{
+	auto it = textureDatas.find(filePath);
+	return it != textureDatas.end() && it->second.isReady;
+}
+
+/// <summary>
+/// ファイルの読み込みとミップマップの生成（ワーカースレッドからも呼ぶ）
+/// </summary>
+HRESULT TextureManager::DecodeTexture(const std::string& filePath, DirectX::ScratchImage& mipImages)
+{
+	// TextureCooker で変換済み（ミップ付き・圧縮済み）の DDS があればそちらを読む
 	DirectX::ScratchImage image{};
 	std::wstring filepathW = ConvertString(filePath);
+	const std::filesystem::path cookedPath = TextureCache::FindCooked(filePath);
 
 	HRESULT hr;
 
-	if (filepathW.ends_with(L".dds")) {
+	if (!cookedPath.empty()) {
+		hr = DirectX::LoadFromDDSFile(cookedPath.wstring().c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
+	} else if (filepathW.ends_with(L".dds")) {
 		hr = DirectX::LoadFromDDSFile(filepathW.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
 	} else {
-		hr = DirectX::LoadFromWICFile(filepathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
+		// 法線・マスクは変換済みと同じくリニアのまま読む
+		const DirectX::WIC_FLAGS wicFlags = (TextureCache::ClassifyTexture(filePath) == TextureCache::Kind::Color)
+			? DirectX::WIC_FLAGS_FORCE_SRGB : DirectX::WIC_FLAGS_IGNORE_SRGB;
+		hr = DirectX::LoadFromWICFile(filepathW.c_str(), wicFlags, nullptr, image);
+	}
+	if (FAILED(hr)) {
+		return hr;
 	}
-	assert(SUCCEEDED(hr));
 
 	if (image.GetMetadata().width == 0 || image.GetMetadata().height == 0) {
 		Logger("Error: Invalid image dimensions (width or height is 0): " + filePath);
-		assert(false);
-		return;
+		return E_FAIL;
 	}
 
-	// ミップマップの生成
-	DirectX::ScratchImage mipImages{};
-	if (DirectX::IsCompressed(image.GetMetadata().format)) {
+	// ミップマップの生成（圧縮済み・ミップ付きの DDS はそのまま使う）
+	if (DirectX::IsCompressed(image.GetMetadata().format) || image.GetMetadata().mipLevels > 1) {
 		mipImages = std::move(image);
-	} else {
-		hr = DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::TEX_FILTER_SRGB, 0, mipImages);
+		return S_OK;
 	}
-	assert(SUCCEEDED(hr));
+	return DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::TEX_FILTER_SRGB, 0, mipImages);
+}
 
-	// テクスチャデータの追加
-	TextureData& textureData = textureDatas[filePath];
-	textureData.srvIndex = srvManager_->Allocate();
+/// <summary>
+/// リソースの生成・転送コマンドの記録・SRVの生成（メインスレッド）
+/// </summary>
+void TextureManager::CreateTextureFromImage(TextureData& textureData, const DirectX::ScratchImage& mipImages)
+{
 	textureData.metadata = mipImages.GetMetadata();
 	textureData.resource = CreateTextureResource(textureData.metadata);
-	textureData.intermediateResource = UploadTextureData(textureData.resource.Get(), mipImages);
+	UploadTextureData(textureData.resource.Get(), mipImages);
 
 	// SRVハンドルの設定
 	textureData.srvHandleCPU = srvManager_->GetCPUDescriptorHandle(textureData.srvIndex);
@@ -118,6 +298,21 @@ void TextureManager::LoadTexture(const std::string& filePath)
 		textureData.metadata);
 }
 
+/// <summary>
+/// 読み込み中に表示する 1x1 の白テクスチャ
+/// </summary>
+void TextureManager::CreatePlaceholder()
+{
+	DirectX::ScratchImage image{};
+	HRESULT hr = image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 1, 1, 1, 1);
+	assert(SUCCEEDED(hr));
+	std::memset(image.GetPixels(), 0xFF, image.GetPixelsSize());
+
+	placeholder_.metadata = image.GetMetadata();
+	placeholder_.resource = CreateTextureResource(placeholder_.metadata);
+	UploadTextureData(placeholder_.resource.Get(), image);
+}
+
 /// <summary>
 /// ファイルパスからテクスチャのSRVインデックスを取得
 /// </summary>
@@ -225,7 +420,7 @@ Microsoft::WRL::ComPtr<ID3D12Resource> TextureManager::CreateTextureResource(con
 	return resource;
 }
 
-Microsoft::WRL::ComPtr<ID3D12Resource> TextureManager::UploadTextureData(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const DirectX::ScratchImage& mipImages)
+void TextureManager::UploadTextureData(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const DirectX::ScratchImage& mipImages)
 {
 	std::vector<D3D12_SUBRESOURCE_DATA> subresources;
 	// 読み込んだデータからDirectX12用のSubresourceの配列を作成
@@ -248,5 +443,7 @@ Microsoft::WRL::ComPtr<ID3D12Resource> TextureManager::UploadTextureData(Microso
 	barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
 	barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
 	commandList_->ResourceBarrier(1, &barrier);
-	return intermediateResource;
+
+	// 転送コマンドが GPU で終わるまで中間リソースを残す
+	YoRigine::DirectXCommon::GetInstance()->GetDeferredReleaseQueue()->Retire(std::move(intermediateResource));
 }
@@ -12,6 +12,7 @@
 #include "DirectXCommon.h"
 #include "DirectXTex.h"
 #include <SrvManager.h>
+#include "Loaders/Asset/AssetRegistry.h"
 
 ///************************* テクスチャ管理クラス *************************///
 ///
@@ -25,10 +26,11 @@ private:
 	struct TextureData {
 		DirectX::TexMetadata metadata;
 		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
-		Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource;
 		uint32_t srvIndex;
 		D3D12_CPU_DESCRIPTOR_HANDLE srvHandleCPU;
 		D3D12_GPU_DESCRIPTOR_HANDLE srvHandleGPU;
+		bool isReady = true;	// 非同期読み込み中は false（プレースホルダーを表示）
+		AssetId assetId;		// AssetRegistry での識別子
 	};
 
 public:
@@ -45,8 +47,20 @@ public:
 	void Finalize();
 
 	// テクスチャ読み込み
+	// パスや SRV 番号で直接使う前提なので、読み込んだテクスチャは解放しない
 	void LoadTexture(const std::string& filePath);
 
+	// テクスチャの非同期読み込み
+	// SRV はすぐに確保してプレースホルダーを指し、読み込みが終わったら同じ番号で差し替える
+	void LoadTextureAsync(const std::string& filePath);
+
+	// 読み込んで参照を取る（ハンドルが全部無くなると AssetRegistry::UnloadUnused で解放される）
+	AssetHandle AcquireTexture(const std::string& filePath);
+	AssetHandle AcquireTextureAsync(const std::string& filePath);
+
+	// 読み込みが終わっているか
+	bool IsTextureReady(const std::string& filePath) const;
+
 public:
 	///************************* アクセッサ *************************///
 
@@ -70,8 +84,28 @@ public:
 	// テクスチャリソース生成
 	Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureResource(const DirectX::TexMetadata& metadata);
 
-	// テクスチャデータ転送
-	Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const DirectX::ScratchImage& mipImages);
+	// テクスチャデータ転送（中間リソースは転送が終わったら解放されるよう DeferredReleaseQueue に預ける）
+	void UploadTextureData(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const DirectX::ScratchImage& mipImages);
+
+private:
+	// 読み込み（済みなら何もしない）と登録。失敗したら nullptr
+	TextureData* LoadTextureData(const std::string& filePath);
+	TextureData* LoadTextureDataAsync(const std::string& filePath);
+
+	// AssetRegistry からの解放（読み込み中なら false）
+	bool UnloadTexture(const std::string& filePath);
+
+	// GPU 上の使用量
+	uint64_t GetResourceSize(ID3D12Resource* resource) const;
+
+	// ファイルの読み込みとミップマップの生成（GPU を使わないのでワーカースレッドからも呼べる）
+	HRESULT DecodeTexture(const std::string& filePath, DirectX::ScratchImage& mipImages);
+
+	// リソース生成・転送・SRV生成（メインスレッド）
+	void CreateTextureFromImage(TextureData& textureData, const DirectX::ScratchImage& mipImages);
+
+	// プレースホルダーの生成
+	void CreatePlaceholder();
 
 private:
 	///************************* メンバ変数 *************************///
@@ -83,6 +117,7 @@ private:
 	TextureManager& operator=(TextureManager&) = delete;
 
 	std::unordered_map<std::string, TextureData> textureDatas;
+	TextureData placeholder_{};
 	YoRigine::DirectXCommon* dxCommon_ = nullptr;
 	SrvManager* srvManager_ = nullptr;
 
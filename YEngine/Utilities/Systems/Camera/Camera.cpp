@@ -20,9 +20,10 @@ Camera::Camera()
 	, nearClip_(0.1f)
 	, farClip_(100.0f)
 	, worldMatrix_(MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate))
-	, viewMatrix_(Inverse(worldMatrix_))
+	, viewMatrix_(InverseAffine(worldMatrix_))
 	, projectionMatrix_(MakePerspectiveFovMatrix(fovY_, aspectRatio_, nearClip_, farClip_))
 	, viewProjectionMatrix_(Multiply(viewMatrix_, projectionMatrix_))
+	, frustum_(MakeFrustum(viewProjectionMatrix_))
 {
 }
 
@@ -38,11 +39,13 @@ void Camera::UpdateMatrix()
 	// transformからアフィン変換行列を計算
 	worldMatrix_ = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate + shakeOffset_);
 	// worldMatrixの逆行列
-	viewMatrix_ = Inverse(worldMatrix_);
+	viewMatrix_ = InverseAffine(worldMatrix_);
 	// プロジェクション行列の更新
 	projectionMatrix_ = MakePerspectiveFovMatrix(fovY_, aspectRatio_, nearClip_, farClip_);
 	// 合成行列
 	viewProjectionMatrix_ = Multiply(viewMatrix_, projectionMatrix_);
+	// 視錐台
+	frustum_ = MakeFrustum(viewProjectionMatrix_);
 }
 
 
@@ -54,9 +57,9 @@ void Camera::DefaultCamera()
 
 	// ワールド行列、ビュー行列の更新
 	worldMatrix_ = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate);
-	viewMatrix_ = Inverse(worldMatrix_);
+	viewMatrix_ = InverseAffine(worldMatrix_);
 	viewProjectionMatrix_ = Multiply(viewMatrix_, projectionMatrix_);
-
+	frustum_ = MakeFrustum(viewProjectionMatrix_);
 }
 
 void Camera::Shake(float time, const Vector2 min, const Vector2 max)
@@ -4,6 +4,7 @@
 #include "Vector3.h"
 #include "MathFunc.h"
 #include "Matrix4x4.h"
+#include "Frustum.h"
 
 ///************************* カメラクラス *************************///
 ///
@@ -59,6 +60,8 @@ public:
 	const Matrix4x4& GetViewMatrix() const { return viewMatrix_; }
 	const Matrix4x4& GetProjectionMatrix() const { return projectionMatrix_; }
 	const Matrix4x4& GetViewProjectionMatrix() const { return viewProjectionMatrix_; }
+	const Frustum& GetFrustum() const { return frustum_; }
+	Vector3 GetWorldPosition() const { return { worldMatrix_.m[3][0], worldMatrix_.m[3][1], worldMatrix_.m[3][2] }; }
 	Vector3 GetRotate() const { return transform_.rotate; }
 	Vector3 GetTranslate() const { return transform_.translate; }
 	Vector3 GetScale() const { return transform_.scale; }
@@ -71,6 +74,7 @@ public:
 	Matrix4x4 viewMatrix_;
 	Matrix4x4 projectionMatrix_;
 	Matrix4x4 viewProjectionMatrix_;
+	Frustum frustum_;		// viewProjectionMatrix_ から作った視錐台（カリング用）
 
 	float fovY_;
 	float aspectRatio_;
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <thread>
 #include "Sprite/SpriteCommon.h"
+#include "Loaders/Json/JsonWriter.h"
 
 #ifdef USE_IMGUI
 #include <imgui.h>
@@ -111,6 +112,11 @@ void UIBase::PlayColorAnimation(const Vector4& from, const Vector4& to, float du
 	SetColor(from);
 }
 
+void UIBase::SetAnimationEasing(Easing::Function easing) {
+	currentAnimation_.easing = easing;
+	currentAnimation_.easeFunc = Easing::GetFunction(easing);
+}
+
 void UIBase::StopAnimation() {
 	currentAnimation_.type = UIAnimation::Type::None;
 	currentAnimation_.elapsed = 0.0f;
@@ -132,6 +138,8 @@ void UIBase::UpdateAnimation(float deltaTime) {
 		}
 	}
 
+	t = currentAnimation_.easeFunc(t);
+
 	switch (currentAnimation_.type) {
 	case UIAnimation::Type::Position: {
 		Vector3 pos;
@@ -261,6 +269,19 @@ void UIBase::ImGuiGridSettings() {
 void UIBase::ImGuiAnimationSettings() {
 #ifdef USE_IMGUI
 	if (ImGui::CollapsingHeader("アニメーション")) {
+		// イージング（再生中のアニメーションにもすぐ反映される）
+		const std::string currentEasing(Easing::functionToString(currentAnimation_.easing));
+		if (ImGui::BeginCombo("イージング", currentEasing.c_str())) {
+			for (size_t i = 0; i < Easing::kFunctionCount; ++i) {
+				const Easing::Function function = static_cast<Easing::Function>(i);
+				const std::string name(Easing::functionToString(function));
+				if (ImGui::Selectable(name.c_str(), function == currentAnimation_.easing)) {
+					SetAnimationEasing(function);
+				}
+			}
+			ImGui::EndCombo();
+		}
+
 		if (IsAnimating()) {
 			ImGui::Text("アニメーション再生中...");
 			ImGui::ProgressBar(currentAnimation_.elapsed / currentAnimation_.duration);
@@ -678,6 +699,9 @@ void UIBase::CheckForChanges() {
 }
 
 bool UIBase::LoadFromJSON(const std::string& jsonPath) {
+	// 書き込み待ちの保存があれば、先に書き出してから読む
+	YoRigine::JsonWriter::GetInstance()->Flush();
+
 	try {
 		std::ifstream file(jsonPath);
 		if (!file.is_open()) {
@@ -706,21 +730,14 @@ bool UIBase::SaveToJSON(const std::string& jsonPath) {
 	}
 
 	try {
-		std::filesystem::path dirPath = std::filesystem::path(savePath).parent_path();
-
-		if (!dirPath.empty() && !std::filesystem::exists(dirPath)) {
-			std::filesystem::create_directories(dirPath);
-		}
-
 		nlohmann::json data = CreateJSONFromCurrentState();
 
-		std::ofstream file(savePath);
-		if (!file.is_open()) {
-			return false;
-		}
-
-		file << std::setw(4) << data << std::endl;
-		file.close();
+		// 書き込みは JsonWriter のスレッドで行う（フォルダも向こうで作る）
+		YoRigine::JsonWriter::GetInstance()->Save(savePath, std::move(data), 4, [savePath](bool succeeded) {
+			if (!succeeded) {
+				printf("JSONへのUI保存に失敗: %s\n", savePath.c_str());
+			}
+			});
 
 		return true;
 	}
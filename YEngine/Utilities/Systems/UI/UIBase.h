@@ -10,6 +10,7 @@
 #include "Vector2.h"
 #include "Vector3.h"
 #include "Vector4.h"
+#include "Easing.h"
 #include "json.hpp" 
 
 // 前方宣言
@@ -30,6 +31,8 @@ struct UIAnimation {
 	float duration = 1.0f;      // アニメーション時間
 	float elapsed = 0.0f;       // 経過時間
 	bool loop = false;          // ループするか
+	Easing::Function easing = Easing::Function::Linear;  // イージングの種類
+	Easing::EaseFunc easeFunc = &Easing::linear;          // 解決済みのイージング関数（毎フレーム引き直さない）
 
 	// 開始・終了値
 	Vector3 startPos, endPos;
@@ -76,7 +79,7 @@ private:
 public:
 	///************************* 基本アクセッサ *************************///
 
-	// 現在の設定をJSONに保存
+	// 現在の設定をJSONに保存（書き込みは非同期。保存を受け付けたら true）
 	bool SaveToJSON(const std::string& jsonPath = "");
 
 	// 位置を設定
@@ -222,6 +225,9 @@ public:
 	// カラーアニメーションを再生
 	void PlayColorAnimation(const Vector4& from, const Vector4& to, float duration, bool loop = false);
 
+	// アニメーションのイージングを設定（以降の再生にも適用される）
+	void SetAnimationEasing(Easing::Function easing);
+
 	// アニメーションを停止
 	void StopAnimation();
 
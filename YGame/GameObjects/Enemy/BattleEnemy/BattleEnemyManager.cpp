@@ -8,6 +8,7 @@
 // Engine
 #include "Systems/GameTime/GameTime.h"
 #include <Loaders/Json/JsonManager.h>
+#include <Loaders/Json/JsonWriter.h>
 #include <Debugger/Logger.h>
 
 // Math
@@ -729,29 +730,24 @@ bool BattleEnemyManager::SaveEnemyData(const std::string& filePath) const {
 
 	j["battleEnemies"] = enemyArray;
 
-	// ファイルに書き出し
-	std::ofstream ofs(filePath);
-	if (!ofs.is_open()) {
-		ThrowError(("敵データ保存用のファイルを開けませんでした: " + filePath + "\n").c_str());
-		return false;
-	}
-
-	try {
-		// インデント4で整形して保存
-		ofs << std::setw(4) << j;
-		ofs.close();
-		Logger((std::to_string(enemyDataMap_.size()) + "件の敵データを正常に保存しました。\n").c_str());
-		return true;
-	}
-	catch (const std::exception& e) {
-		Logger(("敵データの保存中にエラーが発生しました: " + std::string(e.what()) + "\n").c_str());
-		return false;
-	}
+	// ファイルに書き出し（インデント4で整形。書き込みは JsonWriter のスレッドで行う）
+	const size_t enemyCount = enemyDataMap_.size();
+	YoRigine::JsonWriter::GetInstance()->Save(filePath, std::move(j), 4, [filePath, enemyCount](bool succeeded) {
+		if (succeeded) {
+			Logger((std::to_string(enemyCount) + "件の敵データを正常に保存しました。\n").c_str());
+		} else {
+			Logger(("敵データの保存中にエラーが発生しました: " + filePath + "\n").c_str());
+		}
+		});
+	return true;
 }
 /// <summary>
 /// 全ての敵のベースデータをJSONファイルから読み込み、キャッシュする
 /// </summary>
 bool BattleEnemyManager::LoadEnemyData(const std::string& filePath) {
+	// 書き込み待ちの保存があれば、先に書き出してから読む
+	YoRigine::JsonWriter::GetInstance()->Flush();
+
 	std::ifstream ifs(filePath);
 	if (!ifs.is_open()) {
 		ThrowError(("敵データファイルを開けませんでした: " + filePath + "\n").c_str());
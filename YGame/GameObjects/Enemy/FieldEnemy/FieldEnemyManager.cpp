@@ -3,6 +3,7 @@
 #include "MathFunc.h"
 #include "Systems/GameTime/GameTime.h"
 #include <Loaders/Json/JsonManager.h>
+#include <Loaders/Json/JsonWriter.h>
 #include <Debugger/Logger.h>
 #include <fstream>
 #include <filesystem>
@@ -501,13 +502,14 @@ void FieldEnemyManager::SaveEnemyData(const std::string& filePath) {
 			json["fieldEnemies"].push_back(enemyJson);
 		}
 
-		// ファイルに保存
-		std::filesystem::create_directories(std::filesystem::path(filePath).parent_path());
-		std::ofstream file(filePath);
-		file << json.dump(4);
-		file.close();
-
-		Logger("[EnemyEditor] 敵データをファイルに保存: " + filePath + "\n");
+		// ファイルに保存（書き込みは JsonWriter のスレッドで行う）
+		YoRigine::JsonWriter::GetInstance()->Save(filePath, std::move(json), 4, [filePath](bool succeeded) {
+			if (succeeded) {
+				Logger("[EnemyEditor] 敵データをファイルに保存: " + filePath + "\n");
+			} else {
+				Logger("[EnemyEditor] エラー: 敵データ保存失敗: " + filePath + "\n");
+			}
+			});
 	}
 	catch (const std::exception& e) {
 		Logger("[EnemyEditor] エラー: 敵データ保存失敗: " + std::string(e.what()) + "\n");
@@ -520,6 +522,9 @@ void FieldEnemyManager::SaveEnemyData(const std::string& filePath) {
 /// </summary>
 /// <param name="filePath">ファイルパス</param>
 void FieldEnemyManager::LoadEnemyData(const std::string& filePath) {
+	// 書き込み待ちの保存があれば、先に書き出してから読む
+	YoRigine::JsonWriter::GetInstance()->Flush();
+
 	try {
 		std::filesystem::path path(filePath);
 		// ファイルが無かったら終了
@@ -635,15 +640,13 @@ void FieldEnemyManager::SaveEnemySpawnData(const std::string& filePath) {
 			json["spawnPoints"].push_back(spawnJson);
 		}
 
-		std::filesystem::path path(filePath);
-		std::filesystem::create_directories(path.parent_path());
-
-		std::ofstream file(filePath);
-		if (file.is_open()) {
-			file << json.dump(4);
-			file.close();
-			Logger("[FieldEnemyManager] スポーンデータ保存完了: " + filePath + "\n");
-		}
+		YoRigine::JsonWriter::GetInstance()->Save(filePath, std::move(json), 4, [filePath](bool succeeded) {
+			if (succeeded) {
+				Logger("[FieldEnemyManager] スポーンデータ保存完了: " + filePath + "\n");
+			} else {
+				Logger("[FieldEnemyManager] エラー: スポーンデータ保存失敗: " + filePath + "\n");
+			}
+			});
 	}
 	catch (const std::exception& e) {
 		Logger("[FieldEnemyManager] エラー: スポーンデータ保存失敗: " + std::string(e.what()) + "\n");
@@ -655,6 +658,9 @@ void FieldEnemyManager::SaveEnemySpawnData(const std::string& filePath) {
 /// </summary>
 /// <param name="filePath">読み込みパス</param>
 void FieldEnemyManager::LoadEnemySpawnData(const std::string& filePath) {
+	// 書き込み待ちの保存があれば、先に書き出してから読む
+	YoRigine::JsonWriter::GetInstance()->Flush();
+
 	try {
 		std::filesystem::path path(filePath);
 		std::ifstream file(filePath);
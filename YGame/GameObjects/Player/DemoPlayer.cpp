@@ -165,6 +165,7 @@ void DemoPlayer::InitJson() {
 	jsonManager_ = std::make_unique<YoRigine::JsonManager>("DemoPlayer", "Resources/Json/Objects/DemoPlayer");
 	jsonManager_->SetCategory("Objects");
 	jsonManager_->SetSubCategory("DemoPlayer");
+	jsonManager_->BeginRegister();
 
 	//------------------------------------------------------------
 	// メイン情報
@@ -207,6 +208,7 @@ void DemoPlayer::InitJson() {
 	jsonManager_->Register("アイドル状態速度", &motionSpeed[0]);
 	jsonManager_->Register("アタック状態速度", &motionSpeed[1]);
 	jsonManager_->Register("ガード状態速度", &motionSpeed[2]);
+	jsonManager_->EndRegister();
 
 	//------------------------------------------------------------
 	// コライダー設定
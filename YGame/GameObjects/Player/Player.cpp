@@ -185,6 +185,7 @@ void Player::Update() {
 	// ステート更新
 	movement_->Update(YoRigine::GameTime::GetDeltaTime());
 	combat_->Update(YoRigine::GameTime::GetDeltaTime());
+	UpdateLocomotionBlend();
 
 	// オブジェクト更新
 	obj_->UpdateAnimation();
@@ -254,6 +255,45 @@ void Player::UpdateMotionTime() {
 	}
 }
 
+/// <summary>
+/// 移動用ブレンドツリーの初期化（待機 / 歩き / 走りを速度で補間）
+/// </summary>
+void Player::InitLocomotionBlend() {
+	Skeleton* skeleton = obj_->GetModel()->GetSkeleton();
+	if (!skeleton) { return; }
+
+	const MovementConfig& config = movement_->GetConfig();
+
+	locomotionTree_ = std::make_unique<MotionBlendTree>();
+	locomotionTree_->Initialize(*skeleton);
+	locomotionLayer_ = locomotionTree_->AddLayer("Locomotion", MotionBlendTree::LayerMode::Override);
+	locomotionTree_->SetBlendSpace(locomotionLayer_, MotionBlendTree::BlendSpaceType::Linear1D);
+	locomotionTree_->AddClip(locomotionLayer_, obj_->LoadMotion("Player.gltf", "Idle4"), { 0.0f, 0.0f });
+	locomotionTree_->AddClip(locomotionLayer_, obj_->LoadMotion("Player.gltf", "Walk1"), { config.walkSpeed, 0.0f });
+	locomotionTree_->AddClip(locomotionLayer_, obj_->LoadMotion("Player.gltf", "Run1"), { config.runSpeed, 0.0f });
+}
+
+/// <summary>
+/// 移動用ブレンドツリーの更新（戦闘行動中は通常のモーション再生に戻す）
+/// </summary>
+void Player::UpdateLocomotionBlend() {
+	MotionSystem* motionSystem = obj_->GetModel()->GetMotionSystem();
+	if (!motionSystem) { return; }
+
+	if (!useLocomotionBlend_ || !combat_->IsIdle()) {
+		motionSystem->SetBlendTree(nullptr);
+		return;
+	}
+
+	if (!locomotionTree_) {
+		InitLocomotionBlend();
+		if (!locomotionTree_) { return; }
+	}
+
+	locomotionTree_->SetParameter(locomotionLayer_, movement_->GetSpeed());
+	motionSystem->SetBlendTree(locomotionTree_.get());
+}
+
 /// <summary>
 /// ワールド座標を取得
 /// </summary>
@@ -283,6 +323,9 @@ void Player::InitJson() {
 	jsonManager_->SetCategory("Objects");
 	jsonManager_->SetSubCategory("Player");
 
+	// 下層システムの分もまとめて登録し、最後に一度だけ値を反映する
+	jsonManager_->BeginRegister();
+
 	//------------------------------------------------------------
 	// メイン情報
 	//------------------------------------------------------------
@@ -320,6 +363,7 @@ void Player::InitJson() {
 	//------------------------------------------------------------
 	jsonManager_->SetTreePrefix("その他");
 	jsonManager_->Register("モーションの再生速度係数", &motionSpeed_);
+	jsonManager_->Register("移動モーションをブレンド", &useLocomotionBlend_);
 
 	jsonManager_->SetTreePrefix("モーション速度");
 	jsonManager_->Register("アイドル状態速度", &motionSpeed[0]);
@@ -333,6 +377,7 @@ void Player::InitJson() {
 	movement_->InitJson(jsonManager_.get());
 	combat_->GetCombo()->InitJson(jsonManager_.get());
 	combat_->GetGuard()->InitJson(jsonManager_.get());
+	jsonManager_->EndRegister();
 
 	jsonCollider_ = std::make_unique<YoRigine::JsonManager>("PlayerCollider", "Resources/Json/Colliders");
 	obbCollider_->InitJson(jsonCollider_.get());
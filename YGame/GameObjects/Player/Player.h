@@ -106,6 +106,10 @@ private:
 	// モーションの再生時間を更新する関数
 	void UpdateMotionTime();
 
+	// 移動速度で歩き/走りを混ぜるブレンドツリー
+	void InitLocomotionBlend();
+	void UpdateLocomotionBlend();
+
 private:
 	///************************* メンバ変数 *************************///
 
@@ -123,6 +127,11 @@ private:
 
 	Vector3 anchorPoint_ = { 0.0f, -1.0f, 0.0f };
 
+	// 移動モーションのブレンドツリー
+	std::unique_ptr<MotionBlendTree> locomotionTree_;
+	uint32_t locomotionLayer_ = MotionBlendTree::kInvalidIndex;
+	bool useLocomotionBlend_ = false;
+
 	// モーションの再生時間係数
 	float motionSpeed_ = 1.0f;
 	float preMotionSpeed_ = 1.0f;
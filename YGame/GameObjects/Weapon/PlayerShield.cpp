@@ -221,6 +221,7 @@ void PlayerShield::InitJson() {
 	jsonManager_ = std::make_unique<YoRigine::JsonManager>("PlayerShield", "Resources/Json/Weapon");
 	jsonManager_->SetCategory("Objects");
 	jsonManager_->SetSubCategory("PlayerShield");
+	jsonManager_->BeginRegister();
 	jsonManager_->Register("Translation", &wt_.translate_);
 	jsonManager_->Register("Rotate", &wt_.rotate_);
 	jsonManager_->Register("Scale", &wt_.scale_);
@@ -234,6 +235,7 @@ void PlayerShield::InitJson() {
 	jsonManager_->Register("Offset Position", &offsetPos_);
 	jsonManager_->Register("Offset Rotation", &offsetRot_);
 	jsonManager_->Register("Offset Scale", &offsetScale_);
+	jsonManager_->EndRegister();
 
 	//------------------------------------------------------------
 	// コライダー設定
@@ -261,6 +261,7 @@ void PlayerSword::InitJson() {
 	jsonManager_ = std::make_unique<YoRigine::JsonManager>("PlayerSword", "Resources/Json/Weapon");
 	jsonManager_->SetCategory("Objects");
 	jsonManager_->SetSubCategory("PlayerSword");
+	jsonManager_->BeginRegister();
 	jsonManager_->Register("Translation", &wt_.translate_);
 	jsonManager_->Register("Rotate", &wt_.rotate_);
 	jsonManager_->Register("Scale", &wt_.scale_);
@@ -281,6 +282,7 @@ void PlayerSword::InitJson() {
 	//------------------------------------------------------------
 	jsonManager_->SetTreePrefix("Color");
 	jsonManager_->Register("", &obj_->GetColor());
+	jsonManager_->EndRegister();
 
 	//------------------------------------------------------------
 	// コライダー情報
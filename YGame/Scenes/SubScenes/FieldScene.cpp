@@ -31,7 +31,7 @@ void FieldScene::Initialize(Camera* camera, Player* player) {
 	ground_->Initialize(sceneCamera_);
 
 	testjson_ = std::make_unique<LevelDataLoader>();
-	testjson_->Initialize();
+	testjson_->Initialize(sceneCamera_);
 
 	emitter_ = std::make_unique<ParticleEmitter>("TestParticle", Vector3{ 0.0f, 0.0f, 0.0f }, 5);
 
@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <Windows.h>
 #include "Loaders/Json/JsonConverters.h"
+#include "Loaders/Json/JsonWriter.h"
 
 /// <summary>
 /// バトル遷移データを保存
@@ -280,30 +281,23 @@ CameraMode SceneSyncData::JsonToCameraMode(const nlohmann::json& j) {
 }
 
 /// <summary>
-/// JSONデータをファイルに保存
+/// JSONデータをファイルに保存（書き込みは JsonWriter のスレッドで行う）
 /// </summary>
 void SceneSyncData::SaveJsonToFile(const nlohmann::json& j, const std::string& filePath) const {
-	try {
-		std::filesystem::path path(filePath);
-		std::filesystem::create_directories(path.parent_path());
-
-		std::ofstream file(filePath);
-		if (file.is_open()) {
-			file << j.dump(4);
-			file.close();
-		} else {
+	YoRigine::JsonWriter::GetInstance()->Save(filePath, j, 4, [filePath](bool succeeded) {
+		if (!succeeded) {
 			OutputDebugStringA(("[SceneSyncData] Failed to open file for writing: " + filePath + "\n").c_str());
 		}
-	}
-	catch (const std::exception& e) {
-		OutputDebugStringA(("[SceneSyncData] Save error: " + std::string(e.what()) + "\n").c_str());
-	}
+		});
 }
 
 /// <summary>
 /// JSONファイルを読み込み
 /// </summary>
 nlohmann::json SceneSyncData::LoadJsonFromFile(const std::string& filePath) const {
+	// 書き込み待ちの保存があれば、先に書き出してから読む
+	YoRigine::JsonWriter::GetInstance()->Flush();
+
 	nlohmann::json j;
 	try {
 		std::ifstream file(filePath);
@@ -322,6 +316,9 @@ nlohmann::json SceneSyncData::LoadJsonFromFile(const std::string& filePath) cons
 /// 指定ファイルとディレクトリの存在を保証（なければ作成）
 /// </summary>
 void SceneSyncData::EnsureFileExists(const std::string& filePath) const {
+	// 書き込み待ちのファイルを「無い」と判断して空で上書きしないよう、先に書き出す
+	YoRigine::JsonWriter::GetInstance()->Flush();
+
 	std::filesystem::path path(filePath);
 
 	if (!std::filesystem::exists(path.parent_path())) {
@@ -3,6 +3,7 @@
 // C++
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 // Engine
 #include <MathFunc.h>
@@ -113,6 +114,21 @@ void BattleStartCamera::BuildApproachArc(const Vector3& startWorld, const Vector
 	arcStartRadius_ = std::max(0.01f, std::sqrtf(vS.x * vS.x + vS.z * vS.z));
 	arcEndRadius_ = std::max(0.01f, std::sqrtf(vH.x * vH.x + vH.z * vH.z));
 	holdHeight_ = holdWorld.y;
+
+	//------------------------------------------------------------
+	// 角度と半径を同時に補間すると速さが一定にならないので、
+	// 円弧上の点からスプラインを作り、弧長で引けるようにしておく
+	//------------------------------------------------------------
+	constexpr int kArcSamples = 9;
+	std::vector<Vector3> arcPoints(kArcSamples);
+	for (int i = 0; i < kArcSamples; ++i) {
+		const float u = float(i) / float(kArcSamples - 1);
+		const float ang = LerpAngle(arcStartAngle_, arcEndAngle_, u);
+		const float rad = LerpF(arcStartRadius_, arcEndRadius_, u);
+		const float h = LerpF(startWorld.y, holdHeight_, u);
+		arcPoints[i] = { std::sinf(ang) * rad, h, std::cosf(ang) * rad };
+	}
+	approachPath_.Build(arcPoints);
 }
 
 /// <summary>
@@ -133,6 +149,7 @@ void BattleStartCamera::InitJson() {
 	json_ = std::make_unique<YoRigine::JsonManager>("BattleStartCamera", "Resources/Json/Cameras");
 	json_->SetCategory("Cameras");
 	json_->SetSubCategory("BattleStart");
+	json_->BeginRegister();
 
 	//------------------------------------------------------------
 	// Timing
@@ -175,6 +192,7 @@ void BattleStartCamera::InitJson() {
 	json_->SetTreePrefix("ExitLook");
 	json_->Register("LookAtTargetOnExit", &p_.lookAtTargetOnExit);
 	json_->ClearTreePrefix();
+	json_->EndRegister();
 }
 
 /// <summary>
@@ -211,7 +229,7 @@ void BattleStartCamera::Initialize() {
 
 	BuildApproachArc(startWorld, holdWorld);
 
-	matView_ = Inverse(MakeAffineMatrix(scale_, rotate_, translate_));
+	matView_ = InverseAffine(MakeAffineMatrix(scale_, rotate_, translate_));
 }
 
 /// <summary>
@@ -240,12 +258,8 @@ void BattleStartCamera::Update() {
 		const float s = std::clamp(t_ / std::max(0.001f, p_.approachTime), 0.0f, 1.0f);
 		const float u = Easing::EaseInOutCubic(s);
 
-		const float ang = LerpAngle(arcStartAngle_, arcEndAngle_, u);
-		const float rad = LerpF(arcStartRadius_, arcEndRadius_, u);
-		const float h = LerpF(startPos_.y, holdHeight_, u);
-
-		Vector3 posLocalXZ = { std::sinf(ang) * rad, h, std::cosf(ang) * rad };
-		translate_ = targetPos + posLocalXZ;
+		// 円弧はターゲット基準なので、ターゲットが動いても追従する
+		translate_ = targetPos + approachPath_.EvaluateAtDistance(u * approachPath_.GetLength());
 
 		LookAtTarget();
 
@@ -302,5 +316,5 @@ void BattleStartCamera::Update() {
 	//------------------------------------------------------------
 	// ビュー行列更新
 	//------------------------------------------------------------
-	matView_ = Inverse(MakeAffineMatrix(scale_, rotate_, translate_));
+	matView_ = InverseAffine(MakeAffineMatrix(scale_, rotate_, translate_));
 }
@@ -2,6 +2,7 @@
 
 #include <Vector3.h>
 #include <Matrix4x4.h>
+#include <Spline.h>
 #include <WorldTransform/WorldTransform.h>
 #include <Loaders/Json/JsonManager.h>
 #include <memory>
@@ -105,6 +106,9 @@ private:
 	float arcEndRadius_ = 0.0f;
 	float holdHeight_ = 0.0f;
 
+	// 円弧をターゲット基準でサンプリングしたスプライン（距離で引いて等速にする）
+	Spline approachPath_;
+
 	// 距離（fit）
 	float fitDist_ = 6.0f;
 };
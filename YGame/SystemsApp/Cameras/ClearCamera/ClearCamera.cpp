@@ -44,12 +44,12 @@ void ClearCamera::Update()
 		rotate_.y = atan2f(forward.x, forward.z);
 		rotate_.x = asinf(forward.y);
 
-		matView_ = Inverse(MakeAffineMatrix(scale_, rotate_, translate_));
+		matView_ = InverseAffine(MakeAffineMatrix(scale_, rotate_, translate_));
 	} else {
 
 #ifdef USE_IMGUI
 		UpdateInput();
-		matView_ = Inverse(MakeAffineMatrix(scale_, rotate_, translate_));
+		matView_ = InverseAffine(MakeAffineMatrix(scale_, rotate_, translate_));
 #endif
 	}
 }
@@ -32,7 +32,7 @@ void DebugCamera::Update()
 	UpdateInput();
 
 	// ビュー行列を更新
-	matView_ = Inverse(MakeAffineMatrix(scale_, rotate_, translate_));
+	matView_ = InverseAffine(MakeAffineMatrix(scale_, rotate_, translate_));
 
 #ifdef USE_IMGUI
 	// ImGui描画（必要に応じて）
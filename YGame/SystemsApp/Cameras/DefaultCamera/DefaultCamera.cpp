@@ -48,14 +48,14 @@ void DefaultCamera::Update()
 		rotate_.y = atan2f(forward.x, forward.z);
 		rotate_.x = asinf(forward.y);
 
-		matView_ = Inverse(MakeAffineMatrix(scale_, rotate_, translate_));
+		matView_ = InverseAffine(MakeAffineMatrix(scale_, rotate_, translate_));
 	} else {
 #ifdef USE_IMGUI
 		//------------------------------------------------------------
 		// 通常（自由移動）モード
 		//------------------------------------------------------------
 		UpdateInput();
-		matView_ = Inverse(MakeAffineMatrix(scale_, rotate_, translate_));
+		matView_ = InverseAffine(MakeAffineMatrix(scale_, rotate_, translate_));
 #endif
 	}
 }
@@ -84,7 +84,7 @@ void FollowCamera::FollowProsess()
 	//------------------------------------------------------------
 	// ビュー行列更新
 	//------------------------------------------------------------
-	matView_ = Inverse(MakeAffineMatrix(scale_, rotate_, translate_));
+	matView_ = InverseAffine(MakeAffineMatrix(scale_, rotate_, translate_));
 }
 
 /// <summary>
@@ -35,6 +35,9 @@ void SplineCamera::InitJson()
 /// </summary>
 void SplineCamera::Update()
 {
+	// JSON / ImGui で制御点が編集されたときだけ作り直す
+	spline_.Rebuild(controlPoints_);
+
 	t_ += speed_;
 	if (t_ > float(controlPoints_.size() - 1)) {
 		t_ = float(controlPoints_.size() - 1);
@@ -48,7 +51,7 @@ void SplineCamera::Update()
 	//------------------------------------------------------------
 	if (target_) {
 		rotate_ = GetEulerAnglesFromToDirection(translate_, target_->translate_);
-		matView_ = Inverse(MakeAffineMatrix(scale_, rotate_, translate_));
+		matView_ = InverseAffine(MakeAffineMatrix(scale_, rotate_, translate_));
 	}
 
 	//------------------------------------------------------------
@@ -77,7 +80,7 @@ void SplineCamera::FollowProsess()
 	Vector3 targetTranslate = Vector3(0.0f, target_->translate_.y, 0.0f);
 	translate_ = targetTranslate + offset;
 
-	matView_ = Inverse(MakeAffineMatrix(scale_, rotate_, translate_));
+	matView_ = InverseAffine(MakeAffineMatrix(scale_, rotate_, translate_));
 }
 
 /// <summary>
@@ -108,17 +111,16 @@ void SplineCamera::RegisterControlPoints()
 
 /// <summary>
 /// カメラ経路上の位置をスプライン補間で算出
+/// t は区間数を終点とする進行度として扱い、経路長に比例した距離で引く（制御点の間隔によらず等速）
 /// </summary>
 /// <param name="t">現在の補間パラメータ</param>
 /// <returns>補間後の座標</returns>
 Vector3 SplineCamera::EvaluateSpline(float t)
 {
-	if (controlPoints_.size() < 2) return Vector3{};
-
-	int seg = std::clamp(int(t), 0, int(controlPoints_.size() - 2));
-	float localT = t - float(seg);
+	if (spline_.GetSegmentCount() == 0) return Vector3{};
 
-	return Lerp(controlPoints_[seg], controlPoints_[seg + 1], localT);
+	const float progress = t / float(spline_.GetSegmentCount());
+	return spline_.EvaluateAtDistance(progress * spline_.GetLength());
 }
 
 /// <summary>
@@ -2,6 +2,7 @@
 #include <Vector3.h>
 #include <Matrix4x4.h>
 #include "MathFunc.h"
+#include "Spline.h"
 #include <WorldTransform/WorldTransform.h>
 #include "Loaders/Json/JsonManager.h"
 #include "Object3D/Object3d.h"
@@ -47,6 +48,7 @@ private:
 	std::vector<std::unique_ptr<Object3d>> obj_;
 	std::vector<std::unique_ptr<WorldTransform>> wt_;
 	std::vector<Vector3> controlPoints_;
+	Spline spline_; // 制御点から作った係数と弧長表（制御点が変わったときだけ作り直す）
 
 	// 追従処理関連
 	Vector3 rotation_;
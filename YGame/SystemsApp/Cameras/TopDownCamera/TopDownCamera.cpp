@@ -39,5 +39,5 @@ void TopDownCamera::TopDownProsess()
 	translate_ = target_->translate_ + offset_;
 
 	// ビュー行列を更新
-	matView_ = Inverse(MakeAffineMatrix(scale_, rotate_, translate_));
+	matView_ = InverseAffine(MakeAffineMatrix(scale_, rotate_, translate_));
 }
@@ -1,113 +1,151 @@
 #include "Easing.h"
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+	// 列挙型の並びと同じ順の関数表（switch を通らずに1回の間接呼び出しで済む）
+	constexpr std::array<Easing::EaseFunc, Easing::kFunctionCount> kFunctions = {
+		&Easing::linear,
+
+		&Easing::EaseInSine, &Easing::EaseOutSine, &Easing::EaseInOutSine,
+		&Easing::EaseInQuad, &Easing::EaseOutQuad, &Easing::EaseInOutQuad,
+		&Easing::EaseInCubic, &Easing::EaseOutCubic, &Easing::EaseInOutCubic,
+		&Easing::EaseInQuart, &Easing::EaseOutQuart, &Easing::EaseInOutQuart,
+		&Easing::EaseInQuint, &Easing::EaseOutQuint, &Easing::EaseInOutQuint,
+		&Easing::EaseInExpo, &Easing::EaseOutExpo, &Easing::EaseInOutExpo,
+		&Easing::EaseInCirc, &Easing::EaseOutCirc, &Easing::EaseInOutCirc,
+		&Easing::EaseInBack, &Easing::EaseOutBack, &Easing::EaseInOutBack,
+		&Easing::EaseInElastic, &Easing::EaseOutElastic, &Easing::EaseInOutElastic,
+		&Easing::EaseInBounce, &Easing::EaseOutBounce, &Easing::EaseInOutBounce,
+		&Easing::EaseOutGrowBounce
+	};
 
+	// 列挙型の並びと同じ順の名前（JSON などの文字列指定用）
+	constexpr std::array<std::string_view, Easing::kFunctionCount> kFunctionNames = {
+		"linear",
+
+		"EaseInSine", "EaseOutSine", "EaseInOutSine",
+		"EaseInQuad", "EaseOutQuad", "EaseInOutQuad",
+		"EaseInCubic", "EaseOutCubic", "EaseInOutCubic",
+		"EaseInQuart", "EaseOutQuart", "EaseInOutQuart",
+		"EaseInQuint", "EaseOutQuint", "EaseInOutQuint",
+		"EaseInExpo", "EaseOutExpo", "EaseInOutExpo",
+		"EaseInCirc", "EaseOutCirc", "EaseInOutCirc",
+		"EaseInBack", "EaseOutBack", "EaseInOutBack",
+		"EaseInElastic", "EaseOutElastic", "EaseInOutElastic",
+		"EaseInBounce", "EaseOutBounce", "EaseInOutBounce",
+		"EaseOutGrowBounce"
+	};
 
-float Easing::Ease(Function func, float x) {
-	switch (func) {
-	case Function::Linear: return linear(x);
-
-	case Function::EaseInSine: return EaseInSine(x);
-	case Function::EaseOutSine: return EaseOutSine(x);
-	case Function::EaseInOutSine: return EaseInOutSine(x);
-
-	case Function::EaseInQuad: return EaseInQuad(x);
-	case Function::EaseOutQuad: return EaseOutQuad(x);
-	case Function::EaseInOutQuad: return EaseInOutQuad(x);
-
-	case Function::EaseInCubic: return EaseInCubic(x);
-	case Function::EaseOutCubic: return EaseOutCubic(x);
-	case Function::EaseInOutCubic: return EaseInOutCubic(x);
-
-	case Function::EaseInQuart: return EaseInQuart(x);
-	case Function::EaseOutQuart: return EaseOutQuart(x);
-	case Function::EaseInOutQuart: return EaseInOutQuart(x);
-
-	case Function::EaseInQuint: return EaseInQuint(x);
-	case Function::EaseOutQuint: return EaseOutQuint(x);
-	case Function::EaseInOutQuint: return EaseInOutQuint(x);
-
-	case Function::EaseInExpo: return EaseInExpo(x);
-	case Function::EaseOutExpo: return EaseOutExpo(x);
-	case Function::EaseInOutExpo: return EaseInOutExpo(x);
-
-	case Function::EaseInCirc: return EaseInCirc(x);
-	case Function::EaseOutCirc: return EaseOutCirc(x);
-	case Function::EaseInOutCirc: return EaseInOutCirc(x);
-
-	case Function::EaseInBack: return EaseInBack(x);
-	case Function::EaseOutBack: return EaseOutBack(x);
-	case Function::EaseInOutBack: return EaseInOutBack(x);
-
-	case Function::EaseInElastic: return EaseInElastic(x);
-	case Function::EaseOutElastic: return EaseOutElastic(x);
-	case Function::EaseInOutElastic: return EaseInOutElastic(x);
-
-	case Function::EaseInBounce: return EaseInBounce(x);
-	case Function::EaseOutBounce: return EaseOutBounce(x);
-	case Function::EaseInOutBounce: return EaseInOutBounce(x);
-
-	case Function::EaseOutGrowBounce: return EaseOutGrowBounce(x);
+	// テンプレート版と関数表の並びが一致しているか
+	static_assert(Easing::Evaluate<Easing::Function::EaseOutCubic>(0.5f) == Easing::EaseOutCubic(0.5f));
+	static_assert(Easing::Evaluate<Easing::Function::EaseOutBounce>(0.5f) == Easing::EaseOutBounce(0.5f));
+}
 
-	default: return x; // デフォルトは線形
+float Easing::Ease(Function func, float x) {
+	return GetFunction(func)(x);
+}
+
+/// <summary>
+/// 配列をまとめて計算
+/// </summary>
+void Easing::Ease(Function func, std::span<const float> x, std::span<float> out) {
+	assert(out.size() >= x.size());
+	const EaseFunc ease = GetFunction(func);
+	const size_t count = std::min(x.size(), out.size());
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = ease(x[i]);
 	}
 }
 
-// 文字列から列挙型への変換
-Easing::Function Easing::functionFromString(const std::string& name) {
-	static const std::unordered_map<std::string, Function> functionMap = {
-		{"linear", Function::Linear},
-
-		{"EaseInSine", Function::EaseInSine},
-		{"EaseOutSine", Function::EaseOutSine},
-		{"EaseInOutSine", Function::EaseInOutSine},
-
-		{"EaseInQuad", Function::EaseInQuad},
-		{"EaseOutQuad", Function::EaseOutQuad},
-		{"EaseInOutQuad", Function::EaseInOutQuad},
-
-		{"EaseInCubic", Function::EaseInCubic},
-		{"EaseOutCubic", Function::EaseOutCubic},
-		{"EaseInOutCubic", Function::EaseInOutCubic},
-
-		{"EaseInQuart", Function::EaseInQuart},
-		{"EaseOutQuart", Function::EaseOutQuart},
-		{"EaseInOutQuart", Function::EaseInOutQuart},
-
-		{"EaseInQuint", Function::EaseInQuint},
-		{"EaseOutQuint", Function::EaseOutQuint},
-		{"EaseInOutQuint", Function::EaseInOutQuint},
-
-		{"EaseInExpo", Function::EaseInExpo},
-		{"EaseOutExpo", Function::EaseOutExpo},
-		{"EaseInOutExpo", Function::EaseInOutExpo},
-
-		{"EaseInCirc", Function::EaseInCirc},
-		{"EaseOutCirc", Function::EaseOutCirc},
-		{"EaseInOutCirc", Function::EaseInOutCirc},
-
-		{"EaseInBack", Function::EaseInBack},
-		{"EaseOutBack", Function::EaseOutBack},
-		{"EaseInOutBack", Function::EaseInOutBack},
-
-		{"EaseInElastic", Function::EaseInElastic},
-		{"EaseOutElastic", Function::EaseOutElastic},
-		{"EaseInOutElastic", Function::EaseInOutElastic},
+/// <summary>
+/// 関数ポインタを取得（範囲外は線形）
+/// </summary>
+Easing::EaseFunc Easing::GetFunction(Function func) {
+	const size_t index = static_cast<size_t>(func);
+	return index < kFunctionCount ? kFunctions[index] : &Easing::linear;
+}
 
-		{"EaseInBounce", Function::EaseInBounce},
-		{"EaseOutBounce", Function::EaseOutBounce},
-		{"EaseInOutBounce", Function::EaseInOutBounce},
+// 文字列から列挙型への変換
+Easing::Function Easing::functionFromString(std::string_view name) {
+	for (size_t i = 0; i < kFunctionCount; ++i) {
+		if (kFunctionNames[i] == name) {
+			return static_cast<Function>(i);
+		}
+	}
+	return Function::Linear;
+}
 
-		{"EaseOutGrowBounce", Function::EaseOutGrowBounce}
+// 列挙型から文字列への変換
+std::string_view Easing::functionToString(Function func) {
+	const size_t index = static_cast<size_t>(func);
+	return index < kFunctionCount ? kFunctionNames[index] : kFunctionNames[0];
+}
 
+///************************* テーブル近似 *************************///
 
-	};
+/// <summary>
+/// [0, 1] を resolution 等分した resolution + 1 点をサンプリング
+/// </summary>
+Easing::Table::Table(Function func, size_t resolution)
+	: func_(func) {
+	resolution = std::max<size_t>(resolution, 1);
+	const EaseFunc ease = Easing::GetFunction(func);
 
-	auto it = functionMap.find(name);
-	return it != functionMap.end() ? it->second : Function::Linear;
+	samples_.resize(resolution + 1);
+	for (size_t i = 0; i <= resolution; ++i) {
+		samples_[i] = ease(static_cast<float>(i) / static_cast<float>(resolution));
+	}
+	scale_ = static_cast<float>(resolution);
+}
+
+/// <summary>
+/// 共有テーブル（静的初期化はスレッドセーフ）
+/// </summary>
+const Easing::Table& Easing::GetTable(Function func) {
+	static const std::array<Table, kFunctionCount> tables = []() {
+		std::array<Table, kFunctionCount> result;
+		for (size_t i = 0; i < kFunctionCount; ++i) {
+			result[i] = Table(static_cast<Function>(i));
+		}
+		return result;
+		}();
+
+	const size_t index = static_cast<size_t>(func);
+	return tables[index < kFunctionCount ? index : 0];
+}
+
+/// <summary>
+/// 重い関数だけ表で近似
+/// </summary>
+float Easing::EaseApprox(Function func, float x) {
+	if (IsTableRecommended(func)) {
+		return GetTable(func)(x);
+	}
+	return GetFunction(func)(std::clamp(x, 0.0f, 1.0f));
+}
+
+/// <summary>
+/// 重い関数だけ表で近似（配列版）
+/// </summary>
+void Easing::EaseApprox(Function func, std::span<const float> x, std::span<float> out) {
+	assert(out.size() >= x.size());
+	const size_t count = std::min(x.size(), out.size());
+	if (IsTableRecommended(func)) {
+		const Table& table = GetTable(func);
+		for (size_t i = 0; i < count; ++i) {
+			out[i] = table(x[i]);
+		}
+	} else {
+		const EaseFunc ease = GetFunction(func);
+		for (size_t i = 0; i < count; ++i) {
+			out[i] = ease(std::clamp(x[i], 0.0f, 1.0f));
+		}
+	}
 }
 
-float Easing::linear(float x) {
-	return x;
-}
+///************************* 個別関数 *************************///
 
 float Easing::EaseInSine(float x) {
 	return 1.0f - cos((x * PI) / 2.0f);
@@ -121,54 +159,6 @@ float Easing::EaseInOutSine(float x) {
 	return -(cos(PI * x) - 1.0f) / 2.0f;
 }
 
-float Easing::EaseInQuad(float x) {
-	return x * x;
-}
-
-float Easing::EaseOutQuad(float x) {
-	return 1.0f - (1.0f - x) * (1.0f - x);
-}
-
-float Easing::EaseInOutQuad(float x) {
-	return x < 0.5f ? 2.0f * x * x : 1.0f - pow(-2.0f * x + 2.0f, 2.0f) / 2.0f;
-}
-
-float Easing::EaseInCubic(float x) {
-	return x * x * x;
-}
-
-float Easing::EaseOutCubic(float x) {
-	return 1.0f - pow(1.0f - x, 3.0f);
-}
-
-float Easing::EaseInOutCubic(float x) {
-	return x < 0.5f ? 4.0f * x * x * x : 1.0f - pow(-2.0f * x + 2.0f, 3.0f) / 2.0f;
-}
-
-float Easing::EaseInQuart(float x) {
-	return x * x * x * x;
-}
-
-float Easing::EaseOutQuart(float x) {
-	return 1.0f - pow(1.0f - x, 4.0f);
-}
-
-float Easing::EaseInOutQuart(float x) {
-	return x < 0.5f ? 8.0f * x * x * x * x : 1.0f - pow(-2.0f * x + 2.0f, 4.0f) / 2.0f;
-}
-
-float Easing::EaseInQuint(float x) {
-	return x * x * x * x * x;
-}
-
-float Easing::EaseOutQuint(float x) {
-	return 1.0f - pow(1.0f - x, 5.0f);
-}
-
-float Easing::EaseInOutQuint(float x) {
-	return x < 0.5f ? 16.0f * x * x * x * x * x : 1.0f - pow(-2.0f * x + 2.0f, 5.0f) / 2.0f;
-}
-
 float Easing::EaseInExpo(float x) {
 	return x == 0.0f ? 0.0f : pow(2.0f, 10.0f * x - 10.0f);
 }
@@ -197,20 +187,6 @@ float Easing::EaseInOutCirc(float x) {
 		: (sqrt(1.0f - pow(-2.0f * x + 2.0f, 2.0f)) + 1.0f) / 2.0f;
 }
 
-float Easing::EaseInBack(float x) {
-	return c3 * x * x * x - c1 * x * x;
-}
-
-float Easing::EaseOutBack(float x) {
-	return 1.0f + c3 * pow(x - 1.0f, 3.0f) + c1 * pow(x - 1.0f, 2.0f);
-}
-
-float Easing::EaseInOutBack(float x) {
-	return x < 0.5f
-		? (pow(2.0f * x, 2.0f) * ((c2 + 1.0f) * 2.0f * x - c2)) / 2.0f
-		: (pow(2.0f * x - 2.0f, 2.0f) * ((c2 + 1.0f) * (x * 2.0f - 2.0f) + c2) + 2.0f) / 2.0f;
-}
-
 float Easing::EaseInElastic(float x) {
 	if (x == 0.0f) return 0.0f;
 	if (x == 1.0f) return 1.0f;
@@ -231,34 +207,6 @@ float Easing::EaseInOutElastic(float x) {
 		: (pow(2.0f, -20.0f * x + 10.0f) * sin((20.0f * x - 11.125f) * c5)) / 2.0f + 1.0f;
 }
 
-float Easing::EaseInBounce(float x) {
-	return 1.0f - EaseOutBounce(1.0f - x);
-}
-
-float Easing::EaseOutBounce(float x) {
-	const float n1 = 7.5625f;
-	const float d1 = 2.75f;
-
-	if (x < 1.0f / d1) {
-		return n1 * x * x;
-	} else if (x < 2.0f / d1) {
-		x -= 1.5f / d1;
-		return n1 * x * x + 0.75f;
-	} else if (x < 2.5f / d1) {
-		x -= 2.25f / d1;
-		return n1 * x * x + 0.9375f;
-	} else {
-		x -= 2.625f / d1;
-		return n1 * x * x + 0.984375f;
-	}
-}
-
-float Easing::EaseInOutBounce(float x) {
-	return x < 0.5f
-		? (1.0f - EaseOutBounce(1.0f - 2.0f * x)) / 2.0f
-		: (1.0f + EaseOutBounce(2.0f * x - 1.0f)) / 2.0f;
-}
-
 float Easing::EaseOutGrowBounce(float t)
 {
 	// クランプして安全に（念のため）
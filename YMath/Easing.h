@@ -1,8 +1,12 @@
 #ifndef EASING_H
 #define EASING_H
 
+#include <array>
+#include <cstddef>
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 #include <numbers>
 #include <algorithm>
 
@@ -24,34 +28,124 @@ public:
 		EaseOutGrowBounce
 	};
 
+	// 関数の数
+	static constexpr size_t kFunctionCount = static_cast<size_t>(Function::EaseOutGrowBounce) + 1;
+
+	// 関数ポインタ
+	using EaseFunc = float(*)(float);
+
 	// 指定されたイージング関数で値を計算
 	static float Ease(Function func, float x);
 
-	// 文字列から列挙型への変換
-	static Function functionFromString(const std::string& name);
+	// 配列をまとめて計算（関数の解決は1回だけ。out は x と同じ配列でもよい）
+	static void Ease(Function func, std::span<const float> x, std::span<float> out);
+
+	// 関数ポインタを取得（毎フレーム同じ関数を使う場合は最初に解決しておく）
+	static EaseFunc GetFunction(Function func);
+
+	// 文字列から列挙型への変換（見つからなければ Linear）
+	static Function functionFromString(std::string_view name);
+
+	// 列挙型から文字列への変換
+	static std::string_view functionToString(Function func);
+
+	///************************* コンパイル時選択 *************************///
+
+	// 関数をテンプレート引数で選ぶ（分岐が消えてインライン展開される）
+	template <Function F>
+	static constexpr float Evaluate(float x);
+
+	// 配列をまとめて計算（関数はコンパイル時に決まる）
+	template <Function F>
+	static void Ease(std::span<const float> x, std::span<float> out) {
+		const size_t count = std::min(x.size(), out.size());
+		for (size_t i = 0; i < count; ++i) {
+			out[i] = Evaluate<F>(x[i]);
+		}
+	}
+
+	///************************* テーブル近似 *************************///
+
+	/// <summary>
+	/// [0, 1] を等間隔にサンプリングした表を線形補間して返す
+	/// 指数・三角関数を含む重い曲線（Elastic / Bounce / Expo など）向け。入力は [0, 1] にクランプする
+	/// </summary>
+	class Table {
+	public:
+		static constexpr size_t kDefaultResolution = 256;
+
+		Table() = default;
+		explicit Table(Function func, size_t resolution = kDefaultResolution);
+
+		float operator()(float x) const {
+			x = std::clamp(x, 0.0f, 1.0f) * scale_;
+			const size_t index = std::min(static_cast<size_t>(x), samples_.size() - 2);
+			const float t = x - static_cast<float>(index);
+			return samples_[index] + (samples_[index + 1] - samples_[index]) * t;
+		}
+
+		Function GetFunction() const { return func_; }
+		size_t GetResolution() const { return samples_.size() - 1; }
+
+	private:
+		Function func_ = Function::Linear;
+		std::vector<float> samples_ = { 0.0f, 1.0f };
+		float scale_ = 1.0f;
+	};
+
+	// 共有テーブルを取得（初回呼び出し時に全関数分を作る）
+	static const Table& GetTable(Function func);
+
+	// 表で近似する方が速い関数か
+	static constexpr bool IsTableRecommended(Function func) {
+		switch (func) {
+		case Function::EaseInExpo: case Function::EaseOutExpo: case Function::EaseInOutExpo:
+		case Function::EaseInElastic: case Function::EaseOutElastic: case Function::EaseInOutElastic:
+		case Function::EaseInBounce: case Function::EaseOutBounce: case Function::EaseInOutBounce:
+			return true;
+		default:
+			// EaseOutGrowBounce は t = 0.2 で不連続なので表にしない
+			return false;
+		}
+	}
+
+	// 重い関数だけ表で近似して計算（入力は [0, 1] にクランプする）
+	static float EaseApprox(Function func, float x);
+	static void EaseApprox(Function func, std::span<const float> x, std::span<float> out);
+
+	///************************* 個別関数 *************************///
 
 	// 個別の関数を直接利用する場合のAPI
-	static float linear(float x);
+	// 多項式のみの関数は constexpr でヘッダに置き、呼び出し側でインライン展開させる
+	static constexpr float linear(float x) { return x; }
 
 	static float EaseInSine(float x);
 	static float EaseOutSine(float x);
 	static float EaseInOutSine(float x);
 
-	static float EaseInQuad(float x);
-	static float EaseOutQuad(float x);
-	static float EaseInOutQuad(float x);
+	static constexpr float EaseInQuad(float x) { return x * x; }
+	static constexpr float EaseOutQuad(float x) { return 1.0f - (1.0f - x) * (1.0f - x); }
+	static constexpr float EaseInOutQuad(float x) {
+		return x < 0.5f ? 2.0f * x * x : 1.0f - Pow<2>(-2.0f * x + 2.0f) / 2.0f;
+	}
 
-	static float EaseInCubic(float x);
-	static float EaseOutCubic(float x);
-	static float EaseInOutCubic(float x);
+	static constexpr float EaseInCubic(float x) { return x * x * x; }
+	static constexpr float EaseOutCubic(float x) { return 1.0f - Pow<3>(1.0f - x); }
+	static constexpr float EaseInOutCubic(float x) {
+		return x < 0.5f ? 4.0f * x * x * x : 1.0f - Pow<3>(-2.0f * x + 2.0f) / 2.0f;
+	}
 
-	static float EaseInQuart(float x);
-	static float EaseOutQuart(float x);
-	static float EaseInOutQuart(float x);
+	static constexpr float EaseInQuart(float x) { return x * x * x * x; }
+	static constexpr float EaseOutQuart(float x) { return 1.0f - Pow<4>(1.0f - x); }
+	static constexpr float EaseInOutQuart(float x) {
+		return x < 0.5f ? 8.0f * x * x * x * x : 1.0f - Pow<4>(-2.0f * x + 2.0f) / 2.0f;
+	}
 
-	static float EaseInQuint(float x);
-	static float EaseOutQuint(float x);
-	static float EaseInOutQuint(float x);
+	static constexpr float EaseInQuint(float x) { return x * x * x * x * x; }
+	static constexpr float EaseOutQuint(float x) { return 1.0f - Pow<5>(1.0f - x); }
+	static constexpr float EaseInOutQuint(float x) {
+		return x < 0.5f ? 16.0f * x * x * x * x * x : 1.0f - Pow<5>(-2.0f * x + 2.0f) / 2.0f;
+	}
 
 	static float EaseInExpo(float x);
 	static float EaseOutExpo(float x);
@@ -61,23 +155,55 @@ public:
 	static float EaseOutCirc(float x);
 	static float EaseInOutCirc(float x);
 
-	static float EaseInBack(float x);
-	static float EaseOutBack(float x);
-	static float EaseInOutBack(float x);
+	static constexpr float EaseInBack(float x) { return c3 * x * x * x - c1 * x * x; }
+	static constexpr float EaseOutBack(float x) { return 1.0f + c3 * Pow<3>(x - 1.0f) + c1 * Pow<2>(x - 1.0f); }
+	static constexpr float EaseInOutBack(float x) {
+		return x < 0.5f
+			? (Pow<2>(2.0f * x) * ((c2 + 1.0f) * 2.0f * x - c2)) / 2.0f
+			: (Pow<2>(2.0f * x - 2.0f) * ((c2 + 1.0f) * (x * 2.0f - 2.0f) + c2) + 2.0f) / 2.0f;
+	}
 
 	static float EaseInElastic(float x);
 	static float EaseOutElastic(float x);
 	static float EaseInOutElastic(float x);
 
-	static float EaseInBounce(float x);
-	static float EaseOutBounce(float x);
-	static float EaseInOutBounce(float x);
+	static constexpr float EaseInBounce(float x) { return 1.0f - EaseOutBounce(1.0f - x); }
+	static constexpr float EaseOutBounce(float x) {
+		constexpr float n1 = 7.5625f;
+		constexpr float d1 = 2.75f;
+
+		if (x < 1.0f / d1) {
+			return n1 * x * x;
+		} else if (x < 2.0f / d1) {
+			x -= 1.5f / d1;
+			return n1 * x * x + 0.75f;
+		} else if (x < 2.5f / d1) {
+			x -= 2.25f / d1;
+			return n1 * x * x + 0.9375f;
+		} else {
+			x -= 2.625f / d1;
+			return n1 * x * x + 0.984375f;
+		}
+	}
+	static constexpr float EaseInOutBounce(float x) {
+		return x < 0.5f
+			? (1.0f - EaseOutBounce(1.0f - 2.0f * x)) / 2.0f
+			: (1.0f + EaseOutBounce(2.0f * x - 1.0f)) / 2.0f;
+	}
 
 
 	//  徐々に大きくなり、最後にバウンドするイージング
 	static float EaseOutGrowBounce(float t);
 
 private:
+	// 整数乗（pow を使わずに掛け算で展開）
+	template <int N>
+	static constexpr float Pow(float x) {
+		float result = 1.0f;
+		for (int i = 0; i < N; ++i) { result *= x; }
+		return result;
+	}
+
 	static constexpr float PI = std::numbers::pi_v<float>;
 	static constexpr float c1 = 1.70158f;
 	static constexpr float c2 = c1 * 1.525f;
@@ -86,4 +212,46 @@ private:
 	static constexpr float c5 = (2.0f * PI) / 4.5f;
 };
 
-#endif // EASING_H
\ No newline at end of file
+template <Easing::Function F>
+constexpr float Easing::Evaluate(float x) {
+	if constexpr (F == Function::Linear) { return linear(x); }
+	else if constexpr (F == Function::EaseInSine) { return EaseInSine(x); }
+	else if constexpr (F == Function::EaseOutSine) { return EaseOutSine(x); }
+	else if constexpr (F == Function::EaseInOutSine) { return EaseInOutSine(x); }
+	else if constexpr (F == Function::EaseInQuad) { return EaseInQuad(x); }
+	else if constexpr (F == Function::EaseOutQuad) { return EaseOutQuad(x); }
+	else if constexpr (F == Function::EaseInOutQuad) { return EaseInOutQuad(x); }
+	else if constexpr (F == Function::EaseInCubic) { return EaseInCubic(x); }
+	else if constexpr (F == Function::EaseOutCubic) { return EaseOutCubic(x); }
+	else if constexpr (F == Function::EaseInOutCubic) { return EaseInOutCubic(x); }
+	else if constexpr (F == Function::EaseInQuart) { return EaseInQuart(x); }
+	else if constexpr (F == Function::EaseOutQuart) { return EaseOutQuart(x); }
+	else if constexpr (F == Function::EaseInOutQuart) { return EaseInOutQuart(x); }
+	else if constexpr (F == Function::EaseInQuint) { return EaseInQuint(x); }
+	else if constexpr (F == Function::EaseOutQuint) { return EaseOutQuint(x); }
+	else if constexpr (F == Function::EaseInOutQuint) { return EaseInOutQuint(x); }
+	else if constexpr (F == Function::EaseInExpo) { return EaseInExpo(x); }
+	else if constexpr (F == Function::EaseOutExpo) { return EaseOutExpo(x); }
+	else if constexpr (F == Function::EaseInOutExpo) { return EaseInOutExpo(x); }
+	else if constexpr (F == Function::EaseInCirc) { return EaseInCirc(x); }
+	else if constexpr (F == Function::EaseOutCirc) { return EaseOutCirc(x); }
+	else if constexpr (F == Function::EaseInOutCirc) { return EaseInOutCirc(x); }
+	else if constexpr (F == Function::EaseInBack) { return EaseInBack(x); }
+	else if constexpr (F == Function::EaseOutBack) { return EaseOutBack(x); }
+	else if constexpr (F == Function::EaseInOutBack) { return EaseInOutBack(x); }
+	else if constexpr (F == Function::EaseInElastic) { return EaseInElastic(x); }
+	else if constexpr (F == Function::EaseOutElastic) { return EaseOutElastic(x); }
+	else if constexpr (F == Function::EaseInOutElastic) { return EaseInOutElastic(x); }
+	else if constexpr (F == Function::EaseInBounce) { return EaseInBounce(x); }
+	else if constexpr (F == Function::EaseOutBounce) { return EaseOutBounce(x); }
+	else if constexpr (F == Function::EaseInOutBounce) { return EaseInOutBounce(x); }
+	else { return EaseOutGrowBounce(x); }
+}
+
+// 関数オブジェクト版（アルゴリズムやテンプレート引数に渡す用）
+template <Easing::Function F>
+struct EaseFunctor {
+	constexpr float operator()(float x) const { return Easing::Evaluate<F>(x); }
+};
+
+#endif // EASING_H
@@ -0,0 +1,272 @@
+#include "Frustum.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// Math
+#include "MathSimd.h"
+
+namespace {
+
+	// 一括判定で1度に扱う AABB の数
+	constexpr size_t kCullBlockSize = 8;
+
+	// 平面を単位法線に揃える
+	Vector4 NormalizePlane(const Vector4& plane) {
+		const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+		return plane * ((length > 0.0f) ? 1.0f / length : 0.0f);
+	}
+
+	// 8個分の中心と半サイズ（SoA）
+	struct AABBBlock {
+		float cx[kCullBlockSize], cy[kCullBlockSize], cz[kCullBlockSize];
+		float ex[kCullBlockSize], ey[kCullBlockSize], ez[kCullBlockSize];
+	};
+
+	void LoadBlock(const AABB* aabbs, AABBBlock& block) {
+		for (size_t i = 0; i < kCullBlockSize; ++i) {
+			const AABB& box = aabbs[i];
+			block.cx[i] = (box.min.x + box.max.x) * 0.5f;
+			block.cy[i] = (box.min.y + box.max.y) * 0.5f;
+			block.cz[i] = (box.min.z + box.max.z) * 0.5f;
+			block.ex[i] = (box.max.x - box.min.x) * 0.5f;
+			block.ey[i] = (box.max.y - box.min.y) * 0.5f;
+			block.ez[i] = (box.max.z - box.min.z) * 0.5f;
+		}
+	}
+
+	/// <summary>
+	/// 8個の AABB を6平面で判定し、可視ならビットを立てたマスクを返す
+	/// 平面ごとに「中心の符号付き距離 + 法線方向の半サイズ」が負なら外側
+	/// </summary>
+	uint32_t CullBlock(const Frustum& frustum, const AABBBlock& block) {
+#if defined(YMATH_SIMD_AVX)
+		const __m256 cx = _mm256_loadu_ps(block.cx), cy = _mm256_loadu_ps(block.cy), cz = _mm256_loadu_ps(block.cz);
+		const __m256 ex = _mm256_loadu_ps(block.ex), ey = _mm256_loadu_ps(block.ey), ez = _mm256_loadu_ps(block.ez);
+		const __m256 zero = _mm256_setzero_ps();
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (const Vector4& plane : frustum.planes) {
+			const __m256 nx = _mm256_set1_ps(plane.x), ny = _mm256_set1_ps(plane.y), nz = _mm256_set1_ps(plane.z);
+			__m256 distance = _mm256_add_ps(_mm256_mul_ps(cx, nx), _mm256_set1_ps(plane.w));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(cy, ny));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(cz, nz));
+			__m256 radius = _mm256_mul_ps(ex, _mm256_set1_ps(std::fabs(plane.x)));
+			radius = _mm256_add_ps(radius, _mm256_mul_ps(ey, _mm256_set1_ps(std::fabs(plane.y))));
+			radius = _mm256_add_ps(radius, _mm256_mul_ps(ez, _mm256_set1_ps(std::fabs(plane.z))));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+		}
+		return static_cast<uint32_t>(_mm256_movemask_ps(inside));
+#elif defined(YMATH_SIMD_SSE)
+		uint32_t mask = 0;
+		for (size_t half = 0; half < kCullBlockSize; half += 4) {
+			const __m128 cx = _mm_loadu_ps(block.cx + half), cy = _mm_loadu_ps(block.cy + half), cz = _mm_loadu_ps(block.cz + half);
+			const __m128 ex = _mm_loadu_ps(block.ex + half), ey = _mm_loadu_ps(block.ey + half), ez = _mm_loadu_ps(block.ez + half);
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			for (const Vector4& plane : frustum.planes) {
+				__m128 distance = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+				distance = _mm_add_ps(distance, _mm_mul_ps(cy, _mm_set1_ps(plane.y)));
+				distance = _mm_add_ps(distance, _mm_mul_ps(cz, _mm_set1_ps(plane.z)));
+				__m128 radius = _mm_mul_ps(ex, _mm_set1_ps(std::fabs(plane.x)));
+				radius = _mm_add_ps(radius, _mm_mul_ps(ey, _mm_set1_ps(std::fabs(plane.y))));
+				radius = _mm_add_ps(radius, _mm_mul_ps(ez, _mm_set1_ps(std::fabs(plane.z))));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+			}
+			mask |= static_cast<uint32_t>(_mm_movemask_ps(inside)) << half;
+		}
+		return mask;
+#elif defined(YMATH_SIMD_NEON)
+		uint32_t mask = 0;
+		for (size_t half = 0; half < kCullBlockSize; half += 4) {
+			const float32x4_t cx = vld1q_f32(block.cx + half), cy = vld1q_f32(block.cy + half), cz = vld1q_f32(block.cz + half);
+			const float32x4_t ex = vld1q_f32(block.ex + half), ey = vld1q_f32(block.ey + half), ez = vld1q_f32(block.ez + half);
+			uint32x4_t inside = vdupq_n_u32(0xFFFFFFFFu);
+
+			for (const Vector4& plane : frustum.planes) {
+				float32x4_t distance = vmlaq_n_f32(vdupq_n_f32(plane.w), cx, plane.x);
+				distance = vmlaq_n_f32(distance, cy, plane.y);
+				distance = vmlaq_n_f32(distance, cz, plane.z);
+				float32x4_t radius = vmulq_n_f32(ex, std::fabs(plane.x));
+				radius = vmlaq_n_f32(radius, ey, std::fabs(plane.y));
+				radius = vmlaq_n_f32(radius, ez, std::fabs(plane.z));
+				inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(distance, radius), vdupq_n_f32(0.0f)));
+			}
+
+			uint32_t lanes[4];
+			vst1q_u32(lanes, inside);
+			for (uint32_t i = 0; i < 4; ++i) {
+				mask |= (lanes[i] ? 1u : 0u) << (half + i);
+			}
+		}
+		return mask;
+#else
+		uint32_t mask = 0;
+		for (size_t i = 0; i < kCullBlockSize; ++i) {
+			bool inside = true;
+			for (const Vector4& plane : frustum.planes) {
+				const float distance = block.cx[i] * plane.x + block.cy[i] * plane.y + block.cz[i] * plane.z + plane.w;
+				const float radius = block.ex[i] * std::fabs(plane.x) + block.ey[i] * std::fabs(plane.y) + block.ez[i] * std::fabs(plane.z);
+				inside = inside && (distance + radius >= 0.0f);
+			}
+			mask |= (inside ? 1u : 0u) << i;
+		}
+		return mask;
+#endif
+	}
+
+} // namespace
+
+///************************* 視錐台 *************************///
+
+/// <summary>
+/// ビュー射影行列から6平面を取り出す
+/// 行ベクトルなので clip = p * M の各成分は M の列との内積になる
+/// </summary>
+Frustum MakeFrustum(const Matrix4x4& vp)
+{
+	const auto column = [&](int j) { return Vector4(vp.m[0][j], vp.m[1][j], vp.m[2][j], vp.m[3][j]); };
+	const Vector4 c0 = column(0);
+	const Vector4 c1 = column(1);
+	const Vector4 c2 = column(2);
+	const Vector4 c3 = column(3);
+
+	Frustum frustum;
+	frustum.planes[Frustum::kLeft] = NormalizePlane(c3 + c0);
+	frustum.planes[Frustum::kRight] = NormalizePlane(c3 - c0);
+	frustum.planes[Frustum::kBottom] = NormalizePlane(c3 + c1);
+	frustum.planes[Frustum::kTop] = NormalizePlane(c3 - c1);
+	// D3D は z が [0, w] なので手前は z >= 0
+	frustum.planes[Frustum::kNear] = NormalizePlane(c2);
+	frustum.planes[Frustum::kFar] = NormalizePlane(c3 - c2);
+	return frustum;
+}
+
+/// <summary>
+/// 視錐台と AABB
+/// </summary>
+bool IsInFrustum(const Frustum& frustum, const AABB& aabb)
+{
+	const Vector3 center = (aabb.min + aabb.max) * 0.5f;
+	const Vector3 extent = (aabb.max - aabb.min) * 0.5f;
+
+	for (const Vector4& plane : frustum.planes) {
+		const float distance = center.x * plane.x + center.y * plane.y + center.z * plane.z + plane.w;
+		const float radius = extent.x * std::fabs(plane.x) + extent.y * std::fabs(plane.y) + extent.z * std::fabs(plane.z);
+		if (distance + radius < 0.0f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// 視錐台と球
+/// </summary>
+bool IsInFrustum(const Frustum& frustum, const Sphere& sphere)
+{
+	for (const Vector4& plane : frustum.planes) {
+		const float distance = sphere.center.x * plane.x + sphere.center.y * plane.y + sphere.center.z * plane.z + plane.w;
+		if (distance < -sphere.radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// 視錐台と AABB の一括判定
+/// </summary>
+size_t CullAABBs(const Frustum& frustum, std::span<const AABB> aabbs, std::span<uint8_t> visible)
+{
+	assert(visible.size() >= aabbs.size());
+	const size_t count = std::min(aabbs.size(), visible.size());
+
+	size_t visibleCount = 0;
+	size_t i = 0;
+	AABBBlock block;
+	for (; i + kCullBlockSize <= count; i += kCullBlockSize) {
+		LoadBlock(aabbs.data() + i, block);
+		const uint32_t mask = CullBlock(frustum, block);
+		for (size_t lane = 0; lane < kCullBlockSize; ++lane) {
+			const uint8_t bit = static_cast<uint8_t>((mask >> lane) & 1u);
+			visible[i + lane] = bit;
+			visibleCount += bit;
+		}
+	}
+
+	// 端数
+	for (; i < count; ++i) {
+		const bool inside = IsInFrustum(frustum, aabbs[i]);
+		visible[i] = inside ? 1 : 0;
+		visibleCount += inside ? 1 : 0;
+	}
+	return visibleCount;
+}
+
+///************************* 境界ボリューム *************************///
+
+/// <summary>
+/// AABB のアフィン変換（中心は点として、半サイズは行列の絶対値で変換する）
+/// </summary>
+AABB TransformAABB(const AABB& aabb, const Matrix4x4& m)
+{
+	const Vector3 center = (aabb.min + aabb.max) * 0.5f;
+	const Vector3 extent = (aabb.max - aabb.min) * 0.5f;
+
+	const Vector3 worldCenter = {
+		center.x * m.m[0][0] + center.y * m.m[1][0] + center.z * m.m[2][0] + m.m[3][0],
+		center.x * m.m[0][1] + center.y * m.m[1][1] + center.z * m.m[2][1] + m.m[3][1],
+		center.x * m.m[0][2] + center.y * m.m[1][2] + center.z * m.m[2][2] + m.m[3][2],
+	};
+	const Vector3 worldExtent = {
+		extent.x * std::fabs(m.m[0][0]) + extent.y * std::fabs(m.m[1][0]) + extent.z * std::fabs(m.m[2][0]),
+		extent.x * std::fabs(m.m[0][1]) + extent.y * std::fabs(m.m[1][1]) + extent.z * std::fabs(m.m[2][1]),
+		extent.x * std::fabs(m.m[0][2]) + extent.y * std::fabs(m.m[1][2]) + extent.z * std::fabs(m.m[2][2]),
+	};
+
+	return { worldCenter - worldExtent, worldCenter + worldExtent };
+}
+
+/// <summary>
+/// 球のアフィン変換
+/// </summary>
+Sphere TransformSphere(const Sphere& sphere, const Matrix4x4& m)
+{
+	const Vector3 center = {
+		sphere.center.x * m.m[0][0] + sphere.center.y * m.m[1][0] + sphere.center.z * m.m[2][0] + m.m[3][0],
+		sphere.center.x * m.m[0][1] + sphere.center.y * m.m[1][1] + sphere.center.z * m.m[2][1] + m.m[3][1],
+		sphere.center.x * m.m[0][2] + sphere.center.y * m.m[1][2] + sphere.center.z * m.m[2][2] + m.m[3][2],
+	};
+
+	// 各行の長さが軸ごとのスケール
+	float maxScaleSq = 0.0f;
+	for (int row = 0; row < 3; ++row) {
+		const float lengthSq = m.m[row][0] * m.m[row][0] + m.m[row][1] * m.m[row][1] + m.m[row][2] * m.m[row][2];
+		maxScaleSq = std::max(maxScaleSq, lengthSq);
+	}
+
+	return { center, sphere.radius * std::sqrt(maxScaleSq) };
+}
+
+/// <summary>
+/// AABB を内包する球
+/// </summary>
+Sphere MakeBoundingSphere(const AABB& aabb)
+{
+	const Vector3 center = (aabb.min + aabb.max) * 0.5f;
+	return { center, ((aabb.max - aabb.min) * 0.5f).Length() };
+}
+
+/// <summary>
+/// 2つの AABB を内包する AABB
+/// </summary>
+AABB MergeAABB(const AABB& a, const AABB& b)
+{
+	return {
+		{ std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z) },
+		{ std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z) },
+	};
+}
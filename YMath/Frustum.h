@@ -0,0 +1,48 @@
+#pragma once
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Math
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Matrix4x4.h"
+#include "MathFunc.h"
+
+///************************* 視錐台 *************************///
+// ビュー射影行列（行ベクトル・D3D の深度 [0, 1]）から取り出した6平面
+// 各平面は xyz が内向きの単位法線、w が距離で、dot(n, p) + w >= 0 なら内側
+struct Frustum {
+	enum Plane {
+		kLeft, kRight, kBottom, kTop, kNear, kFar,
+		kPlaneCount
+	};
+
+	Vector4 planes[kPlaneCount];
+};
+
+// ビュー射影行列から視錐台を作る（透視・平行投影どちらでもよい）
+Frustum MakeFrustum(const Matrix4x4& viewProjection);
+
+// 視錐台と AABB / 球の判定（境界に触れていれば可視。保守的な判定なので見えないものを残すことはある）
+bool IsInFrustum(const Frustum& frustum, const AABB& aabb);
+bool IsInFrustum(const Frustum& frustum, const Sphere& sphere);
+
+// 視錐台と AABB の一括判定（visible[i] に 1 / 0 を書く。8個ずつ SIMD でまとめて判定する）
+// 戻り値は可視の数
+size_t CullAABBs(const Frustum& frustum, std::span<const AABB> aabbs, std::span<uint8_t> visible);
+
+///************************* 境界ボリューム *************************///
+
+// ローカル AABB をアフィン行列で変換した AABB（8頂点を変換せず、中心と半サイズから求める）
+AABB TransformAABB(const AABB& aabb, const Matrix4x4& matrix);
+
+// 球をアフィン行列で変換（半径は最大の軸スケールで広げる）
+Sphere TransformSphere(const Sphere& sphere, const Matrix4x4& matrix);
+
+// AABB を内包する球
+Sphere MakeBoundingSphere(const AABB& aabb);
+
+// 2つの AABB を内包する AABB
+AABB MergeAABB(const AABB& a, const AABB& b);
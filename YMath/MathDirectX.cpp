@@ -0,0 +1,17 @@
+#include "MathDirectX.h"
+
+/// <summary>
+/// Matrix4x4 → XMMATRIX
+/// </summary>
+DirectX::XMMATRIX ConvertToXMMATRIX(const Matrix4x4& matrix)
+{
+	DirectX::XMMATRIX result;
+
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.r[i].m128_f32[j] = matrix.m[i][j];
+		}
+	}
+
+	return result;
+}
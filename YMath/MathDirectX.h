@@ -0,0 +1,13 @@
+#pragma once
+// DX
+#include <DirectXMath.h>
+
+// Math
+#include "Matrix4x4.h"
+
+///************************* DirectXMath 連携 *************************///
+// DirectXMath に依存する変換はここにまとめ、Matrix4x4.h などの基本ヘッダからは切り離す
+// （Windows 以外でも YMath 単体でビルド・ベンチマークできるようにするため）
+
+// Matrix4x4 → XMMATRIX（並びはどちらも行優先なのでそのまま写す）
+DirectX::XMMATRIX ConvertToXMMATRIX(const Matrix4x4& matrix);
@@ -38,8 +38,8 @@ struct OBB {
 	// 中心座標
 	Vector3 center = { 0.0f, 0.0f, 0.0f };
 
-	// 回転（オイラー角）
-	Vector3 rotation = { 0.0f, 0.0f, 0.0f}; // radians
+	// 回転行列（オイラー角を経由せず保持する。平行移動成分は持たない）
+	Matrix4x4 rotation = MakeIdentity4x4();
 
 	// 半サイズ（幅/高さ/奥行きの半分）
 	Vector3 size = { 1.0f, 1.0f, 1.0f };
@@ -0,0 +1,246 @@
+#pragma once
+
+///************************* SIMD バックエンド選択 *************************///
+// Matrix4x4 / Vector4 の演算カーネルで使う命令セットをコンパイル時に1つ選ぶ
+//   YMATH_SIMD_AVX    : AVX（/arch:AVX, -mavx）。FMA が使える場合は積和を1命令にする
+//   YMATH_SIMD_SSE    : SSE2（x64 の既定）
+//   YMATH_SIMD_NEON   : AArch64 の NEON
+//   YMATH_SIMD_SCALAR : 上記以外、または YMATH_FORCE_SCALAR 定義時
+// どのバックエンドでも入出力は float[4][4] / float[4] のままで、アライメントは要求しない
+
+#if defined(YMATH_FORCE_SCALAR)
+#define YMATH_SIMD_SCALAR
+#elif defined(__AVX__)
+#define YMATH_SIMD_AVX
+#define YMATH_SIMD_SSE
+#elif defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define YMATH_SIMD_SSE
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define YMATH_SIMD_NEON
+#else
+#define YMATH_SIMD_SCALAR
+#endif
+
+#if defined(YMATH_SIMD_AVX) && (defined(__FMA__) || defined(__AVX2__))
+#define YMATH_SIMD_FMA
+#endif
+
+#if defined(YMATH_SIMD_AVX)
+#include <immintrin.h>
+#elif defined(YMATH_SIMD_SSE)
+#include <emmintrin.h>
+#elif defined(YMATH_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace YMathSimd {
+
+	// 選択されたバックエンド名（デバッグ表示・ベンチマーク用）
+	inline const char* GetBackendName() {
+#if defined(YMATH_SIMD_FMA)
+		return "AVX+FMA";
+#elif defined(YMATH_SIMD_AVX)
+		return "AVX";
+#elif defined(YMATH_SIMD_SSE)
+		return "SSE2";
+#elif defined(YMATH_SIMD_NEON)
+		return "NEON";
+#else
+		return "Scalar";
+#endif
+	}
+
+	///************************* 4要素ベクトル *************************///
+	// バックエンドごとのレジスタ型の薄いラッパ。YMath の外で SIMD を書くときはこれを使い、命令セットを直接使わない
+	// （YMATH_FORCE_SCALAR や NEON でも同じコードがそのまま動く）
+
+#if defined(YMATH_SIMD_SSE)
+	using Float4 = __m128;
+
+	inline Float4 ZeroFloat4() { return _mm_setzero_ps(); }
+	inline Float4 SplatFloat4(float value) { return _mm_set1_ps(value); }
+	inline Float4 SetFloat4(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+	inline Float4 LoadFloat4(const float* source) { return _mm_loadu_ps(source); }
+	inline void StoreFloat4(float* destination, Float4 v) { _mm_storeu_ps(destination, v); }
+	inline Float4 AddFloat4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+	inline Float4 SubFloat4(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+	inline Float4 MulFloat4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+	inline Float4 DivFloat4(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+#elif defined(YMATH_SIMD_NEON)
+	using Float4 = float32x4_t;
+
+	inline Float4 ZeroFloat4() { return vdupq_n_f32(0.0f); }
+	inline Float4 SplatFloat4(float value) { return vdupq_n_f32(value); }
+	inline Float4 SetFloat4(float x, float y, float z, float w) { const float v[4] = { x, y, z, w }; return vld1q_f32(v); }
+	inline Float4 LoadFloat4(const float* source) { return vld1q_f32(source); }
+	inline void StoreFloat4(float* destination, Float4 v) { vst1q_f32(destination, v); }
+	inline Float4 AddFloat4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+	inline Float4 SubFloat4(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+	inline Float4 MulFloat4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+	inline Float4 DivFloat4(Float4 a, Float4 b) { return vdivq_f32(a, b); }
+#else
+	struct Float4 {
+		float v[4];
+	};
+
+	inline Float4 ZeroFloat4() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+	inline Float4 SplatFloat4(float value) { return { { value, value, value, value } }; }
+	inline Float4 SetFloat4(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+	inline Float4 LoadFloat4(const float* source) { return { { source[0], source[1], source[2], source[3] } }; }
+	inline void StoreFloat4(float* destination, Float4 v) { for (int i = 0; i < 4; ++i) { destination[i] = v.v[i]; } }
+	inline Float4 AddFloat4(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) { a.v[i] += b.v[i]; } return a; }
+	inline Float4 SubFloat4(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) { a.v[i] -= b.v[i]; } return a; }
+	inline Float4 MulFloat4(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) { a.v[i] *= b.v[i]; } return a; }
+	inline Float4 DivFloat4(Float4 a, Float4 b) { for (int i = 0; i < 4; ++i) { a.v[i] /= b.v[i]; } return a; }
+#endif
+
+	// acc + a * b
+	inline Float4 MultiplyAddFloat4(Float4 a, Float4 b, Float4 acc) { return AddFloat4(acc, MulFloat4(a, b)); }
+
+#if defined(YMATH_SIMD_SSE)
+	// 行ベクトル v (xyzw) × 行列の4行
+	inline __m128 TransformRow(__m128 v, __m128 r0, __m128 r1, __m128 r2, __m128 r3) {
+		__m128 result = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r1));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r3));
+		return result;
+	}
+#endif
+
+#if defined(YMATH_SIMD_AVX)
+	// 2行分（256bit）の行ベクトル × 行列（各 128bit レーンが1行）
+	inline __m256 TransformRow2(__m256 v, __m256 r0, __m256 r1, __m256 r2, __m256 r3) {
+#if defined(YMATH_SIMD_FMA)
+		__m256 result = _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+		result = _mm256_fmadd_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r1, result);
+		result = _mm256_fmadd_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r2, result);
+		result = _mm256_fmadd_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r3, result);
+#else
+		__m256 result = _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+		result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r1));
+		result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+		result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r3));
+#endif
+		return result;
+	}
+#endif
+
+	/// <summary>
+	/// 行列積 out = a * b（行ベクトル規約）
+	/// b を先に全て読み込むので out が a / b と同じでもよい
+	/// </summary>
+	inline void MultiplyMatrix(const float(&a)[4][4], const float(&b)[4][4], float(&out)[4][4]) {
+#if defined(YMATH_SIMD_AVX)
+		const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b[0]));
+		const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b[1]));
+		const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b[2]));
+		const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b[3]));
+		const __m256 a01 = _mm256_loadu_ps(a[0]);
+		const __m256 a23 = _mm256_loadu_ps(a[2]);
+		_mm256_storeu_ps(out[0], TransformRow2(a01, b0, b1, b2, b3));
+		_mm256_storeu_ps(out[2], TransformRow2(a23, b0, b1, b2, b3));
+#elif defined(YMATH_SIMD_SSE)
+		const __m128 b0 = _mm_loadu_ps(b[0]);
+		const __m128 b1 = _mm_loadu_ps(b[1]);
+		const __m128 b2 = _mm_loadu_ps(b[2]);
+		const __m128 b3 = _mm_loadu_ps(b[3]);
+		for (int i = 0; i < 4; ++i) {
+			_mm_storeu_ps(out[i], TransformRow(_mm_loadu_ps(a[i]), b0, b1, b2, b3));
+		}
+#elif defined(YMATH_SIMD_NEON)
+		const float32x4_t b0 = vld1q_f32(b[0]);
+		const float32x4_t b1 = vld1q_f32(b[1]);
+		const float32x4_t b2 = vld1q_f32(b[2]);
+		const float32x4_t b3 = vld1q_f32(b[3]);
+		for (int i = 0; i < 4; ++i) {
+			const float32x4_t row = vld1q_f32(a[i]);
+			float32x4_t result = vmulq_laneq_f32(b0, row, 0);
+			result = vfmaq_laneq_f32(result, b1, row, 1);
+			result = vfmaq_laneq_f32(result, b2, row, 2);
+			result = vfmaq_laneq_f32(result, b3, row, 3);
+			vst1q_f32(out[i], result);
+		}
+#else
+		float result[4][4];
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j] + a[i][3] * b[3][j];
+			}
+		}
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				out[i][j] = result[i][j];
+			}
+		}
+#endif
+	}
+
+	/// <summary>
+	/// 行ベクトル × 行列 out = (x, y, z, w) * m
+	/// 成分はレジスタへ直接ブロードキャストする（配列経由だとストアフォワーディングが効かず遅くなる）
+	/// </summary>
+	inline void TransformVector(float x, float y, float z, float w, const float(&m)[4][4], float(&out)[4]) {
+#if defined(YMATH_SIMD_SSE)
+		__m128 result = _mm_mul_ps(_mm_set1_ps(x), _mm_loadu_ps(m[0]));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(y), _mm_loadu_ps(m[1])));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(z), _mm_loadu_ps(m[2])));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(w), _mm_loadu_ps(m[3])));
+		_mm_storeu_ps(out, result);
+#elif defined(YMATH_SIMD_NEON)
+		float32x4_t result = vmulq_n_f32(vld1q_f32(m[0]), x);
+		result = vfmaq_n_f32(result, vld1q_f32(m[1]), y);
+		result = vfmaq_n_f32(result, vld1q_f32(m[2]), z);
+		result = vfmaq_n_f32(result, vld1q_f32(m[3]), w);
+		vst1q_f32(out, result);
+#else
+		for (int j = 0; j < 4; ++j) {
+			out[j] = x * m[0][j] + y * m[1][j] + z * m[2][j] + w * m[3][j];
+		}
+#endif
+	}
+
+	/// <summary>
+	/// 転置
+	/// </summary>
+	inline void TransposeMatrix(const float(&m)[4][4], float(&out)[4][4]) {
+#if defined(YMATH_SIMD_SSE)
+		__m128 r0 = _mm_loadu_ps(m[0]);
+		__m128 r1 = _mm_loadu_ps(m[1]);
+		__m128 r2 = _mm_loadu_ps(m[2]);
+		__m128 r3 = _mm_loadu_ps(m[3]);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(out[0], r0);
+		_mm_storeu_ps(out[1], r1);
+		_mm_storeu_ps(out[2], r2);
+		_mm_storeu_ps(out[3], r3);
+#elif defined(YMATH_SIMD_NEON)
+		const float32x4x4_t rows = vld4q_f32(&m[0][0]);
+		vst1q_f32(out[0], rows.val[0]);
+		vst1q_f32(out[1], rows.val[1]);
+		vst1q_f32(out[2], rows.val[2]);
+		vst1q_f32(out[3], rows.val[3]);
+#else
+		float result[4][4];
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result[i][j] = m[j][i];
+			}
+		}
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				out[i][j] = result[i][j];
+			}
+		}
+#endif
+	}
+
+	// 一般の 4x4 逆行列（実装は Matrix4x4.cpp）
+	void InverseMatrix(const float(&m)[4][4], float(&out)[4][4]);
+
+	// 4列目が (0, 0, 0, 1) の行列の逆行列（transposed なら逆転置行列。実装は Matrix4x4.cpp）
+	void InverseAffineMatrix(const float(&m)[4][4], float(&out)[4][4], bool transposed);
+
+	// 上3x3が正規直交な InverseAffineMatrix（上3x3は転置で済む）
+	void InverseRigidMatrix(const float(&m)[4][4], float(&out)[4][4], bool transposed);
+}
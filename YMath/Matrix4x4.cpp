@@ -67,129 +67,141 @@ Matrix4x4 Subtract(Matrix4x4 matrix1, Matrix4x4 matrix2) {
 //===================================== 3. 行列の積 ===============================================//
 Matrix4x4 Multiply(Matrix4x4 matrix1, Matrix4x4 matrix2) {
 	Matrix4x4 result;
-	result.m[0][0] = matrix1.m[0][0] * matrix2.m[0][0] + matrix1.m[0][1] * matrix2.m[1][0] + matrix1.m[0][2] * matrix2.m[2][0] + matrix1.m[0][3] * matrix2.m[3][0];
-	result.m[1][0] = matrix1.m[1][0] * matrix2.m[0][0] + matrix1.m[1][1] * matrix2.m[1][0] + matrix1.m[1][2] * matrix2.m[2][0] + matrix1.m[1][3] * matrix2.m[3][0];
-	result.m[2][0] = matrix1.m[2][0] * matrix2.m[0][0] + matrix1.m[2][1] * matrix2.m[1][0] + matrix1.m[2][2] * matrix2.m[2][0] + matrix1.m[2][3] * matrix2.m[3][0];
-	result.m[3][0] = matrix1.m[3][0] * matrix2.m[0][0] + matrix1.m[3][1] * matrix2.m[1][0] + matrix1.m[3][2] * matrix2.m[2][0] + matrix1.m[3][3] * matrix2.m[3][0];
-
-	result.m[0][1] = matrix1.m[0][0] * matrix2.m[0][1] + matrix1.m[0][1] * matrix2.m[1][1] + matrix1.m[0][2] * matrix2.m[2][1] + matrix1.m[0][3] * matrix2.m[3][1];
-	result.m[1][1] = matrix1.m[1][0] * matrix2.m[0][1] + matrix1.m[1][1] * matrix2.m[1][1] + matrix1.m[1][2] * matrix2.m[2][1] + matrix1.m[1][3] * matrix2.m[3][1];
-	result.m[2][1] = matrix1.m[2][0] * matrix2.m[0][1] + matrix1.m[2][1] * matrix2.m[1][1] + matrix1.m[2][2] * matrix2.m[2][1] + matrix1.m[2][3] * matrix2.m[3][1];
-	result.m[3][1] = matrix1.m[3][0] * matrix2.m[0][1] + matrix1.m[3][1] * matrix2.m[1][1] + matrix1.m[3][2] * matrix2.m[2][1] + matrix1.m[3][3] * matrix2.m[3][1];
-
-	result.m[0][2] = matrix1.m[0][0] * matrix2.m[0][2] + matrix1.m[0][1] * matrix2.m[1][2] + matrix1.m[0][2] * matrix2.m[2][2] + matrix1.m[0][3] * matrix2.m[3][2];
-	result.m[1][2] = matrix1.m[1][0] * matrix2.m[0][2] + matrix1.m[1][1] * matrix2.m[1][2] + matrix1.m[1][2] * matrix2.m[2][2] + matrix1.m[1][3] * matrix2.m[3][2];
-	result.m[2][2] = matrix1.m[2][0] * matrix2.m[0][2] + matrix1.m[2][1] * matrix2.m[1][2] + matrix1.m[2][2] * matrix2.m[2][2] + matrix1.m[2][3] * matrix2.m[3][2];
-	result.m[3][2] = matrix1.m[3][0] * matrix2.m[0][2] + matrix1.m[3][1] * matrix2.m[1][2] + matrix1.m[3][2] * matrix2.m[2][2] + matrix1.m[3][3] * matrix2.m[3][2];
-
-	result.m[0][3] = matrix1.m[0][0] * matrix2.m[0][3] + matrix1.m[0][1] * matrix2.m[1][3] + matrix1.m[0][2] * matrix2.m[2][3] + matrix1.m[0][3] * matrix2.m[3][3];
-	result.m[1][3] = matrix1.m[1][0] * matrix2.m[0][3] + matrix1.m[1][1] * matrix2.m[1][3] + matrix1.m[1][2] * matrix2.m[2][3] + matrix1.m[1][3] * matrix2.m[3][3];
-	result.m[2][3] = matrix1.m[2][0] * matrix2.m[0][3] + matrix1.m[2][1] * matrix2.m[1][3] + matrix1.m[2][2] * matrix2.m[2][3] + matrix1.m[2][3] * matrix2.m[3][3];
-	result.m[3][3] = matrix1.m[3][0] * matrix2.m[0][3] + matrix1.m[3][1] * matrix2.m[1][3] + matrix1.m[3][2] * matrix2.m[2][3] + matrix1.m[3][3] * matrix2.m[3][3];
-
+	YMathSimd::MultiplyMatrix(matrix1.m, matrix2.m, result.m);
 	return result;
 }
 
 //===================================== 4. 逆行列 ===============================================//
 Matrix4x4 Inverse(const Matrix4x4& m) {
-	float A =
-		m.m[0][0] * m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[0][0] * m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[0][0] * m.m[1][3] * m.m[2][1] * m.m[3][2] - m.m[0][0] * m.m[1][3] * m.m[2][2] * m.m[3][1] -
-		m.m[0][0] * m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[0][0] * m.m[1][1] * m.m[2][3] * m.m[3][2] - m.m[0][1] * m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[1][0] * m.m[2][3] * m.m[3][1] -
-		m.m[0][3] * m.m[1][0] * m.m[2][1] * m.m[3][2] + m.m[0][3] * m.m[1][0] * m.m[2][2] * m.m[3][1] + m.m[0][2] * m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[0][1] * m.m[1][0] * m.m[2][3] * m.m[3][2] +
-		m.m[0][1] * m.m[1][2] * m.m[2][0] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] * m.m[3][1] + m.m[0][3] * m.m[1][1] * m.m[2][0] * m.m[3][2] - m.m[0][3] * m.m[1][2] * m.m[2][0] * m.m[3][1] -
-		m.m[0][2] * m.m[1][1] * m.m[2][0] * m.m[3][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] * m.m[3][2] - m.m[0][1] * m.m[1][2] * m.m[2][3] * m.m[3][0] - m.m[0][2] * m.m[1][3] * m.m[2][1] * m.m[3][0] -
-		m.m[0][3] * m.m[1][1] * m.m[2][2] * m.m[3][0] + m.m[0][3] * m.m[1][2] * m.m[2][1] * m.m[3][0] + m.m[0][2] * m.m[1][1] * m.m[2][3] * m.m[3][0] + m.m[0][1] * m.m[1][3] * m.m[2][2] * m.m[3][0];
-
-	return {
-		(m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[1][3] * m.m[2][1] * m.m[3][2] - m.m[1][3] * m.m[2][2] * m.m[3][1] - m.m[1][2] * m.m[2][1] * m.m[3][3] -
-		 m.m[1][1] * m.m[2][3] * m.m[3][2]) /
-			A,
-
-		(-m.m[0][1] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[2][3] * m.m[3][1] - m.m[0][3] * m.m[2][1] * m.m[3][2] + m.m[0][3] * m.m[2][2] * m.m[3][1] + m.m[0][2] * m.m[2][1] * m.m[3][3] +
-		 m.m[0][1] * m.m[2][3] * m.m[3][2]) /
-			A,
-
-		(m.m[0][1] * m.m[1][2] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[3][1] + m.m[0][3] * m.m[1][1] * m.m[3][2] - m.m[0][3] * m.m[1][2] * m.m[3][1] - m.m[0][2] * m.m[1][1] * m.m[3][3] -
-		 m.m[0][1] * m.m[1][3] * m.m[3][2]) /
-			A,
-
-		(-m.m[0][1] * m.m[1][2] * m.m[2][3] - m.m[0][2] * m.m[1][3] * m.m[2][1] - m.m[0][3] * m.m[1][1] * m.m[2][2] + m.m[0][3] * m.m[1][2] * m.m[2][1] + m.m[0][2] * m.m[1][1] * m.m[2][3] +
-		 m.m[0][1] * m.m[1][3] * m.m[2][2]) /
-			A,
-
-		(-m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[1][2] * m.m[2][3] * m.m[3][0] - m.m[1][3] * m.m[2][0] * m.m[3][2] + m.m[1][3] * m.m[2][2] * m.m[3][0] + m.m[1][2] * m.m[2][0] * m.m[3][3] +
-		 m.m[1][0] * m.m[2][3] * m.m[3][2]) /
-			A,
-
-		(m.m[0][0] * m.m[2][2] * m.m[3][3] + m.m[0][2] * m.m[2][3] * m.m[3][0] + m.m[0][3] * m.m[2][0] * m.m[3][2] - m.m[0][3] * m.m[2][2] * m.m[3][0] - m.m[0][2] * m.m[2][0] * m.m[3][3] -
-		 m.m[0][0] * m.m[2][3] * m.m[3][2]) /
-			A,
-
-		(-m.m[0][0] * m.m[1][2] * m.m[3][3] - m.m[0][2] * m.m[1][3] * m.m[3][0] - m.m[0][3] * m.m[1][0] * m.m[3][2] + m.m[0][3] * m.m[1][2] * m.m[3][0] + m.m[0][2] * m.m[1][0] * m.m[3][3] +
-		 m.m[0][0] * m.m[1][3] * m.m[3][2]) /
-			A,
-
-		(m.m[0][0] * m.m[1][2] * m.m[2][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] + m.m[0][3] * m.m[1][0] * m.m[2][2] - m.m[0][3] * m.m[1][2] * m.m[2][0] - m.m[0][1] * m.m[1][0] * m.m[2][3] -
-		 m.m[0][0] * m.m[1][3] * m.m[2][2]) /
-			A,
-
-		(m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[1][1] * m.m[2][3] * m.m[3][0] + m.m[1][3] * m.m[2][0] * m.m[3][1] - m.m[1][3] * m.m[2][1] * m.m[3][0] - m.m[1][1] * m.m[2][0] * m.m[3][3] -
-		 m.m[1][0] * m.m[2][3] * m.m[3][1]) /
-			A,
-
-		(-m.m[0][0] * m.m[2][1] * m.m[3][3] - m.m[0][1] * m.m[2][3] * m.m[3][0] - m.m[0][3] * m.m[2][0] * m.m[3][1] + m.m[0][3] * m.m[2][1] * m.m[3][0] + m.m[0][1] * m.m[2][0] * m.m[3][3] +
-		 m.m[0][0] * m.m[2][3] * m.m[3][1]) /
-			A,
-
-		(m.m[0][0] * m.m[1][1] * m.m[3][3] + m.m[0][1] * m.m[1][3] * m.m[3][0] + m.m[0][3] * m.m[1][0] * m.m[3][1] - m.m[0][3] * m.m[1][1] * m.m[3][0] - m.m[0][1] * m.m[1][0] * m.m[3][3] -
-		 m.m[0][0] * m.m[1][3] * m.m[3][1]) /
-			A,
-
-		(-m.m[0][0] * m.m[1][1] * m.m[2][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] - m.m[0][3] * m.m[1][0] * m.m[2][1] + m.m[0][3] * m.m[1][1] * m.m[2][0] + m.m[0][1] * m.m[1][0] * m.m[2][3] +
-		 m.m[0][0] * m.m[1][3] * m.m[2][1]) /
-			A,
-
-		(-m.m[1][0] * m.m[2][1] * m.m[3][2] - m.m[1][1] * m.m[2][2] * m.m[3][0] - m.m[1][2] * m.m[2][0] * m.m[3][1] + m.m[1][2] * m.m[2][1] * m.m[3][0] + m.m[1][1] * m.m[2][0] * m.m[3][2] +
-		 m.m[1][0] * m.m[2][2] * m.m[3][1]) /
-			A,
-
-		(m.m[0][0] * m.m[2][1] * m.m[3][2] + m.m[0][1] * m.m[2][2] * m.m[3][0] + m.m[0][2] * m.m[2][0] * m.m[3][1] - m.m[0][2] * m.m[2][1] * m.m[3][0] - m.m[0][1] * m.m[2][0] * m.m[3][2] -
-		 m.m[0][0] * m.m[2][2] * m.m[3][1]) /
-			A,
-
-		(-m.m[0][0] * m.m[1][1] * m.m[3][2] - m.m[0][1] * m.m[1][2] * m.m[3][0] - m.m[0][2] * m.m[1][0] * m.m[3][1] + m.m[0][2] * m.m[1][1] * m.m[3][0] + m.m[0][1] * m.m[1][0] * m.m[3][2] +
-		 m.m[0][0] * m.m[1][2] * m.m[3][1]) /
-			A,
-
-		(m.m[0][0] * m.m[1][1] * m.m[2][2] + m.m[0][1] * m.m[1][2] * m.m[2][0] + m.m[0][2] * m.m[1][0] * m.m[2][1] - m.m[0][2] * m.m[1][1] * m.m[2][0] - m.m[0][1] * m.m[1][0] * m.m[2][2] -
-		 m.m[0][0] * m.m[1][2] * m.m[2][1]) /
-			A
-
-	};
+	Matrix4x4 result;
+	YMathSimd::InverseMatrix(m.m, result.m);
+	return result;
+}
+
+/// <summary>
+/// 一般の 4x4 逆行列
+/// SSE は 2x2 ブロックに分けて余因子をまとめて求め、それ以外は 2x2 小行列式を共有する余因子展開で求める
+/// </summary>
+void YMathSimd::InverseMatrix(const float(&m)[4][4], float(&out)[4][4]) {
+#if defined(YMATH_SIMD_SSE)
+	// 2x2 行列（行優先 xyzw = 00,01,10,11）同士の積 a * b
+	auto mat2Mul = [](__m128 a, __m128 b) {
+		return _mm_add_ps(
+			_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+		};
+	// 余因子行列 adj(a) * b
+	auto mat2AdjMul = [](__m128 a, __m128 b) {
+		return _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+		};
+	// a * adj(b)
+	auto mat2MulAdj = [](__m128 a, __m128 b) {
+		return _mm_sub_ps(
+			_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+		};
+
+	const __m128 r0 = _mm_loadu_ps(m[0]);
+	const __m128 r1 = _mm_loadu_ps(m[1]);
+	const __m128 r2 = _mm_loadu_ps(m[2]);
+	const __m128 r3 = _mm_loadu_ps(m[3]);
+
+	// | A B |
+	// | C D | に分割
+	const __m128 A = _mm_movelh_ps(r0, r1);
+	const __m128 B = _mm_movehl_ps(r1, r0);
+	const __m128 C = _mm_movelh_ps(r2, r3);
+	const __m128 D = _mm_movehl_ps(r3, r2);
+
+	// 各ブロックの行列式 (|A|, |B|, |C|, |D|)
+	const __m128 detSub = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+	const __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+	const __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+	const __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+	const __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+	const __m128 dc = mat2AdjMul(D, C);
+	const __m128 ab = mat2AdjMul(A, B);
+
+	// 逆行列の各ブロックの余因子
+	__m128 x = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Mul(B, dc));
+	__m128 w = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Mul(C, ab));
+	__m128 y = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MulAdj(D, ab));
+	__m128 z = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MulAdj(A, dc));
+
+	// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+	__m128 tr = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0)));
+	tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+	tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+	__m128 detM = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+	detM = _mm_sub_ps(detM, tr);
+
+	// 余因子の並べ替えで付く符号をまとめて掛ける
+	const __m128 rcpDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+	x = _mm_mul_ps(x, rcpDet);
+	y = _mm_mul_ps(y, rcpDet);
+	z = _mm_mul_ps(z, rcpDet);
+	w = _mm_mul_ps(w, rcpDet);
+
+	_mm_storeu_ps(out[0], _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(out[1], _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+	_mm_storeu_ps(out[2], _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(out[3], _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+#else
+	// 上2行・下2行の 2x2 小行列式
+	const float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+	const float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+	const float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+	const float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+	const float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+	const float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+	const float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	const float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+	const float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+	const float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	const float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+	const float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+	const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	const float invDet = 1.0f / det;
+
+	float result[4][4];
+	result[0][0] = (m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * invDet;
+	result[0][1] = (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * invDet;
+	result[0][2] = (m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * invDet;
+	result[0][3] = (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * invDet;
+
+	result[1][0] = (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * invDet;
+	result[1][1] = (m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * invDet;
+	result[1][2] = (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * invDet;
+	result[1][3] = (m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * invDet;
+
+	result[2][0] = (m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * invDet;
+	result[2][1] = (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * invDet;
+	result[2][2] = (m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * invDet;
+	result[2][3] = (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * invDet;
+
+	result[3][0] = (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * invDet;
+	result[3][1] = (m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * invDet;
+	result[3][2] = (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * invDet;
+	result[3][3] = (m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * invDet;
+
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			out[i][j] = result[i][j];
+		}
+	}
+#endif
 }
 //===================================== 5. 転置行列 ===============================================//
 Matrix4x4 TransPose(const Matrix4x4& matrix) {
 	Matrix4x4 result;
-	result.m[0][0] = matrix.m[0][0];
-	result.m[0][1] = matrix.m[1][0];
-	result.m[0][2] = matrix.m[2][0];
-	result.m[0][3] = matrix.m[3][0];
-
-	result.m[1][0] = matrix.m[0][1];
-	result.m[1][1] = matrix.m[1][1];
-	result.m[1][2] = matrix.m[2][1];
-	result.m[1][3] = matrix.m[3][1];
-
-	result.m[2][0] = matrix.m[0][2];
-	result.m[2][1] = matrix.m[1][2];
-	result.m[2][2] = matrix.m[2][2];
-	result.m[2][3] = matrix.m[3][2];
-
-	result.m[3][0] = matrix.m[0][3];
-	result.m[3][1] = matrix.m[1][3];
-	result.m[3][2] = matrix.m[2][3];
-	result.m[3][3] = matrix.m[3][3];
-
+	YMathSimd::TransposeMatrix(matrix.m, result.m);
 	return result;
 }
 //===================================== 6. 単位行列 ===============================================//
@@ -274,12 +286,14 @@ Matrix4x4 MakeTranslateMatrix(const Vector3& translate) {
 
 
 //=====================================9.座標変換===============================================//
+// 1点だけの変換はスカラーのまま（成分を SIMD レジスタへ広げて戻す分だけ遅くなる）
+// 多数の点をまとめて変換するときは TransformBatch.h の span 版を使う
 Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix) {
 	Vector3 result;
-	result.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + 1.0f * matrix.m[3][0];
-	result.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + 1.0f * matrix.m[3][1];
-	result.z = vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] + vector.z * matrix.m[2][2] + 1.0f * matrix.m[3][2];
-	float w = vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] + vector.z * matrix.m[2][3] + 1.0f * matrix.m[3][3];
+	result.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + matrix.m[3][0];
+	result.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + matrix.m[3][1];
+	result.z = vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] + vector.z * matrix.m[2][2] + matrix.m[3][2];
+	float w = vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] + vector.z * matrix.m[2][3] + matrix.m[3][3];
 	assert(w != 0.0f);
 	result.x /= w;
 	result.y /= w;
@@ -303,13 +317,13 @@ Matrix4x4 MakeRotateMatrixX(float radian) {
 	result.m[0][3] = 0;
 
 	result.m[1][0] = 0;
-	result.m[1][1] = std::cosf(radian);
-	result.m[1][2] = std::sinf(radian);
+	result.m[1][1] = std::cos(radian);
+	result.m[1][2] = std::sin(radian);
 	result.m[1][3] = 0;
 
 	result.m[2][0] = 0;
-	result.m[2][1] = -std::sinf(radian);
-	result.m[2][2] = std::cosf(radian);
+	result.m[2][1] = -std::sin(radian);
+	result.m[2][2] = std::cos(radian);
 	result.m[2][3] = 0;
 
 	result.m[3][0] = 0;
@@ -322,9 +336,9 @@ Matrix4x4 MakeRotateMatrixX(float radian) {
 // 2. Y軸回転行列
 Matrix4x4 MakeRotateMatrixY(float radian) {
 	Matrix4x4 result;
-	result.m[0][0] = std::cosf(radian);
+	result.m[0][0] = std::cos(radian);
 	result.m[0][1] = 0;
-	result.m[0][2] = -std::sinf(radian);
+	result.m[0][2] = -std::sin(radian);
 	result.m[0][3] = 0;
 
 	result.m[1][0] = 0;
@@ -332,9 +346,9 @@ Matrix4x4 MakeRotateMatrixY(float radian) {
 	result.m[1][2] = 0;
 	result.m[1][3] = 0;
 
-	result.m[2][0] = std::sinf(radian);
+	result.m[2][0] = std::sin(radian);
 	result.m[2][1] = 0;
-	result.m[2][2] = std::cosf(radian);
+	result.m[2][2] = std::cos(radian);
 	result.m[2][3] = 0;
 
 	result.m[3][0] = 0;
@@ -347,13 +361,13 @@ Matrix4x4 MakeRotateMatrixY(float radian) {
 // 3. Z軸回転行列
 Matrix4x4 MakeRotateMatrixZ(float radian) {
 	Matrix4x4 result;
-	result.m[0][0] = std::cosf(radian);
-	result.m[0][1] = std::sinf(radian);
+	result.m[0][0] = std::cos(radian);
+	result.m[0][1] = std::sin(radian);
 	result.m[0][2] = 0;
 	result.m[0][3] = 0;
 
-	result.m[1][0] = -std::sinf(radian);
-	result.m[1][1] = std::cosf(radian);
+	result.m[1][0] = -std::sin(radian);
+	result.m[1][1] = std::cos(radian);
 	result.m[1][2] = 0;
 	result.m[1][3] = 0;
 
@@ -371,34 +385,55 @@ Matrix4x4 MakeRotateMatrixZ(float radian) {
 }
 Matrix4x4 MakeRotateMatrixXYZ(Vector3 rad)
 {
+	// X * Y * Z を展開した閉形式（行列積3回分の 0 との積和を省く）
+	const float sx = std::sin(rad.x), cx = std::cos(rad.x);
+	const float sy = std::sin(rad.y), cy = std::cos(rad.y);
+	const float sz = std::sin(rad.z), cz = std::cos(rad.z);
+
+	Matrix4x4 result;
+	result.m[0][0] = cy * cz;
+	result.m[0][1] = cy * sz;
+	result.m[0][2] = -sy;
+
+	result.m[1][0] = sx * sy * cz - cx * sz;
+	result.m[1][1] = sx * sy * sz + cx * cz;
+	result.m[1][2] = sx * cy;
 
-	return Multiply(Multiply(MakeRotateMatrixX(rad.x), MakeRotateMatrixY(rad.y)), MakeRotateMatrixZ(rad.z));
+	result.m[2][0] = cx * sy * cz + sx * sz;
+	result.m[2][1] = cx * sy * sz - sx * cz;
+	result.m[2][2] = cx * cy;
+
+	result.m[3][3] = 1.0f;
+	return result;
 };
 
 //=============================11. 3次元のアフィン変換行列=============================//
 Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
-	Matrix4x4 result = MakeIdentity4x4();
-
-	Matrix4x4 matScale = MakeScaleMatrix(scale);
-	Matrix4x4 matRotate = MakeRotateMatrixXYZ(rotate);
-	Matrix4x4 matTrans = MakeTranslateMatrix(translate);
-
-	result = matScale * matRotate * matTrans;
+	// S * R * T は「回転行列の各行をスケール倍し、4行目に平行移動を置く」だけで求まる
+	Matrix4x4 result = MakeRotateMatrixXYZ(rotate);
+	const float s[3] = { scale.x, scale.y, scale.z };
+	for (int i = 0; i < 3; ++i) {
+		result.m[i][0] *= s[i];
+		result.m[i][1] *= s[i];
+		result.m[i][2] *= s[i];
+	}
+	result.m[3][0] = translate.x;
+	result.m[3][1] = translate.y;
+	result.m[3][2] = translate.z;
 	return result;
-	//return result;
 }
 
 //=============================12. レンタリングパイプラインVer2=============================//
 // 1. 透視投影行列
 Matrix4x4 MakePerspectiveFovMatrix(float FovY, float aspectRatio, float nearClip, float farClip) {
 	Matrix4x4 result;
-	result.m[0][0] = 1 / aspectRatio * (1 / std::tanf(FovY / 2));
+	result.m[0][0] = 1 / aspectRatio * (1 / std::tan(FovY / 2));
 	result.m[0][1] = 0;
 	result.m[0][2] = 0;
 	result.m[0][3] = 0;
 
 	result.m[1][0] = 0;
-	result.m[1][1] = (1 / std::tanf(FovY / 2));
+	result.m[1][1] = (1 / std::tan(FovY / 2));
 	result.m[1][2] = 0;
 	result.m[1][3] = 0;
 
@@ -548,40 +583,31 @@ Vector3 ExtractTranslation(const Matrix4x4& matrix)
 Vector3 MatrixToEuler(const Matrix4x4& m) {
 	Vector3 euler;
 
-	// Y軸の角度を計算（より安定した判定のために小さな閾値を使用）
-	float threshold = 0.9999f; // ジンバルロックの判定閾値
+	// MakeRotateMatrixXYZ の逆：m[0][2] = -sin(y)、m[0][0], m[0][1] = cos(y) * (cos(z), sin(z))
+	const float cosY = std::sqrt(m.m[0][0] * m.m[0][0] + m.m[0][1] * m.m[0][1]);
+	euler.y = std::atan2(-m.m[0][2], cosY);
+
+	// cos(y) がこれより小さければ X と Z を区別できないとみなす（ジンバルロック）
+	constexpr float kGimbalThreshold = 1.0e-5f;
 
-	if (fabs(m.m[0][2]) < threshold) {
+	if (cosY > kGimbalThreshold) {
 		// 通常のケース
-		euler.y = std::asin(-m.m[0][2]);
+		// z は求めた x を使って残りから求める（ロック付近で x の精度が落ちても z が補うので、行列としては崩れない）
 		euler.x = std::atan2(m.m[1][2], m.m[2][2]);
-		euler.z = std::atan2(m.m[0][1], m.m[0][0]);
+		const float sinX = std::sin(euler.x);
+		const float cosX = std::cos(euler.x);
+		euler.z = std::atan2(sinX * m.m[2][0] - cosX * m.m[1][0], cosX * m.m[1][1] - sinX * m.m[2][1]);
 	} else {
-		// ジンバルロック状態
-		float sign = (m.m[0][2] > 0) ? -1.0f : 1.0f;
-		euler.y = sign * std::numbers::pi_v<float> / 2.0f;
-
-		// XとZの自由度が1つになるため、任意に1つを固定することが一般的
+		// ジンバルロック状態：X と Z が同じ軸回りになるので z = 0 とし、残りの回転をすべて x に持たせる
+		// sin(y) = s のとき m[1][0] = s * sin(x - s * z)、m[1][1] = cos(x - s * z)
+		const float sign = (m.m[0][2] > 0.0f) ? -1.0f : 1.0f;
+		euler.x = std::atan2(sign * m.m[1][0], m.m[1][1]);
 		euler.z = 0.0f;
-		euler.x = std::atan2(-sign * m.m[1][0], sign * m.m[1][1]);
 	}
 
 	return euler;
 }
 
-DirectX::XMMATRIX ConvertToXMMATRIX(const Matrix4x4& matrix)
-{
-	DirectX::XMMATRIX result;
-
-	for (int i = 0; i < 4; ++i) {
-		for (int j = 0; j < 4; ++j) {
-			result.r[i].m128_f32[j] = matrix.m[i][j];
-		}
-	}
-
-	return result;
-}
-
 Matrix4x4 MatrixLookAtLH(const Vector3& eye, const Vector3& target, const Vector3& up)
 {
 	Vector3 z_axis = { target.x - eye.x, target.y - eye.y, target.z - eye.z };
@@ -637,6 +663,162 @@ Matrix4x4 MatrixLookAtLH(const Vector3& eye, const Vector3& target, const Vector
 	return result;
 }
 
+//=============================13. アフィン行列専用の逆行列=============================//
+// 4列目が (0, 0, 0, 1) の行列のみ対象。上3x3の逆と平行移動だけを求める
+
+/// <summary>
+/// アフィン行列の逆行列（上3x3の逆行列 + 平行移動）
+/// </summary>
+Matrix4x4 InverseAffine(const Matrix4x4& m) {
+	Matrix4x4 result;
+	YMathSimd::InverseAffineMatrix(m.m, result.m, false);
+	return result;
+}
+
+/// <summary>
+/// 回転 + 平行移動のみ（正規直交）の行列の逆行列。上3x3は転置で済む
+/// </summary>
+Matrix4x4 InverseRigid(const Matrix4x4& m) {
+	Matrix4x4 result;
+	YMathSimd::InverseRigidMatrix(m.m, result.m, false);
+	return result;
+}
+
+/// <summary>
+/// アフィン行列の逆転置行列 TransPose(Inverse(m))（法線変換用）
+/// 上3x3は余因子行列 / det をそのまま使い、4列目に -t * A^-1 を置く
+/// </summary>
+Matrix4x4 InverseTransposeAffine(const Matrix4x4& m) {
+	Matrix4x4 result;
+	YMathSimd::InverseAffineMatrix(m.m, result.m, true);
+	return result;
+}
+
+/// <summary>
+/// 正規直交な行列の逆転置行列。上3x3は元の行列と同じになる
+/// </summary>
+Matrix4x4 InverseTransposeRigid(const Matrix4x4& m) {
+	Matrix4x4 result;
+	YMathSimd::InverseRigidMatrix(m.m, result.m, true);
+	return result;
+}
+
+namespace {
+#if defined(YMATH_SIMD_SSE)
+	// 上3x3の各行（w は 0）
+	inline __m128 LoadRow3(const float(&row)[4]) {
+		return _mm_and_ps(_mm_loadu_ps(row), _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+	}
 
+	// a × b（a, b の w が 0 なら結果の w も 0）
+	inline __m128 Cross3(__m128 a, __m128 b) {
+		const __m128 c = _mm_sub_ps(
+			_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), b));
+		return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+	}
 
+	/// <summary>
+	/// 行 (c0, c1, c2) を転置したものを上3x3（A^-1）、-t * A^-1 を4行目として書き出す
+	/// transposed なら全体を転置して書き出す
+	/// </summary>
+	inline void StoreInverseAffine(__m128 c0, __m128 c1, __m128 c2, __m128 t, float(&out)[4][4], bool transposed) {
+		__m128 c3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+		// 平行移動 = -t * A^-1（t の w は c3 = 0 に掛かるので無視される）
+		const __m128 translation = _mm_sub_ps(
+			_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f),
+			YMathSimd::TransformRow(t, c0, c1, c2, c3));
+
+		__m128 r3 = translation;
+		if (transposed) {
+			_MM_TRANSPOSE4_PS(c0, c1, c2, r3);
+		}
+		_mm_storeu_ps(out[0], c0);
+		_mm_storeu_ps(out[1], c1);
+		_mm_storeu_ps(out[2], c2);
+		_mm_storeu_ps(out[3], r3);
+	}
+#else
+	// 上3x3の逆 inv と平行移動から結果を書き出す（transposed なら転置して書き出す）
+	inline void StoreInverseAffine(const float(&inv)[3][3], const float(&m)[4][4], float(&out)[4][4], bool transposed) {
+		// 平行移動 = -t * A^-1（m と out が同じでもよいよう先に求める）
+		const float tx = -(m[3][0] * inv[0][0] + m[3][1] * inv[1][0] + m[3][2] * inv[2][0]);
+		const float ty = -(m[3][0] * inv[0][1] + m[3][1] * inv[1][1] + m[3][2] * inv[2][1]);
+		const float tz = -(m[3][0] * inv[0][2] + m[3][1] * inv[1][2] + m[3][2] * inv[2][2]);
+
+		if (transposed) {
+			out[0][0] = inv[0][0]; out[0][1] = inv[1][0]; out[0][2] = inv[2][0]; out[0][3] = tx;
+			out[1][0] = inv[0][1]; out[1][1] = inv[1][1]; out[1][2] = inv[2][1]; out[1][3] = ty;
+			out[2][0] = inv[0][2]; out[2][1] = inv[1][2]; out[2][2] = inv[2][2]; out[2][3] = tz;
+			out[3][0] = 0.0f;      out[3][1] = 0.0f;      out[3][2] = 0.0f;      out[3][3] = 1.0f;
+		} else {
+			out[0][0] = inv[0][0]; out[0][1] = inv[0][1]; out[0][2] = inv[0][2]; out[0][3] = 0.0f;
+			out[1][0] = inv[1][0]; out[1][1] = inv[1][1]; out[1][2] = inv[1][2]; out[1][3] = 0.0f;
+			out[2][0] = inv[2][0]; out[2][1] = inv[2][1]; out[2][2] = inv[2][2]; out[2][3] = 0.0f;
+			out[3][0] = tx;        out[3][1] = ty;        out[3][2] = tz;        out[3][3] = 1.0f;
+		}
+	}
+#endif
+}
 
+/// <summary>
+/// アフィン行列の逆行列
+/// 上3x3の余因子行列（各行 = 残り2行の外積）を転置して行列式で割る
+/// </summary>
+void YMathSimd::InverseAffineMatrix(const float(&m)[4][4], float(&out)[4][4], bool transposed) {
+#if defined(YMATH_SIMD_SSE)
+	const __m128 r0 = LoadRow3(m[0]);
+	const __m128 r1 = LoadRow3(m[1]);
+	const __m128 r2 = LoadRow3(m[2]);
+
+	const __m128 c0 = Cross3(r1, r2);
+	const __m128 c1 = Cross3(r2, r0);
+	const __m128 c2 = Cross3(r0, r1);
+
+	// det = r0・c0 を全レーンへ
+	__m128 det = _mm_mul_ps(r0, c0);
+	det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+	det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+	const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+	StoreInverseAffine(_mm_mul_ps(c0, invDet), _mm_mul_ps(c1, invDet), _mm_mul_ps(c2, invDet), _mm_loadu_ps(m[3]), out, transposed);
+#else
+	float cof[3][3];
+	for (int r = 0; r < 3; ++r) {
+		const float* u = m[(r + 1) % 3];
+		const float* v = m[(r + 2) % 3];
+		cof[r][0] = u[1] * v[2] - u[2] * v[1];
+		cof[r][1] = u[2] * v[0] - u[0] * v[2];
+		cof[r][2] = u[0] * v[1] - u[1] * v[0];
+	}
+	const float invDet = 1.0f / (m[0][0] * cof[0][0] + m[0][1] * cof[0][1] + m[0][2] * cof[0][2]);
+
+	// A^-1 = 余因子行列の転置 / det
+	float inv[3][3];
+	for (int r = 0; r < 3; ++r) {
+		for (int c = 0; c < 3; ++c) {
+			inv[r][c] = cof[c][r] * invDet;
+		}
+	}
+	StoreInverseAffine(inv, m, out, transposed);
+#endif
+}
+
+/// <summary>
+/// 回転 + 平行移動のみの行列の逆行列（上3x3は転置）
+/// </summary>
+void YMathSimd::InverseRigidMatrix(const float(&m)[4][4], float(&out)[4][4], bool transposed) {
+#if defined(YMATH_SIMD_SSE)
+	StoreInverseAffine(LoadRow3(m[0]), LoadRow3(m[1]), LoadRow3(m[2]), _mm_loadu_ps(m[3]), out, transposed);
+#else
+	float inv[3][3];
+	for (int r = 0; r < 3; ++r) {
+		for (int c = 0; c < 3; ++c) {
+			inv[r][c] = m[c][r];
+		}
+	}
+	StoreInverseAffine(inv, m, out, transposed);
+#endif
+}
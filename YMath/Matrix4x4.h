@@ -5,11 +5,10 @@
 
 // Math
 #include "Vector3.h"
+#include "MathSimd.h"
 #include <initializer_list>
 #include <stdexcept>
-
-// DX
-#include <DirectXMath.h>
+#include <type_traits>
 
 
 struct Matrix4x4 {
@@ -41,14 +40,7 @@ struct Matrix4x4 {
 	// 行列の乗算
 	Matrix4x4 operator*(const Matrix4x4& other) const {
 		Matrix4x4 result;
-		for (int i = 0; i < 4; ++i) {
-			for (int j = 0; j < 4; ++j) {
-				result.m[i][j] = 0.0f;
-				for (int k = 0; k < 4; ++k) {
-					result.m[i][j] += m[i][k] * other.m[k][j];
-				}
-			}
-		}
+		YMathSimd::MultiplyMatrix(m, other.m, result.m);
 		return result;
 	}
 
@@ -79,7 +71,7 @@ struct Matrix4x4 {
 
 	// 乗算代入
 	Matrix4x4& operator*=(const Matrix4x4& other) {
-		*this = *this * other;
+		YMathSimd::MultiplyMatrix(m, other.m, m);
 		return *this;
 	}
 
@@ -89,12 +81,11 @@ struct Matrix4x4 {
 			for (int j = 0; j < 4; ++j)
 				m[i][j] *= scalar;
 		return *this;
-	}
-
+	}};
 
-
-
-};
+// SIMD カーネルは float[4][4] を直接読み書きするので、余計なメンバやパディングを持たせない
+static_assert(sizeof(Matrix4x4) == sizeof(float) * 16);
+static_assert(std::is_standard_layout_v<Matrix4x4>);
 
 inline bool IsEqual(const Matrix4x4& lhs, const Matrix4x4& rhs, float epsilon = 1e-6f)
 {
@@ -178,6 +169,14 @@ Vector3 ExtractTranslation(const Matrix4x4& matrix);
 // 行列から回転成分をオイラー角に変換する関数
 Vector3 MatrixToEuler(const Matrix4x4& m);
 
-DirectX::XMMATRIX ConvertToXMMATRIX(const Matrix4x4& matrix);
-
-Matrix4x4 MatrixLookAtLH(const Vector3& eye, const Vector3& target, const Vector3& up);
\ No newline at end of file
+Matrix4x4 MatrixLookAtLH(const Vector3& eye, const Vector3& target, const Vector3& up);
+
+// 13. アフィン行列（4列目が 0,0,0,1）専用の逆行列
+//  上3x3の逆行列 + 平行移動
+Matrix4x4 InverseAffine(const Matrix4x4& m);
+//  回転 + 平行移動のみ（スケール 1）の逆行列
+Matrix4x4 InverseRigid(const Matrix4x4& m);
+//  TransPose(Inverse(m)) と同じ結果の逆転置行列（法線変換用）
+Matrix4x4 InverseTransposeAffine(const Matrix4x4& m);
+//  回転 + 平行移動のみの逆転置行列
+Matrix4x4 InverseTransposeRigid(const Matrix4x4& m);
\ No newline at end of file
@@ -3,20 +3,20 @@
 
 Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate)
 {
-    Matrix4x4 result;
-
-    Matrix4x4 scaleMatrix = MakeScaleMatrix(scale);
-    Matrix4x4 rotateMatrix = MakeRotateMatrix(rotate);
-    Matrix4x4 translateMatrix = MakeTranslateMatrix(translate);
-
-    result = scaleMatrix * rotateMatrix * translateMatrix;
+    // S * R * T は回転行列の各行をスケール倍し、4行目に平行移動を置くだけで求まる
+    Matrix4x4 result = MakeRotateMatrix(rotate);
+    const float s[3] = { scale.x, scale.y, scale.z };
+    for (int i = 0; i < 3; ++i) {
+        result.m[i][0] *= s[i];
+        result.m[i][1] *= s[i];
+        result.m[i][2] *= s[i];
+    }
+    result.m[3][0] = translate.x;
+    result.m[3][1] = translate.y;
+    result.m[3][2] = translate.z;
     return result;
 }
 
-
-
-
-
 Quaternion IdentityQuaternion()
 {
     return { 0, 0, 0, 1 };
@@ -166,31 +166,34 @@ Vector3 RotateVector(const Vector3& vector, const Quaternion& quaternion) {
 }
 
 Matrix4x4 MakeRotateMatrix(const Quaternion& quaternion) {
-    Matrix4x4 matrix = {};
-
-    float xx = quaternion.x * quaternion.x;
-    float yy = quaternion.y * quaternion.y;
-    float zz = quaternion.z * quaternion.z;
-    float xy = quaternion.x * quaternion.y;
-    float xz = quaternion.x * quaternion.z;
-    float yz = quaternion.y * quaternion.z;
-    float wx = quaternion.w * quaternion.x;
-    float wy = quaternion.w * quaternion.y;
-    float wz = quaternion.w * quaternion.z;
-
-    matrix.m[0][0] = 1.0f - 2.0f * (yy + zz);
-    matrix.m[0][1] = 2.0f * (xy - wz);
-    matrix.m[0][2] = 2.0f * (xz + wy);
+    // 行ベクトル規約の回転行列を直接組み立てる（転置を挟まない）
+    const float x2 = quaternion.x + quaternion.x;
+    const float y2 = quaternion.y + quaternion.y;
+    const float z2 = quaternion.z + quaternion.z;
+    const float xx = quaternion.x * x2;
+    const float yy = quaternion.y * y2;
+    const float zz = quaternion.z * z2;
+    const float xy = quaternion.x * y2;
+    const float xz = quaternion.x * z2;
+    const float yz = quaternion.y * z2;
+    const float wx = quaternion.w * x2;
+    const float wy = quaternion.w * y2;
+    const float wz = quaternion.w * z2;
+
+    Matrix4x4 matrix;
+    matrix.m[0][0] = 1.0f - (yy + zz);
+    matrix.m[0][1] = xy + wz;
+    matrix.m[0][2] = xz - wy;
     matrix.m[0][3] = 0.0f;
 
-    matrix.m[1][0] = 2.0f * (xy + wz);
-    matrix.m[1][1] = 1.0f - 2.0f * (xx + zz);
-    matrix.m[1][2] = 2.0f * (yz - wx);
+    matrix.m[1][0] = xy - wz;
+    matrix.m[1][1] = 1.0f - (xx + zz);
+    matrix.m[1][2] = yz + wx;
     matrix.m[1][3] = 0.0f;
 
-    matrix.m[2][0] = 2.0f * (xz - wy);
-    matrix.m[2][1] = 2.0f * (yz + wx);
-    matrix.m[2][2] = 1.0f - 2.0f * (xx + yy);
+    matrix.m[2][0] = xz + wy;
+    matrix.m[2][1] = yz - wx;
+    matrix.m[2][2] = 1.0f - (xx + yy);
     matrix.m[2][3] = 0.0f;
 
     matrix.m[3][0] = 0.0f;
@@ -198,8 +201,6 @@ Matrix4x4 MakeRotateMatrix(const Quaternion& quaternion) {
     matrix.m[3][2] = 0.0f;
     matrix.m[3][3] = 1.0f;
 
-    matrix = TransPose(matrix);
-
     return matrix;
 }
 
@@ -282,6 +283,46 @@ Quaternion Slerp(Quaternion q1, Quaternion q2, float t)
 }
 
 
+/// <summary>
+/// 正規化線形補間（最短経路）
+/// 角速度は一定にならないが、超越関数を使わない
+/// </summary>
+Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t)
+{
+    // 反対向きなら q1 を反転して最短経路を取る
+    const float dot = Dot(q0, q1);
+    const float t1 = dot < 0.0f ? -t : t;
+    const float t0 = 1.0f - t;
+
+    Quaternion result = {
+        t0 * q0.x + t1 * q1.x,
+        t0 * q0.y + t1 * q1.y,
+        t0 * q0.z + t1 * q1.z,
+        t0 * q0.w + t1 * q1.w
+    };
+
+    const float lengthSq = result.x * result.x + result.y * result.y + result.z * result.z + result.w * result.w;
+    if (lengthSq <= 0.0f) {
+        return q0;
+    }
+    const float invLength = 1.0f / std::sqrt(lengthSq);
+    return { result.x * invLength, result.y * invLength, result.z * invLength, result.w * invLength };
+}
+
+/// <summary>
+/// 近似球面線形補間
+/// t を多項式で補正してから Nlerp する（Nlerp の角速度のずれを打ち消す）
+/// 補正係数は内積 |cosθ| の3次式で、Slerp との角度誤差は 最大 2e-3 ラジアン程度
+/// </summary>
+Quaternion SlerpFast(const Quaternion& q0, const Quaternion& q1, float t)
+{
+    const float d = std::abs(Dot(q0, q1));
+    const float a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    const float b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    const float k = a * (t - 0.5f) * (t - 0.5f) + b;
+    const float correctedT = t + t * (t - 0.5f) * (t - 1.0f) * k;
+    return Nlerp(q0, q1, correctedT);
+}
 
 //Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t) {
 //    // クォータニオンの内積を計算
@@ -596,6 +637,33 @@ Vector3 RotateVectorByQuaternion(const Vector3& vec, const Quaternion& quat) {
     return Vector3(result.x, result.y, result.z);
 }
 
+/// <summary>
+/// X → Y → Z 順のオイラー角（ラジアン）から回転クォータニオンを作る
+/// MakeRotateMatrixXYZ と同じ回転になる（qz * qy * qx を展開した形）
+/// </summary>
+Quaternion MakeRotateQuaternionXYZ(const Vector3& rotate)
+{
+    const float cx = std::cos(rotate.x * 0.5f), sx = std::sin(rotate.x * 0.5f);
+    const float cy = std::cos(rotate.y * 0.5f), sy = std::sin(rotate.y * 0.5f);
+    const float cz = std::cos(rotate.z * 0.5f), sz = std::sin(rotate.z * 0.5f);
+
+    return {
+        cz * cy * sx - sz * sy * cx,
+        cz * sy * cx + sz * cy * sx,
+        sz * cy * cx - cz * sy * sx,
+        cz * cy * cx + sz * sy * sx
+    };
+}
+
+/// <summary>
+/// 回転クォータニオンを X → Y → Z 順のオイラー角（ラジアン）へ変換する
+/// MakeRotateQuaternionXYZ の逆。エディタ表示用で毎フレームの処理には使わない
+/// </summary>
+Vector3 QuaternionToEulerXYZ(const Quaternion& q)
+{
+    return MatrixToEuler(MakeRotateMatrix(q));
+}
+
 // オイラー角をクォータニオンに変換する関数
 Quaternion EulerToQuaternion(const Vector3& euler)
 {
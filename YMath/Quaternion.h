@@ -154,6 +154,12 @@ Quaternion Lerp(const Quaternion& q1, const Quaternion& q2, float t);
 // 2つのクォータニオン間で球面線形補間（Slerp）を行う関数
 Quaternion Slerp(Quaternion q1, Quaternion q2, float t);
 
+// 正規化線形補間（最短経路。超越関数を使わない）
+Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+// 近似球面線形補間（t を多項式補正した Nlerp。アニメーションのサンプリング・ブレンド用）
+Quaternion SlerpFast(const Quaternion& q0, const Quaternion& q1, float t);
+
 //Quaternion Slerps(const Quaternion& q0In, const Quaternion& q1In, float t);
 
 // 4つのクォータニオン間で球面線形補間（Slerp）を行う関数
@@ -181,6 +187,12 @@ Vector3 RotateVectorByQuaternion(const Vector3& vec, const Quaternion& quat);
 
 Quaternion EulerToQuaternion(const Vector3& euler);
 
+// X → Y → Z 順のオイラー角（ラジアン）から回転クォータニオン（MakeRotateMatrixXYZ と同じ回転）
+Quaternion MakeRotateQuaternionXYZ(const Vector3& rotate);
+
+// 回転クォータニオンから X → Y → Z 順のオイラー角（ラジアン。エディタ表示用）
+Vector3 QuaternionToEulerXYZ(const Quaternion& q);
+
 Quaternion MatrixToQuaternion(const Matrix4x4& mat);
 
 Quaternion LookAtQuaternion(const Vector3& from, const Vector3& to, const Vector3& up);
@@ -0,0 +1,236 @@
+#include "Spline.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+///************************* 構築 *************************///
+
+/// <summary>
+/// 制御点から区間ごとの係数と累積弧長の表を作る
+/// </summary>
+void Spline::Build(std::span<const Vector3> controlPoints, uint32_t samplesPerSegment)
+{
+	controlPoints_.assign(controlPoints.begin(), controlPoints.end());
+	samplesPerSegment_ = std::max(1u, samplesPerSegment);
+	segments_.clear();
+	distances_.clear();
+
+	if (controlPoints_.empty()) { return; }
+
+	distances_.push_back(0.0f);
+	if (controlPoints_.size() < 2) { return; }
+
+	//------------------------------------------------------------
+	// 係数（CatmullRomInterpolation を u の多項式に展開したもの）
+	//------------------------------------------------------------
+	const size_t last = controlPoints_.size() - 1;
+	segments_.resize(last);
+	for (size_t i = 0; i < last; ++i) {
+		// 最初の区間の p0 は p1、最後の区間の p3 は p2 を重複使用する
+		const Vector3& p0 = controlPoints_[i == 0 ? 0 : i - 1];
+		const Vector3& p1 = controlPoints_[i];
+		const Vector3& p2 = controlPoints_[i + 1];
+		const Vector3& p3 = controlPoints_[std::min(i + 2, last)];
+
+		Segment& segment = segments_[i];
+		segment.a = (p0 * -1.0f + p1 * 3.0f - p2 * 3.0f + p3) * 0.5f;
+		segment.b = (p0 * 2.0f - p1 * 5.0f + p2 * 4.0f - p3) * 0.5f;
+		segment.c = (p2 - p0) * 0.5f;
+		segment.d = p1;
+	}
+
+	//------------------------------------------------------------
+	// 累積弧長
+	//------------------------------------------------------------
+	const float step = 1.0f / static_cast<float>(samplesPerSegment_);
+	distances_.reserve(segments_.size() * samplesPerSegment_ + 1);
+	float total = 0.0f;
+	for (const Segment& segment : segments_) {
+		for (uint32_t s = 0; s < samplesPerSegment_; ++s) {
+			const float t0 = static_cast<float>(s) * step;
+			total += IntegrateLength(segment, t0, t0 + step);
+			distances_.push_back(total);
+		}
+	}
+}
+
+/// <summary>
+/// 制御点が変わったときだけ作り直す
+/// </summary>
+bool Spline::Rebuild(std::span<const Vector3> controlPoints, uint32_t samplesPerSegment)
+{
+	const bool same = samplesPerSegment == samplesPerSegment_ &&
+		std::equal(controlPoints.begin(), controlPoints.end(), controlPoints_.begin(), controlPoints_.end(),
+			[](const Vector3& a, const Vector3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; });
+	if (same) { return false; }
+
+	Build(controlPoints, samplesPerSegment);
+	return true;
+}
+
+/// <summary>
+/// 破棄
+/// </summary>
+void Spline::Clear()
+{
+	controlPoints_.clear();
+	segments_.clear();
+	distances_.clear();
+}
+
+///************************* 評価 *************************///
+
+/// <summary>
+/// パラメータ指定の位置
+/// </summary>
+Vector3 Spline::Evaluate(float param) const
+{
+	if (segments_.empty()) {
+		return controlPoints_.empty() ? Vector3{} : controlPoints_.front();
+	}
+
+	float t = 0.0f;
+	const Segment& s = segments_[Locate(param, t)];
+	return ((s.a * t + s.b) * t + s.c) * t + s.d;
+}
+
+/// <summary>
+/// パラメータ指定の微分
+/// </summary>
+Vector3 Spline::EvaluateDerivative(float param) const
+{
+	if (segments_.empty()) { return Vector3{}; }
+
+	// Locate が t を書き換えるので、引数の評価順に頼らず先に呼ぶ
+	float t = 0.0f;
+	const size_t index = Locate(param, t);
+	return Derivative(segments_[index], t);
+}
+
+/// <summary>
+/// 距離指定の位置
+/// </summary>
+Vector3 Spline::EvaluateAtDistance(float distance) const
+{
+	return Evaluate(DistanceToParam(distance));
+}
+
+/// <summary>
+/// 距離指定の進行方向
+/// </summary>
+Vector3 Spline::EvaluateTangentAtDistance(float distance) const
+{
+	const Vector3 derivative = EvaluateDerivative(DistanceToParam(distance));
+	const float length = derivative.Length();
+	return length > 0.0f ? derivative * (1.0f / length) : Vector3{};
+}
+
+/// <summary>
+/// 距離 → パラメータ（累積弧長表を二分探索し、サンプル間は線形補間してから Newton 法で詰める）
+/// </summary>
+float Spline::DistanceToParam(float distance) const
+{
+	if (segments_.empty()) { return 0.0f; }
+
+	const float total = distances_.back();
+	if (distance <= 0.0f || total <= 0.0f) { return 0.0f; }
+	if (distance >= total) { return static_cast<float>(segments_.size()); }
+
+	// distances_[index] <= distance < distances_[index + 1] となる index を探す
+	// 入力が毎回ばらばらでも分岐予測を外さないよう、分岐の無い二分探索にする
+	const float* base = distances_.data();
+	size_t count = distances_.size() - 1;
+	while (count > 1) {
+		const size_t half = count / 2;
+		base = (base[half] <= distance) ? base + half : base;
+		count -= half;
+	}
+	const size_t index = static_cast<size_t>(base - distances_.data());
+	const float d0 = distances_[index];
+	const float d1 = distances_[index + 1];
+	const float f = (d1 > d0) ? (distance - d0) / (d1 - d0) : 0.0f;
+
+	const float step = 1.0f / static_cast<float>(samplesPerSegment_);
+	const size_t segmentIndex = std::min(index / samplesPerSegment_, segments_.size() - 1);
+	const float sampleStart = static_cast<float>(index - segmentIndex * samplesPerSegment_) * step;
+	float t = sampleStart + f * step;
+
+	// サンプル内で速さが変わる分を Newton 法で許容誤差まで詰める
+	// サンプル始点から t までの弧長は表と同じ積分で求めるので、サンプル端で表と一致する
+	// Newton の次の値がサンプルの外（今の挟み込みの外）に出たら二分法に切り替える
+	const Segment& s = segments_[segmentIndex];
+	const float tolerance = std::max(total, 1.0f) * kDistanceTolerance;
+	float lower = sampleStart;
+	float upper = sampleStart + step;
+	for (uint32_t iteration = 0; iteration < kMaxNewtonIterations; ++iteration) {
+		const float error = d0 + IntegrateLength(s, sampleStart, t) - distance;
+		if (std::abs(error) <= tolerance) { break; }
+
+		if (error > 0.0f) {
+			upper = t;
+		} else {
+			lower = t;
+		}
+
+		const float speed = Derivative(s, t).Length();
+		float next = (speed > 0.0f) ? t - error / speed : lower;
+		if (next <= lower || next >= upper) {
+			next = (lower + upper) * 0.5f;
+		}
+		t = next;
+	}
+
+	return static_cast<float>(segmentIndex) + t;
+}
+
+/// <summary>
+/// パラメータ → 距離
+/// </summary>
+float Spline::ParamToDistance(float param) const
+{
+	if (segments_.empty()) { return 0.0f; }
+
+	float t = 0.0f;
+	const size_t segmentIndex = Locate(param, t);
+
+	// 表の点から t までの残りだけ積分する
+	const float step = 1.0f / static_cast<float>(samplesPerSegment_);
+	const size_t sample = std::min(static_cast<size_t>(t * static_cast<float>(samplesPerSegment_)), size_t(samplesPerSegment_ - 1));
+	const float sampleStart = static_cast<float>(sample) * step;
+	return distances_[segmentIndex * samplesPerSegment_ + sample] + IntegrateLength(segments_[segmentIndex], sampleStart, t);
+}
+
+///************************* 内部処理 *************************///
+
+/// <summary>
+/// param を区間番号と区間内の位置に分ける（範囲外は端にクランプ）
+/// </summary>
+size_t Spline::Locate(float param, float& localT) const
+{
+	const float clamped = std::clamp(param, 0.0f, static_cast<float>(segments_.size()));
+	const size_t index = std::min(static_cast<size_t>(clamped), segments_.size() - 1);
+	localT = clamped - static_cast<float>(index);
+	return index;
+}
+
+/// <summary>
+/// 区間内 [t0, t1] の弧長（|p'(u)| を3点 Gauss-Legendre で積分）
+/// </summary>
+float Spline::IntegrateLength(const Segment& segment, float t0, float t1)
+{
+	// 節点と重み（[-1, 1] 上）
+	constexpr float kNode = 0.774596669f;
+	constexpr float kWeights[3] = { 5.0f / 9.0f, 8.0f / 9.0f, 5.0f / 9.0f };
+	const float nodes[3] = { -kNode, 0.0f, kNode };
+
+	const float half = (t1 - t0) * 0.5f;
+	const float mid = (t0 + t1) * 0.5f;
+
+	float length = 0.0f;
+	for (int i = 0; i < 3; ++i) {
+		const float u = mid + half * nodes[i];
+		length += kWeights[i] * Derivative(segment, u).Length();
+	}
+	return length * half;
+}
@@ -0,0 +1,99 @@
+#pragma once
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Math
+#include "Vector3.h"
+
+/// <summary>
+/// 弧長で引ける Catmull-Rom スプライン
+/// 制御点を設定した時点で区間ごとの3次式の係数と累積弧長の表を作っておき、
+/// 毎フレームの評価は表の二分探索と3次式1回だけで済ませる
+/// </summary>
+/// <remarks>
+/// 曲線の形は CatmullRomPosition と同じ（両端の区間は端の制御点を重複させる）。
+/// パラメータ param は [0, 区間数]（整数部が区間番号）、距離 distance は [0, GetLength()]。
+/// 距離で進めると制御点の間隔によらず一定速度で移動する。
+/// </remarks>
+class Spline
+{
+public:
+	// 1区間あたりの弧長サンプル数の既定値
+	static constexpr uint32_t kDefaultSamplesPerSegment = 16;
+
+	// DistanceToParam の許容誤差（全長に対する比）と Newton 法の最大反復回数
+	static constexpr float kDistanceTolerance = 1.0e-6f;
+	static constexpr uint32_t kMaxNewtonIterations = 8;
+
+public:
+	///************************* 構築 *************************///
+
+	// 制御点から係数と弧長表を作る
+	void Build(std::span<const Vector3> controlPoints, uint32_t samplesPerSegment = kDefaultSamplesPerSegment);
+
+	// 制御点が前回と異なるときだけ作り直す（作り直したら true）
+	bool Rebuild(std::span<const Vector3> controlPoints, uint32_t samplesPerSegment = kDefaultSamplesPerSegment);
+
+	void Clear();
+
+public:
+	///************************* 評価 *************************///
+
+	// パラメータ指定の位置
+	Vector3 Evaluate(float param) const;
+
+	// パラメータ指定の接線（正規化しない。param に対する微分）
+	Vector3 EvaluateDerivative(float param) const;
+
+	// 距離指定の位置（範囲外は端にクランプ）
+	Vector3 EvaluateAtDistance(float distance) const;
+
+	// 距離指定の進行方向（単位ベクトル。長さ0の曲線ではゼロベクトル）
+	Vector3 EvaluateTangentAtDistance(float distance) const;
+
+	// 距離 → パラメータ（O(log n)）
+	float DistanceToParam(float distance) const;
+
+	// パラメータ → 距離
+	float ParamToDistance(float param) const;
+
+public:
+	///************************* アクセッサ *************************///
+
+	bool IsValid() const { return !controlPoints_.empty(); }
+	size_t GetSegmentCount() const { return segments_.size(); }
+	float GetLength() const { return distances_.empty() ? 0.0f : distances_.back(); }
+	const std::vector<Vector3>& GetControlPoints() const { return controlPoints_; }
+
+private:
+	///************************* 内部処理 *************************///
+
+	// p(u) = ((a * u + b) * u + c) * u + d（u は区間内の [0, 1]）
+	struct Segment {
+		Vector3 a, b, c, d;
+	};
+
+	// p'(u)
+	static Vector3 Derivative(const Segment& segment, float u) {
+		return (segment.a * (3.0f * u) + segment.b * 2.0f) * u + segment.c;
+	}
+
+	// param を区間番号と区間内の位置に分ける
+	size_t Locate(float param, float& localT) const;
+
+	// 区間内 [t0, t1] の弧長（3点 Gauss-Legendre）
+	static float IntegrateLength(const Segment& segment, float t0, float t1);
+
+private:
+	///************************* メンバ変数 *************************///
+
+	std::vector<Vector3> controlPoints_;
+	std::vector<Segment> segments_;
+
+	// 等間隔のパラメータで区切った点までの累積弧長（区間数 * samplesPerSegment_ + 1 個）
+	std::vector<float> distances_;
+	uint32_t samplesPerSegment_ = kDefaultSamplesPerSegment;
+};
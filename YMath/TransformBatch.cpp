@@ -0,0 +1,247 @@
+#include "TransformBatch.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+namespace {
+
+	/// <summary>
+	/// [0, count) を均等に分割して func(begin, end) を並列に呼ぶ
+	/// 先頭の範囲は呼び出し元スレッドで処理する
+	/// </summary>
+	template <typename Func>
+	void ParallelFor(size_t count, uint32_t threadCount, const Func& func) {
+		if (count == 0) { return; }
+
+		if (threadCount == 0) {
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		// 小さい配列は分割するとスレッド生成の方が高くつく
+		const size_t maxThreads = std::max<size_t>(1, count / kBatchMinItemsPerThread);
+		const size_t usedThreads = std::min<size_t>(threadCount, maxThreads);
+		if (usedThreads <= 1) {
+			func(size_t(0), count);
+			return;
+		}
+
+		const size_t chunk = (count + usedThreads - 1) / usedThreads;
+		std::vector<std::thread> workers;
+		workers.reserve(usedThreads - 1);
+
+		for (size_t t = 1; t < usedThreads; ++t) {
+			size_t begin = t * chunk;
+			size_t end = std::min(count, begin + chunk);
+			if (begin >= end) { break; }
+			workers.emplace_back([&func, begin, end]() { func(begin, end); });
+		}
+
+		func(size_t(0), std::min(chunk, count));
+
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
+	// 変換の種類
+	enum class PointMode {
+		Projective, // w 除算あり
+		Affine,     // w 除算なし
+		Direction,  // 平行移動なし
+	};
+
+	/// <summary>
+	/// [begin, end) の点を変換
+	/// 各行列行をレジスタに載せたまま回し、Transform / TransformNormal と同じ順序で積和する
+	/// </summary>
+	template <PointMode Mode>
+	void TransformRange(std::span<const Vector3> points, const Matrix4x4& matrix, std::span<Vector3> out, size_t begin, size_t end) {
+#if defined(YMATH_SIMD_SSE)
+		const __m128 r0 = _mm_loadu_ps(matrix.m[0]);
+		const __m128 r1 = _mm_loadu_ps(matrix.m[1]);
+		const __m128 r2 = _mm_loadu_ps(matrix.m[2]);
+		const __m128 r3 = _mm_loadu_ps(matrix.m[3]);
+
+		alignas(16) float result[4];
+		for (size_t i = begin; i < end; ++i) {
+			const Vector3& p = points[i];
+			__m128 v = _mm_mul_ps(_mm_set1_ps(p.x), r0);
+			v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(p.y), r1));
+			v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(p.z), r2));
+			if constexpr (Mode != PointMode::Direction) {
+				v = _mm_add_ps(v, r3);
+			}
+			if constexpr (Mode == PointMode::Projective) {
+				v = _mm_div_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)));
+			}
+			_mm_store_ps(result, v);
+			out[i] = { result[0], result[1], result[2] };
+		}
+#elif defined(YMATH_SIMD_NEON)
+		const float32x4_t r0 = vld1q_f32(matrix.m[0]);
+		const float32x4_t r1 = vld1q_f32(matrix.m[1]);
+		const float32x4_t r2 = vld1q_f32(matrix.m[2]);
+		const float32x4_t r3 = vld1q_f32(matrix.m[3]);
+
+		float result[4];
+		for (size_t i = begin; i < end; ++i) {
+			const Vector3& p = points[i];
+			float32x4_t v = vmulq_n_f32(r0, p.x);
+			v = vfmaq_n_f32(v, r1, p.y);
+			v = vfmaq_n_f32(v, r2, p.z);
+			if constexpr (Mode != PointMode::Direction) {
+				v = vaddq_f32(v, r3);
+			}
+			if constexpr (Mode == PointMode::Projective) {
+				v = vdivq_f32(v, vdupq_laneq_f32(v, 3));
+			}
+			vst1q_f32(result, v);
+			out[i] = { result[0], result[1], result[2] };
+		}
+#else
+		const float(&m)[4][4] = matrix.m;
+		for (size_t i = begin; i < end; ++i) {
+			const Vector3 p = points[i];
+			float x = p.x * m[0][0] + p.y * m[1][0] + p.z * m[2][0];
+			float y = p.x * m[0][1] + p.y * m[1][1] + p.z * m[2][1];
+			float z = p.x * m[0][2] + p.y * m[1][2] + p.z * m[2][2];
+			if constexpr (Mode != PointMode::Direction) {
+				x += m[3][0];
+				y += m[3][1];
+				z += m[3][2];
+			}
+			if constexpr (Mode == PointMode::Projective) {
+				float w = p.x * m[0][3] + p.y * m[1][3] + p.z * m[2][3] + m[3][3];
+				x /= w;
+				y /= w;
+				z /= w;
+			}
+			out[i] = { x, y, z };
+		}
+#endif
+	}
+
+	template <PointMode Mode>
+	void TransformPointsImpl(std::span<const Vector3> points, const Matrix4x4& matrix, std::span<Vector3> out, uint32_t threadCount) {
+		assert(out.size() >= points.size());
+		const size_t count = std::min(points.size(), out.size());
+		ParallelFor(count, threadCount, [&](size_t begin, size_t end) {
+			TransformRange<Mode>(points, matrix, out, begin, end);
+			});
+	}
+}
+
+///************************* 一括変換 *************************///
+
+/// <summary>
+/// 点の一括変換（w 除算あり）
+/// </summary>
+void TransformPoints(std::span<const Vector3> points, const Matrix4x4& matrix, std::span<Vector3> out, uint32_t threadCount) {
+	TransformPointsImpl<PointMode::Projective>(points, matrix, out, threadCount);
+}
+
+/// <summary>
+/// 点の一括変換（アフィン行列専用）
+/// </summary>
+void TransformAffinePoints(std::span<const Vector3> points, const Matrix4x4& matrix, std::span<Vector3> out, uint32_t threadCount) {
+	TransformPointsImpl<PointMode::Affine>(points, matrix, out, threadCount);
+}
+
+/// <summary>
+/// 方向ベクトルの一括変換
+/// </summary>
+void TransformNormals(std::span<const Vector3> normals, const Matrix4x4& matrix, std::span<Vector3> out, uint32_t threadCount) {
+	TransformPointsImpl<PointMode::Direction>(normals, matrix, out, threadCount);
+}
+
+/// <summary>
+/// 行列の一括乗算（右辺は共通）
+/// </summary>
+void MultiplyMatrices(std::span<const Matrix4x4> lhs, const Matrix4x4& rhs, std::span<Matrix4x4> out, uint32_t threadCount) {
+	assert(out.size() >= lhs.size());
+	const size_t count = std::min(lhs.size(), out.size());
+
+	// 右辺が out の中にあっても上書きされないよう先に複製しておく
+	const Matrix4x4 right = rhs;
+	ParallelFor(count, threadCount, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			YMathSimd::MultiplyMatrix(lhs[i].m, right.m, out[i].m);
+		}
+		});
+}
+
+/// <summary>
+/// 行列の一括乗算（要素ごと）
+/// </summary>
+void MultiplyMatrices(std::span<const Matrix4x4> lhs, std::span<const Matrix4x4> rhs, std::span<Matrix4x4> out, uint32_t threadCount) {
+	assert(out.size() >= std::min(lhs.size(), rhs.size()));
+	const size_t count = std::min({ lhs.size(), rhs.size(), out.size() });
+	ParallelFor(count, threadCount, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			YMathSimd::MultiplyMatrix(lhs[i].m, rhs[i].m, out[i].m);
+		}
+		});
+}
+
+/// <summary>
+/// 回転クォータニオンの一括行列化
+/// </summary>
+void MakeRotateMatrices(std::span<const Quaternion> rotates, std::span<Matrix4x4> out, uint32_t threadCount) {
+	assert(out.size() >= rotates.size());
+	const size_t count = std::min(rotates.size(), out.size());
+	ParallelFor(count, threadCount, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = MakeRotateMatrix(rotates[i]);
+		}
+		});
+}
+
+/// <summary>
+/// S・R(クォータニオン)・T の一括行列化
+/// </summary>
+void MakeAffineMatrices(std::span<const Vector3> scales, std::span<const Quaternion> rotates,
+	std::span<const Vector3> translates, std::span<Matrix4x4> out, uint32_t threadCount) {
+	const size_t count = std::min({ scales.size(), rotates.size(), translates.size(), out.size() });
+	assert(out.size() >= count);
+	ParallelFor(count, threadCount, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = MakeAffineMatrix(scales[i], rotates[i], translates[i]);
+		}
+		});
+}
+
+/// <summary>
+/// 点群を囲む AABB
+/// </summary>
+AABB ComputeAABB(std::span<const Vector3> points) {
+	if (points.empty()) {
+		return { {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f} };
+	}
+
+#if defined(YMATH_SIMD_SSE)
+	__m128 minimum = _mm_setr_ps(points[0].x, points[0].y, points[0].z, 0.0f);
+	__m128 maximum = minimum;
+	for (size_t i = 1; i < points.size(); ++i) {
+		const __m128 p = _mm_setr_ps(points[i].x, points[i].y, points[i].z, 0.0f);
+		minimum = _mm_min_ps(minimum, p);
+		maximum = _mm_max_ps(maximum, p);
+	}
+
+	alignas(16) float mn[4];
+	alignas(16) float mx[4];
+	_mm_store_ps(mn, minimum);
+	_mm_store_ps(mx, maximum);
+	return { {mn[0], mn[1], mn[2]}, {mx[0], mx[1], mx[2]} };
+#else
+	AABB result{ points[0], points[0] };
+	for (size_t i = 1; i < points.size(); ++i) {
+		const Vector3& p = points[i];
+		result.min = { std::min(result.min.x, p.x), std::min(result.min.y, p.y), std::min(result.min.z, p.z) };
+		result.max = { std::max(result.max.x, p.x), std::max(result.max.y, p.y), std::max(result.max.z, p.z) };
+	}
+	return result;
+#endif
+}
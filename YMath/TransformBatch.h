@@ -0,0 +1,46 @@
+#pragma once
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Math
+#include "Vector3.h"
+#include "Matrix4x4.h"
+#include "Quaternion.h"
+#include "MathFunc.h"
+
+///************************* 一括変換 *************************///
+// 点・法線・行列の配列をまとめて変換する
+// 入力と出力は同じ長さ（短い方に合わせる）で、同じ配列を渡してもよい
+// threadCount が 0 ならハードウェアスレッド数、1 なら呼び出し元スレッドのみで処理する
+// 要素数が kBatchMinItemsPerThread 未満のときは分割せずに処理する
+
+// 1スレッドに割り当てる最小要素数
+constexpr size_t kBatchMinItemsPerThread = 4096;
+
+// 点の一括変換（w 除算あり。Transform と同じ結果）
+void TransformPoints(std::span<const Vector3> points, const Matrix4x4& matrix, std::span<Vector3> out, uint32_t threadCount = 1);
+
+// 点の一括変換（アフィン行列専用。w 除算を省く）
+void TransformAffinePoints(std::span<const Vector3> points, const Matrix4x4& matrix, std::span<Vector3> out, uint32_t threadCount = 1);
+
+// 方向ベクトルの一括変換（平行移動を無視。TransformNormal と同じ結果）
+void TransformNormals(std::span<const Vector3> normals, const Matrix4x4& matrix, std::span<Vector3> out, uint32_t threadCount = 1);
+
+// 行列の一括乗算 out[i] = lhs[i] * rhs
+void MultiplyMatrices(std::span<const Matrix4x4> lhs, const Matrix4x4& rhs, std::span<Matrix4x4> out, uint32_t threadCount = 1);
+
+// 行列の一括乗算 out[i] = lhs[i] * rhs[i]
+void MultiplyMatrices(std::span<const Matrix4x4> lhs, std::span<const Matrix4x4> rhs, std::span<Matrix4x4> out, uint32_t threadCount = 1);
+
+// 回転クォータニオンの一括行列化 out[i] = MakeRotateMatrix(rotates[i])
+void MakeRotateMatrices(std::span<const Quaternion> rotates, std::span<Matrix4x4> out, uint32_t threadCount = 1);
+
+// S・R(クォータニオン)・T の一括行列化 out[i] = MakeAffineMatrix(scales[i], rotates[i], translates[i])
+// アニメーションのサンプリング結果（SoA）をそのまま渡せるよう配列を分けて受け取る
+void MakeAffineMatrices(std::span<const Vector3> scales, std::span<const Quaternion> rotates,
+	std::span<const Vector3> translates, std::span<Matrix4x4> out, uint32_t threadCount = 1);
+
+// 点群を囲む AABB（空なら原点の大きさ0の箱）
+AABB ComputeAABB(std::span<const Vector3> points);
@@ -20,15 +20,25 @@ workspace "YoRigine"
     warnings "Extra"
     flags { "MultiProcessorCompile" }
 
-    -- PlatformToolset
-    toolset "v143"
-    
-    buildoptions { "/utf-8", "/permissive-" }
-    defines { "NOMINMAX", "_WINDOWS" }
+    defines { "NOMINMAX" }
 
     targetdir (outputDir)
     objdir    (intDir)
 
+    -- Visual Studio 向けの設定（Linux では YMathBench だけを gmake2 でビルドする）
+    filter "system:windows"
+        -- PlatformToolset
+        toolset "v143"
+
+        buildoptions { "/utf-8", "/permissive-" }
+        defines { "_WINDOWS" }
+
+    filter "system:not windows"
+        targetdir "%{wks.basedir}/generated/outputs/%{cfg.buildcfg}"
+        objdir    "%{wks.basedir}/generated/intermediates/%{prj.name}/%{cfg.buildcfg}"
+
+    filter {}
+
     filter "configurations:Debug"
         defines { "_DEBUG" }
         symbols "On"
@@ -256,6 +266,193 @@ group "Game"
 --------------------------------------------------------------------------------
 group ""
 
+--------------------------------------------------------------------------------
+-- グループ: Tools (開発用ツール)
+--------------------------------------------------------------------------------
+group "Tools"
+
+    --------------------- YMath ベンチマーク (Console Application) ---------------------
+    -- YMath のソースを直接ビルドするので、バックエンドを変えた版を並べて比較できる
+    -- Linux: premake5 gmake2 && make YMathBench YMathBenchScalar config=release_x64
+    local function ymath_bench_project(name, benchDefines)
+        project(name)
+            kind "ConsoleApp"
+            location "%{wks.basedir}/Tools/YMathBench"
+
+            files {
+                "Tools/YMathBench/**.cpp",
+                "YMath/**.h",
+                "YMath/**.cpp"
+            }
+            -- DirectXMath 連携は Windows 専用なので含めない
+            removefiles { "YMath/MathDirectX.*" }
+
+            includedirs { "YMath" }
+            defines(benchDefines)
+
+            vpaths {
+                ["Tools/*"] = "Tools/**",
+                ["YMath/*"] = "YMath/**"
+            }
+
+            filter "configurations:Release"
+                optimize "Speed"
+
+            filter {}
+    end
+
+    -- 既定の SIMD バックエンド
+    ymath_bench_project("YMathBench", {})
+    -- スカラー実装（比較用）
+    ymath_bench_project("YMathBenchScalar", { "YMATH_FORCE_SCALAR" })
+
+    --------------------- テクスチャ変換 (Console Application) ---------------------
+    -- 画像をミップ付きの BC7 / BC5 / BC4 DDS に変換して Resources/Cooked/Textures へ書き出す
+    -- DirectXTex はソースから直接ビルドする（GPU 圧縮と D3D 連携は使わないので除く）
+    -- Linux: DirectX-Headers・DirectXMath・libpng・libjpeg を入れてから premake5 gmake2 && make TextureCooker config=release_x64
+    project "TextureCooker"
+        kind "ConsoleApp"
+        location "%{wks.basedir}/Tools/TextureCooker"
+
+        files {
+            "Tools/TextureCooker/**.cpp",
+            "YEngine/Utilities/Loaders/Texture/TextureCache.*",
+            "Externals/DirectXTex/*.h",
+            "Externals/DirectXTex/*.cpp"
+        }
+        removefiles {
+            "Externals/DirectXTex/BCDirectCompute.*",
+            "Externals/DirectXTex/DirectXTexCompressGPU.cpp",
+            "Externals/DirectXTex/DirectXTexD3D11.cpp",
+            "Externals/DirectXTex/DirectXTexD3D12.cpp"
+        }
+
+        includedirs {
+            "Externals/DirectXTex",
+            "YEngine/Utilities/Loaders/Texture"
+        }
+
+        -- BC7 の圧縮は DirectXTex が OpenMP で並列化する
+        openmp "On"
+
+        vpaths {
+            ["Tools/*"] = "Tools/**",
+            ["YEngine/*"] = "YEngine/**",
+            ["Externals/*"] = "Externals/**"
+        }
+
+        filter "system:windows"
+            removefiles { "Tools/TextureCooker/ImageDecoder.*" }
+            links { "ole32", "windowscodecs" }
+
+        -- WIC が無いので PNG / JPG / BMP は ImageDecoder（libpng / libjpeg）で読む
+        filter "system:not windows"
+            removefiles { "Externals/DirectXTex/DirectXTexWIC.cpp" }
+            includedirs { "/usr/include/directx", "/usr/include/dxguid" }
+            links { "png", "jpeg" }
+
+        filter "configurations:Release"
+            optimize "Speed"
+
+        filter {}
+
+    --------------------- メッシュ最適化レポート (Console Application) ---------------------
+    -- OBJ に MeshOptimizer をかけて ACMR の変化を表示し、三角形が変わっていないことを確かめる（MeshSimplifier の LOD も表示する）
+    -- Linux: premake5 gmake2 && make MeshOptimizerReport config=release_x64
+    project "MeshOptimizerReport"
+        kind "ConsoleApp"
+        location "%{wks.basedir}/Tools/MeshOptimizerReport"
+
+        files {
+            "Tools/MeshOptimizerReport/**.cpp",
+            "YEngine/Model/Mesh/MeshOptimizer.*",
+            "YEngine/Model/Mesh/MeshSimplifier.*"
+        }
+
+        includedirs { "YEngine/Model/Mesh" }
+
+        vpaths {
+            ["Tools/*"] = "Tools/**",
+            ["YEngine/*"] = "YEngine/**"
+        }
+
+        filter "configurations:Release"
+            optimize "Speed"
+
+        filter {}
+
+    --------------------- アロケータのテスト (Console Application) ---------------------
+    -- RangeAllocator / MeshBufferArena / FrameRingAllocator の動作を確かめ、違えば終了コード 1 を返す
+    -- デバイスは WARP で作る（DeviceManager.cpp の代わりに TestDevice.cpp をリンク）。Windows 以外では Stub の代替ヘッダを使う
+    -- Linux: premake5 gmake2 && make AllocatorTest config=release_x64
+    project "AllocatorTest"
+        kind "ConsoleApp"
+        location "%{wks.basedir}/Tools/AllocatorTest"
+
+        files {
+            "Tools/AllocatorTest/**.cpp",
+            "Tools/AllocatorTest/**.h",
+            "YEngine/Core/DirectX/DeviceManager.h",
+            "YEngine/Core/DirectX/RangeAllocator.*",
+            "YEngine/Core/DirectX/MeshBufferArena.*",
+            "YEngine/Core/DirectX/FrameRingAllocator.*"
+        }
+
+        includedirs {
+            "YEngine/Core/DirectX",
+            "YEngine/Utilities"
+        }
+
+        vpaths {
+            ["Tools/*"] = "Tools/**",
+            ["YEngine/*"] = "YEngine/**"
+        }
+
+        filter "system:windows"
+            links { "d3d12", "dxgi" }
+
+        filter "system:not windows"
+            includedirs { "Tools/AllocatorTest/Stub" }
+
+        filter "configurations:Release"
+            optimize "Speed"
+
+        filter {}
+
+    --------------------- レベル配置物のカリングのテスト (Console Application) ---------------------
+    -- LevelObjectCuller が読み込み中のオブジェクトを除いて判定し、モデルが届けば描けるようになるかを確かめる
+    -- Linux: premake5 gmake2 && make LevelCullingTest config=release_x64
+    project "LevelCullingTest"
+        kind "ConsoleApp"
+        location "%{wks.basedir}/Tools/LevelCullingTest"
+
+        files {
+            "Tools/LevelCullingTest/**.cpp",
+            "YEngine/Utilities/Loaders/LevelData/LevelObjectCuller.h",
+            "YMath/**.h",
+            "YMath/**.cpp"
+        }
+        -- DirectXMath 連携は Windows 専用なので含めない
+        removefiles { "YMath/MathDirectX.*" }
+
+        includedirs {
+            "YMath",
+            "YEngine/Utilities/Loaders/LevelData"
+        }
+
+        vpaths {
+            ["Tools/*"] = "Tools/**",
+            ["YEngine/*"] = "YEngine/**",
+            ["YMath/*"] = "YMath/**"
+        }
+
+        filter "configurations:Release"
+            optimize "Speed"
+
+        filter {}
+
+group ""
+
 --------------------------------------------------------------------------------
 -- Resources (リソース管理)
 --------------------------------------------------------------------------------